@@ -0,0 +1,217 @@
+#include "benchmark.hpp"
+#include "tinydds/rtps/cdr_type_support.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace tinydds::rtps;
+namespace bench = tinydds::bench;
+
+// ============================================================
+// CDR 编解码吞吐：三种典型的消息形状
+//   primitive: 全是定长基本类型（类型支持会合并成一段）
+//   string:    以字符串为主（每个字段都有长度前缀和逐个复制）
+//   array:     大数组/序列（看批量复制和字节交换的速度）
+// 每种形状分别测本机字节序和交换字节序（对端字节序不同时的路径）
+// ============================================================
+
+struct PrimitiveMessage{
+    uint32_t id;
+    uint32_t flags;
+    int64_t stamp;
+    double x;
+    double y;
+    double z;
+    float roll;
+    float pitch;
+    float yaw;
+    int32_t temperature;
+    uint16_t battery;
+    uint8_t status;
+    bool valid;
+    uint64_t counter;
+    int16_t rssi;
+    uint32_t checksum;
+};
+
+struct StringMessage{
+    uint32_t id;
+    std::string topic;
+    std::string type_name;
+    std::string frame_id;
+    std::string source;
+    std::string label;
+    std::string unit;
+    std::string owner;
+    std::string note;
+    uint64_t stamp;
+};
+
+struct ArrayMessage{
+    uint32_t id;
+    std::array<float, 256> samples;
+    std::vector<double> values;
+    std::vector<uint16_t> pixels;
+};
+
+TINYDDS_CDR_TYPE(PrimitiveMessage, id, flags, stamp, x, y, z, roll, pitch, yaw, temperature, battery, status, valid,
+                 counter, rssi, checksum);
+TINYDDS_CDR_TYPE(StringMessage, id, topic, type_name, frame_id, source, label, unit, owner, note, stamp);
+TINYDDS_CDR_TYPE(ArrayMessage, id, samples, values, pixels);
+
+namespace {
+
+constexpr double kPrimitiveFields = 16;
+constexpr double kStringFields = 10;
+
+PrimitiveMessage make_primitive(){
+    PrimitiveMessage m{};
+    m.id = 42;
+    m.flags = 0x5a5a;
+    m.stamp = 1700000000123456789LL;
+    m.x = 1.5;
+    m.y = -2.25;
+    m.z = 3.125;
+    m.roll = 0.1f;
+    m.pitch = 0.2f;
+    m.yaw = 0.3f;
+    m.temperature = -40;
+    m.battery = 3700;
+    m.status = 3;
+    m.valid = true;
+    m.counter = 123456789012345ULL;
+    m.rssi = -67;
+    m.checksum = 0xdeadbeef;
+    return m;
+}
+
+StringMessage make_string(){
+    StringMessage m;
+    m.id = 7;
+    m.topic = "rt/vehicle/telemetry";
+    m.type_name = "vehicle::msg::Telemetry";
+    m.frame_id = "base_link";
+    m.source = "lidar_front_left";
+    m.label = "pedestrian";
+    m.unit = "m/s";
+    m.owner = "perception_pipeline_node_03";
+    m.note = "calibrated against reference target at 25 degrees celsius";
+    m.stamp = 1700000000123456789ULL;
+    return m;
+}
+
+ArrayMessage make_array(){
+    ArrayMessage m;
+    m.id = 9;
+    for(size_t i = 0; i < m.samples.size(); ++i) m.samples[i] = static_cast<float>(i) * 0.5f;
+    m.values.resize(512);
+    for(size_t i = 0; i < m.values.size(); ++i) m.values[i] = static_cast<double>(i) * 0.25;
+    m.pixels.resize(1024);
+    for(size_t i = 0; i < m.pixels.size(); ++i) m.pixels[i] = static_cast<uint16_t>(i * 7);
+    return m;
+}
+
+double array_fields(const ArrayMessage& m){
+    return static_cast<double>(1 + m.samples.size() + m.values.size() + m.pixels.size());
+}
+
+// 序列化后的字节数（不含封装头）
+template<typename Serializer, typename T>
+std::vector<uint8_t> encode(const T& sample){
+    Serializer serializer(64 * 1024);
+    serializer.serialize_type(sample);
+    return std::vector<uint8_t>(serializer.data(), serializer.data() + serializer.size());
+}
+
+// 序列化：序列化器复用（reset 后缓冲区保留），测的是编码本身而不是分配
+template<typename Serializer, typename T>
+void bench_serialize(bench::Runner& runner, const std::string& name, const T& sample, double fields){
+    Serializer serializer(64 * 1024);
+    double bytes = static_cast<double>(encode<Serializer>(sample).size());
+    runner.run(name, [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            serializer.reset();
+            serializer.serialize_type(sample);
+            bench::do_not_optimize(serializer.size());
+            bench::clobber_memory();
+        }
+    }, fields, bytes);
+}
+
+// 反序列化到复用的对象（字符串和序列的容量保留，稳定状态下不分配）
+template<typename Serializer, typename Deserializer, typename T>
+void bench_deserialize(bench::Runner& runner, const std::string& name, const T& sample, double fields){
+    std::vector<uint8_t> encoded = encode<Serializer>(sample);
+    T out = sample;
+    runner.run(name, [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            Deserializer deserializer(encoded.data(), encoded.size());
+            bool ok = deserializer.deserialize_type(out);
+            bench::do_not_optimize(ok);
+            bench::clobber_memory();
+        }
+    }, fields, static_cast<double>(encoded.size()));
+}
+
+// 本机字节序和另一种字节序的序列化器/反序列化器
+template<bool Native>
+struct Codec;
+
+template<>
+struct Codec<true>{
+    using Serializer = BasicCdrSerializer<NativeEndianPolicy>;
+    using Deserializer = BasicCdrDeserializer<NativeEndianPolicy>;
+};
+
+template<>
+struct Codec<false>{
+    using SwappedPolicy = std::conditional_t<native_endian() == CdrEndian::LITTLE_ENDIAN_ORDER,
+                                             BigEndianPolicy, LittleEndianPolicy>;
+    using Serializer = BasicCdrSerializer<SwappedPolicy>;
+    using Deserializer = BasicCdrDeserializer<SwappedPolicy>;
+};
+
+template<bool Native, typename T>
+void bench_shape(bench::Runner& runner, const std::string& shape, const T& sample, double fields){
+    const std::string order = Native ? "native" : "swapped";
+    using C = Codec<Native>;
+    bench_serialize<typename C::Serializer>(runner, "cdr/serialize/" + shape + "/" + order, sample, fields);
+    bench_deserialize<typename C::Serializer, typename C::Deserializer>(
+        runner, "cdr/deserialize/" + shape + "/" + order, sample, fields);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    bench::Runner runner(argc, argv, "cdr");
+
+    PrimitiveMessage primitive = make_primitive();
+    StringMessage strings = make_string();
+    ArrayMessage arrays = make_array();
+
+    bench_shape<true>(runner, "primitive", primitive, kPrimitiveFields);
+    bench_shape<false>(runner, "primitive", primitive, kPrimitiveFields);
+    bench_shape<true>(runner, "string", strings, kStringFields);
+    bench_shape<false>(runner, "string", strings, kStringFields);
+    bench_shape<true>(runner, "array", arrays, array_fields(arrays));
+    bench_shape<false>(runner, "array", arrays, array_fields(arrays));
+
+    // CdrSizeCalculator：按确切大小一次分配之前先算一遍大小的开销
+    runner.run("cdr/size_calculator/primitive", [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            CdrSizeCalculator calc;
+            calc.serialize_type(primitive);
+            bench::do_not_optimize(calc.size());
+        }
+    }, kPrimitiveFields);
+    runner.run("cdr/size_calculator/string", [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            CdrSizeCalculator calc;
+            calc.serialize_type(strings);
+            bench::do_not_optimize(calc.size());
+        }
+    }, kStringFields);
+
+    return runner.finish();
+}
@@ -0,0 +1,146 @@
+#include "benchmark.hpp"
+#include "tinydds/rtps/flat_hash_map.hpp"
+#include "tinydds/rtps/guid.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace tinydds::rtps;
+namespace bench = tinydds::bench;
+
+// ============================================================
+// GUID 的哈希、比较，以及按 GUID 查表（匹配远端端点、按写端找读端状态）
+// 表的大小覆盖小系统（1k 个端点）到大规模发现（1M 个端点）。
+// GUID 按实际分布生成：少量参与者（前缀）下面挂很多端点（EntityId 递增）
+// ============================================================
+
+namespace {
+
+constexpr size_t kEndpointsPerParticipant = 64;
+
+std::vector<GUID> make_guids(size_t count, uint64_t seed){
+    std::mt19937_64 rng(seed);
+    std::vector<GUID> guids;
+    guids.reserve(count);
+    GuidPrefix prefix;
+    for(size_t i = 0; i < count; ++i){
+        if(i % kEndpointsPerParticipant == 0){
+            uint64_t a = rng();
+            uint64_t b = rng();
+            for(size_t k = 0; k < 8; ++k) prefix.value[k] = static_cast<uint8_t>(a >> (k * 8));
+            for(size_t k = 0; k < 4; ++k) prefix.value[8 + k] = static_cast<uint8_t>(b >> (k * 8));
+        }
+        uint32_t key = static_cast<uint32_t>(i % kEndpointsPerParticipant) + 1;
+        EntityId entity(static_cast<uint8_t>(key >> 16), static_cast<uint8_t>(key >> 8), static_cast<uint8_t>(key),
+                        i % 2 == 0 ? EntityKind::USER_WRITER_WITH_KEY : EntityKind::USER_READER_WITH_KEY);
+        guids.emplace_back(prefix, entity);
+    }
+    return guids;
+}
+
+std::string size_label(size_t n){
+    if(n >= (1u << 20)) return std::to_string(n >> 20) + "M";
+    if(n >= 1024) return std::to_string(n >> 10) + "k";
+    return std::to_string(n);
+}
+
+// 查表：按打乱后的顺序查找（大表时每次查找都是一次缓存未命中，接近真实情况）
+template<typename Map>
+void bench_lookup(bench::Runner& runner, const std::string& name, const Map& map, const std::vector<GUID>& keys){
+    runner.run(name, [&](uint64_t iterations){
+        size_t index = 0;
+        size_t found = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            found += map.find(keys[index]) != map.end();
+            if(++index == keys.size()) index = 0;
+        }
+        bench::do_not_optimize(found);
+    });
+}
+
+void bench_table(bench::Runner& runner, size_t size){
+    std::vector<GUID> guids = make_guids(size, size);
+    std::vector<GUID> hits = guids;
+    std::shuffle(hits.begin(), hits.end(), std::mt19937_64(1));
+    std::vector<GUID> misses = make_guids(std::min<size_t>(size, 1 << 16), size + 1);
+    const std::string label = size_label(size);
+
+    {
+        GuidMap<uint64_t> map(size);
+        for(size_t i = 0; i < guids.size(); ++i) map.insert(guids[i], i);
+        auto find = [&](const std::vector<GUID>& keys){
+            return [&map, &keys](uint64_t iterations){
+                size_t index = 0;
+                size_t found = 0;
+                for(uint64_t i = 0; i < iterations; ++i){
+                    found += map.find(keys[index]) != nullptr;
+                    if(++index == keys.size()) index = 0;
+                }
+                bench::do_not_optimize(found);
+            };
+        };
+        runner.run("guid/guid_map/find_hit/" + label, find(hits));
+        runner.run("guid/guid_map/find_miss/" + label, find(misses));
+    }
+    {
+        // 对照：std::unordered_map（节点分配，每次查找多一次指针跳转）
+        std::unordered_map<GUID, uint64_t> map;
+        map.reserve(size);
+        for(size_t i = 0; i < guids.size(); ++i) map.emplace(guids[i], i);
+        bench_lookup(runner, "guid/unordered_map/find_hit/" + label, map, hits);
+        bench_lookup(runner, "guid/unordered_map/find_miss/" + label, map, misses);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    bench::Runner runner(argc, argv, "guid");
+
+    // 单个操作：在 1024 个 GUID 上循环，数据都在 L1 里
+    std::vector<GUID> guids = make_guids(1024, 7);
+    const size_t mask = guids.size() - 1;
+
+    runner.run("guid/hash", [&](uint64_t iterations){
+        uint64_t sum = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            sum += std::hash<GUID>()(guids[i & mask]);
+        }
+        bench::do_not_optimize(sum);
+    }, 1, sizeof(GUID));
+
+    // 同一个参与者下的端点前缀相同，比较要看到第二个字才能分出结果
+    runner.run("guid/equal", [&](uint64_t iterations){
+        size_t equal = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            equal += guids[i & mask] == guids[(i + 1) & mask];
+        }
+        bench::do_not_optimize(equal);
+    });
+
+    runner.run("guid/less", [&](uint64_t iterations){
+        size_t less = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            less += guids[i & mask] < guids[(i + 1) & mask];
+        }
+        bench::do_not_optimize(less);
+    });
+
+    runner.run("guid/sort/1k", [&](uint64_t iterations){
+        std::vector<GUID> work;
+        for(uint64_t i = 0; i < iterations; ++i){
+            work = guids;
+            std::sort(work.begin(), work.end());
+            bench::do_not_optimize(work.front());
+        }
+    }, static_cast<double>(guids.size()));
+
+    bench_table(runner, 1024);
+    bench_table(runner, 64 * 1024);
+    bench_table(runner, 1024 * 1024);
+
+    return runner.finish();
+}
@@ -0,0 +1,82 @@
+#include "benchmark.hpp"
+#include "tinydds/rtps/sequence_number.hpp"
+
+#include <vector>
+
+using namespace tinydds::rtps;
+namespace bench = tinydds::bench;
+
+// ============================================================
+// SequenceNumber 的算术和比较：写端每个样本、读端每个 HEARTBEAT/ACKNACK 都要做
+// 输入取自一个数组，避免编译器把整个循环折叠成常量
+// ============================================================
+
+int main(int argc, char** argv){
+    bench::Runner runner(argc, argv, "sequence_number");
+
+    // low 接近 32 位上限，加减时会跨 high/low 边界
+    std::vector<SequenceNumber> values;
+    for(int64_t i = 0; i < 1024; ++i){
+        values.emplace_back(static_cast<int64_t>(0xFFFFFF00LL) + i * 3);
+    }
+    const size_t mask = values.size() - 1;
+
+    runner.run("sequence_number/increment", [&](uint64_t iterations){
+        SequenceNumber sn(0, 0xFFFFFF00u);
+        for(uint64_t i = 0; i < iterations; ++i){
+            ++sn;
+            bench::do_not_optimize(sn);
+        }
+    });
+
+    runner.run("sequence_number/add", [&](uint64_t iterations){
+        int64_t sum = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            sum += (values[i & mask] + static_cast<int64_t>(i & 0xFF)).low;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    runner.run("sequence_number/difference", [&](uint64_t iterations){
+        int64_t sum = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            sum += values[i & mask] - values[(i + 7) & mask];
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    runner.run("sequence_number/less", [&](uint64_t iterations){
+        size_t less = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            less += values[i & mask] < values[(i + 7) & mask];
+        }
+        bench::do_not_optimize(less);
+    });
+
+    runner.run("sequence_number/equal", [&](uint64_t iterations){
+        size_t equal = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            equal += values[i & mask] == values[(i + 1) & mask];
+        }
+        bench::do_not_optimize(equal);
+    });
+
+    runner.run("sequence_number/to_int64", [&](uint64_t iterations){
+        int64_t sum = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            sum += values[i & mask].to_int64();
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    runner.run("sequence_number/from_int64", [&](uint64_t iterations){
+        uint64_t sum = 0;
+        for(uint64_t i = 0; i < iterations; ++i){
+            SequenceNumber sn(static_cast<int64_t>(i) + 0xFFFFFF00LL);
+            sum += sn.low ^ static_cast<uint32_t>(sn.high);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    return runner.finish();
+}
@@ -0,0 +1,94 @@
+#include "benchmark.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+#include "tinydds/rtps/receive_window.hpp"
+#include "tinydds/rtps/writer_history.hpp"
+
+#include <chrono>
+#include <vector>
+
+using namespace tinydds::rtps;
+namespace bench = tinydds::bench;
+
+// ============================================================
+// 实体统计在热路径上的开销
+//
+// statistics/* 是单独的记录操作；history/* 和 window/* 是同一个操作带统计和不带统计的对比，
+// 两者之差就是每个样本的统计开销（记录的调用在库的 .cpp 里，要用 -DCMAKE_BUILD_TYPE=Release
+// 构建库才有意义）。用 -DTINYDDS_STATISTICS=OFF 构建时所有记录都被编译掉
+// ============================================================
+
+int main(int argc, char** argv){
+    bench::Runner runner(argc, argv, "statistics");
+
+    GUID guid;
+    guid.entityId = EntityId(0x00, 0x00, 0x01, EntityKind::USER_WRITER_NO_KEY);
+    EntityStatistics statistics(guid);
+
+    runner.run("statistics/on_sample_sent", [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            statistics.on_sample_sent(64 + (i & 7));
+            bench::clobber_memory();
+        }
+    });
+
+    // 每个样本：计数 + 按 1/16 抽样读时钟记录延迟
+    runner.run("statistics/sample_with_latency", [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            statistics.on_sample_received(64);
+            if(statistics.sample_timing()){
+                auto now = std::chrono::steady_clock::now().time_since_epoch();
+                statistics.record_latency(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()) & 0xFFFFF);
+            }
+            bench::clobber_memory();
+        }
+    });
+
+    runner.run("statistics/serialization_timer", [&](uint64_t iterations){
+        for(uint64_t i = 0; i < iterations; ++i){
+            SerializationTimer timer(&statistics);
+            bench::clobber_memory();
+        }
+    });
+
+    runner.run("statistics/snapshot", [&](uint64_t iterations){
+        EntityStatisticsSnapshot snapshot;
+        for(uint64_t i = 0; i < iterations; ++i){
+            statistics.snapshot(snapshot);
+            bench::do_not_optimize(snapshot.counters.samples_sent);
+        }
+    });
+
+    // 写端：KEEP_LAST 历史缓存写入一个小样本
+    std::vector<uint8_t> payload(64, 0xAB);
+    for(bool with_statistics : {false, true}){
+        HistoryQos qos;
+        qos.depth = 64;
+        WriterHistoryCache history(qos, payload.size());
+        if(with_statistics) history.set_statistics(&statistics);
+        runner.run(with_statistics ? "history/add_change/statistics" : "history/add_change/plain",
+                   [&](uint64_t iterations){
+                       for(uint64_t i = 0; i < iterations; ++i){
+                           bench::do_not_optimize(history.add_change(payload));
+                       }
+                   });
+    }
+
+    // 读端：按序收到一个样本并交付
+    for(bool with_statistics : {false, true}){
+        ReceiveWindow window;
+        if(with_statistics) window.set_statistics(&statistics);
+        int64_t next = 1;
+        runner.run(with_statistics ? "window/on_data/statistics" : "window/on_data/plain",
+                   [&](uint64_t iterations){
+                       for(uint64_t i = 0; i < iterations; ++i){
+                           window.on_data(SequenceNumber(next++), payload);
+                           window.deliver([](const SequenceNumber&, ConstByteSpan sample){
+                               bench::do_not_optimize(sample.data());
+                           });
+                       }
+                   });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace tinydds {
+namespace bench {
+
+// ============================================================
+// 微基准测试的公共部分（只给 benchmarks/ 下的程序用，不进库）
+//
+//     bench::Runner runner(argc, argv, "cdr");
+//     runner.run("cdr/serialize/primitive", [&](uint64_t iterations){
+//         for(uint64_t i = 0; i < iterations; ++i){ ... bench::do_not_optimize(x); }
+//     }, fields_per_op, bytes_per_op);
+//     return runner.finish();
+//
+// 每个用例先自动标定迭代次数（单次运行至少 min_time 秒），再重复 repetitions 次，
+// 报告最快的一次（受干扰最少）和中位数。
+// 结果打印成表格；--json <file> 另外写一份 JSON（file 为 - 时写到标准输出），
+// 便于在不同提交之间比较。
+//
+// 命令行参数：
+//   --json <file>       JSON 输出
+//   --min-time <秒>     每次重复的最短时间，默认 0.2
+//   --repetitions <n>   重复次数，默认 5
+//   --filter <子串>     只运行名字包含子串的用例
+// ============================================================
+
+// 阻止编译器把结果没被使用的计算优化掉
+template<typename T>
+inline void do_not_optimize(const T& value){
+    if constexpr(std::is_trivially_copyable<T>::value && sizeof(T) <= sizeof(void*)){
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+    else{
+        asm volatile("" : : "m"(value) : "memory");
+    }
+}
+
+// 让编译器认为所有内存都可能被读写（写入的数据不能被当成死存储删掉）
+inline void clobber_memory(){
+    asm volatile("" : : : "memory");
+}
+
+struct Result{
+    std::string name;
+    uint64_t iterations = 0;  // 每次重复的迭代次数
+    double ns_per_op = 0;     // 最快的一次重复
+    double ns_per_op_median = 0;
+    double items_per_op = 0;  // 每次操作处理的字段/元素数（0 表示不统计）
+    double bytes_per_op = 0;  // 每次操作处理的字节数（0 表示不统计）
+};
+
+class Runner{
+public:
+    Runner(int argc, char** argv, const char* suite) : suite_(suite){
+        for(int i = 1; i < argc; ++i){
+            const char* arg = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            if(std::strcmp(arg, "--json") == 0 && value != nullptr){
+                json_path_ = value;
+                ++i;
+            }
+            else if(std::strcmp(arg, "--min-time") == 0 && value != nullptr){
+                min_time_ = std::atof(value);
+                ++i;
+            }
+            else if(std::strcmp(arg, "--repetitions") == 0 && value != nullptr){
+                repetitions_ = std::max(1, std::atoi(value));
+                ++i;
+            }
+            else if(std::strcmp(arg, "--filter") == 0 && value != nullptr){
+                filter_ = value;
+                ++i;
+            }
+            else{
+                std::fprintf(stderr, "用法: %s [--json <file>] [--min-time <秒>] [--repetitions <n>] [--filter <子串>]\n",
+                             argv[0]);
+                std::exit(2);
+            }
+        }
+        if(min_time_ <= 0) min_time_ = 0.2;
+        // JSON 写到标准输出时表格改写到标准错误，不混在一起
+        table_ = json_path_ == "-" ? stderr : stdout;
+        std::fprintf(table_, "%-44s %12s %12s %12s %12s %10s\n",
+                     "benchmark", "iterations", "ns/op", "median", "ns/item", "GB/s");
+    }
+
+    // fn(uint64_t iterations) 执行 iterations 次被测操作
+    // items_per_op: 每次操作处理的字段/元素数；bytes_per_op: 每次操作处理的字节数
+    template<typename Fn>
+    void run(const std::string& name, Fn&& fn, double items_per_op = 0, double bytes_per_op = 0){
+        if(!filter_.empty() && name.find(filter_) == std::string::npos) return;
+
+        // 标定：迭代次数翻倍直到单次运行超过 min_time 的十分之一，再按比例放大
+        uint64_t iterations = 1;
+        double elapsed = time(fn, iterations);
+        while(elapsed < min_time_ / 10 && iterations < (uint64_t(1) << 40)){
+            iterations *= 2;
+            elapsed = time(fn, iterations);
+        }
+        if(elapsed < min_time_){
+            double scale = elapsed > 0 ? min_time_ / elapsed : 2.0;
+            iterations = static_cast<uint64_t>(static_cast<double>(iterations) * scale) + 1;
+        }
+
+        std::vector<double> samples;
+        for(int r = 0; r < repetitions_; ++r){
+            samples.push_back(time(fn, iterations) * 1e9 / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.ns_per_op = samples.front();
+        result.ns_per_op_median = samples[samples.size() / 2];
+        result.items_per_op = items_per_op;
+        result.bytes_per_op = bytes_per_op;
+        print(result);
+        results_.push_back(std::move(result));
+    }
+
+    // 写 JSON，返回 main 的退出码
+    int finish() const {
+        if(json_path_.empty()) return 0;
+        FILE* out = json_path_ == "-" ? stdout : std::fopen(json_path_.c_str(), "w");
+        if(out == nullptr){
+            std::fprintf(stderr, "无法写入 %s\n", json_path_.c_str());
+            return 1;
+        }
+        write_json(out);
+        if(out != stdout) std::fclose(out);
+        return 0;
+    }
+
+private:
+    std::string suite_;
+    std::string json_path_;
+    std::string filter_;
+    double min_time_ = 0.2;
+    int repetitions_ = 5;
+    FILE* table_ = stdout;
+    std::vector<Result> results_;
+
+    template<typename Fn>
+    static double time(Fn& fn, uint64_t iterations){
+        auto start = std::chrono::steady_clock::now();
+        fn(iterations);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    static double gb_per_second(const Result& result){
+        return result.bytes_per_op > 0 ? result.bytes_per_op / result.ns_per_op : 0; // 字节/纳秒 = GB/s
+    }
+
+    void print(const Result& result) const {
+        std::fprintf(table_, "%-44s %12llu %12.2f %12.2f", result.name.c_str(),
+                     static_cast<unsigned long long>(result.iterations), result.ns_per_op, result.ns_per_op_median);
+        if(result.items_per_op > 0) std::fprintf(table_, " %12.3f", result.ns_per_op / result.items_per_op);
+        else std::fprintf(table_, " %12s", "-");
+        if(result.bytes_per_op > 0) std::fprintf(table_, " %10.3f\n", gb_per_second(result));
+        else std::fprintf(table_, " %10s\n", "-");
+        std::fflush(table_);
+    }
+
+    // 编译选项里最后一个 -O<n> 是否开启了优化（没有 -O 等同于 -O0）
+    static bool optimized(const char* flags){
+        bool result = false;
+        for(const char* p = std::strstr(flags, "-O"); p != nullptr; p = std::strstr(p + 2, "-O")){
+            result = p[2] != '0';
+        }
+        return result;
+    }
+
+    static void write_string(FILE* out, const std::string& value){
+        std::fputc('"', out);
+        for(char c : value){
+            if(c == '"' || c == '\\') std::fputc('\\', out);
+            if(static_cast<unsigned char>(c) < 0x20) continue;
+            std::fputc(c, out);
+        }
+        std::fputc('"', out);
+    }
+
+    void write_json(FILE* out) const {
+        char host[256] = {0};
+        if(gethostname(host, sizeof(host) - 1) != 0) host[0] = '\0';
+        char date[32] = {0};
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        std::fprintf(out, "{\n  \"context\": {\n    \"suite\": ");
+        write_string(out, suite_);
+        std::fprintf(out, ",\n    \"date\": \"%s\",\n    \"host\": ", date);
+        write_string(out, host);
+        std::fprintf(out, ",\n    \"num_cpus\": %u,\n    \"compiler\": ", std::thread::hardware_concurrency());
+#if defined(__VERSION__)
+        write_string(out, __VERSION__);
+#else
+        write_string(out, "unknown");
+#endif
+        // 记录的是库的构建参数（CMake 通过 tinydds 目标传下来），不是基准程序本身的
+#if defined(TINYDDS_BUILD_TYPE) && defined(TINYDDS_CXX_FLAGS)
+        const char* build_type = TINYDDS_BUILD_TYPE;
+        const char* flags = TINYDDS_CXX_FLAGS;
+#else
+        const char* build_type = "unknown";
+        const char* flags = "";
+#endif
+        std::fprintf(out, ",\n    \"library_build_type\": ");
+        write_string(out, build_type[0] != '\0' ? build_type : "none");
+        std::fprintf(out, ",\n    \"library_cxx_flags\": ");
+        write_string(out, flags);
+        std::fprintf(out, ",\n    \"optimized\": %s", optimized(flags) ? "true" : "false");
+        std::fprintf(out, ",\n    \"min_time\": %g,\n    \"repetitions\": %d\n  },\n  \"benchmarks\": [", min_time_,
+                     repetitions_);
+        for(size_t i = 0; i < results_.size(); ++i){
+            const Result& result = results_[i];
+            std::fprintf(out, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+            write_string(out, result.name);
+            std::fprintf(out, ", \"iterations\": %llu, \"ns_per_op\": %.4f, \"ns_per_op_median\": %.4f",
+                         static_cast<unsigned long long>(result.iterations), result.ns_per_op, result.ns_per_op_median);
+            if(result.items_per_op > 0){
+                std::fprintf(out, ", \"items_per_op\": %g, \"ns_per_item\": %.4f", result.items_per_op,
+                             result.ns_per_op / result.items_per_op);
+            }
+            if(result.bytes_per_op > 0){
+                std::fprintf(out, ", \"bytes_per_op\": %g, \"gb_per_s\": %.4f", result.bytes_per_op,
+                             gb_per_second(result));
+            }
+            std::fprintf(out, "}");
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+    }
+};
+
+} // namespace bench
+} // namespace tinydds
@@ -0,0 +1,770 @@
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "tinydds/rtps/data_fragmenter.hpp"
+#include "tinydds/rtps/fragment_assembler.hpp"
+#include "tinydds/rtps/latency_histogram.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "tinydds/transport/shm_transport.hpp"
+#include "tinydds/transport/udp_transport.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace tinydds::rtps;
+using namespace tinydds::transport;
+
+// ============================================================
+// perftest: 端到端的延迟/吞吐测试（本机回环 UDP 或共享内存，不需要任何外部服务）
+//
+// 数据走库自己的发布/订阅路径：样本用类型支持序列化成 CDR，小样本用 MessageBuilder
+// 编成 DATA，大样本用 DataFragmenter 切成 DATA_FRAG 聚合发送；接收端解析 RTPS 消息，
+// FragmentAssembler 重组（丢失的分片用 NACK_FRAG 请求重传），再反序列化。
+//
+//   pingpong: ping 发出样本，pong 原样回送，ping 记录往返时间 / 2 作为单向延迟
+//   firehose: pub 尽快（或按 --rate）发送，sub 统计吞吐、丢失和单向延迟
+//             （两端用同一个单调时钟，同机的两个进程也可以直接相减）
+//
+// 默认在一个进程里用两个线程运行两端；--fork 让对端在子进程里运行；
+// --role 只运行一端，可以在两个终端里分别启动。
+// 每个负载大小运行 --duration 秒，结果打印成表格，--json 另外写一份 JSON
+// ============================================================
+
+struct PerfSample{
+    uint32_t run;      // 第几个负载大小
+    uint32_t kind;     // SampleKind
+    uint64_t seq;      // DATA: 序号；END: 这一轮发出的样本数
+    int64_t timestamp; // 发送时间（steady_clock，纳秒）
+    std::vector<uint8_t> payload;
+};
+
+TINYDDS_CDR_TYPE(PerfSample, run, kind, seq, timestamp, payload);
+
+namespace {
+
+enum SampleKind : uint32_t {
+    SAMPLE_DATA = 0,
+    SAMPLE_HELLO = 1, // 握手：发起方重复发送，对端回一个 HELLO
+    SAMPLE_END = 2,   // firehose 一轮结束
+    SAMPLE_QUIT = 3   // 全部结束，对端退出
+};
+
+enum class Mode { PINGPONG, FIREHOSE };
+enum class Role { BOTH, PING, PONG, PUB, SUB };
+
+struct Options{
+    Mode mode = Mode::PINGPONG;
+    bool shm = false;
+    Role role = Role::BOTH;
+    bool fork_peer = false;
+    std::vector<size_t> sizes = {16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 8388608};
+    double duration = 1.0;         // 每个负载大小的测量时间（秒）
+    uint64_t max_samples = 0;      // 每个负载大小最多测多少个样本，0 表示只按时间
+    uint32_t warmup = 20;          // 每个负载大小先不计入统计的样本数
+    uint32_t port = 7650;          // 测量端（ping/sub）的端口，对端是 port + 1
+    double rate = 0;               // firehose 的发送速率（样本/秒），0 表示不限
+    size_t fragment_size = 16384;  // DATA_FRAG 的分片大小
+    int64_t spin = -1;             // 共享内存接收时的自旋次数，-1 表示自动（单核不自旋，否则用传输的默认值）
+    std::string json_path;
+};
+
+int64_t now_ns(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string size_label(size_t size){
+    char text[32];
+    if(size >= 1024 * 1024 && size % (1024 * 1024) == 0) std::snprintf(text, sizeof(text), "%zuM", size >> 20);
+    else if(size >= 1024 && size % 1024 == 0) std::snprintf(text, sizeof(text), "%zuK", size >> 10);
+    else std::snprintf(text, sizeof(text), "%zu", size);
+    return text;
+}
+
+// ============================================================
+// Link: 到对端的一条本机链路（UDP 回环或共享内存）
+// ============================================================
+class Link{
+public:
+    Link(const Options& options, uint32_t local_port, uint32_t peer_port) : shm_mode_(options.shm){
+        if(shm_mode_){
+            ShmTransportConfig config;
+            config.port = local_port;
+            config.segment_prefix = "tinydds_perf";
+            // 单核时自旋只会占住对端需要的 CPU
+            if(options.spin >= 0) config.spin_before_wait = static_cast<uint32_t>(options.spin);
+            else if(std::thread::hardware_concurrency() <= 1) config.spin_before_wait = 0;
+            shm_.reset(new ShmTransport(config));
+            peer_ = make_shm_locator(peer_port);
+            max_message_size_ = config.slot_size;
+        }
+        else{
+            UdpTransportConfig config;
+            config.bind_address = "127.0.0.1";
+            config.port = local_port;
+            config.receive_batch = 64;
+            config.socket_receive_buffer = 8 * 1024 * 1024;
+            config.socket_send_buffer = 8 * 1024 * 1024;
+            udp_.reset(new UdpTransport(config));
+            peer_ = Locator("127.0.0.1", peer_port);
+            max_message_size_ = 65000;
+        }
+    }
+
+    bool open(){ return shm_mode_ ? shm_->open() : udp_->open(); }
+
+    size_t max_message_size() const { return max_message_size_; }
+
+    bool send(ConstByteSpan message){
+        if(!shm_mode_) return udp_->send(message, peer_);
+        ShmLoan loan = loan_slot();
+        if(!loan.valid() || message.size() > loan.buffer().size()) return false;
+        std::memcpy(loan.buffer().data(), message.data(), message.size());
+        return shm_->commit(loan, message.size());
+    }
+
+    // DATA_FRAG 消息：UDP 用 iovec 聚合发送；共享内存把各段直接拼进对端的槽位
+    bool send(Span<const FragmentMessage> messages){
+        if(!shm_mode_){
+            gather_.clear();
+            for(const FragmentMessage& message : messages){
+                gather_.push_back(UdpGatherDatagram{message.parts.data(), message.part_count, peer_});
+            }
+            return udp_->send_batch(gather_) == gather_.size();
+        }
+        for(const FragmentMessage& message : messages){
+            ShmLoan loan = loan_slot();
+            if(!loan.valid() || message.size() > loan.buffer().size()) return false;
+            uint8_t* out = loan.buffer().data();
+            for(size_t i = 0; i < message.part_count; ++i){
+                std::memcpy(out, message.parts[i].data(), message.parts[i].size());
+                out += message.parts[i].size();
+            }
+            if(!shm_->commit(loan, message.size())) return false;
+        }
+        return true;
+    }
+
+    // 等待最多 timeout_ms，对收到的每个数据报调用 fn(ConstByteSpan)
+    template<typename Fn>
+    size_t receive(int timeout_ms, Fn&& fn){
+        if(shm_mode_){
+            size_t n = shm_->receive(timeout_ms);
+            for(size_t i = 0; i < n; ++i) fn(shm_->received(i));
+            return n;
+        }
+        size_t n = udp_->receive(timeout_ms);
+        for(size_t i = 0; i < n; ++i) fn(udp_->received(i).data);
+        return n;
+    }
+
+private:
+    bool shm_mode_;
+    std::unique_ptr<UdpTransport> udp_;
+    std::unique_ptr<ShmTransport> shm_;
+    Locator peer_;
+    size_t max_message_size_ = 0;
+    std::vector<UdpGatherDatagram> gather_;
+
+    // 对端的槽位用完时等它处理（共享内存的反压），对端不存在或一直不处理时放弃
+    ShmLoan loan_slot(){
+        int64_t deadline = now_ns() + 1000000000LL;
+        for(uint32_t attempt = 0;; ++attempt){
+            ShmLoan loan = shm_->loan(peer_);
+            if(loan.valid() || now_ns() > deadline) return loan;
+            if(attempt > 64) std::this_thread::yield();
+        }
+    }
+};
+
+// ============================================================
+// Endpoint: 一个写端 + 一个读端，收发 PerfSample
+// ============================================================
+class Endpoint{
+public:
+    Endpoint(Link& link, uint8_t participant, const Options& options)
+        : link_(link),
+          builder_(make_prefix(participant), [this](ConstByteSpan message){ sent_ok_ &= link_.send(message); },
+                   link.max_message_size()),
+          serializer_(64 * 1024),
+          fragmenter_(make_prefix(participant), options.fragment_size, link.max_message_size()),
+          assembler_(4),
+          writer_id_(0, 0, 1, EntityKind::USER_WRITER_NO_KEY),
+          reader_id_(0, 0, 1, EntityKind::USER_READER_NO_KEY) {}
+
+    // 发送一个样本；flush 为 false 时小样本留在 MessageBuilder 里和之后的样本合并成一个数据报
+    bool write(const PerfSample& sample, bool flush = true){
+        ++last_sn_;
+        serializer_.reset();
+        serializer_.serialize_encapsulation();
+        serializer_.serialize_type(sample);
+        sent_ok_ = true;
+        if(builder_.add_data(reader_id_, writer_id_, last_sn_, serializer_.buffer())){
+            if(flush) builder_.flush();
+            return sent_ok_;
+        }
+        // 放不进一个数据报：切成 DATA_FRAG，序列化后的缓冲区留着，NACK_FRAG 时只重传缺失的分片
+        builder_.flush();
+        sent_ok_ &= link_.send(fragmenter_.fragment(reader_id_, writer_id_, last_sn_, serializer_.buffer()));
+        send_heartbeat_frag();
+        return sent_ok_;
+    }
+
+    void flush(){ builder_.flush(); }
+
+    // 接收：对每个完整的样本调用 fn(const PerfSample&)，返回这次收到的数据报数
+    template<typename Fn>
+    size_t poll(int timeout_ms, Fn&& fn){
+        return link_.receive(timeout_ms, [&](ConstByteSpan datagram){ on_datagram(datagram, fn); });
+    }
+
+    // 对还没重组完的样本发 NACK_FRAG（一段时间没有进展时调用）
+    void request_repairs(){
+        assembler_.for_each_incomplete([&](const SequenceNumber& sn){
+            FragmentNumberSet missing;
+            if(assembler_.build_nack_frag(sn, missing)){
+                builder_.add_nack_frag(reader_id_, writer_id_, sn, missing, ++nack_count_);
+                ++nacks_sent_;
+            }
+        });
+        builder_.flush();
+    }
+
+    uint64_t nacks_sent() const { return nacks_sent_; }
+    uint64_t repairs_sent() const { return repairs_sent_; }
+
+private:
+    Link& link_;
+    MessageBuilder builder_;
+    CdrSerializer serializer_;
+    DataFragmenter fragmenter_;
+    FragmentAssembler assembler_;
+    EntityId writer_id_;
+    EntityId reader_id_;
+    SequenceNumber last_sn_;
+    PerfSample received_{};
+    bool sent_ok_ = true;
+    uint32_t nack_count_ = 0;
+    uint32_t heartbeat_count_ = 0;
+    uint64_t nacks_sent_ = 0;
+    uint64_t repairs_sent_ = 0;
+
+    static GuidPrefix make_prefix(uint8_t participant){
+        GuidPrefix prefix;
+        prefix.value[0] = 0x7f;
+        prefix.value[11] = participant;
+        return prefix;
+    }
+
+    void send_heartbeat_frag(){
+        uint32_t last = fragmenter_.fragment_count(serializer_.size());
+        builder_.add_heartbeat_frag(reader_id_, writer_id_, last_sn_, last, ++heartbeat_count_);
+        builder_.flush();
+    }
+
+    template<typename Fn>
+    void deliver(ConstByteSpan serialized, Fn& fn){
+        bool ok = decode_cdr_payload(serialized, [&](auto& deserializer){
+            return deserializer.deserialize_type(received_);
+        });
+        if(ok) fn(received_);
+    }
+
+    template<typename Fn>
+    void on_datagram(ConstByteSpan datagram, Fn& fn){
+        MessageParser parser(datagram);
+        if(!parser.valid()) return;
+        SubmessageView sub;
+        while(parser.next(sub)){
+            switch(sub.id){
+            case SubmessageId::DATA: {
+                DataSubmessage data;
+                if(parse_data(sub, data)) deliver(data.serialized_payload, fn);
+                break;
+            }
+            case SubmessageId::DATA_FRAG: {
+                DataFragSubmessage frag;
+                if(!parse_data_frag(sub, frag)) break;
+                if(assembler_.on_data_frag(frag) == FragmentAssembler::FragmentResult::COMPLETE){
+                    assembler_.take(frag.writer_sn, [&](ConstByteSpan payload){ deliver(payload, fn); });
+                    assembler_.drop_before(frag.writer_sn);
+                }
+                break;
+            }
+            case SubmessageId::HEARTBEAT_FRAG: {
+                HeartbeatFragSubmessage heartbeat;
+                if(parse_heartbeat_frag(sub, heartbeat)){
+                    assembler_.on_heartbeat_frag(heartbeat.writer_sn, heartbeat.last_fragment_num);
+                }
+                break;
+            }
+            case SubmessageId::NACK_FRAG: {
+                // 只保留了最近一个样本的序列化结果，更早的样本不再重传
+                NackFragSubmessage nack;
+                if(parse_nack_frag(sub, nack) && nack.writer_sn == last_sn_){
+                    link_.send(fragmenter_.fragment_missing(reader_id_, writer_id_, last_sn_, serializer_.buffer(),
+                                                            nack.fragment_number_state));
+                    send_heartbeat_frag();
+                    ++repairs_sent_;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+};
+
+// ============================================================
+// 结果
+// ============================================================
+struct RunResult{
+    size_t payload_size = 0;
+    uint64_t samples = 0;   // 计入统计的样本数
+    uint64_t lost = 0;      // pingpong: 超时重发的次数；firehose: 发出但没有收到的样本数
+    double seconds = 0;
+    LatencyHistogram latency;
+
+    double msgs_per_second() const { return seconds > 0 ? static_cast<double>(samples) / seconds : 0; }
+    double mb_per_second() const { return msgs_per_second() * static_cast<double>(payload_size) / 1e6; }
+};
+
+// JSON 写到标准输出时表格改写到标准错误
+FILE* table_stream(const Options& options){
+    return options.json_path == "-" ? stderr : stdout;
+}
+
+void print_header(const Options& options){
+    FILE* out = table_stream(options);
+    std::fprintf(out, "# %s over %s, %s\n", options.mode == Mode::PINGPONG ? "pingpong" : "firehose",
+                 options.shm ? "shared memory" : "UDP loopback",
+                 options.mode == Mode::PINGPONG ? "latency = round trip / 2" : "latency = one way");
+    std::fprintf(out, "%8s %10s %8s %10s %10s %10s %10s %10s %12s %10s\n", "size", "samples", "lost", "p50(us)",
+                 "p99(us)", "p99.9(us)", "max(us)", "mean(us)", "msgs/s", "MB/s");
+    std::fflush(out);
+}
+
+void print_result(const Options& options, const RunResult& r){
+    FILE* out = table_stream(options);
+    auto us = [](uint64_t ns){ return static_cast<double>(ns) / 1000.0; };
+    std::fprintf(out, "%8s %10llu %8llu %10.2f %10.2f %10.2f %10.2f %10.2f %12.0f %10.2f\n",
+                 size_label(r.payload_size).c_str(), static_cast<unsigned long long>(r.samples),
+                 static_cast<unsigned long long>(r.lost), us(r.latency.value_at_percentile(50)),
+                 us(r.latency.value_at_percentile(99)), us(r.latency.value_at_percentile(99.9)), us(r.latency.max()),
+                 r.latency.mean() / 1000.0, r.msgs_per_second(), r.mb_per_second());
+    std::fflush(out);
+}
+
+bool write_json(const Options& options, const std::vector<RunResult>& results){
+    if(options.json_path.empty()) return true;
+    FILE* out = options.json_path == "-" ? stdout : std::fopen(options.json_path.c_str(), "w");
+    if(out == nullptr){
+        std::fprintf(stderr, "无法写入 %s\n", options.json_path.c_str());
+        return false;
+    }
+    std::fprintf(out, "{\n  \"context\": {\"mode\": \"%s\", \"transport\": \"%s\", \"processes\": %d, "
+                      "\"duration\": %g, \"fragment_size\": %zu},\n  \"results\": [",
+                 options.mode == Mode::PINGPONG ? "pingpong" : "firehose", options.shm ? "shm" : "udp",
+                 options.fork_peer || options.role != Role::BOTH ? 2 : 1, options.duration, options.fragment_size);
+    for(size_t i = 0; i < results.size(); ++i){
+        const RunResult& r = results[i];
+        std::fprintf(out,
+                     "%s\n    {\"payload_size\": %zu, \"samples\": %llu, \"lost\": %llu, \"p50_ns\": %llu, "
+                     "\"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu, \"mean_ns\": %.1f, "
+                     "\"msgs_per_s\": %.1f, \"mb_per_s\": %.3f}",
+                     i == 0 ? "" : ",", r.payload_size, static_cast<unsigned long long>(r.samples),
+                     static_cast<unsigned long long>(r.lost),
+                     static_cast<unsigned long long>(r.latency.value_at_percentile(50)),
+                     static_cast<unsigned long long>(r.latency.value_at_percentile(99)),
+                     static_cast<unsigned long long>(r.latency.value_at_percentile(99.9)),
+                     static_cast<unsigned long long>(r.latency.max()), r.latency.mean(), r.msgs_per_second(),
+                     r.mb_per_second());
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if(out != stdout) std::fclose(out);
+    return true;
+}
+
+// 多发几次控制样本（UDP 可能丢包）
+void send_control(Endpoint& endpoint, uint32_t kind, uint32_t run = 0, uint64_t seq = 0){
+    PerfSample control{run, kind, seq, now_ns(), {}};
+    for(int i = 0; i < 3; ++i){
+        endpoint.write(control);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// 发起方：重复发送 HELLO 直到对端回应（对端可能还没启动）
+bool handshake(Endpoint& endpoint){
+    int64_t deadline = now_ns() + 10 * 1000000000LL;
+    PerfSample hello{0, SAMPLE_HELLO, 0, 0, {}};
+    while(now_ns() < deadline){
+        endpoint.write(hello);
+        bool answered = false;
+        endpoint.poll(100, [&](const PerfSample& sample){ answered |= sample.kind == SAMPLE_HELLO; });
+        if(answered) return true;
+    }
+    std::fprintf(stderr, "对端没有响应\n");
+    return false;
+}
+
+// 对端退出的条件：收到 QUIT，或者开始之后长时间没有任何数据
+constexpr int64_t kPeerIdleTimeoutNs = 10 * 1000000000LL;
+constexpr int kRepairIntervalMs = 5;        // 多久没有进展就发 NACK_FRAG
+constexpr int64_t kResendTimeoutNs = 1000000000LL; // ping 多久没收到回应就换一个序号重发
+
+// ============================================================
+// pingpong
+// ============================================================
+bool run_ping(const Options& options, Link& link){
+    Endpoint endpoint(link, 1, options);
+    if(!handshake(endpoint)) return false;
+    print_header(options);
+
+    std::vector<RunResult> results;
+    PerfSample sample{};
+    uint64_t seq = 0;
+    for(size_t run = 0; run < options.sizes.size(); ++run){
+        RunResult result;
+        result.payload_size = options.sizes[run];
+        sample.run = static_cast<uint32_t>(run);
+        sample.kind = SAMPLE_DATA;
+        sample.payload.assign(options.sizes[run], static_cast<uint8_t>(run));
+
+        int64_t start = 0;
+        for(uint64_t round = 0;; ++round){
+            if(round == options.warmup) start = now_ns();
+            if(round > options.warmup){
+                uint64_t measured = round - options.warmup;
+                if(options.max_samples != 0 && measured >= options.max_samples) break;
+                if(static_cast<double>(now_ns() - start) >= options.duration * 1e9) break;
+            }
+
+            sample.seq = ++seq;
+            sample.timestamp = now_ns();
+            endpoint.write(sample);
+            int64_t sent_at = sample.timestamp;
+            bool answered = false;
+            while(!answered){
+                size_t n = endpoint.poll(kRepairIntervalMs, [&](const PerfSample& echo){
+                    if(echo.kind != SAMPLE_DATA || echo.seq != seq) return;
+                    answered = true;
+                    if(round >= options.warmup){
+                        result.latency.record(static_cast<uint64_t>(now_ns() - echo.timestamp) / 2);
+                        ++result.samples;
+                    }
+                });
+                if(answered) break;
+                if(n == 0) endpoint.request_repairs();
+                if(now_ns() - sent_at > kResendTimeoutNs){
+                    // 样本或者回应整个丢了：换一个序号重发，这一次不计入统计
+                    ++result.lost;
+                    sample.seq = ++seq;
+                    sample.timestamp = now_ns();
+                    sent_at = sample.timestamp;
+                    endpoint.write(sample);
+                }
+            }
+        }
+        result.seconds = static_cast<double>(now_ns() - start) / 1e9;
+        print_result(options, result);
+        results.push_back(std::move(result));
+    }
+    send_control(endpoint, SAMPLE_QUIT);
+    return write_json(options, results);
+}
+
+bool run_pong(const Options& options, Link& link){
+    Endpoint endpoint(link, 2, options);
+    bool quit = false;
+    int64_t last_activity = now_ns();
+    while(!quit){
+        size_t n = endpoint.poll(kRepairIntervalMs, [&](const PerfSample& sample){
+            if(sample.kind == SAMPLE_QUIT) quit = true;
+            else endpoint.write(sample); // DATA 原样回送，HELLO 回一个 HELLO
+        });
+        if(n != 0){
+            last_activity = now_ns();
+            continue;
+        }
+        endpoint.request_repairs();
+        if(now_ns() - last_activity > kPeerIdleTimeoutNs) break;
+    }
+    return true;
+}
+
+// ============================================================
+// firehose
+// ============================================================
+bool run_pub(const Options& options, Link& link){
+    Endpoint endpoint(link, 2, options);
+    if(!handshake(endpoint)) return false;
+
+    PerfSample sample{};
+    int64_t interval = options.rate > 0 ? static_cast<int64_t>(1e9 / options.rate) : 0;
+    for(size_t run = 0; run < options.sizes.size(); ++run){
+        sample.run = static_cast<uint32_t>(run);
+        sample.kind = SAMPLE_DATA;
+        sample.payload.assign(options.sizes[run], static_cast<uint8_t>(run));
+
+        uint64_t sent = 0;
+        int64_t start = now_ns();
+        int64_t next = start;
+        for(;;){
+            int64_t now = now_ns();
+            if(static_cast<double>(now - start) >= options.duration * 1e9) break;
+            if(options.max_samples != 0 && sent >= options.max_samples + options.warmup) break;
+            if(interval != 0){
+                if(now < next){
+                    std::this_thread::yield();
+                    continue;
+                }
+                next += interval;
+            }
+            sample.seq = sent;
+            sample.timestamp = now;
+            // 小样本在 MessageBuilder 里合并，满一个数据报才发送
+            if(endpoint.write(sample, false)) ++sent;
+            // 单核上也要让接收端有机会运行
+            if((sent & 63) == 0) std::this_thread::yield();
+        }
+        endpoint.flush();
+        send_control(endpoint, SAMPLE_END, static_cast<uint32_t>(run), sent);
+        // 等接收端处理完这一轮再开始下一轮
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    send_control(endpoint, SAMPLE_QUIT);
+    return true;
+}
+
+bool run_sub(const Options& options, Link& link){
+    Endpoint endpoint(link, 1, options);
+    print_header(options);
+
+    std::vector<RunResult> results;
+    RunResult current;
+    int64_t current_run = -1; // 正在统计的轮次
+    int64_t reported = -1;    // 最后一个已经输出的轮次
+    uint64_t received = 0;    // 这一轮收到的样本数（包括预热）
+    int64_t first = 0;
+    int64_t last = 0;
+    bool quit = false;
+    int64_t last_activity = now_ns();
+
+    auto report = [&](uint32_t run, uint64_t sent){
+        if(static_cast<int64_t>(run) <= reported) return; // END 会发多次
+        if(current_run != static_cast<int64_t>(run)){
+            current = RunResult(); // 这一轮一个样本也没收到
+            received = 0;
+            first = last = 0;
+        }
+        current.payload_size = run < options.sizes.size() ? options.sizes[run] : 0;
+        current.lost = sent > received ? sent - received : 0;
+        current.seconds = static_cast<double>(last - first) / 1e9;
+        print_result(options, current);
+        results.push_back(std::move(current));
+        current = RunResult();
+        current_run = -1;
+        reported = run;
+    };
+
+    while(!quit){
+        size_t n = endpoint.poll(kRepairIntervalMs, [&](const PerfSample& sample){
+            int64_t now = now_ns();
+            switch(sample.kind){
+            case SAMPLE_HELLO:
+                endpoint.write(sample);
+                break;
+            case SAMPLE_DATA:
+                if(static_cast<int64_t>(sample.run) <= reported) break;
+                if(current_run != static_cast<int64_t>(sample.run)){
+                    current = RunResult();
+                    current_run = sample.run;
+                    received = 0;
+                }
+                ++received;
+                if(received <= options.warmup) break;
+                if(current.samples == 0) first = now;
+                last = now;
+                current.latency.record(static_cast<uint64_t>(now - sample.timestamp));
+                ++current.samples;
+                break;
+            case SAMPLE_END:
+                report(sample.run, sample.seq);
+                break;
+            case SAMPLE_QUIT:
+                quit = true;
+                break;
+            default:
+                break;
+            }
+        });
+        // firehose 是尽力而为的：写端不处理 NACK_FRAG，丢失的样本直接计入 lost
+        if(n != 0) last_activity = now_ns();
+        else if(now_ns() - last_activity > kPeerIdleTimeoutNs) break;
+    }
+    return write_json(options, results);
+}
+
+// ============================================================
+// 命令行
+// ============================================================
+void usage(const char* program){
+    std::fprintf(stderr,
+                 "用法: %s [选项]\n"
+                 "  --mode pingpong|firehose   测试模式（默认 pingpong）\n"
+                 "  --transport udp|shm        本机回环 UDP 或共享内存（默认 udp）\n"
+                 "  --role ping|pong|pub|sub   只运行一端（默认在一个进程里运行两端）\n"
+                 "  --fork                     对端在子进程里运行\n"
+                 "  --sizes 16,1K,64K,8M       负载大小（默认 16B 到 8MB）\n"
+                 "  --duration <秒>            每个负载大小的测量时间（默认 1）\n"
+                 "  --samples <n>              每个负载大小最多测多少个样本\n"
+                 "  --warmup <n>               每个负载大小先丢掉的样本数（默认 20）\n"
+                 "  --rate <样本/秒>           firehose 的发送速率（默认不限）\n"
+                 "  --fragment-size <字节>     DATA_FRAG 分片大小（默认 16384）\n"
+                 "  --spin <n>                 共享内存接收时先自旋多少次再休眠\n"
+                 "  --port <端口>              测量端的端口，对端用 port+1（默认 7650）\n"
+                 "  --json <file>              JSON 输出（- 表示标准输出）\n",
+                 program);
+}
+
+bool parse_size(const std::string& text, size_t& out){
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if(end == text.c_str()) return false;
+    std::string suffix(end);
+    if(suffix == "K" || suffix == "k") value <<= 10;
+    else if(suffix == "M" || suffix == "m") value <<= 20;
+    else if(!suffix.empty()) return false;
+    out = static_cast<size_t>(value);
+    return true;
+}
+
+bool parse_options(int argc, char** argv, Options& options){
+    for(int i = 1; i < argc; ++i){
+        std::string arg = argv[i];
+        if(arg == "--fork"){
+            options.fork_peer = true;
+            continue;
+        }
+        if(i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if(arg == "--mode"){
+            if(value == "pingpong") options.mode = Mode::PINGPONG;
+            else if(value == "firehose") options.mode = Mode::FIREHOSE;
+            else return false;
+        }
+        else if(arg == "--transport"){
+            if(value == "udp") options.shm = false;
+            else if(value == "shm") options.shm = true;
+            else return false;
+        }
+        else if(arg == "--role"){
+            if(value == "ping") options.role = Role::PING;
+            else if(value == "pong") options.role = Role::PONG;
+            else if(value == "pub") options.role = Role::PUB;
+            else if(value == "sub") options.role = Role::SUB;
+            else return false;
+        }
+        else if(arg == "--sizes"){
+            options.sizes.clear();
+            size_t begin = 0;
+            while(begin <= value.size()){
+                size_t end = value.find(',', begin);
+                if(end == std::string::npos) end = value.size();
+                size_t size;
+                if(!parse_size(value.substr(begin, end - begin), size)) return false;
+                options.sizes.push_back(size);
+                begin = end + 1;
+            }
+        }
+        else if(arg == "--duration") options.duration = std::atof(value.c_str());
+        else if(arg == "--samples") options.max_samples = std::strtoull(value.c_str(), nullptr, 10);
+        else if(arg == "--warmup") options.warmup = static_cast<uint32_t>(std::atoi(value.c_str()));
+        else if(arg == "--rate") options.rate = std::atof(value.c_str());
+        else if(arg == "--spin") options.spin = std::atoll(value.c_str());
+        else if(arg == "--port") options.port = static_cast<uint32_t>(std::atoi(value.c_str()));
+        else if(arg == "--json") options.json_path = value;
+        else if(arg == "--fragment-size"){
+            if(!parse_size(value, options.fragment_size)) return false;
+        }
+        else return false;
+    }
+    if(options.mode == Mode::PINGPONG && (options.role == Role::PUB || options.role == Role::SUB)) return false;
+    if(options.mode == Mode::FIREHOSE && (options.role == Role::PING || options.role == Role::PONG)) return false;
+    return !options.sizes.empty() && options.duration > 0;
+}
+
+// 运行一端：measuring 为 true 时是 ping/sub（端口 port），否则是 pong/pub（端口 port + 1）
+bool run_role(const Options& options, Link& link, bool measuring){
+    if(options.mode == Mode::PINGPONG) return measuring ? run_ping(options, link) : run_pong(options, link);
+    return measuring ? run_sub(options, link) : run_pub(options, link);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    Options options;
+    if(!parse_options(argc, argv, options)){
+        usage(argv[0]);
+        return 2;
+    }
+    bool measuring_role = options.role == Role::PING || options.role == Role::SUB;
+    bool peer_role = options.role == Role::PONG || options.role == Role::PUB;
+
+    if(measuring_role || peer_role){
+        Link link(options, measuring_role ? options.port : options.port + 1,
+                  measuring_role ? options.port + 1 : options.port);
+        if(!link.open()){
+            std::fprintf(stderr, "无法打开传输\n");
+            return 1;
+        }
+        return run_role(options, link, measuring_role) ? 0 : 1;
+    }
+
+    if(options.fork_peer){
+        // 在创建任何线程和传输之前 fork
+        pid_t child = ::fork();
+        if(child < 0){
+            std::perror("fork");
+            return 1;
+        }
+        if(child == 0){
+            bool ok;
+            {
+                // 链路要在 _exit 之前析构，共享内存段才会被删除
+                Link link(options, options.port + 1, options.port);
+                ok = link.open() && run_role(options, link, false);
+            }
+            std::fflush(stdout);
+            ::_exit(ok ? 0 : 1);
+        }
+        Link link(options, options.port, options.port + 1);
+        bool ok = link.open() && run_role(options, link, true);
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+    }
+
+    // 一个进程两个线程：两端的传输都先打开，对端线程不需要等待
+    Link measuring_link(options, options.port, options.port + 1);
+    Link peer_link(options, options.port + 1, options.port);
+    if(!measuring_link.open() || !peer_link.open()){
+        std::fprintf(stderr, "无法打开传输\n");
+        return 1;
+    }
+    bool peer_ok = true;
+    std::thread peer([&]{ peer_ok = run_role(options, peer_link, false); });
+    bool ok = run_role(options, measuring_link, true);
+    peer.join();
+    return ok && peer_ok ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/cdr_type_info.hpp"
+#include "tinydds/rtps/flat_hash_map.hpp"
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// ContentFilter: ContentFilteredTopic 的过滤表达式（DDS SQL 的子集）
+//
+// 表达式编译一次，之后直接在序列化数据（带封装头的 CDR）上求值，不反序列化整个样本：
+//   - 按类型描述只读出表达式引用到的字段，中间的字段按 CDR 规则跳过，
+//     最后一个被引用的字段之后的内容完全不看
+//   - 被引用的字段之前都是定长字段时，偏移在编译时就算好了，求值时按偏移直接读
+//
+// 支持的语法：
+//   条件    := 条件 OR 条件 | 条件 AND 条件 | NOT 条件 | ( 条件 )
+//            | 操作数 比较符 操作数 | 字段 [NOT] BETWEEN 操作数 AND 操作数
+//   比较符  := = | <> | != | < | <= | > | >= | LIKE（% 匹配任意串，_ 匹配一个字符）
+//   操作数  := 字段路径（a.b.c，只能进入嵌套结构体）| 整数 | 浮点数 | 'string' | TRUE | FALSE | %n
+// %n 是第 n 个过滤参数：能解析为数字的按数字，'...' 按字符串，其余原样按字符串。
+// 关键字不区分大小写。枚举字段按整数比较
+// ============================================================
+
+// 表达式里的值
+struct FilterValue{
+    enum class Type : uint8_t{ NONE, INTEGER, REAL, STRING, BOOLEAN };
+
+    Type type = Type::NONE;
+    int64_t integer = 0;
+    double real = 0.0;
+    std::string_view string;
+
+    bool is_numeric() const { return type == Type::INTEGER || type == Type::REAL; }
+    double as_real() const { return type == Type::INTEGER ? static_cast<double>(integer) : real; }
+};
+
+class ContentFilter{
+public:
+    // 一个过滤表达式最多引用的字段数
+    static constexpr size_t MAX_FIELDS = 16;
+    // 括号和 NOT 最多嵌套的层数（语法分析是递归的，限制层数防止栈溢出）
+    static constexpr size_t MAX_NESTING_DEPTH = 64;
+
+    ContentFilter() = default;
+
+    // 编译表达式，失败时返回 false，error 里是原因
+    bool compile(const rtps::CdrTypeDesc& type, std::string_view expression,
+                 const std::vector<std::string>& parameters = {}, std::string* error = nullptr);
+
+    template<typename T>
+    bool compile(std::string_view expression, const std::vector<std::string>& parameters = {},
+                 std::string* error = nullptr){
+        return compile(rtps::cdr_type_desc_v<T>, expression, parameters, error);
+    }
+
+    bool valid() const { return root_ != INVALID; }
+    const std::string& expression() const { return expression_; }
+    const std::vector<std::string>& parameters() const { return parameters_; }
+
+    // 在带封装头的序列化数据上求值；数据不完整（读不到被引用的字段）时返回 false
+    bool evaluate(rtps::ConstByteSpan payload) const;
+
+    // 被引用的字段之前都是定长字段，求值时按固定偏移直接读
+    bool uses_fixed_offsets() const { return fixed_offsets_; }
+
+private:
+    static constexpr uint16_t INVALID = 0xFFFF;
+
+    enum class Op : uint8_t{
+        AND, OR, NOT,
+        EQ, NE, LT, LE, GT, GE, LIKE,
+        BETWEEN, NOT_BETWEEN,
+        FIELD,   // 操作数：value = 字段槽位
+        CONSTANT // 操作数：value = 常量下标
+    };
+
+    struct Node{
+        Op op;
+        uint16_t a = INVALID; // 子节点
+        uint16_t b = INVALID;
+        uint16_t c = INVALID;
+        uint16_t value = 0;
+    };
+
+    // 取字段的步骤：按 CDR 顺序，跳过不需要的字段，读出需要的字段放进槽位
+    struct Step{
+        const rtps::CdrTypeDesc* type;
+        uint16_t slot = INVALID;   // INVALID 表示只跳过
+        size_t fixed_offset = 0;   // fixed_offsets_ 为 true 时有效（相对封装头之后）
+    };
+
+    struct FieldRef{
+        std::string path;
+        const rtps::CdrTypeDesc* type;
+    };
+
+    std::string expression_;
+    std::vector<std::string> parameters_;
+    std::vector<Node> nodes_;
+    std::vector<std::string> strings_;   // 字符串常量
+    std::vector<FilterValue> constants_; // 字符串常量的 integer 是 strings_ 的下标
+    std::vector<FieldRef> fields_;
+    std::vector<Step> steps_;
+    bool fixed_offsets_ = false;
+    size_t fixed_end_ = 0;     // fixed_offsets_ 为 true 时，最后一个字段结束的偏移
+    uint16_t root_ = INVALID;
+
+    friend class FilterCompiler;
+
+    void build_steps(const rtps::CdrTypeDesc& type);
+    void plan_struct(const rtps::CdrTypeDesc& type, const std::string& prefix, size_t& remaining);
+    int16_t find_slot(const std::string& path) const;
+
+    template<typename Policy>
+    bool load_fields(rtps::ConstByteSpan payload, std::array<FilterValue, MAX_FIELDS>& slots) const;
+
+    bool eval(uint16_t node, const std::array<FilterValue, MAX_FIELDS>& slots) const;
+    FilterValue operand(uint16_t node, const std::array<FilterValue, MAX_FIELDS>& slots) const;
+};
+
+// ============================================================
+// ReaderFilterSet: 写端一侧的内容过滤
+//
+// 写端记录每个匹配的读端的过滤表达式（读端通过 SEDP 宣告，见 ContentFilterProperty），
+// 发送前对每个样本求值，没有读端需要的样本不发送、需要的只发给需要的读端。
+// 表达式和参数完全相同的读端共用一个编译好的过滤器，每个样本对它只求值一次
+// ============================================================
+class ReaderFilterSet{
+public:
+    explicit ReaderFilterSet(const rtps::CdrTypeDesc& type) : type_(type) {}
+
+    // 没有过滤条件的读端（接收所有样本）
+    void add_reader(const rtps::GUID& reader);
+
+    // 带过滤条件的读端；表达式编译失败时返回 false，读端不会被加入
+    bool add_reader(const rtps::GUID& reader, const std::string& expression,
+                    const std::vector<std::string>& parameters, std::string* error = nullptr);
+
+    bool remove_reader(const rtps::GUID& reader);
+
+    // 对一个样本，把需要它的读端追加到 out，返回追加的数量
+    size_t select(rtps::ConstByteSpan payload, std::vector<rtps::GUID>& out) const;
+
+    // 是否至少有一个读端需要这个样本（为 false 时整个样本都不用发送）
+    bool wanted(rtps::ConstByteSpan payload) const;
+
+    size_t reader_count() const { return readers_.size(); }
+    size_t filter_count() const { return filters_.size(); } // 不同的过滤器个数
+
+private:
+    static constexpr uint32_t NO_FILTER = 0xFFFFFFFF;
+
+    struct SharedFilter{
+        ContentFilter filter;
+        std::vector<rtps::GUID> readers;
+        std::string key;
+    };
+
+    const rtps::CdrTypeDesc& type_;
+    rtps::GuidMap<uint32_t> readers_;                     // 读端 -> 过滤器下标（NO_FILTER 表示不过滤）
+    std::vector<rtps::GUID> unfiltered_;
+    std::vector<SharedFilter> filters_;
+    std::unordered_map<std::string, uint32_t> filter_index_; // 表达式 + 参数 -> 过滤器下标
+
+    static std::string filter_key(const std::string& expression, const std::vector<std::string>& parameters);
+};
+
+} // namespace dds
+} // namespace tinydds
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+#include "tinydds/rtps/mpsc_queue.hpp"
+#include "tinydds/rtps/sample_slab.hpp"
+#include "tinydds/rtps/span.hpp"
+#include "tinydds/rtps/timestamp.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// DataReader: 类型 T 的读端样本队列
+//
+// on_data() 收到序列化数据（例如 ReceiveWindow::deliver() 按序交付的 payload）后，
+// 从主题的 SampleSlab 借一个样本直接解码进去（复用样本里 vector / string 的容量），
+// 放进固定容量的待取队列；take() 把样本连同所有权交给应用，用完析构即归还给 slab。
+// 稳定运行时整个接收路径不分配内存
+//
+// 待取队列是 MpscQueue：on_data() 可以由多个接收线程（UDP、共享内存）同时调用，
+// take() 只能由一个线程（应用）调用，两边都不加锁
+// ============================================================
+template<typename T>
+class DataReader{
+public:
+    // max_samples: 待取队列的容量（向上取整为 2 的幂），满了之后新样本被丢弃
+    explicit DataReader(rtps::SampleSlab<T>& slab, size_t max_samples = 64) : slab_(slab), queue_(max_samples) {}
+
+    DataReader(const DataReader&) = delete;
+    DataReader& operator=(const DataReader&) = delete;
+
+    // 解码一个带封装头的样本并放进队列
+    // source_timestamp 是写端的源时间戳（INFO_TS），有效时抽样记录端到端延迟
+    // 队列已满、slab 用完或者解码失败时丢弃样本，返回 false
+    // 这里是读端唯一记录收到的样本的地方（ReceiveWindow 不再计数），可靠和尽力而为的读端都一样
+    bool on_data(rtps::ConstByteSpan serialized_payload, const rtps::Timestamp& source_timestamp = rtps::Timestamp()){
+        // 已经满了就不必解码（只是提前判断，最终以 push 的结果为准）
+        bool ok = queue_.size() < queue_.capacity();
+        rtps::LoanedSample<T> sample;
+        if(ok){
+            sample = slab_.loan();
+            ok = sample && rtps::decode_cdr_payload(serialized_payload, [&](auto& deserializer){
+                return deserializer.deserialize_type(*sample);
+            });
+        }
+        if(!ok || !queue_.push(std::move(sample))){
+            if(statistics_ != nullptr) statistics_->on_sample_dropped();
+            return false; // sample 析构时归还给 slab
+        }
+        if(statistics_ != nullptr){
+            statistics_->on_sample_received(serialized_payload.size());
+            statistics_->set_queue_depth(queue_.size());
+            if(source_timestamp.valid() && statistics_->sample_timing()){
+                int64_t latency = rtps::Timestamp::now().to_nanoseconds() - source_timestamp.to_nanoseconds();
+                if(latency >= 0) statistics_->record_latency(static_cast<uint64_t>(latency)); // 两端时钟不同步时可能为负
+            }
+        }
+        return true;
+    }
+
+    // 取出最早的样本，没有样本时返回空（只能由一个线程调用）
+    rtps::LoanedSample<T> take(){
+        rtps::LoanedSample<T> sample;
+        if(queue_.take(sample) && statistics_ != nullptr) statistics_->set_queue_depth(queue_.size());
+        return sample;
+    }
+
+    // 队列里的样本数（其他线程同时投递时是近似值）
+    size_t available() const { return queue_.size(); }
+    size_t max_samples() const { return queue_.capacity(); }
+
+    // 收到的样本、丢弃的样本、队列深度和抽样的端到端延迟记到这里（nullptr 不统计）
+    void set_statistics(rtps::EntityStatistics* statistics){ statistics_ = statistics; }
+
+private:
+    rtps::SampleSlab<T>& slab_;
+    rtps::MpscQueue<rtps::LoanedSample<T>, false> queue_;
+    rtps::EntityStatistics* statistics_ = nullptr;
+};
+
+} // namespace dds
+} // namespace tinydds
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/sample_slab.hpp"
+#include "tinydds/rtps/writer_history.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// DataWriter: 类型 T 的写端（只负责样本的编码和发出，匹配和可靠性由上层处理）
+//
+// 两种写法：
+//   write(const T&)：按值写入，编码到内部复用的序列化器
+//   loan_sample() + write(LoanedSample&&)：样本从主题的 SampleSlab 借出，
+//     调用方直接填写，写出后所有权交回 slab。有界类型在槽位里就地编码，
+//     内存布局即 CDR 布局的类型（is_cdr_memcpy_layout）完全不编码，
+//     [封装头][样本] 这段内存直接交给 MessageBuilder（共享内存传输也是这一次复制）
+// 写出的样本都进历史缓存（槽位按有界类型的序列化大小预留），供重传使用
+//
+// 不是线程安全的，由调用方负责加锁
+// ============================================================
+template<typename T>
+class DataWriter{
+public:
+    DataWriter(rtps::MessageBuilder& builder, const rtps::EntityId& writer_id, const rtps::EntityId& reader_id,
+               rtps::SampleSlab<T>& slab, const rtps::HistoryQos& qos = rtps::HistoryQos())
+        : builder_(builder), writer_id_(writer_id), reader_id_(reader_id), slab_(slab),
+          history_(qos, bounded_payload_size()), serializer_(bounded_payload_size() > 0 ? bounded_payload_size() : 256) {}
+
+    DataWriter(const DataWriter&) = delete;
+    DataWriter& operator=(const DataWriter&) = delete;
+
+    // 借出一个样本，slab 用完时返回空
+    rtps::LoanedSample<T> loan_sample() { return slab_.loan(); }
+
+    // 写出借出的样本，之后样本归还给 slab（无论是否成功）
+    // 历史缓存写满（KEEP_ALL）或者样本超过 MTU（需要分片）时返回 false，这时不分配序列号
+    bool write(rtps::LoanedSample<T>&& sample){
+        rtps::LoanedSample<T> owned(std::move(sample));
+        if(!owned) return false;
+        if constexpr (rtps::LoanedSample<T>::serializes_in_place()){
+            if constexpr (rtps::is_cdr_memcpy_layout<T>()){
+                return publish(owned.serialize());
+            }
+            else{
+                rtps::ConstByteSpan payload;
+                {
+                    rtps::SerializationTimer timer(statistics_);
+                    payload = owned.serialize();
+                }
+                return publish(payload);
+            }
+        }
+        else{
+            return write(*owned);
+        }
+    }
+
+    bool write(const T& sample){
+        {
+            rtps::SerializationTimer timer(statistics_);
+            serializer_.reset();
+            serializer_.serialize_encapsulation();
+            serializer_.serialize_type(sample);
+        }
+        return publish(serializer_.buffer());
+    }
+
+    rtps::WriterHistoryCache& history() { return history_; }
+    const rtps::WriterHistoryCache& history() const { return history_; }
+
+    // 发出的样本、历史缓存深度、丢弃的样本和抽样的编码耗时记到这里（nullptr 不统计）
+    void set_statistics(rtps::EntityStatistics* statistics){
+        statistics_ = statistics;
+        history_.set_statistics(statistics);
+    }
+
+private:
+    rtps::MessageBuilder& builder_;
+    rtps::EntityId writer_id_;
+    rtps::EntityId reader_id_;
+    rtps::SampleSlab<T>& slab_;
+    rtps::WriterHistoryCache history_;
+    rtps::CdrSerializer serializer_; // write(const T&) 的编码缓冲区，反复复用
+    rtps::EntityStatistics* statistics_ = nullptr;
+
+    // 有界类型带封装头的序列化大小，变长类型为 0
+    static constexpr size_t bounded_payload_size(){
+        if constexpr (rtps::is_cdr_bounded<T>()){
+            return rtps::ENCAPSULATION_HEADER_SIZE + rtps::get_serialized_size<T>();
+        }
+        else{
+            return 0;
+        }
+    }
+
+    bool publish(rtps::ConstByteSpan payload){
+        // 先确认 DATA 发得出去再分配序列号：否则序列号被占用、样本留在历史缓存里，读端会看到一个补不上的缺口
+        if(!builder_.fits_data(payload.size())){
+            if(statistics_ != nullptr) statistics_->on_sample_dropped();
+            return false;
+        }
+        rtps::SequenceNumber sequence_number;
+        if(!history_.add_change(payload, sequence_number)) return false;
+        // 源时间戳随 INFO_TS 发出，读端用它计算端到端延迟
+        if(!builder_.add_data(reader_id_, writer_id_, sequence_number, payload, rtps::Timestamp::now())) return false;
+        if(statistics_ != nullptr) statistics_->on_sample_sent(payload.size());
+        return true;
+    }
+};
+
+} // namespace dds
+} // namespace tinydds
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tinydds/rtps/event_count.hpp"
+#include "tinydds/rtps/mpmc_queue.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// Executor: 执行监听器回调（on_data_available 等）的地方
+//
+// 两种实现：
+//   - InlineExecutor：直接在投递的线程（接收线程）上执行，没有线程切换，延迟最低；
+//     回调慢会拖住接收
+//   - ThreadPoolExecutor：工作线程池，每个线程一个无锁任务队列，空闲的线程从别的队列偷任务，
+//     工作线程可以绑定到指定的 CPU 核
+// ============================================================
+class Executor{
+public:
+    using Task = std::function<void()>;
+
+    virtual ~Executor() = default;
+
+    // 投递一个任务，已关闭或队列全满时返回 false（任务没有执行也不会执行）
+    virtual bool post(Task task) = 0;
+
+    // 任务是否在 post() 的调用线程上同步执行
+    virtual bool runs_inline() const { return false; }
+};
+
+class InlineExecutor : public Executor{
+public:
+    bool post(Task task) override {
+        task();
+        return true;
+    }
+
+    bool runs_inline() const override { return true; }
+};
+
+struct ThreadPoolConfig{
+    size_t threads = 0;              // 工作线程数，0 表示与 CPU 核数相同
+    std::vector<int> cpus;           // 工作线程 i 绑定到 cpus[i % cpus.size()]，为空时不绑定
+    size_t queue_capacity = 1024;    // 每个工作线程的任务队列容量
+};
+
+class ThreadPoolExecutor : public Executor{
+public:
+    explicit ThreadPoolExecutor(const ThreadPoolConfig& config = ThreadPoolConfig());
+    ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    // 轮流投递到各个工作线程的队列，某个队列满了就换下一个
+    bool post(Task task) override;
+
+    // 投递到指定工作线程的队列（例如让同一个 DataReader 的回调尽量留在同一个核上），
+    // 这个队列满了时返回 false；任务仍然可能被空闲的线程偷走
+    bool post_to(size_t worker, Task task);
+
+    // 停止接收新任务，执行完已经投递的任务后等待所有工作线程退出
+    void shutdown();
+
+    size_t thread_count() const { return workers_.size(); }
+    size_t pinned_threads() const { return pinned_.load(std::memory_order_relaxed); } // 成功绑核的线程数
+    uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }      // 从别的队列偷到的任务数
+
+private:
+    struct Worker{
+        explicit Worker(size_t capacity) : queue(capacity) {}
+        rtps::MpmcQueue<Task> queue;
+        std::thread thread;
+    };
+
+    ThreadPoolConfig config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    rtps::EventCount idle_;                    // 所有队列都空时工作线程在这里睡眠
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> next_worker_{0};
+    std::atomic<size_t> pinned_{0};
+    std::atomic<uint64_t> steals_{0};
+
+    void run(size_t index);
+    bool run_one(size_t index); // 先取自己的队列，再依次偷别的队列
+    bool has_work() const;
+    bool pin_current_thread(int cpu);
+};
+
+// ============================================================
+// 按配置创建执行器
+// ============================================================
+enum class ExecutorKind{
+    INLINE,
+    THREAD_POOL
+};
+
+struct ExecutorConfig{
+    ExecutorKind kind = ExecutorKind::INLINE;
+    ThreadPoolConfig pool;
+};
+
+std::unique_ptr<Executor> make_executor(const ExecutorConfig& config);
+
+} // namespace dds
+} // namespace tinydds
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "tinydds/dds/executor.hpp"
+#include "tinydds/rtps/mpsc_queue.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// ListenerDispatcher: 把接收线程交来的样本成批地交给一个 DataReader 的监听器
+//
+// 接收线程调用 deliver()：样本进入无锁 MPSC 队列，如果这个 reader 当前没有待执行的回调，
+// 就向执行器投递一次回调。回调执行时一次取出队列里最多 max_batch 个样本，
+// 用一次 listener(samples) 交出去：样本到得越密，每次回调带的样本越多，
+// 回调和线程切换的开销被分摊到整批样本上。
+//
+// 同一个 dispatcher 的 listener 不会并发执行（同一时刻最多一个回调在跑），
+// 批内和批间都保持每个接收线程的投递顺序。
+// 使用线程池时，dispatcher 必须比所有已投递的回调活得久（先 shutdown 执行器再销毁）
+// ============================================================
+template<typename Sample>
+class ListenerDispatcher{
+public:
+    // samples 指向内部缓冲区，只在回调期间有效；回调里可以把样本移走
+    using BatchListener = std::function<void(rtps::Span<Sample> samples)>;
+
+    ListenerDispatcher(Executor& executor, BatchListener listener,
+                       size_t queue_capacity = 1024, size_t max_batch = 64)
+        : executor_(executor), listener_(std::move(listener)), queue_(queue_capacity),
+          max_batch_(max_batch == 0 ? 1 : max_batch){
+        batch_.reserve(max_batch_);
+    }
+
+    ListenerDispatcher(const ListenerDispatcher&) = delete;
+    ListenerDispatcher& operator=(const ListenerDispatcher&) = delete;
+
+    // 接收线程调用（可以多个线程并发），队列满时丢弃样本并返回 false
+    bool deliver(Sample&& sample){
+        if(!queue_.push(std::move(sample))){
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if(!scheduled_.exchange(true, std::memory_order_seq_cst)){
+            dispatch();
+        }
+        return true;
+    }
+
+    bool deliver(const Sample& sample){
+        Sample copy(sample);
+        return deliver(std::move(copy));
+    }
+
+    // 队列为空且没有待执行的回调
+    bool idle() const { return !scheduled_.load(std::memory_order_acquire) && queue_.empty(); }
+
+    uint64_t delivered() const { return delivered_.load(std::memory_order_relaxed); } // 交给监听器的样本数
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }     // 回调次数
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }     // 队列满丢弃的样本数
+
+private:
+    Executor& executor_;
+    BatchListener listener_;
+    rtps::MpscQueue<Sample, false> queue_;
+    size_t max_batch_;
+    std::vector<Sample> batch_;           // 只在持有 scheduled_ 的线程上使用
+    std::atomic<bool> scheduled_{false};  // 已经投递了回调、还没有执行完
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    // 调用方已经把 scheduled_ 置为 true
+    void dispatch(){
+        if(executor_.runs_inline()){
+            // 在接收线程上直接处理，把期间其他接收线程投递的样本也一并处理完
+            do{
+                run_batch();
+            }while(reacquire());
+            return;
+        }
+        // 线程池满了或已关闭：退回到当前线程上执行，不丢样本
+        if(!executor_.post([this]{ run_async(); })){
+            do{
+                run_batch();
+            }while(reacquire());
+        }
+    }
+
+    void run_async(){
+        run_batch();
+        // 每次回调只处理一批，还有样本就重新投递，让同一个线程池里的其他 reader 也能执行
+        if(reacquire()) dispatch();
+    }
+
+    void run_batch(){
+        batch_.clear();
+        queue_.take_batch([this](Sample& sample){ batch_.push_back(std::move(sample)); }, max_batch_);
+        if(batch_.empty()) return;
+        if(listener_){
+            listener_(rtps::Span<Sample>(batch_.data(), batch_.size()));
+        }
+        delivered_.fetch_add(batch_.size(), std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 释放 scheduled_；如果队列里还有样本，重新抢回 scheduled_ 并返回 true
+    // 先释放再检查：与 deliver() 的 push + exchange 配对，样本不会被漏掉
+    bool reacquire(){
+        scheduled_.store(false, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(queue_.empty()) return false;
+        return !scheduled_.exchange(true, std::memory_order_seq_cst);
+    }
+};
+
+} // namespace dds
+} // namespace tinydds
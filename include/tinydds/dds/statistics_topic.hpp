@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// 内置统计主题
+//
+// 每个实体（按 GUID）一个实例，key 是 GUID：
+//   writer ENTITYID_TINYDDS_STATISTICS_WRITER -> reader ENTITYID_TINYDDS_STATISTICS_READER，
+//   DATA 的 inline QoS 里带 PID_KEY_HASH（就是 GUID 的 16 个字节），
+//   payload 是 CDR 编码的 StatisticsSample
+// 延迟直方图只发布几个分位数，完整的直方图用 StatisticsRegistry::snapshot() 读取
+// ============================================================
+
+struct StatisticsLatency{
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+struct StatisticsSample{
+    std::array<uint8_t, 16> guid{}; // key
+    rtps::StatisticsCounters counters;
+    StatisticsLatency latency;
+
+    rtps::GUID entity_guid() const;
+};
+
+// 从快照生成统计主题的样本
+void make_statistics_sample(const rtps::EntityStatisticsSnapshot& snapshot, StatisticsSample& out);
+
+// 解码 DATA 的 payload（带封装头），失败时返回 false
+bool decode_statistics_sample(rtps::ConstByteSpan payload, StatisticsSample& out);
+
+// ============================================================
+// StatisticsPublisher: 把注册表里所有实体的统计写成统计主题的 DATA
+//
+// 由参与者按自己的周期调用 write_samples()（和发现的宣告一样），
+// 快照、样本和编码缓冲区都是成员，反复复用
+// ============================================================
+class StatisticsPublisher{
+public:
+    explicit StatisticsPublisher(const rtps::StatisticsRegistry& registry);
+
+    // 每个实体写一个 DATA，返回写入的个数
+    size_t write_samples(rtps::MessageBuilder& builder);
+
+private:
+    const rtps::StatisticsRegistry& registry_;
+    std::vector<rtps::EntityStatisticsSnapshot> snapshots_;
+    StatisticsSample sample_;
+    rtps::CdrSerializer serializer_; // payload
+    rtps::CdrSerializer inline_qos_; // PID_KEY_HASH
+    rtps::SequenceNumber sn_;
+};
+
+} // namespace dds
+} // namespace tinydds
+
+TINYDDS_CDR_TYPE(tinydds::rtps::StatisticsCounters, samples_sent, bytes_sent, samples_received, bytes_received,
+                 retransmits, nacks_sent, nacks_received, samples_dropped, serialization_ns, serializations,
+                 queue_depth, queue_depth_max);
+TINYDDS_CDR_TYPE(tinydds::dds::StatisticsLatency, count, min_ns, p50_ns, p99_ns, p999_ns, max_ns);
+TINYDDS_CDR_TYPE(tinydds::dds::StatisticsSample, guid, counters, latency);
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "tinydds/discovery/discovery_data.hpp"
+#include "tinydds/discovery/endpoint_matcher.hpp"
+#include "tinydds/discovery/timer_wheel.hpp"
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/flat_hash_map.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/sequence_number.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+struct DiscoveryConfig{
+    std::chrono::milliseconds lease_tick{100}; // 租期检查的精度（时间轮一个 tick 的长度）
+    size_t lease_wheel_slots = 512;
+};
+
+// ============================================================
+// Discovery: 简单参与者发现（SPDP）+ 简单端点发现（SEDP）
+//
+// 不直接收发网络数据：
+//   - write_announcements() 把本地参与者和本地端点的宣告写进 MessageBuilder，
+//     由调用方周期性调用并发送到发现用的多播/单播地址
+//   - handle_message() 处理收到的一条 RTPS 消息，按内置写端的 EntityId 分发 SPDP/SEDP 数据
+//   - check_leases() 在事件循环里调用，让租期到期的参与者及其端点离开
+//
+// 远端参与者的租期挂在时间轮上，每次宣告只是续期；端点匹配由 EndpointMatcher 按主题索引增量完成。
+// SEDP 数据只在发送方参与者已经被 SPDP 发现之后才接受（之后的周期宣告会再次带上它）。
+// 不是线程安全的
+// ============================================================
+class Discovery{
+public:
+    using Clock = std::chrono::steady_clock;
+    using ParticipantListener = std::function<void(const ParticipantProxyData& participant, bool discovered)>;
+
+    Discovery(const ParticipantProxyData& local, const DiscoveryConfig& config = DiscoveryConfig(),
+              Clock::time_point now = Clock::now());
+
+    void set_participant_listener(ParticipantListener listener) { participant_listener_ = std::move(listener); }
+    void set_match_listener(EndpointMatcher::MatchListener listener) { matcher_.set_listener(std::move(listener)); }
+
+    // ========================================
+    // 本地端点
+    // ========================================
+
+    // GUID 前缀必须是本地参与者的前缀
+    bool add_local_endpoint(const EndpointProxyData& data);
+    bool remove_local_endpoint(const rtps::GUID& guid);
+
+    // ========================================
+    // 宣告与接收
+    // ========================================
+
+    // 写入一条 SPDP 宣告和所有本地端点的 SEDP 宣告
+    // 有端点编码失败或者 MessageBuilder 写不下时返回 false；编码失败的端点被跳过，不影响其他端点
+    bool write_announcements(rtps::MessageBuilder& builder);
+
+    // 处理一条收到的 RTPS 消息，返回其中处理了多少条发现数据
+    size_t handle_message(rtps::ConstByteSpan message, Clock::time_point now = Clock::now());
+
+    // 直接处理解码后的数据（handle_message 内部调用）
+    bool on_participant_data(const ParticipantProxyData& data, Clock::time_point now);
+    bool on_endpoint_data(const EndpointProxyData& data);
+
+    // 让租期到期的远端参与者离开，返回离开的数量
+    size_t check_leases(Clock::time_point now = Clock::now());
+
+    // ========================================
+    // 状态查询
+    // ========================================
+
+    const ParticipantProxyData& local_participant() const { return local_; }
+    const ParticipantProxyData* find_participant(const rtps::GuidPrefix& prefix) const { return participants_.find(prefix); }
+    size_t participant_count() const { return participants_.size(); }
+    const EndpointMatcher& matcher() const { return matcher_; }
+
+private:
+    ParticipantProxyData local_;
+    DiscoveryConfig config_;
+    ParticipantListener participant_listener_;
+    EndpointMatcher matcher_;
+    rtps::GuidPrefixMap<ParticipantProxyData> participants_;
+    TimerWheel<rtps::GuidPrefix> leases_;
+    rtps::GuidMap<EndpointProxyData> local_endpoints_;
+    rtps::CdrSerializer serializer_; // 宣告的编码缓冲区，反复复用
+
+    rtps::SequenceNumber spdp_sn_{0};
+    rtps::SequenceNumber publications_sn_{0};
+    rtps::SequenceNumber subscriptions_sn_{0};
+
+    int64_t to_tick(Clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() /
+               config_.lease_tick.count();
+    }
+
+    void remove_participant(const rtps::GuidPrefix& prefix);
+};
+
+} // namespace discovery
+} // namespace tinydds
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/locator.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+// ============================================================
+// 匹配时用到的 QoS（数值越大要求越强，写端 >= 读端才能匹配）
+// ============================================================
+enum class ReliabilityKind : uint8_t {
+    BEST_EFFORT = 1,
+    RELIABLE = 2
+};
+
+enum class DurabilityKind : uint8_t {
+    VOLATILE = 0,
+    TRANSIENT_LOCAL = 1
+};
+
+// ============================================================
+// ParticipantProxyData: SPDP 宣告的参与者信息
+// ============================================================
+struct ParticipantProxyData{
+    rtps::GuidPrefix guid_prefix;
+    std::array<uint8_t, 2> vendor_id = {0, 0};
+    std::vector<rtps::Locator> metatraffic_unicast_locators;   // 接收 SEDP 等内置流量
+    std::vector<rtps::Locator> metatraffic_multicast_locators;
+    std::vector<rtps::Locator> default_unicast_locators;       // 接收用户数据
+    std::chrono::milliseconds lease_duration{10000};           // 超过这么久没有再次宣告就认为参与者已经离开
+
+    bool operator==(const ParticipantProxyData& other) const {
+        return guid_prefix == other.guid_prefix && vendor_id == other.vendor_id &&
+               metatraffic_unicast_locators == other.metatraffic_unicast_locators &&
+               metatraffic_multicast_locators == other.metatraffic_multicast_locators &&
+               default_unicast_locators == other.default_unicast_locators &&
+               lease_duration == other.lease_duration;
+    }
+
+    bool operator!=(const ParticipantProxyData& other) const { return !(*this == other); }
+};
+
+// ============================================================
+// ContentFilterProperty: 读端的内容过滤条件（ContentFilteredTopic）
+// 随 SEDP 宣告给写端，写端据此在发送前过滤样本（见 dds/content_filter.hpp）
+// filter_expression 为空表示没有过滤
+// ============================================================
+struct ContentFilterProperty{
+    std::string content_filtered_topic_name;
+    std::string related_topic_name;
+    std::string filter_class_name = "DDSSQL";
+    std::string filter_expression;
+    std::vector<std::string> expression_parameters;
+
+    bool empty() const { return filter_expression.empty(); }
+
+    bool operator==(const ContentFilterProperty& other) const {
+        return content_filtered_topic_name == other.content_filtered_topic_name &&
+               related_topic_name == other.related_topic_name &&
+               filter_class_name == other.filter_class_name &&
+               filter_expression == other.filter_expression &&
+               expression_parameters == other.expression_parameters;
+    }
+
+    bool operator!=(const ContentFilterProperty& other) const { return !(*this == other); }
+};
+
+// ============================================================
+// EndpointProxyData: SEDP 宣告的 DataWriter / DataReader 信息
+// ============================================================
+struct EndpointProxyData{
+    rtps::GUID guid;
+    bool is_writer = false;
+    std::string topic_name;
+    std::string type_name;
+    ReliabilityKind reliability = ReliabilityKind::BEST_EFFORT;
+    DurabilityKind durability = DurabilityKind::VOLATILE;
+    std::vector<rtps::Locator> unicast_locators; // 为空时使用参与者的 default_unicast_locators
+    ContentFilterProperty content_filter;         // 只对读端有意义
+
+    bool operator==(const EndpointProxyData& other) const {
+        return guid == other.guid && is_writer == other.is_writer &&
+               topic_name == other.topic_name && type_name == other.type_name &&
+               reliability == other.reliability && durability == other.durability &&
+               unicast_locators == other.unicast_locators && content_filter == other.content_filter;
+    }
+
+    bool operator!=(const EndpointProxyData& other) const { return !(*this == other); }
+};
+
+// 写端和读端的 QoS 是否兼容（主题和类型由调用方保证相同）
+inline bool is_compatible(const EndpointProxyData& writer, const EndpointProxyData& reader){
+    return writer.reliability >= reader.reliability && writer.durability >= reader.durability;
+}
+
+// ============================================================
+// 参数列表编码（PL_CDR 封装头，按 serializer 的字节序，PID 取 RTPS 规范的值）
+// 解码时按封装头自动识别对端字节序，不认识的参数直接跳过；
+// 缺少必需的参数（GUID、主题名、类型名）或内容不完整时返回 false；
+// 编码时某个参数值超过 PARAMETER_MAX_LENGTH（例如过长的主题名）返回 false，这时的数据不能发送
+// ============================================================
+bool serialize_participant_data(const ParticipantProxyData& data, rtps::CdrSerializer& serializer);
+bool deserialize_participant_data(rtps::ConstByteSpan payload, ParticipantProxyData& data);
+
+bool serialize_endpoint_data(const EndpointProxyData& data, rtps::CdrSerializer& serializer);
+bool deserialize_endpoint_data(rtps::ConstByteSpan payload, EndpointProxyData& data);
+
+} // namespace discovery
+} // namespace tinydds
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tinydds/discovery/discovery_data.hpp"
+#include "tinydds/rtps/flat_hash_map.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+// ============================================================
+// EndpointMatcher: 增量的写端/读端匹配
+//
+// 端点按 (主题名, 类型名) 建索引：新端点只和同一主题、同一类型下的对端比较 QoS，
+// 而不是和所有已知端点比较；重复的宣告（内容没变）直接忽略，不做任何匹配。
+// 端点按参与者分组，参与者离开时可以一次移除它的所有端点。
+//
+// 匹配/解除匹配通过 listener(writer, reader, matched) 通知，
+// listener 里不能修改这个 matcher（引用指向内部存储）
+// ============================================================
+class EndpointMatcher{
+public:
+    using MatchListener = std::function<void(const EndpointProxyData& writer, const EndpointProxyData& reader, bool matched)>;
+
+    explicit EndpointMatcher(MatchListener listener = MatchListener()) : listener_(std::move(listener)) {}
+
+    void set_listener(MatchListener listener) { listener_ = std::move(listener); }
+
+    // 新增或更新端点，返回是否有变化（内容和已知的完全相同时返回 false）
+    bool add_endpoint(const EndpointProxyData& data);
+
+    // 移除端点，对它的所有匹配发出解除通知
+    bool remove_endpoint(const rtps::GUID& guid);
+
+    // 移除某个参与者的所有端点，返回移除的数量
+    size_t remove_participant_endpoints(const rtps::GuidPrefix& prefix);
+
+    const EndpointProxyData* find(const rtps::GUID& guid) const { return endpoints_.find(guid); }
+
+    size_t endpoint_count() const { return endpoints_.size(); }
+    size_t topic_count() const { return topics_.size(); }
+
+    // 累计做过的 QoS 兼容性检查次数（用于观察匹配的开销）
+    uint64_t compatibility_checks() const { return compatibility_checks_; }
+
+private:
+    struct TopicEntry{
+        std::vector<rtps::GUID> writers;
+        std::vector<rtps::GUID> readers;
+    };
+
+    MatchListener listener_;
+    rtps::GuidMap<EndpointProxyData> endpoints_;
+    std::unordered_map<std::string, TopicEntry> topics_;               // 键：主题名 + '\0' + 类型名
+    rtps::GuidPrefixMap<std::vector<rtps::GUID>> participant_endpoints_;
+    uint64_t compatibility_checks_ = 0;
+
+    static std::string topic_key(const EndpointProxyData& data);
+
+    // 对 data 和同一主题下所有兼容的对端调用 listener(…, matched)
+    void notify_matches(const EndpointProxyData& data, const TopicEntry& topic, bool matched);
+};
+
+} // namespace discovery
+} // namespace tinydds
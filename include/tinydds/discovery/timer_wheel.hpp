@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "tinydds/rtps/flat_hash_map.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+// ============================================================
+// TimerWheel: 哈希时间轮，用于参与者租期等大量、经常续期的超时
+//
+// 时间按 tick 计数，截止时间为 t 的条目挂在槽 t % slots 上，advance() 每推进一个 tick 只看一个槽。
+// 续期（schedule 一个已有的 key，截止时间变晚）只修改表里记录的截止时间，不移动条目：
+// 条目到点时发现截止时间已经推后，再重新挂到新的槽上。
+// 参与者每隔几秒宣告一次，续期是 O(1)，而且不会在时间轮上留下垃圾条目
+// ============================================================
+template<typename Key, typename Hash = std::hash<Key>>
+class TimerWheel{
+public:
+    explicit TimerWheel(size_t slots = 512, int64_t start_tick = 0)
+        : slots_(slots == 0 ? 1 : slots), current_tick_(start_tick) {}
+
+    // 新增或更新 key 的截止时间
+    void schedule(const Key& key, int64_t deadline){
+        State* state = states_.find(key);
+        if(state != nullptr){
+            state->deadline = deadline;
+            // 截止时间变晚：等原来的条目到点后再重新挂；变早：在新位置再挂一个条目，原条目作废
+            if(deadline >= state->armed_tick) return;
+        }else{
+            state = states_.insert(key, State()).first;
+            state->deadline = deadline;
+        }
+        arm(key, *state, deadline);
+    }
+
+    // 取消，返回 key 是否存在
+    bool cancel(const Key& key){
+        return states_.erase(key); // 时间轮上的条目到点时发现 key 不存在，直接丢弃
+    }
+
+    bool contains(const Key& key) const { return states_.contains(key); }
+
+    // 推进到 now，对每个截止时间 <= now 的 key 调用 on_expired(key)，返回超时的数量
+    // on_expired 里可以再 schedule/cancel
+    template<typename Fn>
+    size_t advance(int64_t now, Fn&& on_expired){
+        if(now <= current_tick_) return 0;
+        // 一次跳过超过一圈时，每个槽只需要看一次
+        int64_t steps = now - current_tick_;
+        if(steps > static_cast<int64_t>(slots_.size())) steps = static_cast<int64_t>(slots_.size());
+        int64_t first = current_tick_ + 1;
+        current_tick_ = now;
+
+        size_t expired = 0;
+        for(int64_t tick = first; tick < first + steps; ++tick){
+            scratch_.clear();
+            scratch_.swap(slots_[slot_of(tick)]);
+            for(const Entry& entry : scratch_){
+                State* state = states_.find(entry.key);
+                if(state == nullptr || state->armed_tick != entry.tick) continue; // 已取消或已重新挂载
+                if(entry.tick > now){
+                    slots_[slot_of(entry.tick)].push_back(entry); // 后面几圈才到点
+                }else if(state->deadline <= now){
+                    Key key = entry.key;
+                    states_.erase(key);
+                    on_expired(key);
+                    ++expired;
+                }else{
+                    arm(entry.key, *state, state->deadline); // 已经续期
+                }
+            }
+        }
+        return expired;
+    }
+
+    size_t size() const { return states_.size(); }
+    bool empty() const { return states_.empty(); }
+    int64_t current_tick() const { return current_tick_; }
+
+private:
+    struct State{
+        int64_t deadline = 0;
+        int64_t armed_tick = 0; // 当前有效的条目挂在哪个 tick 上
+    };
+
+    struct Entry{
+        Key key;
+        int64_t tick;
+    };
+
+    std::vector<std::vector<Entry>> slots_;
+    std::vector<Entry> scratch_;
+    rtps::FlatHashMap<Key, State, Hash> states_;
+    int64_t current_tick_;
+
+    size_t slot_of(int64_t tick) const {
+        return static_cast<size_t>(tick) % slots_.size();
+    }
+
+    void arm(const Key& key, State& state, int64_t deadline){
+        // 已经过期的截止时间挂在下一个 tick 上
+        int64_t tick = deadline > current_tick_ ? deadline : current_tick_ + 1;
+        state.armed_tick = tick;
+        slots_[slot_of(tick)].push_back(Entry{key, tick});
+    }
+};
+
+} // namespace discovery
+} // namespace tinydds
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds{
+namespace rtps{
+
+class BufferPool;
+
+// ============================================================
+// PooledBuffer: 可以在模块之间移动传递的字节缓冲区
+// storage_.size() 是容量，size_ 是已写入的有效数据长度
+// 如果缓冲区来自 BufferPool，析构时自动归还给池，而不是释放内存
+// ============================================================
+class PooledBuffer{
+public:
+    PooledBuffer() = default;
+
+    // 直接从堆上分配指定容量的缓冲区（不属于任何池）
+    explicit PooledBuffer(size_t capacity) : storage_(capacity) {}
+
+    PooledBuffer(std::vector<uint8_t>&& storage, BufferPool* pool)
+        : storage_(std::move(storage)), pool_(pool) {}
+
+    ~PooledBuffer(){
+        reset();
+    }
+
+    // 只能移动，不能复制：一块缓冲区同一时刻只有一个所有者
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : storage_(std::move(other.storage_)), size_(other.size_), pool_(other.pool_){
+        other.storage_.clear();
+        other.size_ = 0;
+        other.pool_ = nullptr;
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept{
+        if(this != &other){
+            reset();
+            storage_ = std::move(other.storage_);
+            size_ = other.size_;
+            pool_ = other.pool_;
+            other.storage_.clear();
+            other.size_ = 0;
+            other.pool_ = nullptr;
+        }
+        return *this;
+    }
+
+    uint8_t* data() { return storage_.data(); }
+    const uint8_t* data() const { return storage_.data(); }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return storage_.size(); }
+    bool empty() const { return size_ == 0; }
+
+    // 设置有效数据长度（不能超过容量）
+    void set_size(size_t size){
+        size_ = size < storage_.size() ? size : storage_.size();
+    }
+
+    // 扩容到至少 min_capacity，已有数据保持不变
+    void grow(size_t min_capacity){
+        if(min_capacity > storage_.size()){
+            storage_.resize(min_capacity);
+        }
+    }
+
+    // 有效数据的只读视图
+    ConstByteSpan span() const { return ConstByteSpan(storage_.data(), size_); }
+
+    // 整块容量的可写视图
+    ByteSpan writable_span() { return ByteSpan(storage_.data(), storage_.size()); }
+
+    BufferPool* pool() const { return pool_; }
+
+    // 脱离缓冲池，把底层 vector（裁剪到有效长度）交给调用方
+    std::vector<uint8_t> release(){
+        storage_.resize(size_);
+        std::vector<uint8_t> out = std::move(storage_);
+        storage_.clear();
+        size_ = 0;
+        pool_ = nullptr;
+        return out;
+    }
+
+    // 归还给缓冲池（如果有），自身变为空缓冲区
+    void reset();
+
+private:
+    std::vector<uint8_t> storage_; // 底层存储，size() 即容量
+    size_t size_ = 0;              // 有效数据长度
+    BufferPool* pool_ = nullptr;   // 所属缓冲池，nullptr 表示普通堆内存
+};
+
+// ============================================================
+// BufferPool: 固定大小缓冲区的复用池
+// 发送路径每条消息都从池里取一块缓冲，传输层用完后自动归还，
+// 稳定运行时不再产生堆分配。
+// 注意：池必须比从它取出的所有 PooledBuffer 活得更久
+// ============================================================
+class BufferPool{
+public:
+    // buffer_size: 每块缓冲区的初始容量
+    // preallocate: 构造时预先分配的缓冲区数量
+    // max_cached:  池中最多缓存的空闲缓冲区数量，超过的直接释放
+    explicit BufferPool(size_t buffer_size, size_t preallocate = 0, size_t max_cached = 256);
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // 取出一块缓冲区（空闲列表为空时新分配）
+    PooledBuffer acquire();
+
+    size_t buffer_size() const { return buffer_size_; }
+
+    // 当前池中空闲缓冲区的数量
+    size_t cached() const;
+
+private:
+    friend class PooledBuffer;
+
+    // PooledBuffer 析构/reset 时调用，把存储放回空闲列表
+    void recycle(std::vector<uint8_t>&& storage);
+
+    size_t buffer_size_;
+    size_t max_cached_;
+    mutable std::mutex mutex_; // 发送线程取、传输线程还，需要加锁
+    std::vector<std::vector<uint8_t>> free_list_;
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tinydds{
+namespace rtps{
+
+// ============================================================
+// 批量字节序翻转
+// 用于 CDR 序列化时对端字节序与本机不同的情况：
+// 把 count 个宽度为 elem_size（2/4/8）字节的元素从 src 复制到 dst，
+// 同时翻转每个元素内部的字节顺序。
+//
+// x86 上运行时检测 CPU 能力，依次选用 AVX2 / SSSE3 的字节洗牌指令
+// （每条指令处理 32/16 字节），其它平台使用标量 bswap 循环。
+// dst 和 src 可以相同（原地翻转），但不能部分重叠。
+// ============================================================
+void byte_swap_copy(uint8_t* dst, const uint8_t* src, size_t count, size_t elem_size);
+
+// 翻转单个基本类型值的字节序（整数和浮点都可以，编译为一条 bswap 指令）
+template<typename T>
+inline T byte_swap_value(T value){
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "byte_swap_value 只支持 1/2/4/8 字节的类型");
+    if constexpr (sizeof(T) == 2){
+        uint16_t bits;
+        std::memcpy(&bits, &value, 2);
+        bits = __builtin_bswap16(bits);
+        std::memcpy(&value, &bits, 2);
+    }
+    else if constexpr (sizeof(T) == 4){
+        uint32_t bits;
+        std::memcpy(&bits, &value, 4);
+        bits = __builtin_bswap32(bits);
+        std::memcpy(&value, &bits, 4);
+    }
+    else if constexpr (sizeof(T) == 8){
+        uint64_t bits;
+        std::memcpy(&bits, &value, 8);
+        bits = __builtin_bswap64(bits);
+        std::memcpy(&value, &bits, 8);
+    }
+    return value;
+}
+
+} // namespace rtps
+} // namespace tinydds
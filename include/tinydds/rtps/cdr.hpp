@@ -5,28 +5,193 @@
 #include <vector>
 #include <iostream>
 #include <cstring>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <string>
+#include <string_view>
+
+#include "tinydds/rtps/span.hpp"
+#include "tinydds/rtps/buffer_pool.hpp"
+#include "tinydds/rtps/byte_swap.hpp"
+#include "tinydds/rtps/cdr_encapsulation.hpp"
 
 namespace tinydds{
 namespace rtps{
 
+// 可以整块 memcpy 的 CDR 基本类型：整数、浮点（bool 的取值只能是 0/1，不走批量路径）
+template<typename T>
+struct is_cdr_primitive : std::integral_constant<bool,
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8> {};
+
+// CDR 基本类型的对齐要求等于它的大小
+template<typename T>
+constexpr size_t cdr_alignment() { return sizeof(T); }
+
+// ============================================================
+// CDR 输出缓冲区（与字节序无关的部分）
+// 负责缓冲区的管理：预留空间、扩容、对齐填充
+//
+// 三种缓冲区模式：
+// 1. 自有缓冲区：CdrSerializer(capacity)，空间不够时自动扩容
+// 2. 外部缓冲区：CdrSerializer(ByteSpan)，直接写入调用方提供的内存，
+//    不会扩容，写满后 good() 返回 false
+// 3. 池化缓冲区：CdrSerializer(BufferPool&)，从缓冲池取一块内存写入
+// 自有/池化模式下可以通过 release_buffer() 把写好的缓冲区移动给传输层，
+// 避免再复制一次
+// ============================================================
+class CdrOutputBuffer{
+public:
+    // 构造函数：预分配缓冲区大小
+    CdrOutputBuffer(size_t capacity = 1024) : storage_(capacity){ // size_t 专门用来表示大小
+        attach_storage();
+    }
+
+    // 直接写入外部内存（例如共享内存、发送队列中的槽位）
+    explicit CdrOutputBuffer(ByteSpan external)
+        : data_(external.data()), capacity_(external.size()), external_capacity_(external.size()), external_(true) {}
+
+    // 从缓冲池取一块缓冲区写入
+    explicit CdrOutputBuffer(BufferPool& pool) : storage_(pool.acquire()){
+        attach_storage();
+    }
+
+    // 从缓冲池取一块缓冲区，并保证至少有 min_capacity 字节（已知序列化大小时使用）
+    CdrOutputBuffer(BufferPool& pool, size_t min_capacity) : storage_(pool.acquire()){
+        storage_.grow(min_capacity);
+        attach_storage();
+    }
+
+    // 获取已写入的数据（只读视图，不复制）
+    ConstByteSpan buffer() const{
+        return ConstByteSpan(data_, size_);
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // 外部缓冲区模式下空间不足时返回 false，此后的写入都会被丢弃
+    bool good() const { return !overflow_; }
+
+    // 相对封装头之后的写入位置（CDR 对齐以它为准）
+    size_t offset() const { return size_ - origin_; }
+
+    // 对齐起点（缓冲区内的绝对位置）
+    // 参数列表里每个参数值以自己的开头为起点对齐，写参数值时临时改到参数值的开头
+    size_t alignment_origin() const { return origin_; }
+    void set_alignment_origin(size_t position) { origin_ = position; }
+
+    // 交出缓冲区的所有权（移动，不复制），序列化器变为空
+    // 外部缓冲区模式下内存本来就属于调用方，返回空的 PooledBuffer
+    PooledBuffer release_buffer(){
+        PooledBuffer out = std::move(storage_);
+        out.set_size(size_);
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        external_capacity_ = 0;
+        origin_ = 0;
+        external_ = false;
+        overflow_ = false;
+        return out;
+    }
+
+    // 清空已写入的内容，复用同一块缓冲区（外部缓冲区溢出后也恢复成完整的大小）
+    void reset(){
+        size_ = 0;
+        origin_ = 0;
+        overflow_ = false;
+        capacity_ = external_ ? external_capacity_ : storage_.capacity();
+    }
+
+protected:
+    // 选择 uint8_t 作为缓存类型有以下几个重要原因：核心原因：明确的字节语义
+    // uint8_t 保证：正好 1 字节（8位）、无符号（0-255）、平台无关的大小
+    PooledBuffer storage_;     // 自有/池化模式下的底层存储
+    uint8_t* data_ = nullptr;  // 当前写入的内存起始地址（指向 storage_ 或外部内存）
+    size_t size_ = 0;          // 已写入的字节数
+    size_t capacity_ = 0;      // data_ 可用的总字节数
+    size_t external_capacity_ = 0; // 外部内存的大小（溢出时 capacity_ 被截到 size_，reset() 用它恢复）
+    size_t origin_ = 0;        // 对齐的起点（封装头之后的位置）
+    bool external_ = false;    // 是否写入外部内存（不能扩容）
+    bool overflow_ = false;    // 外部内存是否已写满
+
+    void attach_storage(){
+        data_ = storage_.data();
+        capacity_ = storage_.capacity();
+    }
+
+    // 预留 n 个字节并返回写入位置，空间不足且无法扩容时返回 nullptr
+    uint8_t* reserve(size_t n){
+        if(size_ + n > capacity_ && !grow(size_ + n)){
+            return nullptr;
+        }
+        uint8_t* ptr = data_ + size_;
+        size_ += n;
+        return ptr;
+    }
+
+    // 不检查容量直接预留：调用方已经用 CdrSizeCalculator 算好大小并一次分配够了
+    uint8_t* reserve_unchecked(size_t n){
+        assert(size_ + n <= capacity_ && "预先计算的序列化大小不足");
+        uint8_t* ptr = data_ + size_;
+        size_ += n;
+        return ptr;
+    }
+
+    // 扩容（冷路径，实现在 cdr.cpp）
+    bool grow(size_t required);
+};
+
 // ============================================================
 // CDR 序列化器
 // 负责将各种数据类型写入字节流
+//
+// 模板参数 Policy 决定输出的字节序（见 cdr_encapsulation.hpp）：
+// 是否翻转字节在编译期确定，本机字节序时 write_value 就是一次 memcpy
+//
+// 模板参数 Checked 为 false 时每次写入都不检查容量（也不会扩容）：
+// 先用 CdrSizeCalculator 算出确切大小，按这个大小一次分配，再无检查地写入
 // ============================================================
-class CdrSerializer{
+template<typename Policy, bool Checked = true>
+class BasicCdrSerializer : public CdrOutputBuffer{
 public:
-    // 构造函数：预分配缓冲区大小
-    CdrSerializer(size_t capacity = 1024){ // size_t 专门用来表示大小
-        // reserve() vs resize()
-        // 操作	         容量    大小	 元素状态	 用途
-        // reserve(n)	≥ n	   不变 	未创建	 预分配内存
-        // resize(n)	≥ n	   = n	   已创建	改变元素个数
-        buffer_.reserve(capacity); // 预分配内存，避免频繁分配
+    using CdrOutputBuffer::CdrOutputBuffer;
+
+    static constexpr CdrEndian endian() { return Policy::endian; }
+
+    // 不对齐地预留 n 个字节，返回写入位置（空间不足时返回 nullptr）
+    // 供类型支持层一次预留一整段连续字段后直接写入
+    uint8_t* reserve_bytes(size_t n) { return claim(n); }
+
+    // 改写已经写入的 uint16（按本序列化器的字节序），用于回填长度字段
+    // position 是缓冲区内的绝对位置，超出已写入的范围时什么也不做
+    void patch_uint16(size_t position, uint16_t value){
+        if(position + sizeof(value) > size_) return;
+        if constexpr (Policy::swap){
+            value = byte_swap_value(value);
+        }
+        std::memcpy(data_ + position, &value, sizeof(value));
     }
 
-    // 获取底层缓冲区
-    const std::vector<uint8_t>& buffer() const{
-        return buffer_;
+    // ========================================
+    // 封装头
+    // ========================================
+
+    // 写入 4 字节封装头（CDR_BE / CDR_LE，或参数列表 PL_CDR_BE / PL_CDR_LE）
+    // 之后写入的字段以封装头之后的位置为起点对齐
+    void serialize_encapsulation(bool parameter_list = false, uint16_t options = 0){
+        EncapsulationHeader header = EncapsulationHeader::make(Policy::endian, parameter_list, options);
+        uint8_t* ptr = claim(ENCAPSULATION_HEADER_SIZE);
+        if(ptr == nullptr) return;
+        // representation identifier 和 options 都按大端写入
+        uint16_t id = static_cast<uint16_t>(header.kind);
+        ptr[0] = static_cast<uint8_t>(id >> 8);
+        ptr[1] = static_cast<uint8_t>(id & 0xFF);
+        ptr[2] = static_cast<uint8_t>(options >> 8);
+        ptr[3] = static_cast<uint8_t>(options & 0xFF);
+        origin_ = size_;
     }
 
     // ========================================
@@ -39,12 +204,13 @@ public:
 
     // bool 类型序列化
     void serialize_bool(bool value){
-        buffer_.push_back(value ? 1 : 0);
+        serialize_byte(value ? 1 : 0);
     }
 
     // uint8_t 类型序列化
     void serialize_byte(uint8_t value) {
-        buffer_.push_back(value);
+        uint8_t* ptr = claim(1);
+        if(ptr != nullptr) *ptr = value;
     }
 
     void serialize_uint16(uint16_t value) {
@@ -87,6 +253,14 @@ public:
         write_value(value);
     }
 
+    // 按类型写入任意 CDR 基本类型（整数、浮点）
+    template<typename T>
+    void serialize_primitive(T value) {
+        static_assert(is_cdr_primitive<T>::value, "serialize_primitive 只支持整数和浮点类型");
+        align(cdr_alignment<T>());
+        write_value(value);
+    }
+
     // ========================================
     // 写入复杂类型
     // ========================================
@@ -99,65 +273,317 @@ public:
 
         // length 占 4 字节，存储的是字符串长度
         // 这样写是将 length 作为 uint32_t 写入缓存，占用 4 字节，存储字符串长度
-        serialize_uint32(length); 
-        for(char c : value){
-            buffer_.push_back(static_cast<uint8_t>(c)); // 写入每个字符
-        }
-        buffer_.push_back(0); // 写入空终止符
+        serialize_uint32(length);
+        uint8_t* ptr = claim(length);
+        if(ptr == nullptr) return;
+        std::memcpy(ptr, value.data(), value.size()); // 一次性写入所有字符
+        ptr[value.size()] = 0; // 写入空终止符
     }
 
     // 写入字节数组
     void serialize_array(const std::vector<uint8_t>& value){
         // 数组格式：长度(4字节) + 内容
         serialize_uint32(static_cast<uint32_t>(value.size()));
-        // 向buffer_中插入类型相同的value的begin到end范围内的元素
-        buffer_.insert(buffer_.end(), value.begin(), value.end());
+        if(value.empty()) return;
+        uint8_t* ptr = claim(value.size());
+        if(ptr == nullptr) return;
+        std::memcpy(ptr, value.data(), value.size());
+    }
+
+    // 写入基本类型序列：长度(4字节) + 对齐 + 连续的元素
+    // 只对齐一次、只扩容一次，然后整块复制；
+    // 字节序不同时用批量翻转（SIMD）代替逐个元素处理
+    template<typename T>
+    void serialize_sequence(const T* values, size_t count){
+        static_assert(is_cdr_primitive<T>::value, "serialize_sequence 只支持整数和浮点类型");
+        serialize_uint32(static_cast<uint32_t>(count));
+        serialize_primitive_array(values, count);
+    }
+
+    template<typename T>
+    void serialize_sequence(const std::vector<T>& values){
+        serialize_sequence(values.data(), values.size());
+    }
+
+    // 写入定长数组（CDR 数组没有长度前缀）：对齐一次 + 整块复制
+    template<typename T>
+    void serialize_primitive_array(const T* values, size_t count){
+        static_assert(is_cdr_primitive<T>::value, "serialize_primitive_array 只支持整数和浮点类型");
+        if(count == 0) return;
+        align(cdr_alignment<T>());
+        uint8_t* dst = claim(count * sizeof(T));
+        if(dst == nullptr) return;
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(values);
+        if constexpr (Policy::swap && sizeof(T) > 1){
+            byte_swap_copy(dst, src, count, sizeof(T));
+        }
+        else{
+            std::memcpy(dst, src, count * sizeof(T));
+        }
+    }
+
+    // 写入注册了类型支持的结构体（见 cdr_type_support.hpp）
+    template<typename T>
+    void serialize_type(const T& value){
+        cdr_serialize(*this, value);
     }
 
 private:
-    // 选择 uint8_t 作为缓存类型有以下几个重要原因：核心原因：明确的字节语义
-    // uint8_t 保证：正好 1 字节（8位）、无符号（0-255）、平台无关的大小
-    std::vector<uint8_t> buffer_; // 底层缓冲区
-    bool swap_bytes_ = false; // 是否需要字节序转换
+    uint8_t* claim(size_t n){
+        if constexpr (Checked){
+            return reserve(n);
+        }
+        else{
+            return reserve_unchecked(n);
+        }
+    }
 
+    // CDR 的对齐是相对于封装头之后的位置计算的，不是缓冲区的绝对地址
     void align(size_t alignment){
-        size_t current_pos = buffer_.size(); // buffer_当前的下一个写入位置
+        size_t current_pos = size_ - origin_; // 当前的下一个写入位置
         size_t padding = (alignment - (current_pos % alignment)) % alignment; // 计算对其位置
-        for(size_t i = 0; i < padding; ++i){
-            buffer_.push_back(0); // 填充对齐字节
+        if(padding == 0) return;
+        uint8_t* ptr = claim(padding);
+        if(ptr != nullptr){
+            std::memset(ptr, 0, padding); // 填充对齐字节
         }
     }
 
     // 模板函数：写入任意类型
     template<typename T>
     void write_value(T value){
+        uint8_t* dst = claim(sizeof(T));
+        if(dst == nullptr) return;
+
+        // 是否需要大小端转换在编译期就确定了
+        if constexpr (Policy::swap){
+            value = byte_swap_value(value);
+        }
+        // 把任何类型的内存看作字节数组直接写入缓存
+        std::memcpy(dst, &value, sizeof(T));
+    }
+};
+
+// ============================================================
+// CDR 大小计算器
+// 与序列化器的接口一一对应，但只累计字节数（含对齐填充），不写入任何数据。
+// 用法：先用计算器把消息"写"一遍得到确切大小，按这个大小一次分配，
+// 再用不检查容量的序列化器写入：
+//
+//     CdrSizeCalculator calc;
+//     calc.serialize_encapsulation();
+//     calc.serialize_uint32(id);
+//     calc.serialize_string(name);
+//     CdrPresizedSerializerLE ser(calc.size());
+//     ser.serialize_encapsulation(); ...
+//
+// 知道每个样本的大小之后，也可以提前决定一个数据报里能放下多少样本
+// ============================================================
+class CdrSizeCalculator{
+public:
+    CdrSizeCalculator() = default;
+
+    // 从已有的写入位置继续计算（例如接在 RTPS 消息已有的内容之后）
+    explicit CdrSizeCalculator(size_t initial_size) : size_(initial_size) {}
+
+    // 累计的总字节数
+    size_t size() const { return size_; }
+
+    // 相对封装头之后的位置（CDR 对齐以它为准）
+    size_t offset() const { return size_ - origin_; }
+
+    void reset(){
+        size_ = 0;
+        origin_ = 0;
+    }
+
+    // 累加不需要对齐的 n 个字节
+    void add_bytes(size_t n) { size_ += n; }
+
+    void serialize_encapsulation(bool parameter_list = false, uint16_t options = 0){
+        (void)parameter_list;
+        (void)options;
+        size_ += ENCAPSULATION_HEADER_SIZE;
+        origin_ = size_;
+    }
+
+    void serialize_bool(bool) { size_ += 1; }
+    void serialize_byte(uint8_t) { size_ += 1; }
+    void serialize_uint16(uint16_t value) { serialize_primitive(value); }
+    void serialize_int16(int16_t value) { serialize_primitive(value); }
+    void serialize_uint32(uint32_t value) { serialize_primitive(value); }
+    void serialize_int32(int32_t value) { serialize_primitive(value); }
+    void serialize_uint64(uint64_t value) { serialize_primitive(value); }
+    void serialize_int64(int64_t value) { serialize_primitive(value); }
+    void serialize_float(float value) { serialize_primitive(value); }
+    void serialize_double(double value) { serialize_primitive(value); }
+
+    template<typename T>
+    void serialize_primitive(T) {
+        static_assert(is_cdr_primitive<T>::value, "serialize_primitive 只支持整数和浮点类型");
+        align(cdr_alignment<T>());
+        size_ += sizeof(T);
+    }
+
+    void serialize_string(const std::string& value){
+        align(4);
+        size_ += 4 + value.size() + 1;
+    }
+
+    void serialize_array(const std::vector<uint8_t>& value){
+        align(4);
+        size_ += 4 + value.size();
+    }
+
+    template<typename T>
+    void serialize_sequence(const T* values, size_t count){
+        align(4);
+        size_ += 4;
+        serialize_primitive_array(values, count);
+    }
+
+    template<typename T>
+    void serialize_sequence(const std::vector<T>& values){
+        serialize_sequence(values.data(), values.size());
+    }
 
-        // 这里是强制类型转换，将 value 的地址解释为 uint8_t 数组，
-        // 把任何类型的内存看作字节数组，这样好存入缓存中
-        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&value);
+    template<typename T>
+    void serialize_primitive_array(const T*, size_t count){
+        static_assert(is_cdr_primitive<T>::value, "serialize_primitive_array 只支持整数和浮点类型");
+        if(count == 0) return;
+        align(cdr_alignment<T>());
+        size_ += count * sizeof(T);
+    }
 
-        // 是否需要打小端转换
-        if(swap_bytes_){
-            for(size_t i = 0; i < sizeof(T); ++i){
-                buffer_.push_back(ptr[sizeof(T) - 1 - i]); // 将 value 的字节你许下写入缓存
-            }
+    // 注册了类型支持的结构体（见 cdr_type_support.hpp）
+    template<typename T>
+    void serialize_type(const T& value){
+        cdr_measure(*this, value);
+    }
+
+private:
+    size_t size_ = 0;
+    size_t origin_ = 0; // 对齐的起点（封装头之后的位置）
+
+    void align(size_t alignment){
+        size_t current_pos = size_ - origin_;
+        size_ += (alignment - (current_pos % alignment)) % alignment;
+    }
+};
+
+// ============================================================
+// CDR 序列视图：指向线上数据的基本类型序列，不复制
+// 数据在缓冲区里不一定按 T 对齐，字节序也可能与本机不同，
+// 所以按下标读取时用 memcpy + 按需翻转；需要整块数据时用 copy_to()
+// ============================================================
+template<typename T, typename Policy>
+class CdrSequenceView{
+public:
+    CdrSequenceView() = default;
+
+    CdrSequenceView(const uint8_t* data, size_t count) : data_(data), count_(count) {}
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // 原始字节（线上格式）
+    ConstByteSpan bytes() const { return ConstByteSpan(data_, count_ * sizeof(T)); }
+
+    T operator[](size_t index) const {
+        T value;
+        std::memcpy(&value, data_ + index * sizeof(T), sizeof(T));
+        if constexpr (Policy::swap) {
+            value = byte_swap_value(value);
         }
-        else{
-            // 直接写入
-            for(size_t i = 0; i < sizeof(T); ++i){
-                buffer_.push_back(ptr[i]);
-            }
+        return value;
+    }
+
+    // 字节序与本机相同且地址按 T 对齐时，可以直接当作 T 数组访问
+    bool is_contiguous() const {
+        return !Policy::swap && reinterpret_cast<uintptr_t>(data_) % alignof(T) == 0;
+    }
+
+    // 直接访问的视图，is_contiguous() 为 false 时返回空视图
+    Span<const T> span() const {
+        if (!is_contiguous()) return Span<const T>();
+        return Span<const T>(reinterpret_cast<const T*>(data_), count_);
+    }
+
+    // 整块复制到 dst（至少 size() 个元素），需要时批量翻转字节序
+    void copy_to(T* dst) const {
+        if constexpr (Policy::swap && sizeof(T) > 1) {
+            byte_swap_copy(reinterpret_cast<uint8_t*>(dst), data_, count_, sizeof(T));
+        }
+        else {
+            std::memcpy(dst, data_, count_ * sizeof(T));
         }
     }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t count_ = 0;
 };
 
 // ============================================================
 // CDR 反序列化器
 // 负责从字节流读取数据
+// 反序列化器不拥有数据，只保存输入缓冲区的视图（例如直接指向接收缓冲区），
+// 构造时不会分配内存或复制数据
+//
+// 模板参数 Policy 是数据的字节序。收到的数据字节序由封装头决定，
+// 用 decode_cdr_payload() 读取封装头后再选择对应的实例，
+// 每个缓冲区只判断一次字节序
 // ============================================================
-class CdrDeserializer{
+template<typename Policy>
+class BasicCdrDeserializer{
 public:
-    CdrDeserializer(const std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+    // 只保存视图，不复制输入数据：调用方要保证缓冲区在反序列化期间一直有效
+    BasicCdrDeserializer(ConstByteSpan buffer) : buffer_(buffer) {}
+
+    BasicCdrDeserializer(const uint8_t* data, size_t size) : buffer_(data, size) {}
+
+    BasicCdrDeserializer(const std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+    // 禁止绑定到临时 vector，否则视图会立即悬空
+    BasicCdrDeserializer(std::vector<uint8_t>&&) = delete;
+
+    static constexpr CdrEndian endian() { return Policy::endian; }
+
+    // ========================================
+    // 封装头
+    // ========================================
+
+    // 读取 4 字节封装头，之后的字段以封装头之后的位置为起点对齐
+    // 封装类型未知，或者字节序与 Policy 不一致时返回 false
+    bool deserialize_encapsulation(){
+        if(pos_ + ENCAPSULATION_HEADER_SIZE > buffer_.size()) return false;
+        uint16_t id = static_cast<uint16_t>((buffer_[pos_] << 8) | buffer_[pos_ + 1]);
+        uint16_t options = static_cast<uint16_t>((buffer_[pos_ + 2] << 8) | buffer_[pos_ + 3]);
+        EncapsulationHeader header(static_cast<EncapsulationKind>(id), options);
+        if(!header.is_valid() || header.endian() != Policy::endian) return false;
+        header_ = header;
+        pos_ += ENCAPSULATION_HEADER_SIZE;
+        origin_ = pos_;
+        return true;
+    }
+
+    // 最近一次读到的封装头
+    const EncapsulationHeader& encapsulation() const { return header_; }
+
+    // 当前读取位置和剩余字节数
+    size_t position() const { return pos_; }
+    size_t remaining() const { return pos_ < buffer_.size() ? buffer_.size() - pos_ : 0; }
+
+    // 相对封装头之后的读取位置（CDR 对齐以它为准）
+    size_t offset() const { return pos_ - origin_; }
+
+    // 不对齐地取出 n 个字节，返回数据位置（剩余不足时返回 nullptr）
+    const uint8_t* consume_bytes(size_t n){
+        if(n > remaining()) return nullptr;
+        const uint8_t* ptr = &buffer_[pos_];
+        pos_ += n;
+        return ptr;
+    }
 
     // ========================================
     // 读取基本类型
@@ -204,6 +630,24 @@ public:
         return read_value(value);
     }
 
+    bool deserialize_float(float& value) {
+        align(4);
+        return read_value(value);
+    }
+
+    bool deserialize_double(double& value) {
+        align(8);
+        return read_value(value);
+    }
+
+    // 按类型读取任意 CDR 基本类型（整数、浮点）
+    template<typename T>
+    bool deserialize_primitive(T& value) {
+        static_assert(is_cdr_primitive<T>::value, "deserialize_primitive 只支持整数和浮点类型");
+        align(cdr_alignment<T>());
+        return read_value(value);
+    }
+
     // ========================================
     // 读取复杂类型
     // ========================================
@@ -211,13 +655,13 @@ public:
     bool deserialize_string(std::string& value) {
         uint32_t length;
         if (!deserialize_uint32(length)) return false;
-        
+
         if (length == 0) {
             value = "";
             return true;
         }
 
-        if (pos_ + length > buffer_.size()) return false; // 越界检查
+        if (length > remaining()) return false; // 越界检查
 
         // 读取字符串内容（减去最后的空终止符）
         value.assign(reinterpret_cast<const char*>(&buffer_[pos_]), length - 1); // 字符串赋值
@@ -225,33 +669,144 @@ public:
         return true;
     }
 
+    // 读取基本类型序列：先检查剩余长度，再一次性分配并整块复制
+    template<typename T>
+    bool deserialize_sequence(std::vector<T>& values){
+        static_assert(is_cdr_primitive<T>::value, "deserialize_sequence 只支持整数和浮点类型");
+        uint32_t count;
+        if (!deserialize_uint32(count)) return false;
+        if (count == 0) {
+            values.clear();
+            return true;
+        }
+        align(cdr_alignment<T>());
+        // 先用除法判断，避免 count * sizeof(T) 溢出
+        if (pos_ > buffer_.size() || count > (buffer_.size() - pos_) / sizeof(T)) return false;
+
+        values.resize(count);
+        return deserialize_primitive_array(values.data(), count);
+    }
+
+    // 读取定长数组（没有长度前缀）：对齐一次 + 整块复制
+    template<typename T>
+    bool deserialize_primitive_array(T* values, size_t count){
+        static_assert(is_cdr_primitive<T>::value, "deserialize_primitive_array 只支持整数和浮点类型");
+        if (count == 0) return true;
+        align(cdr_alignment<T>());
+        if (pos_ > buffer_.size() || count > (buffer_.size() - pos_) / sizeof(T)) return false;
+
+        uint8_t* dst = reinterpret_cast<uint8_t*>(values);
+        if constexpr (Policy::swap && sizeof(T) > 1) {
+            byte_swap_copy(dst, &buffer_[pos_], count, sizeof(T));
+        }
+        else {
+            std::memcpy(dst, &buffer_[pos_], count * sizeof(T));
+        }
+        pos_ += count * sizeof(T);
+        return true;
+    }
+
+    // 读取注册了类型支持的结构体（见 cdr_type_support.hpp）
+    template<typename T>
+    bool deserialize_type(T& value){
+        return cdr_deserialize(*this, value);
+    }
+
+    // ========================================
+    // 零拷贝读取：返回指向原始数据的视图
+    // 视图的生命周期与输入缓冲区相同
+    // ========================================
+
+    // 字符串视图（不包含空终止符）
+    bool deserialize_string_view(std::string_view& value) {
+        uint32_t length;
+        if (!deserialize_uint32(length)) return false;
+
+        if (length == 0) {
+            value = std::string_view();
+            return true;
+        }
+
+        if (length > remaining()) return false; // 越界检查
+
+        value = std::string_view(reinterpret_cast<const char*>(&buffer_[pos_]), length - 1);
+        pos_ += length;
+        return true;
+    }
+
+    // 基本类型序列视图：只做长度检查，元素在访问时才按需翻转字节序
+    template<typename T>
+    bool deserialize_sequence_view(CdrSequenceView<T, Policy>& values){
+        static_assert(is_cdr_primitive<T>::value, "deserialize_sequence_view 只支持整数和浮点类型");
+        uint32_t count;
+        if (!deserialize_uint32(count)) return false;
+        if (count == 0) {
+            values = CdrSequenceView<T, Policy>();
+            return true;
+        }
+        align(cdr_alignment<T>());
+        if (pos_ > buffer_.size() || count > (buffer_.size() - pos_) / sizeof(T)) return false;
+
+        values = CdrSequenceView<T, Policy>(&buffer_[pos_], count);
+        pos_ += count * sizeof(T);
+        return true;
+    }
+
 private:
-    std::vector<uint8_t> buffer_;
-    size_t pos_ = 0; // 当前读取位置
-    bool swap_bytes_ = false; // 是否需要字节序转换
+    ConstByteSpan buffer_;  // 输入数据的视图（不拥有内存）
+    size_t pos_ = 0;    // 当前读取位置
+    size_t origin_ = 0; // 对齐的起点（封装头之后的位置）
+    EncapsulationHeader header_;
 
     void align(size_t alignment){
-        size_t padding = (alignment - (pos_ % alignment)) % alignment;
+        size_t padding = (alignment - ((pos_ - origin_) % alignment)) % alignment;
         pos_ += padding; // 移动读取位置 跳过填充位
     }
 
     template<typename T>
     bool read_value(T& value){
         if((pos_ + sizeof(T)) > buffer_.size()) return false; // 越界检查
-        if(swap_bytes_){
-            uint8_t* ptr = reinterpret_cast<uint8_t*>(&value);
-
-            for(size_t i = 0; i < sizeof(T); ++i){
-                ptr[i] = buffer_[pos_ + sizeof(T) - 1 - i];
-            }
-        }
-        else{
-            std::memcpy(&value, &buffer_[pos_], sizeof(T));
+        std::memcpy(&value, &buffer_[pos_], sizeof(T));
+        if constexpr (Policy::swap){
+            value = byte_swap_value(value);
         }
         pos_ += sizeof(T); // 移动读取位置
         return true;
     }
 };
 
+// 默认使用本机字节序（没有封装头的内部数据，例如同一进程内的缓冲区）
+using CdrSerializer = BasicCdrSerializer<NativeEndianPolicy>;
+using CdrDeserializer = BasicCdrDeserializer<NativeEndianPolicy>;
+
+// 指定字节序的版本，用于生成/解析网络上的数据
+using CdrSerializerBE = BasicCdrSerializer<BigEndianPolicy>;
+using CdrSerializerLE = BasicCdrSerializer<LittleEndianPolicy>;
+
+// 不检查容量的版本：缓冲区必须已经按 CdrSizeCalculator 的结果分配好
+using CdrPresizedSerializer = BasicCdrSerializer<NativeEndianPolicy, false>;
+using CdrPresizedSerializerBE = BasicCdrSerializer<BigEndianPolicy, false>;
+using CdrPresizedSerializerLE = BasicCdrSerializer<LittleEndianPolicy, false>;
+using CdrDeserializerBE = BasicCdrDeserializer<BigEndianPolicy>;
+using CdrDeserializerLE = BasicCdrDeserializer<LittleEndianPolicy>;
+
+// 读取带封装头的序列化数据：
+// 先解析封装头得到对端的字节序，再用对应字节序的反序列化器调用 decode(deserializer)
+// decode 是一个泛型可调用对象（例如 [&](auto& d){ ... }），返回 bool
+// 封装头无效时返回 false，不会调用 decode
+template<typename Decoder>
+bool decode_cdr_payload(ConstByteSpan payload, Decoder&& decode){
+    if(payload.size() < ENCAPSULATION_HEADER_SIZE) return false;
+    // 封装头第 2 个字节的最低位就是字节序标志
+    if(payload[1] & 0x01){
+        CdrDeserializerLE deserializer(payload);
+        if(!deserializer.deserialize_encapsulation()) return false;
+        return decode(deserializer);
+    }
+    CdrDeserializerBE deserializer(payload);
+    if(!deserializer.deserialize_encapsulation()) return false;
+    return decode(deserializer);
+}
+
 } // namespace rtps
-} // namespace tinydds
\ No newline at end of file
+} // namespace tinydds
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tinydds{
+namespace rtps{
+
+// ============================================================
+// 字节序
+// ============================================================
+enum class CdrEndian : uint8_t{
+    BIG_ENDIAN_ORDER = 0,
+    LITTLE_ENDIAN_ORDER = 1
+};
+
+// 本机字节序（编译期确定）
+constexpr CdrEndian native_endian(){
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return CdrEndian::BIG_ENDIAN_ORDER;
+#else
+    return CdrEndian::LITTLE_ENDIAN_ORDER;
+#endif
+}
+
+// ============================================================
+// 字节序策略：作为序列化器/反序列化器的模板参数
+// 是否需要翻转字节在编译期就确定了，写入/读取每个字段时没有运行时分支
+// ============================================================
+template<CdrEndian E>
+struct EndianPolicy{
+    static constexpr CdrEndian endian = E;
+    static constexpr bool swap = (E != native_endian()); // 与本机不同才需要翻转
+};
+
+using BigEndianPolicy = EndianPolicy<CdrEndian::BIG_ENDIAN_ORDER>;
+using LittleEndianPolicy = EndianPolicy<CdrEndian::LITTLE_ENDIAN_ORDER>;
+using NativeEndianPolicy = EndianPolicy<native_endian()>;
+
+// ============================================================
+// RTPS 序列化数据的封装头（SerializedPayloadHeader，4 字节）
+// 格式：representation identifier(2字节，大端) + representation options(2字节)
+// 之后数据的对齐都以封装头之后的位置为起点计算
+// ============================================================
+enum class EncapsulationKind : uint16_t{
+    CDR_BE = 0x0000,     // 普通 CDR，大端
+    CDR_LE = 0x0001,     // 普通 CDR，小端
+    PL_CDR_BE = 0x0002,  // 参数列表 CDR，大端
+    PL_CDR_LE = 0x0003   // 参数列表 CDR，小端
+};
+
+constexpr size_t ENCAPSULATION_HEADER_SIZE = 4;
+
+// options 的最低两位：序列化数据末尾为了 4 字节对齐补的填充字节数（XTypes 7.6.3.1.2），
+// 读端据此去掉填充，得到原始长度的序列化数据
+constexpr uint16_t ENCAPSULATION_OPTIONS_PADDING_MASK = 0x0003;
+
+struct EncapsulationHeader{
+    EncapsulationKind kind = EncapsulationKind::CDR_LE;
+    uint16_t options = 0;
+
+    EncapsulationHeader() = default;
+
+    EncapsulationHeader(EncapsulationKind k, uint16_t opts = 0) : kind(k), options(opts) {}
+
+    // 根据字节序和是否参数列表构造
+    static EncapsulationHeader make(CdrEndian endian, bool parameter_list = false, uint16_t opts = 0){
+        uint16_t id = (parameter_list ? 0x0002 : 0x0000) |
+                      (endian == CdrEndian::LITTLE_ENDIAN_ORDER ? 0x0001 : 0x0000);
+        return EncapsulationHeader(static_cast<EncapsulationKind>(id), opts);
+    }
+
+    // 最低位表示字节序：1 为小端，0 为大端
+    CdrEndian endian() const{
+        return (static_cast<uint16_t>(kind) & 0x0001) ? CdrEndian::LITTLE_ENDIAN_ORDER
+                                                      : CdrEndian::BIG_ENDIAN_ORDER;
+    }
+
+    bool is_parameter_list() const{
+        return (static_cast<uint16_t>(kind) & 0x0002) != 0;
+    }
+
+    // 是否是已知的封装类型
+    bool is_valid() const{
+        return static_cast<uint16_t>(kind) <= 0x0003;
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tinydds/rtps/cdr_type_support.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// CDR 类型的运行期描述
+//
+// 由 TINYDDS_CDR_TYPE 注册的字段列表在编译期生成（全部是常量，不分配内存），
+// 给需要在运行期按名字找字段、在序列化数据上跳过字段的代码使用（例如内容过滤）。
+// 描述的是 CDR 编码的形状，不是内存布局
+// ============================================================
+enum class CdrFieldKind : uint8_t{
+    BOOL,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT32,
+    FLOAT64,
+    ENUM,      // 按 uint32 编码
+    STRING,
+    SEQUENCE,  // uint32 长度 + 元素
+    ARRAY,     // 定长，没有长度字段
+    STRUCT
+};
+
+struct CdrMemberDesc;
+
+struct CdrTypeDesc{
+    CdrFieldKind kind;
+    const CdrTypeDesc* element = nullptr;   // SEQUENCE / ARRAY 的元素类型
+    size_t count = 0;                       // ARRAY 的元素个数
+    const CdrMemberDesc* members = nullptr; // STRUCT 的字段
+    size_t member_count = 0;
+    const char* name = nullptr;             // STRUCT 的类型名
+
+    // 基本类型（整数、浮点、bool、枚举）的编码大小，其他类型返回 0
+    constexpr size_t primitive_size() const {
+        switch(kind){
+        case CdrFieldKind::BOOL:
+        case CdrFieldKind::INT8:
+        case CdrFieldKind::UINT8: return 1;
+        case CdrFieldKind::INT16:
+        case CdrFieldKind::UINT16: return 2;
+        case CdrFieldKind::INT32:
+        case CdrFieldKind::UINT32:
+        case CdrFieldKind::FLOAT32:
+        case CdrFieldKind::ENUM: return 4;
+        case CdrFieldKind::INT64:
+        case CdrFieldKind::UINT64:
+        case CdrFieldKind::FLOAT64: return 8;
+        default: return 0;
+        }
+    }
+
+    constexpr bool is_primitive() const { return primitive_size() != 0; }
+
+    // 按名字找字段（只看这一层），找不到返回 nullptr
+    const CdrMemberDesc* find_member(const std::string& member_name) const;
+};
+
+struct CdrMemberDesc{
+    const char* name;
+    const CdrTypeDesc* type;
+};
+
+namespace detail{
+
+template<typename M>
+constexpr CdrTypeDesc make_type_desc();
+
+} // namespace detail
+
+// 类型 M 的描述（编译期常量）
+template<typename M>
+inline constexpr CdrTypeDesc cdr_type_desc_v = detail::make_type_desc<M>();
+
+namespace detail{
+
+template<typename T, typename... F, size_t... I>
+constexpr std::array<CdrMemberDesc, sizeof...(F)> make_member_descs(CdrFieldList<F...>*, std::index_sequence<I...>){
+    return {{CdrMemberDesc{CdrTypeSupport<T>::field_names[I], &cdr_type_desc_v<typename F::type>}...}};
+}
+
+template<typename T>
+inline constexpr auto cdr_member_descs_v = make_member_descs<T>(
+    static_cast<cdr_fields_t<T>*>(nullptr), std::make_index_sequence<cdr_fields_t<T>::count>());
+
+template<typename M>
+constexpr CdrFieldKind primitive_kind(){
+    if constexpr (std::is_floating_point<M>::value){
+        return sizeof(M) == 4 ? CdrFieldKind::FLOAT32 : CdrFieldKind::FLOAT64;
+    }
+    else if constexpr (std::is_signed<M>::value){
+        return sizeof(M) == 1 ? CdrFieldKind::INT8 : sizeof(M) == 2 ? CdrFieldKind::INT16
+             : sizeof(M) == 4 ? CdrFieldKind::INT32 : CdrFieldKind::INT64;
+    }
+    else{
+        return sizeof(M) == 1 ? CdrFieldKind::UINT8 : sizeof(M) == 2 ? CdrFieldKind::UINT16
+             : sizeof(M) == 4 ? CdrFieldKind::UINT32 : CdrFieldKind::UINT64;
+    }
+}
+
+template<typename M>
+constexpr CdrTypeDesc make_type_desc(){
+    if constexpr (std::is_same<M, bool>::value){
+        return CdrTypeDesc{CdrFieldKind::BOOL};
+    }
+    else if constexpr (is_cdr_primitive<M>::value){
+        return CdrTypeDesc{primitive_kind<M>()};
+    }
+    else if constexpr (std::is_enum<M>::value){
+        return CdrTypeDesc{CdrFieldKind::ENUM};
+    }
+    else if constexpr (std::is_same<M, std::string>::value){
+        return CdrTypeDesc{CdrFieldKind::STRING};
+    }
+    else if constexpr (is_std_vector<M>::value){
+        return CdrTypeDesc{CdrFieldKind::SEQUENCE, &cdr_type_desc_v<typename M::value_type>};
+    }
+    else if constexpr (is_std_array<M>::value){
+        return CdrTypeDesc{CdrFieldKind::ARRAY, &cdr_type_desc_v<typename M::value_type>, std::tuple_size<M>::value};
+    }
+    else{
+        static_assert(has_cdr_type_support<M>::value, "字段类型没有 CDR 类型支持，请用 TINYDDS_CDR_TYPE 注册");
+        return CdrTypeDesc{CdrFieldKind::STRUCT, nullptr, 0, cdr_member_descs_v<M>.data(),
+                           cdr_member_descs_v<M>.size(), CdrTypeSupport<M>::name};
+    }
+}
+
+} // namespace detail
+
+inline const CdrMemberDesc* CdrTypeDesc::find_member(const std::string& member_name) const {
+    for(size_t i = 0; i < member_count; ++i){
+        if(member_name == members[i].name) return &members[i];
+    }
+    return nullptr;
+}
+
+// ============================================================
+// 在序列化数据上跳过一个 desc 类型的值（不解码、不分配内存）
+// 数据不完整时返回 false
+// ============================================================
+template<typename Policy>
+bool cdr_skip(BasicCdrDeserializer<Policy>& des, const CdrTypeDesc& desc){
+    switch(desc.kind){
+    case CdrFieldKind::BOOL:
+    case CdrFieldKind::INT8:
+    case CdrFieldKind::UINT8: return des.consume_bytes(1) != nullptr;
+    case CdrFieldKind::INT16:
+    case CdrFieldKind::UINT16: { uint16_t v; return des.deserialize_uint16(v); }
+    case CdrFieldKind::INT32:
+    case CdrFieldKind::UINT32:
+    case CdrFieldKind::FLOAT32:
+    case CdrFieldKind::ENUM: { uint32_t v; return des.deserialize_uint32(v); }
+    case CdrFieldKind::INT64:
+    case CdrFieldKind::UINT64:
+    case CdrFieldKind::FLOAT64: { uint64_t v; return des.deserialize_uint64(v); }
+    case CdrFieldKind::STRING: {
+        uint32_t length;
+        return des.deserialize_uint32(length) && des.consume_bytes(length) != nullptr;
+    }
+    case CdrFieldKind::SEQUENCE:
+    case CdrFieldKind::ARRAY: {
+        uint32_t count = static_cast<uint32_t>(desc.count);
+        if(desc.kind == CdrFieldKind::SEQUENCE && !des.deserialize_uint32(count)) return false;
+        if(count == 0) return true;
+        const CdrTypeDesc& element = *desc.element;
+        size_t size = element.primitive_size();
+        if(size != 0 && element.kind != CdrFieldKind::BOOL){
+            // 基本类型元素是连续的：对齐读出第一个，其余整段跳过
+            if(!cdr_skip(des, element)) return false;
+            return static_cast<size_t>(count - 1) <= des.remaining() / size &&
+                   des.consume_bytes(static_cast<size_t>(count - 1) * size) != nullptr;
+        }
+        if(count > des.remaining()) return false; // 每个元素至少 1 字节
+        for(uint32_t i = 0; i < count; ++i){
+            if(!cdr_skip(des, element)) return false;
+        }
+        return true;
+    }
+    case CdrFieldKind::STRUCT:
+        for(size_t i = 0; i < desc.member_count; ++i){
+            if(!cdr_skip(des, *desc.members[i].type)) return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace rtps
+} // namespace tinydds
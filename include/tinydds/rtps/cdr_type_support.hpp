@@ -0,0 +1,638 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "tinydds/rtps/cdr.hpp"
+
+namespace tinydds{
+namespace rtps{
+
+// ============================================================
+// CDR 类型支持（type support）
+//
+// 用 TINYDDS_CDR_TYPE 描述一个结构体有哪些字段，编译期就能生成它的
+// 序列化/反序列化代码，不用再逐个字段手写 serialize_xxx：
+//
+//     struct Telemetry{
+//         uint32_t id;
+//         double x, y, z;
+//         std::string frame;
+//     };
+//     TINYDDS_CDR_TYPE(Telemetry, id, x, y, z, frame)   // 必须写在全局命名空间
+//
+//     serializer.serialize_type(sample);
+//     deserializer.deserialize_type(sample);
+//
+// 字段按列出的顺序编码（应与声明顺序一致）。支持的字段类型：
+// 整数/浮点、bool、枚举（按 32 位编码）、std::string、std::vector、
+// std::array，以及同样注册了类型支持的嵌套结构体。
+//
+// 连续的定长基本类型字段，如果内存布局和 CDR 布局一致，会合并成一段：
+// 只对齐/检查一次空间，然后按固定偏移直接读写；
+// 中间没有填充且字节序与本机相同时就是一次 memcpy
+// ============================================================
+
+// 类型支持的主模板，由 TINYDDS_CDR_TYPE 特化
+template<typename T>
+struct CdrTypeSupport;
+
+template<typename T, typename = void>
+struct has_cdr_type_support : std::false_type {};
+
+template<typename T>
+struct has_cdr_type_support<T, std::void_t<typename CdrTypeSupport<T>::fields>> : std::true_type {};
+
+// 成员指针的类型拆解：M C::* -> (C, M)
+template<typename P>
+struct cdr_member_pointer_traits;
+
+template<typename C, typename M>
+struct cdr_member_pointer_traits<M C::*>{
+    using owner = C;
+    using type = M;
+};
+
+template<typename T>
+struct is_std_vector : std::false_type {};
+
+template<typename T, typename A>
+struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+template<typename T>
+struct is_std_array : std::false_type {};
+
+template<typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+// "平坦"类型：内存中的表示就是 CDR 的表示（不考虑字节序），可以按偏移直接读写
+// 要求自然对齐（alignof == sizeof），这样内存中的填充和 CDR 的填充一致
+template<typename T>
+struct is_cdr_flat : std::integral_constant<bool,
+    is_cdr_primitive<T>::value && alignof(T) == sizeof(T)> {};
+
+template<typename T, size_t N>
+struct is_cdr_flat<std::array<T, N>> : std::integral_constant<bool,
+    is_cdr_flat<T>::value && N != 0 && sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+template<typename T>
+struct cdr_flat_element { using type = T; };
+
+template<typename T, size_t N>
+struct cdr_flat_element<std::array<T, N>> { using type = T; };
+
+constexpr size_t cdr_align_up(size_t offset, size_t alignment){
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// ============================================================
+// 字段描述：成员指针 + 成员在结构体中的偏移
+// ============================================================
+template<auto Member, size_t Offset>
+struct CdrField{
+    using owner = typename cdr_member_pointer_traits<decltype(Member)>::owner;
+    using type = typename cdr_member_pointer_traits<decltype(Member)>::type;
+
+    static constexpr size_t offset = Offset;
+    static constexpr bool flat = is_cdr_flat<type>::value;
+    static constexpr size_t flat_size = flat ? sizeof(type) : 0;
+    static constexpr size_t flat_align = flat ? sizeof(typename cdr_flat_element<type>::type) : 1;
+
+    static const type& get(const owner& object) { return object.*Member; }
+    static type& get(owner& object) { return object.*Member; }
+};
+
+// ============================================================
+// 字段列表，以及编译期计算的连续段信息
+// 段 [s, e)：字段都是平坦类型，并且每个字段紧跟在前一个之后的第一个对齐位置
+// 只要写入位置对 段内最大对齐 取模等于 offsets[s] 对它取模，
+// CDR 中各字段的相对位置就和内存中完全一样
+// ============================================================
+template<typename... F>
+struct CdrFieldList{
+    static_assert(sizeof...(F) > 0, "CDR 类型至少需要一个字段");
+
+    static constexpr size_t count = sizeof...(F);
+    static constexpr size_t offsets[] = {F::offset...};
+    static constexpr size_t sizes[] = {F::flat_size...};
+    static constexpr size_t aligns[] = {F::flat_align...};
+    static constexpr bool flat[] = {F::flat...};
+
+    template<size_t I>
+    using field = std::tuple_element_t<I, std::tuple<F...>>;
+
+    // 字段 j 能否接在字段 j-1 后面组成连续段
+    static constexpr bool continues(size_t j){
+        return flat[j - 1] && flat[j] &&
+               offsets[j] == cdr_align_up(offsets[j - 1] + sizes[j - 1], aligns[j]);
+    }
+
+    // 从字段 s 开始的连续段的结束位置（不包含）
+    static constexpr size_t run_end(size_t s){
+        size_t e = s + 1;
+        while(e < count && continues(e)) ++e;
+        return e;
+    }
+
+    static constexpr size_t run_align(size_t s, size_t e){
+        size_t m = 1;
+        for(size_t i = s; i < e; ++i) m = aligns[i] > m ? aligns[i] : m;
+        return m;
+    }
+
+    static constexpr size_t run_bytes(size_t s, size_t e){
+        return offsets[e - 1] + sizes[e - 1] - offsets[s];
+    }
+
+    // 段内没有填充字节
+    static constexpr bool run_packed(size_t s, size_t e){
+        size_t total = 0;
+        for(size_t i = s; i < e; ++i) total += sizes[i];
+        return total == run_bytes(s, e);
+    }
+};
+
+namespace detail{
+
+template<typename T>
+using cdr_fields_t = typename CdrTypeSupport<T>::fields;
+
+// ========================================
+// 平坦字段按偏移直接读写
+// ========================================
+template<typename Policy, typename M>
+inline void store_flat(uint8_t* dst, const M& value){
+    using E = typename cdr_flat_element<M>::type;
+    if constexpr (Policy::swap && sizeof(E) > 1){
+        byte_swap_copy(dst, reinterpret_cast<const uint8_t*>(&value), sizeof(M) / sizeof(E), sizeof(E));
+    }
+    else{
+        std::memcpy(dst, &value, sizeof(M));
+    }
+}
+
+template<typename Policy, typename M>
+inline void load_flat(const uint8_t* src, M& value){
+    using E = typename cdr_flat_element<M>::type;
+    if constexpr (Policy::swap && sizeof(E) > 1){
+        byte_swap_copy(reinterpret_cast<uint8_t*>(&value), src, sizeof(M) / sizeof(E), sizeof(E));
+    }
+    else{
+        std::memcpy(&value, src, sizeof(M));
+    }
+}
+
+// ========================================
+// 单个成员的编码/解码
+// ========================================
+template<typename Policy, bool Checked, typename M>
+void encode_member(BasicCdrSerializer<Policy, Checked>& ser, const M& value);
+
+template<typename Policy, typename M>
+bool decode_member(BasicCdrDeserializer<Policy>& des, M& value);
+
+template<typename Policy, bool Checked, typename T>
+void encode_struct(BasicCdrSerializer<Policy, Checked>& ser, const T& value);
+
+template<typename Policy, typename T>
+bool decode_struct(BasicCdrDeserializer<Policy>& des, T& value);
+
+template<typename Policy, bool Checked, typename M>
+void encode_member(BasicCdrSerializer<Policy, Checked>& ser, const M& value){
+    if constexpr (std::is_same<M, bool>::value){
+        ser.serialize_bool(value);
+    }
+    else if constexpr (is_cdr_primitive<M>::value){
+        ser.serialize_primitive(value);
+    }
+    else if constexpr (std::is_enum<M>::value){
+        ser.serialize_uint32(static_cast<uint32_t>(value));
+    }
+    else if constexpr (std::is_same<M, std::string>::value){
+        ser.serialize_string(value);
+    }
+    else if constexpr (is_std_vector<M>::value){
+        using E = typename M::value_type;
+        static_assert(!std::is_same<E, bool>::value, "不支持 std::vector<bool>");
+        if constexpr (is_cdr_primitive<E>::value){
+            ser.serialize_sequence(value);
+        }
+        else{
+            ser.serialize_uint32(static_cast<uint32_t>(value.size()));
+            for(const E& element : value) encode_member(ser, element);
+        }
+    }
+    else if constexpr (is_std_array<M>::value){
+        using E = typename M::value_type;
+        if constexpr (is_cdr_primitive<E>::value){
+            ser.serialize_primitive_array(value.data(), value.size());
+        }
+        else{
+            for(const E& element : value) encode_member(ser, element);
+        }
+    }
+    else{
+        static_assert(has_cdr_type_support<M>::value, "字段类型没有 CDR 类型支持，请用 TINYDDS_CDR_TYPE 注册");
+        encode_struct(ser, value);
+    }
+}
+
+template<typename Policy, typename M>
+bool decode_member(BasicCdrDeserializer<Policy>& des, M& value){
+    if constexpr (std::is_same<M, bool>::value){
+        return des.deserilalizer_bool(value);
+    }
+    else if constexpr (is_cdr_primitive<M>::value){
+        return des.deserialize_primitive(value);
+    }
+    else if constexpr (std::is_enum<M>::value){
+        uint32_t raw;
+        if(!des.deserialize_uint32(raw)) return false;
+        value = static_cast<M>(raw);
+        return true;
+    }
+    else if constexpr (std::is_same<M, std::string>::value){
+        return des.deserialize_string(value);
+    }
+    else if constexpr (is_std_vector<M>::value){
+        using E = typename M::value_type;
+        static_assert(!std::is_same<E, bool>::value, "不支持 std::vector<bool>");
+        if constexpr (is_cdr_primitive<E>::value){
+            return des.deserialize_sequence(value);
+        }
+        else{
+            uint32_t count;
+            if(!des.deserialize_uint32(count)) return false;
+            // 每个元素至少占 1 字节，先检查，防止恶意长度导致巨大的分配
+            if(count > des.remaining()) return false;
+            value.resize(count);
+            for(E& element : value){
+                if(!decode_member(des, element)) return false;
+            }
+            return true;
+        }
+    }
+    else if constexpr (is_std_array<M>::value){
+        using E = typename M::value_type;
+        if constexpr (is_cdr_primitive<E>::value){
+            return des.deserialize_primitive_array(value.data(), value.size());
+        }
+        else{
+            for(E& element : value){
+                if(!decode_member(des, element)) return false;
+            }
+            return true;
+        }
+    }
+    else{
+        static_assert(has_cdr_type_support<M>::value, "字段类型没有 CDR 类型支持，请用 TINYDDS_CDR_TYPE 注册");
+        return decode_struct(des, value);
+    }
+}
+
+// ========================================
+// 逐个字段 [I, E)
+// ========================================
+template<size_t I, size_t E, typename Policy, bool Checked, typename T>
+void encode_each(BasicCdrSerializer<Policy, Checked>& ser, const T& value){
+    if constexpr (I < E){
+        using L = cdr_fields_t<T>;
+        encode_member(ser, L::template field<I>::get(value));
+        encode_each<I + 1, E>(ser, value);
+    }
+}
+
+template<size_t I, size_t E, typename Policy, typename T>
+bool decode_each(BasicCdrDeserializer<Policy>& des, T& value){
+    if constexpr (I < E){
+        using L = cdr_fields_t<T>;
+        if(!decode_member(des, L::template field<I>::get(value))) return false;
+        return decode_each<I + 1, E>(des, value);
+    }
+    return true;
+}
+
+// ========================================
+// 连续段 [I, E)：按固定偏移写入预留好的一段内存
+// ========================================
+template<size_t I, size_t E, size_t Base, typename Policy, typename T>
+void store_run(uint8_t* dst, const T& value){
+    if constexpr (I < E){
+        using F = typename cdr_fields_t<T>::template field<I>;
+        store_flat<Policy>(dst + (F::offset - Base), F::get(value));
+        store_run<I + 1, E, Base, Policy>(dst, value);
+    }
+}
+
+template<size_t I, size_t E, size_t Base, typename Policy, typename T>
+void load_run(const uint8_t* src, T& value){
+    if constexpr (I < E){
+        using F = typename cdr_fields_t<T>::template field<I>;
+        load_flat<Policy>(src + (F::offset - Base), F::get(value));
+        load_run<I + 1, E, Base, Policy>(src, value);
+    }
+}
+
+template<size_t I, typename Policy, bool Checked, typename T>
+void encode_fields(BasicCdrSerializer<Policy, Checked>& ser, const T& value){
+    using L = cdr_fields_t<T>;
+    if constexpr (I < L::count){
+        constexpr size_t E = L::run_end(I);
+        if constexpr (E - I >= 2){
+            constexpr size_t align = L::run_align(I, E);
+            constexpr size_t base = L::offsets[I];
+            constexpr size_t bytes = L::run_bytes(I, E);
+            // 写入位置与内存布局同余时整段写入，否则退回逐个字段
+            if(ser.offset() % align == base % align){
+                uint8_t* dst = ser.reserve_bytes(bytes);
+                if(dst != nullptr){
+                    if constexpr (!Policy::swap && L::run_packed(I, E)){
+                        std::memcpy(dst, reinterpret_cast<const uint8_t*>(&value) + base, bytes);
+                    }
+                    else{
+                        if constexpr (!L::run_packed(I, E)){
+                            std::memset(dst, 0, bytes); // 填充字节写 0，保证输出确定
+                        }
+                        store_run<I, E, base, Policy>(dst, value);
+                    }
+                }
+            }
+            else{
+                encode_each<I, E>(ser, value);
+            }
+            encode_fields<E>(ser, value);
+        }
+        else{
+            encode_member(ser, L::template field<I>::get(value));
+            encode_fields<I + 1>(ser, value);
+        }
+    }
+}
+
+template<size_t I, typename Policy, typename T>
+bool decode_fields(BasicCdrDeserializer<Policy>& des, T& value){
+    using L = cdr_fields_t<T>;
+    if constexpr (I < L::count){
+        constexpr size_t E = L::run_end(I);
+        if constexpr (E - I >= 2){
+            constexpr size_t align = L::run_align(I, E);
+            constexpr size_t base = L::offsets[I];
+            if(des.offset() % align == base % align){
+                const uint8_t* src = des.consume_bytes(L::run_bytes(I, E));
+                if(src == nullptr) return false;
+                load_run<I, E, base, Policy>(src, value);
+            }
+            else if(!decode_each<I, E>(des, value)){
+                return false;
+            }
+            return decode_fields<E>(des, value);
+        }
+        else{
+            if(!decode_member(des, L::template field<I>::get(value))) return false;
+            return decode_fields<I + 1>(des, value);
+        }
+    }
+    return true;
+}
+
+template<typename Policy, bool Checked, typename T>
+void encode_struct(BasicCdrSerializer<Policy, Checked>& ser, const T& value){
+    encode_fields<0>(ser, value);
+}
+
+template<typename Policy, typename T>
+bool decode_struct(BasicCdrDeserializer<Policy>& des, T& value){
+    return decode_fields<0>(des, value);
+}
+
+// ========================================
+// 序列化大小
+// ========================================
+
+// 是否有上界（不含 string / vector）
+template<typename M>
+constexpr bool is_bounded();
+
+template<typename... F>
+constexpr bool all_bounded(CdrFieldList<F...>*){
+    return (is_bounded<typename F::type>() && ...);
+}
+
+template<typename M>
+constexpr bool is_bounded(){
+    if constexpr (std::is_same<M, bool>::value || is_cdr_primitive<M>::value || std::is_enum<M>::value){
+        return true;
+    }
+    else if constexpr (std::is_same<M, std::string>::value || is_std_vector<M>::value){
+        return false;
+    }
+    else if constexpr (is_std_array<M>::value){
+        return is_bounded<typename M::value_type>();
+    }
+    else{
+        static_assert(has_cdr_type_support<M>::value, "字段类型没有 CDR 类型支持，请用 TINYDDS_CDR_TYPE 注册");
+        return all_bounded(static_cast<cdr_fields_t<M>*>(nullptr));
+    }
+}
+
+// 有界类型：从 offset 开始写入后的结束位置（编译期）
+template<typename M>
+constexpr size_t bounded_end(size_t offset);
+
+template<typename... F>
+constexpr size_t fields_bounded_end(size_t offset, CdrFieldList<F...>*){
+    ((offset = bounded_end<typename F::type>(offset)), ...);
+    return offset;
+}
+
+template<typename M>
+constexpr size_t bounded_end(size_t offset){
+    if constexpr (std::is_same<M, bool>::value){
+        return offset + 1;
+    }
+    else if constexpr (is_cdr_primitive<M>::value){
+        return cdr_align_up(offset, cdr_alignment<M>()) + sizeof(M);
+    }
+    else if constexpr (std::is_enum<M>::value){
+        return cdr_align_up(offset, 4) + 4;
+    }
+    else if constexpr (is_std_array<M>::value){
+        using E = typename M::value_type;
+        for(size_t i = 0; i < std::tuple_size<M>::value; ++i) offset = bounded_end<E>(offset);
+        return offset;
+    }
+    else{
+        return fields_bounded_end(offset, static_cast<cdr_fields_t<M>*>(nullptr));
+    }
+}
+
+// 任意类型：按实际内容计算从 offset 开始写入后的结束位置（运行期）
+template<typename M>
+size_t serialized_end(const M& value, size_t offset);
+
+template<typename T, typename... F>
+size_t fields_serialized_end(const T& value, size_t offset, CdrFieldList<F...>*){
+    ((offset = serialized_end(F::get(value), offset)), ...);
+    return offset;
+}
+
+template<typename M>
+size_t serialized_end(const M& value, size_t offset){
+    if constexpr (is_bounded<M>()){
+        (void)value;
+        return bounded_end<M>(offset);
+    }
+    else if constexpr (std::is_same<M, std::string>::value){
+        return cdr_align_up(offset, 4) + 4 + value.size() + 1;
+    }
+    else if constexpr (is_std_vector<M>::value){
+        using E = typename M::value_type;
+        offset = cdr_align_up(offset, 4) + 4;
+        if constexpr (is_cdr_primitive<E>::value){
+            if(value.empty()) return offset;
+            return cdr_align_up(offset, cdr_alignment<E>()) + value.size() * sizeof(E);
+        }
+        else{
+            for(const E& element : value) offset = serialized_end(element, offset);
+            return offset;
+        }
+    }
+    else if constexpr (is_std_array<M>::value){
+        for(const auto& element : value) offset = serialized_end(element, offset);
+        return offset;
+    }
+    else{
+        return fields_serialized_end(value, offset, static_cast<cdr_fields_t<M>*>(nullptr));
+    }
+}
+
+} // namespace detail
+
+// ============================================================
+// 对外接口
+// ============================================================
+
+template<typename Policy, bool Checked, typename T>
+void cdr_serialize(BasicCdrSerializer<Policy, Checked>& serializer, const T& value){
+    detail::encode_member(serializer, value);
+}
+
+template<typename Policy, typename T>
+bool cdr_deserialize(BasicCdrDeserializer<Policy>& deserializer, T& value){
+    return detail::decode_member(deserializer, value);
+}
+
+// CdrSizeCalculator::serialize_type 的实现：按当前对齐位置累加 value 的大小
+template<typename T>
+void cdr_measure(CdrSizeCalculator& calculator, const T& value){
+    calculator.add_bytes(detail::serialized_end(value, calculator.offset()) - calculator.offset());
+}
+
+// 类型是否有上界（不含 string / vector 等变长字段）
+template<typename T>
+constexpr bool is_cdr_bounded(){
+    return detail::is_bounded<T>();
+}
+
+// 有界类型的序列化大小（编译期常量）
+// 按从对齐起点（封装头之后）开始写入计算；从其它位置开始时对齐填充可能不同
+template<typename T>
+constexpr size_t get_serialized_size(){
+    static_assert(is_cdr_bounded<T>(), "变长类型没有编译期大小，请使用 get_serialized_size(value)");
+    return detail::bounded_end<T>(0);
+}
+
+// 内存布局就是本机字节序的 CDR 编码：所有字段都是平坦类型，从偏移 0 开始组成一个没有填充的连续段
+// 这样的对象（去掉结构体末尾的填充）原样就是封装头之后的 CDR 数据，不需要序列化
+template<typename T>
+constexpr bool is_cdr_memcpy_layout(){
+    if constexpr (has_cdr_type_support<T>::value){
+        using L = detail::cdr_fields_t<T>;
+        return L::flat[0] && L::offsets[0] == 0 && L::run_end(0) == L::count && L::run_packed(0, L::count);
+    }
+    else{
+        return false;
+    }
+}
+
+// 任意类型的序列化大小：从 offset 处开始写入 value 需要的字节数
+template<typename T>
+size_t get_serialized_size(const T& value, size_t offset = 0){
+    return detail::serialized_end(value, offset) - offset;
+}
+
+// 生成带封装头的完整序列化数据：
+// 先计算确切大小，只分配一次，然后不检查容量地写入
+template<typename Policy = NativeEndianPolicy, typename T>
+PooledBuffer encode_cdr_payload(const T& value, bool parameter_list = false){
+    size_t size = ENCAPSULATION_HEADER_SIZE + get_serialized_size(value);
+    BasicCdrSerializer<Policy, false> serializer(size);
+    serializer.serialize_encapsulation(parameter_list);
+    cdr_serialize(serializer, value);
+    return serializer.release_buffer();
+}
+
+// 同上，缓冲区从缓冲池中取
+template<typename Policy = NativeEndianPolicy, typename T>
+PooledBuffer encode_cdr_payload(BufferPool& pool, const T& value, bool parameter_list = false){
+    size_t size = ENCAPSULATION_HEADER_SIZE + get_serialized_size(value);
+    BasicCdrSerializer<Policy, false> serializer(pool, size);
+    serializer.serialize_encapsulation(parameter_list);
+    cdr_serialize(serializer, value);
+    return serializer.release_buffer();
+}
+
+} // namespace rtps
+} // namespace tinydds
+
+// ============================================================
+// 注册宏
+// TINYDDS_CDR_TYPE(Type, field1, field2, ...) 最多 16 个字段，必须写在全局命名空间
+// Type 需要是标准布局类型（普通数据结构体），字段偏移用 offsetof 在编译期取得
+// 同时记下字段名（field_names），供按名字访问字段的代码使用（见 cdr_type_info.hpp）
+// ============================================================
+#define TINYDDS_CDR_FIELD_(Type, field) ::tinydds::rtps::CdrField<&Type::field, offsetof(Type, field)>
+#define TINYDDS_CDR_FIELD_NAME_(Type, field) #field
+
+#define TINYDDS_CDR_FOR_EACH_1(M, T, a) M(T, a)
+#define TINYDDS_CDR_FOR_EACH_2(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_1(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_3(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_2(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_4(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_3(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_5(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_4(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_6(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_5(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_7(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_6(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_8(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_7(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_9(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_8(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_10(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_9(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_11(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_10(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_12(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_11(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_13(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_12(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_14(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_13(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_15(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_14(M, T, __VA_ARGS__)
+#define TINYDDS_CDR_FOR_EACH_16(M, T, a, ...) M(T, a), TINYDDS_CDR_FOR_EACH_15(M, T, __VA_ARGS__)
+
+#define TINYDDS_CDR_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define TINYDDS_CDR_COUNT(...) \
+    TINYDDS_CDR_COUNT_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define TINYDDS_CDR_CONCAT_(a, b) a##b
+#define TINYDDS_CDR_CONCAT(a, b) TINYDDS_CDR_CONCAT_(a, b)
+
+#define TINYDDS_CDR_TYPE(Type, ...)                                                              \
+    template<>                                                                                   \
+    struct tinydds::rtps::CdrTypeSupport<Type>{                                                  \
+        static_assert(std::is_standard_layout<Type>::value, #Type " 必须是标准布局类型");        \
+        using fields = ::tinydds::rtps::CdrFieldList<                                            \
+            TINYDDS_CDR_CONCAT(TINYDDS_CDR_FOR_EACH_, TINYDDS_CDR_COUNT(__VA_ARGS__))(           \
+                TINYDDS_CDR_FIELD_, Type, __VA_ARGS__)>;                                         \
+        static constexpr const char* name = #Type;                                              \
+        static constexpr const char* field_names[] = {                                           \
+            TINYDDS_CDR_CONCAT(TINYDDS_CDR_FOR_EACH_, TINYDDS_CDR_COUNT(__VA_ARGS__))(           \
+                TINYDDS_CDR_FIELD_NAME_, Type, __VA_ARGS__)};                                    \
+    }
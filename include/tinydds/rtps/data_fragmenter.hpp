@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tinydds/rtps/message.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+class EntityStatistics;
+
+// DATA_FRAG 消息的头部：RTPS 消息头(20) + 子消息头(4) + DATA_FRAG 的固定字段(32)
+constexpr size_t DATA_FRAG_FIXED_SIZE = 32;
+constexpr size_t DATA_FRAG_MESSAGE_HEADER_SIZE = RTPS_HEADER_SIZE + SUBMESSAGE_HEADER_SIZE + DATA_FRAG_FIXED_SIZE;
+
+// ============================================================
+// FragmentMessage: 一条 DATA_FRAG 消息的分段视图（用于 scatter-gather 发送）
+// parts[0] 是头部，parts[1] 是样本里的一段分片数据，parts[2] 是对齐填充（可能没有）
+// ============================================================
+struct FragmentMessage{
+    static constexpr size_t MAX_PARTS = 3;
+
+    std::array<ConstByteSpan, MAX_PARTS> parts;
+    size_t part_count = 0;
+    uint32_t first_fragment = 0; // 这条消息里的第一个分片号
+    uint32_t fragment_count = 0;
+
+    size_t size() const {
+        size_t total = 0;
+        for(size_t i = 0; i < part_count; ++i) total += parts[i].size();
+        return total;
+    }
+};
+
+// ============================================================
+// DataFragmenter: 把一个大样本切成 DATA_FRAG 消息
+//
+// 每条消息只有头部（几十字节）写在内部缓冲区里，分片数据直接是样本缓冲区的视图：
+// 整个样本序列化一次，之后发送、重传都不再按分片复制，由传输层用 iovec 聚合发送
+// （UdpTransport::send_batch(UdpGatherDatagram)）。
+// 一条消息里放尽量多的连续分片（不超过 max_message_size），分片小时丢一个数据报只损失少量数据，
+// 读端用 NACK_FRAG 只请求缺失的分片，fragment_missing() 只把这些分片重新编成消息。
+//
+// 返回的消息视图在下一次调用 fragment()/fragment_missing() 之前有效；
+// 样本缓冲区在发送完成之前必须有效。不是线程安全的
+// ============================================================
+class DataFragmenter{
+public:
+    // fragment_size: 每个分片的字节数；max_message_size: 每条消息（数据报）的最大字节数
+    explicit DataFragmenter(const GuidPrefix& prefix, size_t fragment_size = 1024, size_t max_message_size = 65000);
+
+    size_t fragment_size() const { return fragment_size_; }
+    size_t fragments_per_message() const { return fragments_per_message_; }
+
+    // 样本一共切成多少个分片
+    uint32_t fragment_count(size_t sample_size) const {
+        return static_cast<uint32_t>((sample_size + fragment_size_ - 1) / fragment_size_);
+    }
+
+    // 按分片号 [first_fragment, last_fragment]（与实际分片数取交集）生成消息，默认是整个样本
+    // 样本超过 4 GB 时返回空
+    Span<const FragmentMessage> fragment(const EntityId& reader_id, const EntityId& writer_id,
+                                         const SequenceNumber& writer_sn, ConstByteSpan payload,
+                                         uint32_t first_fragment = 1, uint32_t last_fragment = UINT32_MAX);
+
+    // 只生成 NACK_FRAG 请求的分片：连续缺失的分片放在同一条消息里
+    Span<const FragmentMessage> fragment_missing(const EntityId& reader_id, const EntityId& writer_id,
+                                                 const SequenceNumber& writer_sn, ConstByteSpan payload,
+                                                 const FragmentNumberSet& missing);
+
+    // 收到的 NACK_FRAG 和重传的分片数记到这里（nullptr 不统计）
+    void set_statistics(EntityStatistics* statistics){ statistics_ = statistics; }
+
+private:
+    // 每条消息的头部在 headers_ 里占的字节数（按 8 字节对齐）
+    static constexpr size_t HEADER_STRIDE = (DATA_FRAG_MESSAGE_HEADER_SIZE + 7) / 8 * 8;
+
+    struct Run{
+        uint32_t first;
+        uint32_t last;
+    };
+
+    GuidPrefix prefix_;
+    size_t fragment_size_;
+    size_t fragments_per_message_;
+    std::vector<uint8_t> headers_;
+    std::vector<FragmentMessage> messages_;
+    std::vector<Run> runs_;
+    EntityStatistics* statistics_ = nullptr;
+
+    // 按 runs_ 生成消息
+    Span<const FragmentMessage> build(const EntityId& reader_id, const EntityId& writer_id,
+                                      const SequenceNumber& writer_sn, ConstByteSpan payload);
+
+    void write_header(uint8_t* out, const EntityId& reader_id, const EntityId& writer_id,
+                      const SequenceNumber& writer_sn, uint32_t first_fragment, uint32_t fragment_count,
+                      uint32_t sample_size, size_t body_size) const;
+};
+
+} // namespace rtps
+} // namespace tinydds
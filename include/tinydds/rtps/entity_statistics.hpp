@@ -0,0 +1,243 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tinydds/rtps/flat_hash_map.hpp"
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/latency_histogram.hpp"
+
+// 统计开关：CMake 选项 TINYDDS_STATISTICS=OFF 时定义为 0，
+// 所有记录函数变成空函数，调用处的 if(statistics_ != nullptr) 也一起被优化掉
+#ifndef TINYDDS_ENABLE_STATISTICS
+#define TINYDDS_ENABLE_STATISTICS 1
+#endif
+
+namespace tinydds {
+namespace rtps {
+
+constexpr bool STATISTICS_ENABLED = TINYDDS_ENABLE_STATISTICS != 0;
+
+// ============================================================
+// StatCounter: 可以多个线程同时写入的计数器
+//
+// 一个实体的统计会被几个线程同时更新（例如发送线程计发出的样本，
+// 收到 ACKNACK 的接收线程计重传），所以 add() 是 relaxed 的 fetch_add，不会丢失计数；
+// 不需要和其他内存操作排序，没有竞争时代价只是一条 lock 前缀的加法。
+// 其他线程随时可以读取（快照），读到的是某个时刻完整的 64 位值
+// ============================================================
+class StatCounter{
+public:
+    void add(uint64_t n = 1){ value_.fetch_add(n, std::memory_order_relaxed); }
+
+    void set(uint64_t value){ value_.store(value, std::memory_order_relaxed); }
+
+    // 保留较大的值（CAS 循环，多个线程同时更新时不会把较大的值覆盖掉）
+    void update_max(uint64_t value){
+        uint64_t current = value_.load(std::memory_order_relaxed);
+        while(value > current && !value_.compare_exchange_weak(current, value, std::memory_order_relaxed)){}
+    }
+
+    uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+// 一个实体的计数（快照和内置统计主题里用的普通结构体）
+struct StatisticsCounters{
+    uint64_t samples_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t samples_received = 0;
+    uint64_t bytes_received = 0;
+    uint64_t retransmits = 0;      // 重传的样本（或分片）数
+    uint64_t nacks_sent = 0;       // 发出的 ACKNACK/NACK_FRAG 中请求了重传的次数
+    uint64_t nacks_received = 0;
+    uint64_t samples_dropped = 0;  // 超出窗口、历史缓存已满、重组时被挤掉的样本
+    uint64_t serialization_ns = 0; // 抽样测量的序列化总耗时
+    uint64_t serializations = 0;   // 抽样测量的序列化次数
+    uint64_t queue_depth = 0;      // 当前队列（历史缓存）深度
+    uint64_t queue_depth_max = 0;
+};
+
+struct StatisticsConfig{
+    bool latency_histograms = true; // 每个实体一个延迟直方图（约 35 KB）
+    uint32_t sample_period = 16;    // 每多少个样本测量一次耗时/延迟（向上取整为 2 的幂）
+};
+
+struct EntityStatisticsSnapshot{
+    GUID guid;
+    StatisticsCounters counters;
+    LatencyHistogram latency; // 精度是桶的精度（相对误差 1/128）
+
+    double mean_serialization_ns() const {
+        return counters.serializations == 0 ? 0.0
+                                            : static_cast<double>(counters.serialization_ns) /
+                                                  static_cast<double>(counters.serializations);
+    }
+};
+
+// ============================================================
+// EntityStatistics: 一个写端/读端（按 GUID）的热路径统计
+//
+// 计数器都是 StatCounter，放在同一个缓存行开始的连续内存里，
+// 记录一个样本只是几次 relaxed 的原子加法。
+// 耗时和延迟按 sample_period 抽样：sample_timing() 返回 true 时调用方才读时钟，
+// 其余样本没有任何计时开销。
+// 记录函数和 snapshot() 都可以在任何线程调用
+// ============================================================
+class alignas(64) EntityStatistics{
+public:
+    explicit EntityStatistics(const GUID& guid, const StatisticsConfig& config = StatisticsConfig());
+
+    EntityStatistics(const EntityStatistics&) = delete;
+    EntityStatistics& operator=(const EntityStatistics&) = delete;
+
+    const GUID& guid() const { return guid_; }
+
+    void on_sample_sent(size_t bytes){
+        if constexpr(STATISTICS_ENABLED){
+            samples_sent_.add();
+            bytes_sent_.add(bytes);
+        }
+    }
+
+    void on_sample_received(size_t bytes){
+        if constexpr(STATISTICS_ENABLED){
+            samples_received_.add();
+            bytes_received_.add(bytes);
+        }
+    }
+
+    void on_retransmit(uint64_t count = 1){
+        if constexpr(STATISTICS_ENABLED) retransmits_.add(count);
+    }
+
+    void on_nack_sent(){
+        if constexpr(STATISTICS_ENABLED) nacks_sent_.add();
+    }
+
+    void on_nack_received(){
+        if constexpr(STATISTICS_ENABLED) nacks_received_.add();
+    }
+
+    void on_sample_dropped(uint64_t count = 1){
+        if constexpr(STATISTICS_ENABLED) samples_dropped_.add(count);
+    }
+
+    void set_queue_depth(size_t depth){
+        if constexpr(STATISTICS_ENABLED){
+            queue_depth_.set(depth);
+            queue_depth_max_.update_max(depth);
+        }
+    }
+
+    // 这一个样本要不要测量耗时/延迟（每 sample_period 个一次）
+    bool sample_timing(){
+        if constexpr(STATISTICS_ENABLED){
+            return (tick_.fetch_add(1, std::memory_order_relaxed) & sample_mask_) == 0;
+        }
+        return false;
+    }
+
+    void record_serialization(uint64_t nanoseconds){
+        if constexpr(STATISTICS_ENABLED){
+            serialization_ns_.add(nanoseconds);
+            serializations_.add();
+        }
+    }
+
+    // 记录一个抽样的延迟（配置里关闭了直方图时忽略）
+    void record_latency(uint64_t nanoseconds){
+        if constexpr(STATISTICS_ENABLED){
+            if(latency_ != nullptr) latency_[LatencyHistogram::bucket_index(nanoseconds)].add();
+        }
+    }
+
+    void snapshot(EntityStatisticsSnapshot& out) const;
+
+private:
+    StatCounter samples_sent_;
+    StatCounter bytes_sent_;
+    StatCounter samples_received_;
+    StatCounter bytes_received_;
+    StatCounter retransmits_;
+    StatCounter nacks_sent_;
+    StatCounter nacks_received_;
+    StatCounter samples_dropped_;
+    StatCounter serialization_ns_;
+    StatCounter serializations_;
+    StatCounter queue_depth_;
+    StatCounter queue_depth_max_;
+
+    std::atomic<uint32_t> tick_{0};
+    uint32_t sample_mask_;
+    GUID guid_;
+    std::unique_ptr<StatCounter[]> latency_; // LatencyHistogram::BUCKET_COUNT 个桶
+};
+
+// 抽样测量一次序列化的耗时（没有轮到抽样或者 statistics 为 nullptr 时不读时钟）：
+//     {
+//         SerializationTimer timer(statistics);
+//         serializer.serialize_type(sample);
+//     }
+class SerializationTimer{
+public:
+    explicit SerializationTimer(EntityStatistics* statistics)
+        : statistics_(statistics != nullptr && statistics->sample_timing() ? statistics : nullptr){
+        if(statistics_ != nullptr) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~SerializationTimer(){
+        if(statistics_ != nullptr){
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            statistics_->record_serialization(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    SerializationTimer(const SerializationTimer&) = delete;
+    SerializationTimer& operator=(const SerializationTimer&) = delete;
+
+private:
+    EntityStatistics* statistics_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// ============================================================
+// StatisticsRegistry: 按 GUID 管理所有实体的统计
+//
+// register_entity() 返回的指针在 unregister_entity() 之前一直有效，
+// 实体把它保存下来，热路径上直接记录，不查表也不加锁；
+// 注册/注销/快照用一把锁保护（都不在热路径上）
+// ============================================================
+class StatisticsRegistry{
+public:
+    explicit StatisticsRegistry(const StatisticsConfig& config = StatisticsConfig()) : config_(config) {}
+
+    // 已经注册过时返回同一个对象
+    EntityStatistics* register_entity(const GUID& guid);
+
+    // 调用方保证之后不再使用这个实体的指针
+    bool unregister_entity(const GUID& guid);
+
+    bool snapshot(const GUID& guid, EntityStatisticsSnapshot& out) const;
+
+    // 所有实体的快照（out 的元素会被复用）
+    void snapshot_all(std::vector<EntityStatisticsSnapshot>& out) const;
+
+    size_t size() const;
+
+private:
+    StatisticsConfig config_;
+    mutable std::mutex mutex_;
+    GuidMap<std::unique_ptr<EntityStatistics>> entities_;
+};
+
+} // namespace rtps
+} // namespace tinydds
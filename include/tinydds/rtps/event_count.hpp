@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tinydds {
+namespace rtps {
+
+// 缓存行大小：生产者和消费者各自修改的变量放在不同的缓存行上，避免伪共享
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+// ============================================================
+// EventCount: 无锁队列的阻塞等待（基于 futex，只在进程内有效）
+//
+// 队列本身不加锁，take() 只是几次原子读写；只有队列空、消费者又想睡眠时才进入内核。
+// 通知方（生产者）在 push 之后调用 notify_all()：没有等待方时只是一次内存屏障和一次读，
+// 不会进行系统调用。
+//
+// 等待方的用法（await() 已经封装好）：
+//     uint32_t key = prepare_wait();   // 先登记为等待方
+//     if(条件已满足){ cancel_wait(); ... }
+//     else wait(key, timeout_ms);      // 登记之后通知方一定能看到，不会丢失唤醒
+// ============================================================
+class EventCount{
+public:
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    uint32_t prepare_wait(){
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    void cancel_wait(){
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    // 在 prepare_wait() 之后还没有通知时睡眠，最多 timeout_ms 毫秒（-1 表示一直等）
+    // 可能被虚假唤醒，调用方要重新检查条件
+    void wait(uint32_t key, int timeout_ms);
+
+    // 条件发生变化（例如 push 了新元素）之后调用
+    void notify_all(){
+        // 与等待方的 prepare_wait() 配对：要么这里看到等待方，要么等待方看到新的元素
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters_.load(std::memory_order_relaxed) == 0) return;
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        wake_all();
+    }
+
+    // 只唤醒一个已经睡眠的等待方（还没睡下的等待方看到代数变化也会返回）
+    // 用于每次只增加一份工作的场合，例如线程池投递一个任务
+    void notify_one(){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters_.load(std::memory_order_relaxed) == 0) return;
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        wake_one();
+    }
+
+    // 反复调用 try_once() 直到它返回 true，中间没有进展时睡眠
+    // 超时返回 false；timeout_ms 为 -1 时一直等
+    template<typename TryFn>
+    bool await(TryFn&& try_once, int timeout_ms){
+        if(try_once()) return true;
+        if(timeout_ms == 0) return false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        for(;;){
+            uint32_t key = prepare_wait();
+            if(try_once()){
+                cancel_wait();
+                return true;
+            }
+            int remaining = -1;
+            if(timeout_ms > 0){
+                // 向上取整，否则不足 1ms 的剩余时间会被当成已经超时
+                auto left = std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if(left <= 0){
+                    cancel_wait();
+                    return try_once();
+                }
+                remaining = static_cast<int>(left);
+            }
+            wait(key, remaining);
+        }
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch_{0}; // 每次通知加一，等待方在它上面 futex 等待
+    std::atomic<uint32_t> waiters_{0};                        // 已登记的等待方数量
+
+    void wake_all();
+    void wake_one();
+};
+
+} // namespace rtps
+} // namespace tinydds
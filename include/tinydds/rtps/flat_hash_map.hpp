@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "tinydds/rtps/guid.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// FlatHashMap: 开放寻址（线性探测）的哈希表
+//
+// 所有元素放在一个连续数组里，容量是 2 的幂，下标 = hash & mask，
+// 冲突时向后找下一个空位；查找时只访问连续的几个槽位，没有链表节点，也没有逐个元素的分配。
+// 删除使用 backward shift（把后面的元素往前挪），不留墓碑，长时间增删后查找也不会变慢。
+//
+// 要求哈希函数的低位分布均匀（GUID 的 std::hash 满足），
+// Key 和 Value 需要可以默认构造和移动。插入或删除会使指向元素的指针失效
+// ============================================================
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap{
+public:
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_t expected){
+        reserve(expected);
+    }
+
+    // 查找，不存在时返回 nullptr
+    Value* find(const Key& key){
+        size_t index;
+        return locate(key, index) ? &entries_[index].second : nullptr;
+    }
+
+    const Value* find(const Key& key) const{
+        size_t index;
+        return locate(key, index) ? &entries_[index].second : nullptr;
+    }
+
+    bool contains(const Key& key) const{
+        size_t index;
+        return locate(key, index);
+    }
+
+    // 插入，key 已存在时不覆盖；返回元素的指针和是否新插入
+    std::pair<Value*, bool> insert(const Key& key, Value value){
+        size_t index;
+        if(locate(key, index)){
+            return {&entries_[index].second, false};
+        }
+        if((size_ + 1) * 4 > capacity() * 3){ // 负载因子不超过 0.75
+            rehash(capacity() == 0 ? 16 : capacity() * 2);
+            locate(key, index);
+        }
+        entries_[index].first = key;
+        entries_[index].second = std::move(value);
+        used_[index] = 1;
+        ++size_;
+        return {&entries_[index].second, true};
+    }
+
+    // 插入或覆盖
+    Value& insert_or_assign(const Key& key, Value value){
+        auto result = insert(key, Value());
+        *result.first = std::move(value);
+        return *result.first;
+    }
+
+    Value& operator[](const Key& key){
+        return *insert(key, Value()).first;
+    }
+
+    // 删除，返回是否存在
+    bool erase(const Key& key){
+        size_t hole;
+        if(!locate(key, hole)) return false;
+        // backward shift：后面探测链上的元素如果可以放到空洞处就往前挪
+        size_t mask = capacity() - 1;
+        size_t next = hole;
+        for(;;){
+            next = (next + 1) & mask;
+            if(!used_[next]) break;
+            size_t home = hasher_(entries_[next].first) & mask;
+            // home 落在 (hole, next] 之间（循环意义上）时元素不能挪
+            bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+            if(stays) continue;
+            entries_[hole] = std::move(entries_[next]);
+            hole = next;
+        }
+        used_[hole] = 0;
+        entries_[hole] = std::pair<Key, Value>(); // 释放值持有的资源
+        --size_;
+        return true;
+    }
+
+    // 按存储顺序遍历：fn(const Key&, Value&)
+    template<typename Fn>
+    void for_each(Fn&& fn){
+        for(size_t i = 0; i < entries_.size(); ++i){
+            if(used_[i]) fn(static_cast<const Key&>(entries_[i].first), entries_[i].second);
+        }
+    }
+
+    template<typename Fn>
+    void for_each(Fn&& fn) const{
+        for(size_t i = 0; i < entries_.size(); ++i){
+            if(used_[i]) fn(entries_[i].first, entries_[i].second);
+        }
+    }
+
+    // 预留至少能放 count 个元素的容量，避免插入过程中 rehash
+    void reserve(size_t count){
+        size_t needed = 16;
+        while(needed * 3 < count * 4){
+            needed *= 2;
+        }
+        if(needed > capacity()){
+            rehash(needed);
+        }
+    }
+
+    void clear(){
+        for(size_t i = 0; i < entries_.size(); ++i){
+            if(used_[i]){
+                entries_[i] = std::pair<Key, Value>();
+                used_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return entries_.size(); }
+
+private:
+    std::vector<std::pair<Key, Value>> entries_;
+    std::vector<uint8_t> used_;
+    size_t size_ = 0;
+    Hash hasher_;
+
+    // 找到 key 时返回 true 并给出下标；否则返回 false，index 为应当插入的空位
+    bool locate(const Key& key, size_t& index) const{
+        if(entries_.empty()){
+            index = 0;
+            return false;
+        }
+        size_t mask = capacity() - 1;
+        size_t i = hasher_(key) & mask;
+        while(used_[i]){
+            if(entries_[i].first == key){
+                index = i;
+                return true;
+            }
+            i = (i + 1) & mask;
+        }
+        index = i;
+        return false;
+    }
+
+    void rehash(size_t new_capacity){
+        std::vector<std::pair<Key, Value>> old_entries(new_capacity);
+        std::vector<uint8_t> old_used(new_capacity, 0);
+        old_entries.swap(entries_);
+        old_used.swap(used_);
+        size_t mask = new_capacity - 1;
+        for(size_t i = 0; i < old_entries.size(); ++i){
+            if(!old_used[i]) continue;
+            size_t j = hasher_(old_entries[i].first) & mask;
+            while(used_[j]){
+                j = (j + 1) & mask;
+            }
+            entries_[j] = std::move(old_entries[i]);
+            used_[j] = 1;
+        }
+    }
+};
+
+// 参与者和端点注册表
+template<typename Value>
+using GuidMap = FlatHashMap<GUID, Value>;
+
+template<typename Value>
+using GuidPrefixMap = FlatHashMap<GuidPrefix, Value>;
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tinydds/rtps/message.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+class EntityStatistics;
+
+// ============================================================
+// FragmentAssembler: 读端针对一个远端写端重组 DATA_FRAG 分片
+//
+// 每个正在重组的样本在收到第一个分片时按 sample_size 一次性分配好整块缓冲区，
+// 分片直接从接收缓冲区复制到它在样本里的最终位置，不再另外保存分片；
+// 收到哪些分片记在位图里（每个分片 1 位）：
+//   - 重复的分片按位图丢弃，完成判断只比较计数
+//   - build_nack_frag() 从第一个缺失的分片开始，按 64 位字取反生成 NACK_FRAG 位图
+//
+// 同时最多重组 max_samples 个样本，满了之后丢掉序列号最小的那个（写端会重传）。
+// 交付后槽位的缓冲区保留容量，之后的样本复用；不是线程安全的
+// ============================================================
+class FragmentAssembler{
+public:
+    enum class FragmentResult : uint8_t {
+        ACCEPTED,  // 新分片，样本还不完整
+        COMPLETE,  // 这个分片让样本完整了，可以用 take() 取走
+        DUPLICATE, // 分片已经收到过，或者样本已经交付
+        INVALID    // 分片与样本大小不一致、超过 max_sample_size 或者数据不够
+    };
+
+    explicit FragmentAssembler(size_t max_samples = 4, size_t max_sample_size = 64 * 1024 * 1024);
+
+    FragmentResult on_data_frag(const DataFragSubmessage& fragment);
+
+    // HEARTBEAT_FRAG：写端已经发出了 [1, last_fragment_num]，之后生成的 NACK_FRAG 覆盖到这里
+    void on_heartbeat_frag(const SequenceNumber& writer_sn, uint32_t last_fragment_num);
+
+    // 取走一个已经完整的样本：fn(ConstByteSpan payload)，视图只在回调期间有效
+    // 样本不完整或者不存在时返回 false
+    template<typename Fn>
+    bool take(const SequenceNumber& writer_sn, Fn&& fn){
+        Sample* sample = find(writer_sn);
+        if(sample == nullptr || sample->received != sample->total) return false;
+        fn(ConstByteSpan(sample->payload.data(), sample->payload.size()));
+        release(*sample);
+        return true;
+    }
+
+    // 生成样本 writer_sn 的 NACK_FRAG 缺失集合：base 是第一个缺失的分片，
+    // 覆盖到已知的最大分片号（收到的最大分片号或者 HEARTBEAT_FRAG 的 last）
+    // 有缺失的分片时返回 true
+    bool build_nack_frag(const SequenceNumber& writer_sn, FragmentNumberSet& out) const;
+
+    // 对每个还在重组的样本调用 fn(const SequenceNumber&)
+    template<typename Fn>
+    void for_each_incomplete(Fn&& fn) const {
+        for(const Sample& sample : samples_){
+            if(sample.active && sample.received != sample.total) fn(SequenceNumber(sample.sequence));
+        }
+    }
+
+    // 放弃一个样本（例如写端 GAP 或 HEARTBEAT 表示它已经不可用）
+    void drop(const SequenceNumber& writer_sn);
+
+    // 放弃所有序列号 < writer_sn 的样本
+    void drop_before(const SequenceNumber& writer_sn);
+
+    size_t in_progress() const;
+
+    // 超过容量被丢掉的样本数
+    uint64_t evicted() const { return evicted_; }
+
+    // 被挤掉的样本和请求重传的 NACK_FRAG 记到这里（nullptr 不统计）
+    void set_statistics(EntityStatistics* statistics){ statistics_ = statistics; }
+
+private:
+    struct Sample{
+        bool active = false;
+        int64_t sequence = 0;
+        uint32_t sample_size = 0;
+        uint16_t fragment_size = 0;
+        uint32_t total = 0;           // 分片总数
+        uint32_t received = 0;        // 已收到的分片数
+        uint32_t highest = 0;         // 收到的最大分片号
+        uint32_t announced = 0;       // HEARTBEAT_FRAG 告知的最大分片号
+        std::vector<uint8_t> payload; // 整个样本，按 sample_size 一次分配
+        std::vector<uint64_t> bitmap; // 第 n 个分片（从 1 开始）在 bitmap[(n-1)/64] 的第 (n-1)%64 位
+    };
+
+    static constexpr size_t RECENT_SIZE = 16;
+
+    std::vector<Sample> samples_;
+    size_t max_sample_size_;
+    std::array<int64_t, RECENT_SIZE> recent_{}; // 最近交付的序列号，之后到达的重复分片直接丢弃
+    size_t recent_next_ = 0;
+    uint64_t evicted_ = 0;
+    EntityStatistics* statistics_ = nullptr;
+
+    bool recently_delivered(int64_t sequence) const;
+
+    Sample* find(const SequenceNumber& writer_sn);
+    const Sample* find(const SequenceNumber& writer_sn) const;
+
+    // 为新样本找一个槽位，满了时丢掉序列号最小的
+    Sample& acquire();
+
+    void release(Sample& sample);
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tinydds {
+namespace rtps {
+
+// FragmentNumberSet 最多 256 位（8 个 32 位字），和 SequenceNumberSet 相同
+constexpr uint32_t FRAGMENT_NUMBER_SET_MAX_BITS = 256;
+constexpr size_t FRAGMENT_NUMBER_SET_MAX_WORDS = FRAGMENT_NUMBER_SET_MAX_BITS / 32;
+
+// ============================================================
+// FragmentNumberSet: 基准分片号 + 最多 256 位的位图（NACK_FRAG 的线上格式）
+// 分片号从 1 开始，第 i 位（从第一个字的最高位开始数）为 1 表示分片 base + i 在集合中
+// ============================================================
+struct FragmentNumberSet{
+    uint32_t base = 1;
+    uint32_t num_bits = 0;
+    std::array<uint32_t, FRAGMENT_NUMBER_SET_MAX_WORDS> bitmap{};
+
+    FragmentNumberSet() = default;
+
+    explicit FragmentNumberSet(uint32_t base, uint32_t num_bits = 0)
+        : base(base), num_bits(num_bits > FRAGMENT_NUMBER_SET_MAX_BITS ? FRAGMENT_NUMBER_SET_MAX_BITS : num_bits) {}
+
+    void reset(uint32_t new_base, uint32_t new_num_bits = 0){
+        base = new_base;
+        num_bits = new_num_bits > FRAGMENT_NUMBER_SET_MAX_BITS ? FRAGMENT_NUMBER_SET_MAX_BITS : new_num_bits;
+        bitmap.fill(0);
+    }
+
+    size_t num_words() const { return (num_bits + 31) / 32; }
+
+    // 加入一个分片号，超出 base 之后 256 个分片的范围时返回 false，需要时自动扩大 num_bits
+    bool add(uint32_t fragment){
+        if(fragment < base || fragment - base >= FRAGMENT_NUMBER_SET_MAX_BITS) return false;
+        uint32_t offset = fragment - base;
+        bitmap[offset / 32] |= 0x80000000u >> (offset % 32);
+        if(offset >= num_bits){
+            num_bits = offset + 1;
+        }
+        return true;
+    }
+
+    bool contains(uint32_t fragment) const {
+        if(fragment < base || fragment - base >= num_bits) return false;
+        uint32_t offset = fragment - base;
+        return (bitmap[offset / 32] >> (31 - offset % 32)) & 1u;
+    }
+
+    bool empty() const {
+        for(size_t i = 0; i < num_words(); ++i){
+            if(bitmap[i] != 0) return false;
+        }
+        return true;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for(size_t i = 0; i < num_words(); ++i){
+            total += static_cast<size_t>(__builtin_popcount(bitmap[i]));
+        }
+        return total;
+    }
+
+    // 按递增顺序对集合中的每个分片号调用 fn(uint32_t)，跳过全 0 的字
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for(size_t i = 0; i < num_words(); ++i){
+            uint32_t word = bitmap[i];
+            while(word != 0){
+                uint32_t bit = static_cast<uint32_t>(__builtin_clz(word));
+                fn(base + static_cast<uint32_t>(i * 32) + bit);
+                word &= ~(0x80000000u >> bit);
+            }
+        }
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -1,12 +1,52 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <type_traits>
+
+#include "tinydds/rtps/hash.hpp"
 
 namespace tinydds{
 namespace rtps{
 
+namespace detail{
+
+// 从任意地址读取 32/64 位字（memcpy 会被编译成一条 load 指令）
+inline uint32_t load_u32(const uint8_t* ptr){
+    uint32_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline uint64_t load_u64(const uint8_t* ptr){
+    uint64_t value;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+// 按大端解释读出的字：比较两个这样的值等价于按字节逐个比较
+inline uint32_t load_be32(const uint8_t* ptr){
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap32(load_u32(ptr));
+#else
+    return load_u32(ptr);
+#endif
+}
+
+inline uint64_t load_be64(const uint8_t* ptr){
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap64(load_u64(ptr));
+#else
+    return load_u64(ptr);
+#endif
+}
+
+} // namespace detail
+
 // GuidPrefix结构体定义 用 12 个字节标识一个 DomainParticipant
 struct GuidPrefix{
 
@@ -17,14 +57,23 @@ struct GuidPrefix{
         value.fill(0); // 初始化为全0
     }
 
-    // 相等比较运算符
+    // 相等比较运算符：一个 64 位字 + 一个 32 位字
     bool operator==(const GuidPrefix& other) const {
-        return value == other.value;
+        return detail::load_u64(value.data()) == detail::load_u64(other.value.data()) &&
+               detail::load_u32(value.data() + 8) == detail::load_u32(other.value.data() + 8);
     }
 
     bool operator!=(const GuidPrefix& other) const {
         return !(*this == other); // 调用相等运算符
     }
+
+    // 按字节的字典序
+    bool operator<(const GuidPrefix& other) const {
+        uint64_t a = detail::load_be64(value.data());
+        uint64_t b = detail::load_be64(other.value.data());
+        if(a != b) return a < b;
+        return detail::load_be32(value.data() + 8) < detail::load_be32(other.value.data() + 8);
+    }
 };
 
 // EntityId结构体定义 用 4 个字节标识一个实体（如 DataWriter、DataReader 等）
@@ -46,16 +95,23 @@ struct EntityId{
 
     // 相等比较运算符
     bool operator==(const EntityId& other) const {
-        return value == other.value;
+        return detail::load_u32(value.data()) == detail::load_u32(other.value.data());
     }
 
     bool operator!=(const EntityId& other) const {
         return !(*this == other); // 调用相等运算符
     }
+
+    // 按字节的字典序
+    bool operator<(const EntityId& other) const {
+        return detail::load_be32(value.data()) < detail::load_be32(other.value.data());
+    }
 };
 
 // Guid结构体定义 由 GuidPrefix 和 EntityId 组成 用于唯一标识 RTPS 实体
-struct GUID{
+// 16 字节对齐、可平凡复制：整个 GUID 就是两个 64 位字，
+// 相等比较是两次 64 位比较，大小比较是两次字节交换后的 64 位比较（与按字节的字典序一致）
+struct alignas(16) GUID{
     GuidPrefix prefix;
     EntityId entityId;
 
@@ -64,26 +120,35 @@ struct GUID{
     GUID(const GuidPrefix& p, const EntityId& e) 
         : prefix(p), entityId(e) {}
 
+    // 第 index 个 64 位字（0: 前缀的前 8 字节，1: 前缀的后 4 字节 + EntityId）
+    uint64_t word(size_t index) const {
+        return detail::load_u64(reinterpret_cast<const uint8_t*>(this) + index * 8);
+    }
+
     bool operator==(const GUID& other) const {
-        return (prefix == other.prefix) && (entityId == other.entityId);
+        return ((word(0) ^ other.word(0)) | (word(1) ^ other.word(1))) == 0;
     }
 
     bool operator!=(const GUID& other) const {
         return !(*this == other); // 调用相等运算符
     }
 
-    // TODO: 小于比较
+    // 先比较 GuidPrefix，再比较 EntityId，即 16 个字节的字典序
     bool operator<(const GUID& other) const {
-        // 先比较 GuidPrefix，再比较 EntityId
-        if (prefix.value != other.prefix.value) {
-            return prefix.value < other.prefix.value;
-        }
-        else{
-            return entityId.value < other.entityId.value;
-        }
+        const uint8_t* lhs = reinterpret_cast<const uint8_t*>(this);
+        const uint8_t* rhs = reinterpret_cast<const uint8_t*>(&other);
+        uint64_t a = detail::load_be64(lhs);
+        uint64_t b = detail::load_be64(rhs);
+        if(a != b) return a < b;
+        return detail::load_be64(lhs + 8) < detail::load_be64(rhs + 8);
     }
 };
 
+static_assert(sizeof(GUID) == 16 && alignof(GUID) == 16, "GUID must be a packed 16-byte value");
+static_assert(std::is_trivially_copyable<GUID>::value, "GUID must be trivially copyable");
+static_assert(std::is_standard_layout<GUID>::value && offsetof(GUID, entityId) == 12,
+              "GUID bytes must be prefix followed by entityId");
+
 // 预定义 EntityId 常量
 // 这些常量是在 RTPS 协议中预定义的，主要用于 内置发现协议（SPDP / SEDP），它们的用途如下：
 // ENTITYID_UNKNOWN	                            (0x00,0x00,0x00,0x00)	未知或未初始化的 EntityId，通常用作默认值
@@ -96,6 +161,8 @@ struct GUID{
 // ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_READER	(0x00,0x00,0x04,0xC7)	SEDP 内置 Subscription Reader，用于接收 DataReader 信息
 // ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER	    (0x00,0x01,0x00,0xC2)	SPDP 内置 Participant Writer，用于广播 Participant 信息
 // ENTITYID_SPDP_BUILTIN_PARTICIPANT_READER	    (0x00,0x01,0x00,0xC7)	SPDP 内置 Participant Reader，用于接收 Participant 信息
+// ENTITYID_TINYDDS_STATISTICS_WRITER	        (0x00,0x00,0x01,0x42)	TinyDDS 内置统计主题的 Writer（厂商自定义，带 key），发布各实体的统计
+// ENTITYID_TINYDDS_STATISTICS_READER	        (0x00,0x00,0x01,0x47)	TinyDDS 内置统计主题的 Reader（厂商自定义，带 key），接收各实体的统计
 namespace EntityIdValues{
     const EntityId ENTITYID_UNKNOWN(0x00, 0x00, 0x00, 0x00);
     const EntityId ENTITYID_PARTICIPANT(0x00, 0x00, 0x01, 0xC1);
@@ -107,28 +174,82 @@ namespace EntityIdValues{
     const EntityId ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_READER(0x00, 0x00, 0x04, 0xC7);
     const EntityId ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER(0x00, 0x01, 0x00, 0xC2);
     const EntityId ENTITYID_SPDP_BUILTIN_PARTICIPANT_READER(0x00, 0x01, 0x00, 0xC7);
+    const EntityId ENTITYID_TINYDDS_STATISTICS_WRITER(0x00, 0x00, 0x01, 0x42);
+    const EntityId ENTITYID_TINYDDS_STATISTICS_READER(0x00, 0x00, 0x01, 0x47);
+}
+
+// 用户实体的 EntityKind（EntityId 的最后一个字节）
+namespace EntityKind{
+    constexpr uint8_t USER_WRITER_WITH_KEY = 0x02;
+    constexpr uint8_t USER_WRITER_NO_KEY = 0x03;
+    constexpr uint8_t USER_READER_NO_KEY = 0x04;
+    constexpr uint8_t USER_READER_WITH_KEY = 0x07;
+
+    // 最高两位区分用户/内置/厂商实体，低 6 位是实体类型（内置写端 0xC2 也是写端）
+    constexpr bool is_writer(uint8_t kind){
+        return (kind & 0x3F) == 0x02 || (kind & 0x3F) == 0x03;
+    }
+
+    constexpr bool is_reader(uint8_t kind){
+        return (kind & 0x3F) == 0x04 || (kind & 0x3F) == 0x07;
+    }
+}
+
+// ============================================================
+// 生成新的 GuidPrefix（创建 DomainParticipant 时调用）
+// 布局：vendorId(2) + hostId(4) + processId(2，折叠后的进程号) + 进程内计数器(4)
+// 计数器占 32 位，同一个进程创建超过 65536 个参与者也不会重复
+// 随机种子在进程内只向内核取一次（getrandom），之后每次调用只是一次原子自增，
+// 不加锁、不阻塞，可以在任意线程并发调用
+// ============================================================
+GuidPrefix generate_guid_prefix();
+
+// ============================================================
+// EntityIdGenerator: 为一个参与者分配用户实体的 EntityId
+// entityKey 是 3 字节的递增计数，最后一个字节是 EntityKind；无锁，可并发调用
+// ============================================================
+class EntityIdGenerator{
+public:
+    EntityId next(uint8_t kind){
+        uint32_t key = next_key_.fetch_add(1, std::memory_order_relaxed);
+        return EntityId(static_cast<uint8_t>(key >> 16), static_cast<uint8_t>(key >> 8),
+                        static_cast<uint8_t>(key), kind);
+    }
+
+private:
+    std::atomic<uint32_t> next_key_{1};
+};
+
+// ============================================================
+// 哈希
+// 16 字节的 GUID 按两个 64 位字读入，再经过 hash_mix64 混合：
+// 前缀相同、只有 EntityId 不同的 GUID 也能均匀分布
+// ============================================================
+inline uint64_t guid_prefix_hash(const GuidPrefix& prefix){
+    return hash_words(detail::load_u64(prefix.value.data()), detail::load_u32(prefix.value.data() + 8));
+}
+
+inline uint64_t guid_hash(const GUID& guid){
+    return hash_words(guid.word(0), guid.word(1));
 }
 
 } // namespace rtps
 } // namespace tinydds
 
-// 为 GUID 提供 hash 支持（用于 unordered_map）
+// 为 GUID / GuidPrefix 提供 hash 支持（用于 unordered_map 和 FlatHashMap）
 namespace std{
 
-// todo:学习哈希实现
-// 让 GUID 可以在哈希容器里当 key 
 template<>
 struct hash<tinydds::rtps::GUID> {
     size_t operator()(const tinydds::rtps::GUID& guid) const noexcept {
-        // 简单的 hash 算法：对所有16个字节进行异或
-        size_t h = 0;
-        for (int i = 0; i < 12; ++i) {
-            h ^= std::hash<uint8_t>{}(guid.prefix.value[i]) << i;
-        }
-        for (int i = 0; i < 4; ++i) {
-            h ^= std::hash<uint8_t>{}(guid.entityId.value[i]) << (i + 12);
-        }
-        return h;
+        return static_cast<size_t>(tinydds::rtps::guid_hash(guid));
+    }
+};
+
+template<>
+struct hash<tinydds::rtps::GuidPrefix> {
+    size_t operator()(const tinydds::rtps::GuidPrefix& prefix) const noexcept {
+        return static_cast<size_t>(tinydds::rtps::guid_prefix_hash(prefix));
     }
 };
 }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// 64 位混合函数（splitmix64 的 finalizer）
+// 每个输入位都会影响输出的所有位，结果可以直接用 hash & mask 作为
+// 开放寻址哈希表的下标。GUID、Locator 等定长 key 先按 64 位字读入，再用它混合
+// ============================================================
+inline uint64_t hash_mix64(uint64_t x){
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+inline uint64_t hash_words(uint64_t a, uint64_t b){
+    return hash_mix64(hash_mix64(a ^ 0x9E3779B97F4A7C15ULL) ^ b);
+}
+
+inline uint64_t hash_words(uint64_t a, uint64_t b, uint64_t c){
+    return hash_mix64(hash_words(a, b) ^ c);
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// LatencyHistogram: HDR 风格的对数-线性直方图（记录纳秒延迟）
+//
+// 小于 2^SUB_BUCKET_BITS 的值每个值一个桶（精确）；更大的值按 2 的幂分段，
+// 每段再等分成 2^(SUB_BUCKET_BITS-1) 个桶，所以任何值的相对误差不超过 1/128。
+// 桶的下标只要一次 clz 和几次移位就能算出来，记录一个值是 O(1) 且不分配内存；
+// 分位数按累计计数查找，返回桶内的最大值（和 HdrHistogram 一样偏保守）。
+//
+// 最大可记录 2^MAX_VALUE_BITS - 1 纳秒（约 18 分钟），更大的值计入最后一个桶
+// （max() 仍然是实际记录的最大值）。
+// 不是线程安全的；每个线程各自记录，最后用 merge() 合并
+// ============================================================
+class LatencyHistogram{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 8;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+    static constexpr uint64_t MAX_TRACKABLE_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+
+    LatencyHistogram() : counts_(BUCKET_COUNT, 0) {}
+
+    void record(uint64_t value, uint64_t count = 1){
+        counts_[bucket_index(value)] += count;
+        total_ += count;
+        sum_ += value * count;
+        if(value < min_) min_ = value;
+        if(value > max_) max_ = value;
+    }
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const { return total_ == 0 ? 0 : min_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(total_); }
+
+    // 至少 percentile%（0~100）的记录不大于返回值；没有记录时返回 0
+    uint64_t value_at_percentile(double percentile) const;
+
+    // 按值从小到大，对每个非空的桶调用 fn(uint64_t lowest, uint64_t highest, uint64_t count)
+    template<typename Fn>
+    void for_each_bucket(Fn&& fn) const {
+        for(size_t i = 0; i < BUCKET_COUNT; ++i){
+            if(counts_[i] != 0) fn(bucket_lowest(i), bucket_highest(i), counts_[i]);
+        }
+    }
+
+    // ========================================
+    // 桶的下标和范围
+    // ========================================
+
+    static size_t bucket_index(uint64_t value){
+        if(value < SUB_BUCKET_COUNT) return static_cast<size_t>(value);
+        if(value > MAX_TRACKABLE_VALUE) value = MAX_TRACKABLE_VALUE;
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        unsigned shift = msb - (SUB_BUCKET_BITS - 1);
+        return SUB_BUCKET_COUNT + (msb - SUB_BUCKET_BITS) * SUB_BUCKET_HALF +
+               static_cast<size_t>((value >> shift) - SUB_BUCKET_HALF);
+    }
+
+    // 落在第 index 个桶里的最小值
+    static uint64_t bucket_lowest(size_t index){
+        if(index < SUB_BUCKET_COUNT) return index;
+        size_t group = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF;
+        uint64_t mantissa = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+        return mantissa << (group + 1);
+    }
+
+    // 落在第 index 个桶里的最大值
+    static uint64_t bucket_highest(size_t index){
+        if(index < SUB_BUCKET_COUNT) return index;
+        size_t group = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF;
+        return bucket_lowest(index) + (uint64_t(1) << (group + 1)) - 1;
+    }
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+} // namespace rtps
+} // namespace tinydds
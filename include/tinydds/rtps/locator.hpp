@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 #include <string>
+#include <string_view>
 #include <cstring>
-#include <arpa/inet.h>  // for inet_pton, inet_ntop
-#include <iostream>
+#include <functional>
+#include <type_traits>
+
+#include "tinydds/rtps/hash.hpp"
 
 namespace tinydds {
 namespace rtps {
@@ -18,11 +22,118 @@ enum class LocatorKind : int32_t{
     LOCATOR_KIND_INVALID = -1,
     LOCATOR_KIND_RESERVED = 0,
     LOCATOR_KIND_UDPv4 = 1,
-    LOCATOR_KIND_UDPv6 = 2
+    LOCATOR_KIND_UDPv6 = 2,
+    LOCATOR_KIND_SHM = 16   // 同一台机器上的共享内存传输（与常见实现取值一致）
 };
 
+// ============================================================
+// 地址解析（constexpr，不分配内存）
+// 代替 inet_pton：可以在编译期构造 Locator 常量，运行时也没有系统调用和字符串拷贝
+// ============================================================
+
+// 点分十进制 IPv4，写入 out[0..3]；不接受前导 0（与 inet_pton 一致）
+constexpr bool parse_ipv4_address(std::string_view text, uint8_t* out){
+    size_t pos = 0;
+    for(int part = 0; part < 4; ++part){
+        if(part > 0){
+            if(pos >= text.size() || text[pos] != '.') return false;
+            ++pos;
+        }
+        size_t start = pos;
+        uint32_t value = 0;
+        while(pos < text.size() && text[pos] >= '0' && text[pos] <= '9'){
+            value = value * 10 + static_cast<uint32_t>(text[pos] - '0');
+            ++pos;
+            if(pos - start > 3) return false;
+        }
+        if(pos == start || value > 255) return false;
+        if(pos - start > 1 && text[start] == '0') return false;
+        out[part] = static_cast<uint8_t>(value);
+    }
+    return pos == text.size();
+}
+
+namespace detail{
+
+constexpr int hex_digit_value(char c){
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace detail
+
+// IPv6（RFC 4291 文本格式，支持 "::" 压缩和末尾内嵌的 IPv4），写入 out[0..15]
+constexpr bool parse_ipv6_address(std::string_view text, uint8_t* out){
+    uint8_t bytes[16] = {};
+    size_t count = 0;     // 已解析的字节数
+    int gap = -1;         // "::" 出现在第几个字节之前
+    size_t pos = 0;
+    if(text.size() >= 2 && text[0] == ':'){
+        if(text[1] != ':') return false;
+        gap = 0;
+        pos = 2;
+    }
+    while(pos < text.size()){
+        size_t start = pos;
+        uint32_t value = 0;
+        while(pos < text.size() && detail::hex_digit_value(text[pos]) >= 0){
+            value = value * 16 + static_cast<uint32_t>(detail::hex_digit_value(text[pos]));
+            ++pos;
+            if(pos - start > 4) return false;
+        }
+        if(pos < text.size() && text[pos] == '.'){
+            // 最后 32 位写成点分十进制，例如 ::ffff:192.168.1.1
+            if(count + 4 > 16 || !parse_ipv4_address(text.substr(start), bytes + count)) return false;
+            count += 4;
+            pos = text.size();
+            break;
+        }
+        if(pos == start || count + 2 > 16) return false;
+        bytes[count++] = static_cast<uint8_t>(value >> 8);
+        bytes[count++] = static_cast<uint8_t>(value);
+        if(pos == text.size()) break;
+        if(text[pos] != ':') return false;
+        ++pos;
+        if(pos < text.size() && text[pos] == ':'){
+            if(gap >= 0) return false; // 只能出现一次 "::"
+            gap = static_cast<int>(count);
+            ++pos;
+        }else if(pos == text.size()){
+            return false; // 不能以单个 ':' 结尾
+        }
+    }
+    if(gap < 0){
+        if(count != 16) return false;
+        for(size_t i = 0; i < 16; ++i) out[i] = bytes[i];
+        return true;
+    }
+    if(count > 14) return false; // "::" 至少代表一组 0
+    size_t head = static_cast<size_t>(gap);
+    size_t tail = count - head;
+    for(size_t i = 0; i < 16; ++i) out[i] = 0;
+    for(size_t i = 0; i < head; ++i) out[i] = bytes[i];
+    for(size_t i = 0; i < tail; ++i) out[16 - tail + i] = bytes[head + i];
+    return true;
+}
+
+// ============================================================
+// 地址格式化（写入调用方的缓冲区，不分配内存），实现在 locator.cpp
+// 返回写入的字符数（不含结尾的 '\0'），缓冲区不够时返回 0
+// ============================================================
+constexpr size_t IPV4_ADDRESS_MAX_CHARS = 16;  // "255.255.255.255" + '\0'
+constexpr size_t IPV6_ADDRESS_MAX_CHARS = 46;  // 与 INET6_ADDRSTRLEN 相同
+constexpr size_t LOCATOR_MAX_CHARS = IPV6_ADDRESS_MAX_CHARS + 13; // "[" + 地址 + "]:" + 10 位端口
+
+size_t format_ipv4_address(const uint8_t* address, char* buffer, size_t size);
+
+// RFC 5952 规范格式：小写、省略前导 0、最长的一段全 0 压缩成 "::"
+size_t format_ipv6_address(const uint8_t* address, char* buffer, size_t size);
+
 // ============================================================
 // Locator: 表示网络地址（IP + Port）
+// 24 字节、没有填充、可平凡复制：比较和哈希都直接按 64 位字处理
 // ============================================================
 struct Locator{
     LocatorKind kind; // 地址类型
@@ -34,59 +145,49 @@ struct Locator{
     // ========================================
 
     // 默认构造：无效地址
-    Locator() : kind(LocatorKind::LOCATOR_KIND_INVALID), port(0){
-        address.fill(0);
-    }
+    constexpr Locator() : kind(LocatorKind::LOCATOR_KIND_INVALID), port(0), address{} {}
 
-    // todo: 鉴别IPv4和IPv6地址的构造函数待实现
-    // 从 IPv4 字符串和端口构造
-    // 例如：Locator("192.168.1.100", 7400)
-    Locator(const std::string& ipv4_str, uint32_t port_num) 
-        : kind(LocatorKind::LOCATOR_KIND_UDPv4), port(port_num){
-        address.fill(0);
-
-        // IPv4 地址放在最后 4 字节
-        struct in_addr addr; // 表示一个32位的IPv4地址
-        // inet_pton函数将字符串形式的IP地址转换为网络字节序的二进制形式
-        if (inet_pton(AF_INET, ipv4_str.c_str(), &addr) == 1) {
-            // 将 4 字节 IP 地址复制到 address[12..15]
-            uint8_t* ip_bytes = reinterpret_cast<uint8_t*>(&addr.s_addr); // 用于将 uint32_t 的地址转换为字节数组
-
-            address[12] = ip_bytes[0];
-            address[13] = ip_bytes[1];
-            address[14] = ip_bytes[2];
-            address[15] = ip_bytes[3];
+    // 从地址字符串和端口构造，根据是否含有 ':' 区分 IPv4 和 IPv6
+    // 例如：Locator("192.168.1.100", 7400)、Locator("fe80::1", 7400)
+    // 可以在编译期使用：constexpr Locator kDiscovery("239.255.0.1", 7400);
+    // 字符串不合法时得到无效地址（kind 为 LOCATOR_KIND_INVALID）
+    constexpr Locator(std::string_view address_str, uint32_t port_num)
+        : kind(LocatorKind::LOCATOR_KIND_INVALID), port(port_num), address{}{
+        if(address_str.find(':') != std::string_view::npos){
+            if(parse_ipv6_address(address_str, &address[0])){
+                kind = LocatorKind::LOCATOR_KIND_UDPv6;
+            }
+        }else if(parse_ipv4_address(address_str, &address[12])){
+            // IPv4 地址放在最后 4 字节
+            kind = LocatorKind::LOCATOR_KIND_UDPv4;
+        }
+        if(kind == LocatorKind::LOCATOR_KIND_INVALID){
+            for(size_t i = 0; i < 16; ++i) address[i] = 0;
         }
     }
+
     // ========================================
     // 工具函数
     // ========================================
 
-    // 获取 IPv4 地址字符串
+    // 把地址部分写入 buffer（IPv4 点分十进制 / IPv6 规范格式），返回字符数，失败返回 0
+    size_t address_to_chars(char* buffer, size_t size) const;
+
+    // "地址:端口"，IPv6 写成 "[地址]:端口"
+    size_t to_chars(char* buffer, size_t size) const;
+
+    // 获取 IPv4 地址字符串（不超过 15 个字符，std::string 的小字符串优化下不分配堆内存）
     std::string get_ipv4_string() const {
         // 仅支持 IPv4 地址
         if (kind != LocatorKind::LOCATOR_KIND_UDPv4) {
             return "";
         }
-        
-        // 从 address[12..15] 提取 IPv4 地址
-        struct in_addr addr;
-        uint8_t* ip_bytes = reinterpret_cast<uint8_t*>(&addr.s_addr);
-        ip_bytes[0] = address[12];
-        ip_bytes[1] = address[13];
-        ip_bytes[2] = address[14];
-        ip_bytes[3] = address[15];
-        
-        // inet_ntop 函数将网络字节序的二进制IP地址转换为字符串形式
-        char buffer[INET_ADDRSTRLEN]; // 缓冲区大小 INET_ADDRSTRLEN = 16，ipv4 的 string 类型占 16 个字节
-        if (inet_ntop(AF_INET, &addr, buffer, INET_ADDRSTRLEN) != nullptr) {
-            return std::string(buffer); // 强制转换为 std::string 并返回
-        }
-        return "";
+        char buffer[IPV4_ADDRESS_MAX_CHARS];
+        return std::string(buffer, format_ipv4_address(&address[12], buffer, sizeof(buffer)));
     }
 
     // 获取 IPv4 地址（网络字节序）
-    uint32_t get_ipv4_address() const {
+    constexpr uint32_t get_ipv4_address() const {
         return (static_cast<uint32_t>(address[12]) << 24) |
                (static_cast<uint32_t>(address[13]) << 16) |
                (static_cast<uint32_t>(address[14]) << 8) |
@@ -95,24 +196,32 @@ struct Locator{
 
     // 判断是否是多播地址
     // IPv4 多播地址范围：224.0.0.0 ~ 239.255.255.255（11100000.00000000.000000000.000000000 - 11100000.11111111.11111111.111111111）
-    bool is_multicast() const {
-        // 仅支持 IPv4 地址
+    // IPv6 多播地址：ff00::/8
+    constexpr bool is_multicast() const {
+        if (kind == LocatorKind::LOCATOR_KIND_UDPv6) {
+            return address[0] == 0xFF;
+        }
         if (kind != LocatorKind::LOCATOR_KIND_UDPv4) {
             return false;
-        } 
+        }
         return address[12] >= 224 && address[12] <= 239;
     }
 
     // 判断是否有效
-    bool is_valid() const {
+    constexpr bool is_valid() const {
         return kind != LocatorKind::LOCATOR_KIND_INVALID;
     }
 
-    // 比较运算符
+    // 第 index 个 64 位字（0: kind + port，1/2: 地址）
+    uint64_t word(size_t index) const {
+        uint64_t value;
+        std::memcpy(&value, reinterpret_cast<const uint8_t*>(this) + index * 8, sizeof(value));
+        return value;
+    }
+
+    // 比较运算符：三个 64 位字
     bool operator==(const Locator& other) const {
-        return kind == other.kind && 
-               port == other.port && 
-               address == other.address;
+        return ((word(0) ^ other.word(0)) | (word(1) ^ other.word(1)) | (word(2) ^ other.word(2))) == 0;
     }
 
     bool operator!=(const Locator& other) const {
@@ -120,21 +229,39 @@ struct Locator{
     }
 };
 
+static_assert(sizeof(Locator) == 24, "Locator must have no padding");
+static_assert(std::is_trivially_copyable<Locator>::value, "Locator must be trivially copyable");
+
+inline uint64_t locator_hash(const Locator& locator){
+    return hash_words(locator.word(0), locator.word(1), locator.word(2));
+}
+
 // ============================================================
 // 预定义的特殊地址
 // ============================================================
 namespace LocatorValues {
     // DDS 默认多播地址（用于服务发现）
     // 239.255.0.1 是 RTPS 规定的默认多播地址
-    inline Locator default_multicast_locator(uint32_t port = 7400) {
+    constexpr Locator default_multicast_locator(uint32_t port = 7400) {
         return Locator("239.255.0.1", port);
     }
-    
+
     // 本机地址
-    inline Locator localhost_locator(uint32_t port = 7400) {
+    constexpr Locator localhost_locator(uint32_t port = 7400) {
         return Locator("127.0.0.1", port);
     }
 }
 
 } // namespace rtps
-} // namespace tinydds
\ No newline at end of file
+} // namespace tinydds
+
+// 为 Locator 提供 hash 支持（传输层按目的地址索引发送队列）
+namespace std{
+
+template<>
+struct hash<tinydds::rtps::Locator> {
+    size_t operator()(const tinydds::rtps::Locator& locator) const noexcept {
+        return static_cast<size_t>(tinydds::rtps::locator_hash(locator));
+    }
+};
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "tinydds/rtps/fragment_number_set.hpp"
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/sequence_number.hpp"
+#include "tinydds/rtps/sequence_number_set.hpp"
+#include "tinydds/rtps/span.hpp"
+#include "tinydds/rtps/timestamp.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// RTPS 消息格式的常量
+// 一条 RTPS 消息 = 20 字节消息头 + 若干个子消息
+// 每个子消息 = 4 字节子消息头(id, flags, octetsToNextHeader) + 内容，按 4 字节对齐
+// ============================================================
+
+constexpr size_t RTPS_HEADER_SIZE = 20;
+constexpr size_t SUBMESSAGE_HEADER_SIZE = 4;
+constexpr size_t SUBMESSAGE_ALIGNMENT = 4;
+
+// 协议版本 2.3
+constexpr uint8_t PROTOCOL_VERSION_MAJOR = 2;
+constexpr uint8_t PROTOCOL_VERSION_MINOR = 3;
+
+// 厂商号（未注册，仅用于区分 TinyDDS 自己发出的消息）
+constexpr uint8_t VENDOR_ID_TINYDDS[2] = {0x01, 0xFE};
+
+// 子消息类型
+enum class SubmessageId : uint8_t{
+    PAD = 0x01,
+    ACKNACK = 0x06,
+    HEARTBEAT = 0x07,
+    GAP = 0x08,
+    INFO_TS = 0x09,
+    INFO_SRC = 0x0C,
+    INFO_REPLY_IP4 = 0x0D,
+    INFO_DST = 0x0E,
+    INFO_REPLY = 0x0F,
+    NACK_FRAG = 0x12,
+    HEARTBEAT_FRAG = 0x13,
+    DATA = 0x15,
+    DATA_FRAG = 0x16
+};
+
+// 子消息标志位
+namespace SubmessageFlag{
+    constexpr uint8_t ENDIANNESS = 0x01; // 所有子消息：1 表示内容是小端
+    // DATA
+    constexpr uint8_t INLINE_QOS = 0x02;
+    constexpr uint8_t DATA_PRESENT = 0x04;
+    constexpr uint8_t KEY_PRESENT = 0x08;
+    // HEARTBEAT / ACKNACK
+    constexpr uint8_t FINAL = 0x02;
+    constexpr uint8_t LIVELINESS = 0x04;
+    // DATA_FRAG（Q 标志与 DATA 相同）
+    constexpr uint8_t FRAG_KEY_PRESENT = 0x04;
+    // INFO_TS：1 表示之后的子消息没有时间戳（不带内容）
+    constexpr uint8_t INVALIDATE = 0x02;
+}
+
+// ============================================================
+// 消息头
+// ============================================================
+struct MessageHeader{
+    uint8_t version_major = PROTOCOL_VERSION_MAJOR;
+    uint8_t version_minor = PROTOCOL_VERSION_MINOR;
+    std::array<uint8_t, 2> vendor_id = {VENDOR_ID_TINYDDS[0], VENDOR_ID_TINYDDS[1]};
+    GuidPrefix guid_prefix;
+};
+
+// ============================================================
+// 解析结果：字段都是值或者指向原始消息的视图，不分配内存
+// ============================================================
+
+// 子消息的原始视图
+struct SubmessageView{
+    SubmessageId id;
+    uint8_t flags;
+    ConstByteSpan body; // 子消息头之后的内容
+
+    bool little_endian() const { return (flags & SubmessageFlag::ENDIANNESS) != 0; }
+};
+
+struct DataSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber writer_sn;
+    ConstByteSpan inline_qos;         // Q 标志为 1 时有效（参数列表的原始字节）
+    ConstByteSpan serialized_payload; // D 或 K 标志为 1 时有效（包含封装头，已去掉 options 里记录的末尾填充）
+    uint8_t flags = 0;
+};
+
+// DATA_FRAG：一个样本的第 fragment_starting_num 起连续 fragments_in_submessage 个分片
+// 分片号从 1 开始，第 n 个分片是样本的 [(n - 1) * fragment_size, n * fragment_size)，最后一个分片可以不满
+struct DataFragSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber writer_sn;
+    uint32_t fragment_starting_num = 0;
+    uint16_t fragments_in_submessage = 0;
+    uint16_t fragment_size = 0;
+    uint32_t sample_size = 0;
+    ConstByteSpan inline_qos; // Q 标志为 1 时有效（参数列表的原始字节）
+    ConstByteSpan fragments;  // 分片数据，末尾可能有对齐填充
+    uint8_t flags = 0;
+
+    // 样本一共有多少个分片
+    uint32_t total_fragments() const {
+        return fragment_size == 0 ? 0 : static_cast<uint32_t>((static_cast<uint64_t>(sample_size) + fragment_size - 1) / fragment_size);
+    }
+};
+
+struct HeartbeatSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber first_sn;
+    SequenceNumber last_sn;
+    uint32_t count = 0;
+    bool final_flag = false;
+    bool liveliness_flag = false;
+};
+
+struct AckNackSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumberSet reader_sn_state;
+    uint32_t count = 0;
+    bool final_flag = false;
+};
+
+// NACK_FRAG：读端请求重传一个样本中缺失的分片
+struct NackFragSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber writer_sn;
+    FragmentNumberSet fragment_number_state;
+    uint32_t count = 0;
+};
+
+// HEARTBEAT_FRAG：写端告知一个样本已经发出的最后一个分片号
+struct HeartbeatFragSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber writer_sn;
+    uint32_t last_fragment_num = 0;
+    uint32_t count = 0;
+};
+
+struct GapSubmessage{
+    EntityId reader_id;
+    EntityId writer_id;
+    SequenceNumber gap_start;
+    SequenceNumberSet gap_list;
+};
+
+// INFO_TS：同一条消息里之后的子消息（直到下一个 INFO_TS）的源时间戳
+// INVALIDATE 标志为 1 时 timestamp 是 TIME_INVALID
+struct InfoTimestampSubmessage{
+    Timestamp timestamp;
+};
+
+} // namespace rtps
+} // namespace tinydds
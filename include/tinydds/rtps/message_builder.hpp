@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/message.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// MessageBuilder: 把多个子消息攒进同一条 RTPS 消息
+//
+// 每条消息以 RTPS 消息头开始，之后追加 DATA/HEARTBEAT/ACKNACK/GAP 子消息，
+// 所有内容直接写进同一个 CdrSerializer 缓冲区（按本机字节序，E 标志置位）。
+// 下一个子消息放不进 MTU 时，先把已有的消息交给 sink 发送，再开始新消息；
+// 调用方也可以在事件循环里调用 flush_if_due()，让攒了一段时间的消息按时发出，
+// 这样低速率时延迟有上界，高速率时许多小样本合并成一个数据报。
+//
+// sink 收到的视图只在回调期间有效；缓冲区在 flush 之后复用，稳定运行时不再分配内存
+// ============================================================
+class MessageBuilder{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Sink = std::function<void(ConstByteSpan message)>;
+
+    MessageBuilder(const GuidPrefix& prefix, Sink sink, size_t mtu = 1472,
+                   std::chrono::microseconds max_delay = std::chrono::microseconds(500));
+
+    // ========================================
+    // 追加子消息，单个子消息超过 MTU 时返回 false（样本需要分片，见 DataFragmenter）
+    // ========================================
+
+    // DATA：serialized_payload 是带封装头的完整序列化数据，会被复制进消息。
+    // 长度不是 4 的倍数时末尾补 0，补的字节数写进消息里封装头 options 的最低两位
+    // 当前消息里前面有带时间戳的 DATA 时，先写一个 INVALIDATE 的 INFO_TS，这个样本不继承别人的时间戳
+    bool add_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                  ConstByteSpan serialized_payload, ConstByteSpan inline_qos = ConstByteSpan());
+
+    // INFO_TS + DATA：带源时间戳的样本，两个子消息总是放进同一条消息（放不下时一起换到下一条）
+    // 和上一个样本的时间戳相同时不重复写 INFO_TS
+    bool add_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                  ConstByteSpan serialized_payload, const Timestamp& source_timestamp);
+
+    // 这么大的 DATA（带封装头的负载和 inline QoS 的字节数）能不能发出：不超过 MTU 和子消息的长度上限。
+    // add_data 只会因为这个原因失败，调用方可以先检查，再分配序列号
+    bool fits_data(size_t serialized_payload_size, size_t inline_qos_size = 0) const;
+
+    // INFO_TS：同一条消息里之后的子消息的源时间戳（无效的时间戳写成 INVALIDATE）
+    bool add_info_ts(const Timestamp& timestamp);
+
+    bool add_heartbeat(const EntityId& reader_id, const EntityId& writer_id,
+                       const SequenceNumber& first_sn, const SequenceNumber& last_sn,
+                       uint32_t count, bool final_flag = false, bool liveliness_flag = false);
+
+    // bitmap 有 (num_bits + 31) / 32 个字，最高位对应 base
+    bool add_acknack(const EntityId& reader_id, const EntityId& writer_id,
+                     const SequenceNumber& base, uint32_t num_bits, const uint32_t* bitmap,
+                     uint32_t count, bool final_flag = false);
+
+    bool add_acknack(const EntityId& reader_id, const EntityId& writer_id,
+                     const SequenceNumberSet& reader_sn_state, uint32_t count, bool final_flag = false){
+        return add_acknack(reader_id, writer_id, reader_sn_state.base, reader_sn_state.num_bits,
+                           reader_sn_state.bitmap.data(), count, final_flag);
+    }
+
+    bool add_gap(const EntityId& reader_id, const EntityId& writer_id,
+                 const SequenceNumber& gap_start, const SequenceNumber& list_base,
+                 uint32_t num_bits, const uint32_t* bitmap);
+
+    bool add_gap(const EntityId& reader_id, const EntityId& writer_id,
+                 const SequenceNumber& gap_start, const SequenceNumberSet& gap_list){
+        return add_gap(reader_id, writer_id, gap_start, gap_list.base, gap_list.num_bits, gap_list.bitmap.data());
+    }
+
+    // NACK_FRAG：请求重传样本 writer_sn 中 fragment_number_state 里的分片
+    bool add_nack_frag(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                       const FragmentNumberSet& fragment_number_state, uint32_t count);
+
+    // HEARTBEAT_FRAG：样本 writer_sn 已经发出了 [1, last_fragment_num] 的分片
+    bool add_heartbeat_frag(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                            uint32_t last_fragment_num, uint32_t count);
+
+    // ========================================
+    // 发送
+    // ========================================
+
+    // 立即发送当前消息（没有子消息时什么也不做）
+    void flush();
+
+    // 当前消息里最早的子消息已经等待超过 max_delay 时发送，返回是否发送了
+    bool flush_if_due(Clock::time_point now = Clock::now());
+
+    // 当前消息还能容纳的字节数
+    size_t remaining() const { return mtu_ - serializer_.size(); }
+
+    size_t pending_submessages() const { return pending_submessages_; }
+    size_t mtu() const { return mtu_; }
+
+    uint64_t messages_sent() const { return messages_sent_; }
+    uint64_t submessages_sent() const { return submessages_sent_; }
+
+private:
+    GuidPrefix prefix_;
+    Sink sink_;
+    size_t mtu_;
+    std::chrono::microseconds max_delay_;
+    CdrSerializer serializer_;
+    size_t pending_submessages_ = 0;
+    Clock::time_point first_pending_;
+    Timestamp current_timestamp_; // 当前消息里最近一个 INFO_TS 的时间戳（每条新消息重置为无效）
+
+    uint64_t messages_sent_ = 0;
+    uint64_t submessages_sent_ = 0;
+
+    void write_message_header();
+
+    // 当前消息里有时间戳时，让之后 data_size 字节的 DATA 不继承它：
+    // 放得下就写一个 INVALIDATE 的 INFO_TS，放不下就先 flush，DATA 从一条新消息（没有时间戳）开始
+    bool clear_timestamp(size_t data_size);
+
+    bool append_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                     ConstByteSpan serialized_payload, ConstByteSpan inline_qos);
+
+    // 为一个内容长度为 body_size 的子消息腾出空间（必要时先 flush），并写入子消息头
+    bool begin_submessage(SubmessageId id, uint8_t flags, size_t body_size);
+
+    void write_entity_id(const EntityId& id);
+    void write_sequence_number(const SequenceNumber& seq);
+    void write_sequence_number_set(const SequenceNumber& base, uint32_t num_bits, const uint32_t* bitmap);
+};
+
+} // namespace rtps
+} // namespace tinydds
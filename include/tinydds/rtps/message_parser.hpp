@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tinydds/rtps/message.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// MessageParser: 原地遍历一条 RTPS 消息里的子消息
+// 不复制、不分配内存：解析结果里的视图都指向传入的消息缓冲区，
+// 缓冲区必须在使用解析结果期间有效
+//
+//     MessageParser parser(datagram);
+//     SubmessageView sub;
+//     while(parser.next(sub)){
+//         if(sub.id == SubmessageId::DATA){
+//             DataSubmessage data;
+//             if(parse_data(sub, data)) ...
+//         }
+//     }
+// ============================================================
+class MessageParser{
+public:
+    explicit MessageParser(ConstByteSpan message);
+
+    // 消息头是否合法（"RTPS" 标记、主版本号为 2）
+    bool valid() const { return valid_; }
+
+    const MessageHeader& header() const { return header_; }
+
+    // 取出下一个子消息，没有更多子消息或者格式错误时返回 false
+    bool next(SubmessageView& submessage);
+
+    // 遍历过程中是否遇到了格式错误（长度越界等）
+    bool malformed() const { return malformed_; }
+
+private:
+    ConstByteSpan message_;
+    size_t pos_ = 0;
+    MessageHeader header_;
+    bool valid_ = false;
+    bool malformed_ = false;
+};
+
+// ============================================================
+// 解析具体的子消息内容（按子消息头中的 E 标志选择字节序）
+// 内容长度不够时返回 false
+// ============================================================
+bool parse_data(const SubmessageView& submessage, DataSubmessage& out);
+bool parse_heartbeat(const SubmessageView& submessage, HeartbeatSubmessage& out);
+bool parse_acknack(const SubmessageView& submessage, AckNackSubmessage& out);
+bool parse_gap(const SubmessageView& submessage, GapSubmessage& out);
+bool parse_data_frag(const SubmessageView& submessage, DataFragSubmessage& out);
+bool parse_nack_frag(const SubmessageView& submessage, NackFragSubmessage& out);
+bool parse_heartbeat_frag(const SubmessageView& submessage, HeartbeatFragSubmessage& out);
+bool parse_info_ts(const SubmessageView& submessage, InfoTimestampSubmessage& out);
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "tinydds/rtps/event_count.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// MpmcQueue: 有界多生产者/多消费者无锁队列（Vyukov）
+//
+// 和 MpscQueue 相同的格子序号算法，只是消费者也要用 CAS 抢 dequeue 位置。
+// 用于线程池的任务队列：任意线程投递，所属的工作线程取，空闲的工作线程也可以来偷。
+// 不带阻塞等待，等待由使用方自己的 EventCount 负责（例如整个线程池共用一个）
+// ============================================================
+template<typename T>
+class MpmcQueue{
+public:
+    // capacity 向上取整为 2 的幂，至少为 2
+    explicit MpmcQueue(size_t capacity) : mask_(round_up_pow2(capacity) - 1), cells_(new Cell[mask_ + 1]){
+        for(size_t i = 0; i <= mask_; ++i){
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue(){
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for(;; ++pos){
+            Cell& cell = cells_[pos & mask_];
+            if(cell.sequence.load(std::memory_order_relaxed) != pos + 1) break;
+            item(cell)->~T();
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // 队列满时返回 false，参数不会被移走
+    template<typename... Args>
+    bool emplace(Args&&... args){
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for(;;){
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if(diff == 0){
+                if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0){
+                return false; // 队列满
+            }
+            else{
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& value) { return emplace(value); }
+    bool push(T&& value) { return emplace(std::move(value)); }
+
+    // 队列空时返回 false
+    bool take(T& out){
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for(;;){
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if(diff == 0){
+                if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0){
+                return false; // 队列空
+            }
+            else{
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        T* value = item(*cell);
+        out = std::move(*value);
+        value->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似值
+    size_t size() const {
+        size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell{
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+    alignas(CACHE_LINE_SIZE) const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    static T* item(Cell& cell){
+        return std::launder(reinterpret_cast<T*>(&cell.storage));
+    }
+
+    // 至少 2 个格子，原因同 MpscQueue
+    static size_t round_up_pow2(size_t value){
+        size_t result = 2;
+        while(result < value) result <<= 1;
+        return result;
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "tinydds/rtps/event_count.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// MpscQueue: 有界多生产者/单消费者无锁队列
+//
+// 用于多个接收线程（UDP、共享内存，或多个写端）给同一个 DataReader 投递样本。
+// 和共享内存传输里的环一样是 Vyukov 的格子序号算法：
+//   - 生产者用 CAS 抢 enqueue 位置，构造元素后用格子序号的 release 发布（lock-free）
+//   - 只有一个消费者，不需要 CAS：检查格子序号、取走元素、交还格子（wait-free）
+// 某个生产者抢到位置但还没写完时，消费者会把队列看成空的，之后的元素要等它写完才能取；
+// 每个生产者自己的元素保持 FIFO 顺序。
+//
+// 模板参数 Blocking 的含义同 SpscQueue
+// ============================================================
+template<typename T, bool Blocking = true>
+class MpscQueue{
+public:
+    // capacity 向上取整为 2 的幂，至少为 2
+    explicit MpscQueue(size_t capacity) : mask_(round_up_pow2(capacity) - 1), cells_(new Cell[mask_ + 1]){
+        for(size_t i = 0; i <= mask_; ++i){
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpscQueue(){
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for(;; ++pos){
+            Cell& cell = cells_[pos & mask_];
+            if(cell.sequence.load(std::memory_order_relaxed) != pos + 1) break;
+            item(cell)->~T();
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // ========================================
+    // 生产者（任意线程）
+    // ========================================
+
+    // 队列满时返回 false，参数不会被移走
+    template<typename... Args>
+    bool emplace(Args&&... args){
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for(;;){
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if(diff == 0){
+                if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0){
+                return false; // 队列满
+            }
+            else{
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        if constexpr (Blocking){
+            signal_.notify_all();
+        }
+        return true;
+    }
+
+    bool push(const T& value) { return emplace(value); }
+    bool push(T&& value) { return emplace(std::move(value)); }
+
+    // ========================================
+    // 消费者（只能有一个线程调用）
+    // ========================================
+
+    // 队列空时返回 false
+    bool take(T& out){
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        if(cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        T* value = item(cell);
+        out = std::move(*value);
+        value->~T();
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release); // 交还给下一圈的生产者
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 一次取出最多 max_count 个元素，对每个调用 fn(T&)，返回取出的数量
+    template<typename Fn>
+    size_t take_batch(Fn&& fn, size_t max_count){
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for(; count < max_count; ++count, ++pos){
+            Cell& cell = cells_[pos & mask_];
+            if(cell.sequence.load(std::memory_order_acquire) != pos + 1) break;
+            T* value = item(cell);
+            fn(*value);
+            value->~T();
+            cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        }
+        dequeue_pos_.store(pos, std::memory_order_relaxed);
+        return count;
+    }
+
+    // 队列空时睡眠等待，最多 timeout_ms 毫秒（-1 表示一直等），超时返回 false
+    bool wait_take(T& out, int timeout_ms = -1){
+        static_assert(Blocking, "wait_take 需要 MpscQueue<T, true>");
+        return signal_.await([&]{ return take(out); }, timeout_ms);
+    }
+
+    // ========================================
+    // 状态（近似值）
+    // ========================================
+
+    size_t size() const {
+        size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell{
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0}; // 生产者之间竞争
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0}; // 只有消费者写
+    alignas(CACHE_LINE_SIZE) const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    EventCount signal_;
+
+    static T* item(Cell& cell){
+        return std::launder(reinterpret_cast<T*>(&cell.storage));
+    }
+
+    // 至少 2 个格子：只有 1 个格子时，"已写入"的序号 pos + 1 和下一圈"可写入"的序号相同，
+    // 生产者会覆盖还没被取走的元素
+    static size_t round_up_pow2(size_t value){
+        size_t result = 2;
+        while(result < value) result <<= 1;
+        return result;
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// RTPS 参数列表（PL_CDR）
+// 参数列表 = 若干个参数 + PID_SENTINEL
+// 每个参数 = parameterId(2) + length(2) + 值，值补齐到 4 字节，length 包含补齐
+// PID 和 length 按所在数据的字节序（封装头或子消息的 E 标志）编码
+//
+// 发现数据（SPDP/SEDP）和 DATA 子消息的 inline QoS 都是参数列表。
+// 参数值以自己的开头为起点做 CDR 对齐
+// ============================================================
+
+using ParameterId = uint16_t;
+
+constexpr size_t PARAMETER_HEADER_SIZE = 4;
+constexpr size_t PARAMETER_ALIGNMENT = 4;
+constexpr size_t PARAMETER_MAX_LENGTH = 0xFFFC; // length 字段是 uint16，并且必须是 4 的倍数
+
+namespace ParameterIdValues{
+    constexpr ParameterId PID_PAD = 0x0000;
+    constexpr ParameterId PID_SENTINEL = 0x0001;
+    constexpr ParameterId PID_PARTICIPANT_LEASE_DURATION = 0x0002;
+    constexpr ParameterId PID_TOPIC_NAME = 0x0005;
+    constexpr ParameterId PID_TYPE_NAME = 0x0007;
+    constexpr ParameterId PID_PROTOCOL_VERSION = 0x0015;
+    constexpr ParameterId PID_VENDORID = 0x0016;
+    constexpr ParameterId PID_RELIABILITY = 0x001a;
+    constexpr ParameterId PID_DURABILITY = 0x001d;
+    constexpr ParameterId PID_UNICAST_LOCATOR = 0x002f;
+    constexpr ParameterId PID_DEFAULT_UNICAST_LOCATOR = 0x0031;
+    constexpr ParameterId PID_METATRAFFIC_UNICAST_LOCATOR = 0x0032;
+    constexpr ParameterId PID_METATRAFFIC_MULTICAST_LOCATOR = 0x0033;
+    constexpr ParameterId PID_CONTENT_FILTER_PROPERTY = 0x0035;
+    constexpr ParameterId PID_PARTICIPANT_GUID = 0x0050;
+    constexpr ParameterId PID_ENDPOINT_GUID = 0x005a;
+    constexpr ParameterId PID_KEY_HASH = 0x0070;
+    constexpr ParameterId PID_STATUS_INFO = 0x0071;
+
+    // PID 的最高两位
+    constexpr ParameterId PID_VENDOR_SPECIFIC_FLAG = 0x8000; // 厂商自定义，其他厂商应当忽略
+    constexpr ParameterId PID_MUST_UNDERSTAND_FLAG = 0x4000; // 不认识时必须丢弃整条数据
+}
+
+// 参数列表里的一个参数：value 直接指向输入缓冲区（不含参数头，含补齐）
+struct Parameter{
+    ParameterId id = ParameterIdValues::PID_PAD;
+    ConstByteSpan value;
+
+    bool vendor_specific() const { return (id & ParameterIdValues::PID_VENDOR_SPECIFIC_FLAG) != 0; }
+    bool must_understand() const { return (id & ParameterIdValues::PID_MUST_UNDERSTAND_FLAG) != 0; }
+};
+
+// ============================================================
+// ParameterListWriter: 在 CDR 序列化器上写参数列表
+//
+// begin(pid) 写入参数头并记下长度字段的位置（长度先写 0），
+// 之后直接用序列化器写参数值；end() 补齐到 4 字节并回填长度。
+// 只写一遍，不需要先算每个参数值的大小：
+//
+//     ParameterListWriter<CdrSerializer> writer(serializer);
+//     writer.begin(PID_TOPIC_NAME);
+//     serializer.serialize_string(name);
+//     writer.end();
+//     writer.finish();
+//
+// 写参数列表之前序列化器的写入位置必须 4 字节对齐（例如紧跟在封装头之后）
+// ============================================================
+template<typename Serializer>
+class ParameterListWriter{
+public:
+    explicit ParameterListWriter(Serializer& serializer) : serializer_(serializer) {}
+
+    Serializer& serializer() { return serializer_; }
+
+    // 开始一个参数
+    void begin(ParameterId id){
+        assert(!open_ && "上一个参数还没有 end()");
+        assert(serializer_.offset() % PARAMETER_ALIGNMENT == 0);
+        header_pos_ = serializer_.size();
+        serializer_.serialize_uint16(id);
+        serializer_.serialize_uint16(0); // 长度在 end() 时回填
+        saved_origin_ = serializer_.alignment_origin();
+        serializer_.set_alignment_origin(serializer_.size());
+        open_ = true;
+    }
+
+    // 结束当前参数：补齐并回填长度。参数值超过 PARAMETER_MAX_LENGTH 时返回 false
+    bool end(){
+        assert(open_ && "没有 begin() 的参数");
+        size_t value_start = serializer_.alignment_origin();
+        size_t padding = (PARAMETER_ALIGNMENT - (serializer_.size() - value_start) % PARAMETER_ALIGNMENT) %
+                         PARAMETER_ALIGNMENT;
+        if(padding != 0){
+            uint8_t* ptr = serializer_.reserve_bytes(padding);
+            if(ptr != nullptr) std::memset(ptr, 0, padding);
+        }
+        serializer_.set_alignment_origin(saved_origin_);
+        open_ = false;
+
+        size_t length = serializer_.size() - value_start;
+        if(length > PARAMETER_MAX_LENGTH){
+            good_ = false;
+            return false;
+        }
+        serializer_.patch_uint16(header_pos_ + 2, static_cast<uint16_t>(length));
+        return true;
+    }
+
+    // 写一个完整的参数：write_value(serializer) 负责写参数值
+    template<typename Fn>
+    bool add(ParameterId id, Fn&& write_value){
+        begin(id);
+        write_value(serializer_);
+        return end();
+    }
+
+    // 写一个不透明的参数值（原样复制）
+    bool add_bytes(ParameterId id, ConstByteSpan value){
+        begin(id);
+        if(!value.empty()){
+            uint8_t* ptr = serializer_.reserve_bytes(value.size());
+            if(ptr != nullptr) std::memcpy(ptr, value.data(), value.size());
+        }
+        return end();
+    }
+
+    // 写入 PID_SENTINEL 结束参数列表
+    bool finish(){
+        assert(!open_ && "最后一个参数还没有 end()");
+        serializer_.serialize_uint16(ParameterIdValues::PID_SENTINEL);
+        serializer_.serialize_uint16(0);
+        return good();
+    }
+
+    // 所有参数长度都合法，且序列化器没有写满
+    bool good() const { return good_ && serializer_.good(); }
+
+private:
+    Serializer& serializer_;
+    size_t header_pos_ = 0;   // 当前参数头在缓冲区里的绝对位置
+    size_t saved_origin_ = 0; // begin() 之前的对齐起点
+    bool open_ = false;
+    bool good_ = true;
+};
+
+// ============================================================
+// ParameterListReader: 零拷贝地遍历参数列表
+//
+// 只保存输入缓冲区的视图，next() 读出参数头后按 length 直接跳到下一个参数，
+// 不认识的参数不需要解析内容，跳过是 O(1) 的；参数值以视图返回，不复制。
+// 参数值用 value_deserializer() 解码（以参数值开头为对齐起点）。
+// 遇到 PID_SENTINEL 或数据不完整时停止，用 finished() / malformed() 区分
+//
+// 模板参数 Policy 是参数列表的字节序，用 decode_parameter_list() 按封装头选择
+// ============================================================
+template<typename Policy>
+class ParameterListReader{
+public:
+    // list 从第一个参数头开始（封装头之后）
+    explicit ParameterListReader(ConstByteSpan list) : list_(list) {}
+
+    static constexpr CdrEndian endian() { return Policy::endian; }
+
+    // 读出下一个参数（PID_PAD 自动跳过），没有更多参数时返回 false
+    bool next(Parameter& out){
+        while(!done_){
+            if(list_.size() - pos_ < PARAMETER_HEADER_SIZE){
+                fail();
+                return false;
+            }
+            ParameterId id = load_uint16(&list_[pos_]);
+            uint16_t length = load_uint16(&list_[pos_ + 2]);
+            pos_ += PARAMETER_HEADER_SIZE;
+            if(id == ParameterIdValues::PID_SENTINEL){ // 按规范 SENTINEL 的 length 被忽略
+                done_ = true;
+                finished_ = true;
+                return false;
+            }
+            if(length > list_.size() - pos_){
+                fail();
+                return false;
+            }
+            size_t value_pos = pos_;
+            pos_ += length;
+            if(id == ParameterIdValues::PID_PAD) continue;
+            out.id = id;
+            out.value = list_.subspan(value_pos, length);
+            return true;
+        }
+        return false;
+    }
+
+    // 对剩下的每个参数调用 fn(const Parameter&)；fn 返回 false 时提前停止
+    // 返回是否完整地读到了 PID_SENTINEL
+    template<typename Fn>
+    bool for_each(Fn&& fn){
+        Parameter parameter;
+        while(next(parameter)){
+            if(!fn(parameter)) return false;
+        }
+        return finished_;
+    }
+
+    // 跳过剩下的所有参数，返回是否以 PID_SENTINEL 正常结束
+    bool skip_to_end(){
+        Parameter parameter;
+        while(next(parameter)) {}
+        return finished_;
+    }
+
+    // 解码参数值的反序列化器（字节序与参数列表相同）
+    static BasicCdrDeserializer<Policy> value_deserializer(const Parameter& parameter){
+        return BasicCdrDeserializer<Policy>(parameter.value);
+    }
+
+    bool finished() const { return finished_; }   // 读到了 PID_SENTINEL
+    bool malformed() const { return malformed_; }  // 参数头或参数值超出了缓冲区
+
+    // 已经读过的字节数（读到 PID_SENTINEL 之后就是整个参数列表的长度）
+    size_t position() const { return pos_; }
+
+private:
+    ConstByteSpan list_;
+    size_t pos_ = 0;
+    bool done_ = false;
+    bool finished_ = false;
+    bool malformed_ = false;
+
+    void fail(){
+        done_ = true;
+        malformed_ = true;
+    }
+
+    static uint16_t load_uint16(const uint8_t* ptr){
+        if constexpr (Policy::endian == CdrEndian::LITTLE_ENDIAN_ORDER){
+            return static_cast<uint16_t>(ptr[0] | (ptr[1] << 8));
+        }
+        else{
+            return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+        }
+    }
+};
+
+using ParameterListReaderBE = ParameterListReader<BigEndianPolicy>;
+using ParameterListReaderLE = ParameterListReader<LittleEndianPolicy>;
+
+// 读取带封装头的参数列表（PL_CDR_BE / PL_CDR_LE）：
+// 按封装头选择字节序，用对应的 reader 调用 decode(reader)，返回 decode 的结果
+// decode 是一个泛型可调用对象（例如 [&](auto& reader){ ... }）
+// 封装头无效或者不是参数列表时返回 false，不会调用 decode
+template<typename Decoder>
+bool decode_parameter_list(ConstByteSpan payload, Decoder&& decode){
+    if(payload.size() < ENCAPSULATION_HEADER_SIZE) return false;
+    // 封装头第 2 个字节：bit1 = 参数列表，bit0 = 小端
+    if(payload[0] != 0 || (payload[1] & 0xFE) != 0x02) return false;
+    ConstByteSpan list = payload.subspan(ENCAPSULATION_HEADER_SIZE);
+    if(payload[1] & 0x01){
+        ParameterListReaderLE reader(list);
+        return decode(reader);
+    }
+    ParameterListReaderBE reader(list);
+    return decode(reader);
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "tinydds/rtps/sequence_number.hpp"
+#include "tinydds/rtps/sequence_number_set.hpp"
+#include "tinydds/rtps/span.hpp"
+#include "tinydds/rtps/timestamp.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+class EntityStatistics;
+
+// ============================================================
+// ReceiveWindow: 可靠读端针对一个远端写端的接收窗口
+//
+// 窗口覆盖 [next_expected, next_expected + 256)，正好是一个 ACKNACK 位图的范围。
+// 乱序到达的样本先存进以 seq & 255 为下标的槽位，"已收到" 状态记在一个 256 位的
+// 环形位图里（最高位在前，和线上的 SequenceNumberSet 相同）：
+//   - deliver() 用 clz 一次找出从 next_expected 开始连续收到的一段，按序交付
+//   - build_acknack() 按 32 位字取反生成缺失位图，代价是 O(字数)，和丢了多少个样本无关
+//   - GAP / HEARTBEAT 告知不再可用的序号按字批量标记，不逐个遍历
+//
+// 槽位里的 payload 在交付后保留容量，之后的样本复用；不是线程安全的
+// ============================================================
+class ReceiveWindow{
+public:
+    static constexpr size_t WINDOW_SIZE = SEQUENCE_NUMBER_SET_MAX_BITS;
+
+    enum class ReceiveResult : uint8_t {
+        ACCEPTED,      // 新样本，已存入窗口
+        DUPLICATE,     // 已经收到过（或者已经交付）
+        OUT_OF_WINDOW  // 超出窗口，丢弃，之后靠重传
+    };
+
+    explicit ReceiveWindow(const SequenceNumber& first_expected = SequenceNumber(1));
+
+    // DATA：payload 会被复制进槽位；source_timestamp 是 DATA 前面 INFO_TS 带的源时间戳（没有时无效）
+    ReceiveResult on_data(const SequenceNumber& sequence_number, ConstByteSpan payload,
+                          const Timestamp& source_timestamp = Timestamp());
+
+    // GAP：[gap_start, gap_list.base - 1] 以及 gap_list 中的序号不会再发送
+    void on_gap(const SequenceNumber& gap_start, const SequenceNumberSet& gap_list);
+
+    // HEARTBEAT：写端当前可用的范围是 [first, last]，first 之前没收到的样本不再等待
+    void on_heartbeat(const SequenceNumber& first, const SequenceNumber& last);
+
+    // 按序交付从 next_expected 开始所有已经就绪的样本：fn(const SequenceNumber&, ConstByteSpan)，
+    // fn 也可以多接收一个 const Timestamp&（样本的源时间戳）。
+    // 被 GAP/HEARTBEAT 标记为不可用的序号直接跳过。返回交付的样本数
+    template<typename Fn>
+    size_t deliver(Fn&& fn){
+        size_t delivered = 0;
+        for(;;){
+            // 从 next_expected 开始连续收到了 run 个
+            uint64_t bits = window_bits(slot_index(base_));
+            size_t run = ~bits == 0 ? 64 : static_cast<size_t>(__builtin_clzll(~bits));
+            if(run == 0){
+                if(base_ >= irrelevant_before_) break;
+                base_ += skip_irrelevant();
+                continue;
+            }
+            for(size_t i = 0; i < run; ++i){
+                int64_t seq = base_ + static_cast<int64_t>(i);
+                Slot& slot = slots_[slot_index(seq)];
+                if(slot.has_data){
+                    ConstByteSpan payload(slot.payload.data(), slot.payload.size());
+                    if constexpr(std::is_invocable_v<Fn&, const SequenceNumber&, ConstByteSpan, const Timestamp&>){
+                        fn(SequenceNumber(seq), payload, slot.source_timestamp);
+                    }
+                    else{
+                        fn(SequenceNumber(seq), payload);
+                    }
+                    slot.has_data = false;
+                    ++delivered;
+                }
+                clear_bit(slot_index(seq));
+            }
+            base_ += static_cast<int64_t>(run);
+        }
+        return delivered;
+    }
+
+    // 生成 ACKNACK 的 readerSNState：base 为 next_expected，
+    // 位图覆盖到已知的最大序号（HEARTBEAT 的 last 或者收到过的最大序号），1 表示缺失
+    // 有缺失的样本时返回 true
+    bool build_acknack(SequenceNumberSet& out) const;
+
+    // 下一个要交付的序号（它之前的都已经交付或者被跳过）
+    SequenceNumber next_expected() const { return SequenceNumber(base_); }
+
+    // 写端已知的最大序号
+    SequenceNumber last_known() const {
+        return SequenceNumber(highest_received_ > writer_last_ ? highest_received_ : writer_last_);
+    }
+
+    // 已收到但是还不能按序交付的样本数
+    size_t pending() const;
+
+    // 超出窗口被丢弃的样本和请求重传的 ACKNACK 记到这里（nullptr 不统计）。
+    // 收到的样本数/字节数由交付的目的地（DataReader）记录，这里不重复计数
+    void set_statistics(EntityStatistics* statistics){ statistics_ = statistics; }
+
+private:
+    struct Slot{
+        std::vector<uint8_t> payload;
+        Timestamp source_timestamp;
+        bool has_data = false; // false 表示序号被标记为不可用（没有数据，只需跳过）
+    };
+
+    static constexpr size_t WORDS = WINDOW_SIZE / 64;
+    static constexpr size_t MASK = WINDOW_SIZE - 1;
+
+    std::array<Slot, WINDOW_SIZE> slots_;
+    std::array<uint64_t, WORDS> received_{}; // 环形位图，环上位置 p 在 received_[p / 64] 的第 63 - p % 64 位
+    int64_t base_;                      // next_expected
+    int64_t irrelevant_before_;         // 小于它的序号都不再等待
+    int64_t highest_received_;
+    int64_t writer_last_;
+    EntityStatistics* statistics_ = nullptr;
+
+    static size_t slot_index(int64_t seq) { return static_cast<size_t>(seq) & MASK; }
+
+    bool test_bit(size_t pos) const { return (received_[pos / 64] >> (63 - pos % 64)) & 1u; }
+    void set_bit(size_t pos) { received_[pos / 64] |= uint64_t(1) << (63 - pos % 64); }
+    void clear_bit(size_t pos) { received_[pos / 64] &= ~(uint64_t(1) << (63 - pos % 64)); }
+
+    // 从环上位置 pos 开始（绕回）的 64 位，最高位对应 pos
+    uint64_t window_bits(size_t pos) const {
+        size_t word = pos / 64;
+        size_t shift = pos % 64;
+        if(shift == 0) return received_[word];
+        return (received_[word] << shift) | (received_[(word + 1) % WORDS] >> (64 - shift));
+    }
+
+    // next_expected 没收到但是已经不可用：跳到下一个收到的序号或者 irrelevant_before_，返回跳过的个数
+    int64_t skip_irrelevant() const;
+
+    // 把窗口内 [first, last] 标记为收到（没有数据）
+    void mark_irrelevant(int64_t first, int64_t last);
+};
+
+} // namespace rtps
+} // namespace tinydds
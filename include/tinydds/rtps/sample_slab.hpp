@@ -0,0 +1,282 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds{
+namespace rtps{
+
+template<typename T>
+class SampleSlab;
+
+namespace detail{
+
+// 有界类型（内存布局不是 CDR 布局时）在槽位里预留的序列化缓冲区：封装头 + 编译期大小
+template<typename T>
+constexpr size_t slab_serialized_capacity(){
+    if constexpr (has_cdr_type_support<T>::value){
+        if constexpr (is_cdr_bounded<T>() && !is_cdr_memcpy_layout<T>()){
+            return ENCAPSULATION_HEADER_SIZE + get_serialized_size<T>();
+        }
+    }
+    return 0;
+}
+
+// 一个样本槽位：
+//   prefix 的最后 4 个字节是封装头，紧跟着就是样本本身，
+//   内存布局即 CDR 布局的类型，[封装头][样本] 这段内存原样就是序列化数据
+template<typename T>
+struct SampleSlot{
+    static constexpr size_t PREFIX = alignof(T) > 8 ? alignof(T) : 8;
+    static constexpr size_t SERIALIZED_CAPACITY = slab_serialized_capacity<T>();
+
+    alignas(PREFIX) uint8_t prefix[PREFIX] = {};
+    T value{};
+    alignas(8) uint8_t serialized[SERIALIZED_CAPACITY > 0 ? SERIALIZED_CAPACITY : 1];
+    std::atomic<SampleSlot*> next_free{nullptr}; // 空闲链表；借出之后其他线程仍可能读到它，所以是原子的
+
+    uint8_t* encapsulation() { return prefix + PREFIX - ENCAPSULATION_HEADER_SIZE; }
+};
+
+} // namespace detail
+
+// ============================================================
+// LoanedSample: 从 SampleSlab 借出的一个样本
+//
+// 只能移动，析构或 reset() 时归还给 slab。借出的样本保留上一次使用时的内容
+// （vector / string 的容量也保留），调用方直接覆盖需要的字段，稳定运行时不再分配内存
+// ============================================================
+template<typename T>
+class LoanedSample{
+public:
+    LoanedSample() = default;
+
+    ~LoanedSample(){
+        reset();
+    }
+
+    LoanedSample(const LoanedSample&) = delete;
+    LoanedSample& operator=(const LoanedSample&) = delete;
+
+    LoanedSample(LoanedSample&& other) noexcept : slab_(other.slab_), slot_(other.slot_){
+        other.slab_ = nullptr;
+        other.slot_ = nullptr;
+    }
+
+    LoanedSample& operator=(LoanedSample&& other) noexcept{
+        if(this != &other){
+            reset();
+            slab_ = other.slab_;
+            slot_ = other.slot_;
+            other.slab_ = nullptr;
+            other.slot_ = nullptr;
+        }
+        return *this;
+    }
+
+    explicit operator bool() const { return slot_ != nullptr; }
+
+    T* get() { return &slot_->value; }
+    const T* get() const { return &slot_->value; }
+    T& operator*() { return slot_->value; }
+    const T& operator*() const { return slot_->value; }
+    T* operator->() { return &slot_->value; }
+    const T* operator->() const { return &slot_->value; }
+
+    // 能否由 serialize() 直接得到序列化数据（有界类型）；否则调用方用自己的序列化器编码
+    static constexpr bool serializes_in_place(){
+        return is_cdr_memcpy_layout<T>() || detail::SampleSlot<T>::SERIALIZED_CAPACITY > 0;
+    }
+
+    // 带封装头的序列化数据（本机字节序），视图在下一次 serialize() 或归还之前有效：
+    //   - 内存布局即 CDR 布局：不编码，直接返回槽位里 [封装头][样本] 这段内存
+    //   - 其他有界类型：编码到槽位自带的缓冲区
+    //   - 变长类型：返回空视图
+    ConstByteSpan serialize(){
+        if constexpr (is_cdr_memcpy_layout<T>()){
+            return ConstByteSpan(slot_->encapsulation(), ENCAPSULATION_HEADER_SIZE + get_serialized_size<T>());
+        }
+        else if constexpr (detail::SampleSlot<T>::SERIALIZED_CAPACITY > 0){
+            CdrPresizedSerializer serializer(ByteSpan(slot_->serialized, detail::SampleSlot<T>::SERIALIZED_CAPACITY));
+            serializer.serialize_encapsulation();
+            serializer.serialize_type(slot_->value);
+            return serializer.buffer();
+        }
+        else{
+            return ConstByteSpan();
+        }
+    }
+
+    // 归还给 slab，自身变为空
+    void reset(){
+        if(slot_ != nullptr){
+            slab_->give_back(slot_);
+            slab_ = nullptr;
+            slot_ = nullptr;
+        }
+    }
+
+private:
+    friend class SampleSlab<T>;
+
+    LoanedSample(SampleSlab<T>* slab, detail::SampleSlot<T>* slot) : slab_(slab), slot_(slot) {}
+
+    SampleSlab<T>* slab_ = nullptr;
+    detail::SampleSlot<T>* slot_ = nullptr;
+};
+
+// ============================================================
+// SampleSlab: 一个主题（类型 T）的样本分配器
+//
+// 按 samples_per_slab 个样本一块向系统申请内存，样本在块里构造一次之后一直复用：
+// loan() 从空闲链表取一个，LoanedSample 析构时放回去，热路径上不调用 malloc，
+// 也不重新构造样本。块只在空闲链表为空时追加（预热阶段），之后不再释放。
+//
+// 写端借出的样本在发送线程归还、读端借出的样本在应用线程归还，空闲链表是无锁的
+// Treiber 栈：表头是一个 64 位字，低 48 位是槽位指针（用户态地址不超过 48 位），
+// 高 16 位是每次修改都加一的标记，避免 ABA（弹出时读到的 next 已经过时，CAS 会因为标记不同而失败）。
+// 槽位的内存在 slab 析构之前不会释放，所以读到过时的 next 也是安全的。
+// 锁只在 grow() 追加块时使用，loan()/归还不加锁。
+// 注意：slab 必须比从它借出的所有样本活得更久
+// ============================================================
+template<typename T>
+class SampleSlab{
+public:
+    static_assert(sizeof(void*) == 8, "空闲链表的标记指针需要 64 位地址");
+
+    // samples_per_slab: 每次申请的样本数；max_samples: 最多的样本数（0 表示不限）
+    // preallocate: 构造时先准备好的样本数
+    explicit SampleSlab(size_t samples_per_slab = 64, size_t max_samples = 0, size_t preallocate = 0)
+        : samples_per_slab_(samples_per_slab == 0 ? 1 : samples_per_slab), max_samples_(max_samples){
+        std::lock_guard<std::mutex> lock(mutex_);
+        while(capacity_ < preallocate && grow(false) != nullptr) {}
+    }
+
+    SampleSlab(const SampleSlab&) = delete;
+    SampleSlab& operator=(const SampleSlab&) = delete;
+
+    // 借出一个样本，已经达到 max_samples 并且都借出去时返回空
+    LoanedSample<T> loan(){
+        detail::SampleSlot<T>* slot = pop();
+        if(slot == nullptr){
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot = pop(); // 等锁的时候其他线程可能已经追加过
+            if(slot == nullptr){
+                slot = grow(true);
+                if(slot == nullptr) return LoanedSample<T>();
+            }
+        }
+        available_.fetch_sub(1, std::memory_order_relaxed);
+        return LoanedSample<T>(this, slot);
+    }
+
+    // 已经申请的样本数
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    // 空闲的样本数（其他线程同时借还时是近似值）
+    size_t available() const { return available_.load(std::memory_order_relaxed); }
+
+    // 向系统申请内存的次数（预热之后应该不再增加）
+    size_t slabs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slabs_.size();
+    }
+
+private:
+    friend class LoanedSample<T>;
+
+    static constexpr unsigned POINTER_BITS = 48;
+    static constexpr uint64_t POINTER_MASK = (uint64_t(1) << POINTER_BITS) - 1;
+
+    size_t samples_per_slab_;
+    size_t max_samples_;
+    mutable std::mutex mutex_; // 保护 slabs_ 和 capacity_
+    std::vector<std::unique_ptr<detail::SampleSlot<T>[]>> slabs_;
+    size_t capacity_ = 0;
+    std::atomic<uint64_t> free_{0}; // 空闲链表表头：标记 << 48 | 槽位指针
+    std::atomic<size_t> available_{0};
+
+    static detail::SampleSlot<T>* slot_of(uint64_t head){
+        return reinterpret_cast<detail::SampleSlot<T>*>(static_cast<uintptr_t>(head & POINTER_MASK));
+    }
+
+    // 用 head 的标记加一和新的槽位组成下一个表头
+    static uint64_t next_head(uint64_t head, detail::SampleSlot<T>* slot){
+        uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(slot));
+        assert((address & ~POINTER_MASK) == 0);
+        return ((head >> POINTER_BITS) + 1) << POINTER_BITS | address;
+    }
+
+    detail::SampleSlot<T>* pop(){
+        uint64_t head = free_.load(std::memory_order_acquire);
+        for(;;){
+            detail::SampleSlot<T>* slot = slot_of(head);
+            if(slot == nullptr) return nullptr;
+            detail::SampleSlot<T>* next = slot->next_free.load(std::memory_order_relaxed);
+            if(free_.compare_exchange_weak(head, next_head(head, next), std::memory_order_acquire,
+                                           std::memory_order_acquire)){
+                return slot;
+            }
+        }
+    }
+
+    // 把 first -> ... -> last 这一串放回空闲链表
+    void push(detail::SampleSlot<T>* first, detail::SampleSlot<T>* last){
+        uint64_t head = free_.load(std::memory_order_relaxed);
+        do{
+            last->next_free.store(slot_of(head), std::memory_order_relaxed);
+        }while(!free_.compare_exchange_weak(head, next_head(head, first), std::memory_order_release,
+                                            std::memory_order_relaxed));
+    }
+
+    void give_back(detail::SampleSlot<T>* slot){
+        push(slot, slot);
+        available_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 追加一块（调用方持有锁），reserve_one 为 true 时第一个样本直接交给调用方，其余放进空闲链表。
+    // 返回新块的第一个样本，达到 max_samples 时返回 nullptr
+    detail::SampleSlot<T>* grow(bool reserve_one){
+        size_t count = samples_per_slab_;
+        if(max_samples_ != 0){
+            if(capacity_ >= max_samples_) return nullptr;
+            if(count > max_samples_ - capacity_) count = max_samples_ - capacity_;
+        }
+        std::unique_ptr<detail::SampleSlot<T>[]> slab(new detail::SampleSlot<T>[count]);
+        for(size_t i = 0; i < count; ++i){
+            detail::SampleSlot<T>& slot = slab[i];
+            assert(reinterpret_cast<uint8_t*>(&slot.value) == slot.prefix + detail::SampleSlot<T>::PREFIX);
+            if constexpr (is_cdr_memcpy_layout<T>()){
+                // 封装头只写一次，之后每次 serialize() 直接返回这段内存
+                CdrPresizedSerializer header(ByteSpan(slot.encapsulation(), ENCAPSULATION_HEADER_SIZE));
+                header.serialize_encapsulation();
+            }
+            if(i + 1 < count) slot.next_free.store(&slab[i + 1], std::memory_order_relaxed);
+        }
+        detail::SampleSlot<T>* first = &slab[0];
+        size_t pushed = reserve_one ? count - 1 : count;
+        if(pushed > 0){
+            push(reserve_one ? &slab[1] : first, &slab[count - 1]);
+        }
+        slabs_.push_back(std::move(slab));
+        capacity_ += count;
+        // 交给调用方的那个样本在 loan() 里计为借出
+        available_.fetch_add(reserve_one ? pushed + 1 : pushed, std::memory_order_relaxed);
+        return first;
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "tinydds/rtps/sequence_number.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// SequenceNumberSet 最多 256 位（8 个 32 位字）
+constexpr uint32_t SEQUENCE_NUMBER_SET_MAX_BITS = 256;
+constexpr size_t SEQUENCE_NUMBER_SET_MAX_WORDS = SEQUENCE_NUMBER_SET_MAX_BITS / 32;
+
+// ============================================================
+// SequenceNumberSet: 基准序号 + 最多 256 位的位图（ACKNACK/GAP 的线上格式）
+// 第 i 位（从第一个字的最高位开始数）为 1 表示序号 base + i 在集合中
+//
+// 计数、查找、遍历都按 32 位字处理（popcount / clz），
+// 代价是 O(字数) 而不是 O(序号个数)
+// ============================================================
+struct SequenceNumberSet{
+    SequenceNumber base;
+    uint32_t num_bits = 0;
+    std::array<uint32_t, SEQUENCE_NUMBER_SET_MAX_WORDS> bitmap{};
+
+    SequenceNumberSet() = default;
+
+    explicit SequenceNumberSet(const SequenceNumber& base, uint32_t num_bits = 0)
+        : base(base), num_bits(num_bits > SEQUENCE_NUMBER_SET_MAX_BITS ? SEQUENCE_NUMBER_SET_MAX_BITS : num_bits) {}
+
+    // 清空并换一个基准序号
+    void reset(const SequenceNumber& new_base, uint32_t new_num_bits = 0){
+        base = new_base;
+        num_bits = new_num_bits > SEQUENCE_NUMBER_SET_MAX_BITS ? SEQUENCE_NUMBER_SET_MAX_BITS : new_num_bits;
+        bitmap.fill(0);
+    }
+
+    size_t num_words() const { return (num_bits + 31) / 32; }
+
+    // ========================================
+    // 单个序号
+    // ========================================
+
+    // 加入一个序号，超出 base 之后 256 个序号的范围时返回 false
+    // 需要时自动扩大 num_bits
+    bool add(const SequenceNumber& seq){
+        int64_t offset = seq - base;
+        if(offset < 0 || offset >= static_cast<int64_t>(SEQUENCE_NUMBER_SET_MAX_BITS)) return false;
+        bitmap[offset / 32] |= 0x80000000u >> (offset % 32);
+        if(static_cast<uint32_t>(offset) >= num_bits){
+            num_bits = static_cast<uint32_t>(offset) + 1;
+        }
+        return true;
+    }
+
+    void remove(const SequenceNumber& seq){
+        int64_t offset = seq - base;
+        if(offset < 0 || offset >= static_cast<int64_t>(num_bits)) return;
+        bitmap[offset / 32] &= ~(0x80000000u >> (offset % 32));
+    }
+
+    bool contains(const SequenceNumber& seq) const {
+        int64_t offset = seq - base;
+        if(offset < 0 || offset >= static_cast<int64_t>(num_bits)) return false;
+        return (bitmap[offset / 32] >> (31 - offset % 32)) & 1u;
+    }
+
+    // ========================================
+    // 按字处理
+    // ========================================
+
+    // 把 [first, last] 中落在位图范围内的部分全部置 1（不扩大 num_bits）
+    void add_range(const SequenceNumber& first, const SequenceNumber& last){
+        int64_t begin = first - base;
+        int64_t end = (last - base) + 1;
+        if(begin < 0) begin = 0;
+        if(end > static_cast<int64_t>(num_bits)) end = num_bits;
+        while(begin < end){
+            size_t word = static_cast<size_t>(begin / 32);
+            uint32_t shift = static_cast<uint32_t>(begin % 32);
+            int64_t count = end - begin < 32 - shift ? end - begin : 32 - shift;
+            uint32_t mask = count == 32 ? 0xFFFFFFFFu : ((1u << count) - 1) << (32 - shift - count);
+            bitmap[word] |= mask;
+            begin += count;
+        }
+    }
+
+    bool empty() const {
+        for(size_t i = 0; i < num_words(); ++i){
+            if(bitmap[i] != 0) return false;
+        }
+        return true;
+    }
+
+    // 集合中的序号个数
+    size_t count() const {
+        size_t total = 0;
+        for(size_t i = 0; i < num_words(); ++i){
+            total += static_cast<size_t>(__builtin_popcount(bitmap[i]));
+        }
+        return total;
+    }
+
+    // 最小的序号，集合为空时返回 SEQUENCENUMBER_UNKNOWN
+    SequenceNumber first() const {
+        for(size_t i = 0; i < num_words(); ++i){
+            if(bitmap[i] != 0){
+                return base + static_cast<int64_t>(i * 32 + __builtin_clz(bitmap[i]));
+            }
+        }
+        return SequenceNumberValues::SEQUENCENUMBER_UNKNOWN;
+    }
+
+    // 按递增顺序对集合中的每个序号调用 fn(const SequenceNumber&)，跳过全 0 的字
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for(size_t i = 0; i < num_words(); ++i){
+            uint32_t word = bitmap[i];
+            while(word != 0){
+                uint32_t bit = static_cast<uint32_t>(__builtin_clz(word));
+                fn(base + static_cast<int64_t>(i * 32 + bit));
+                word &= ~(0x80000000u >> bit);
+            }
+        }
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
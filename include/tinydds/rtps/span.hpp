@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace tinydds{
+namespace rtps{
+
+// ============================================================
+// Span: 非拥有的连续内存视图
+// C++17 没有 std::span，这里实现一个够用的简化版本
+// 只保存指针和长度，不负责内存的分配和释放，调用方要保证内存的生命周期
+// ============================================================
+template<typename T>
+class Span{
+public:
+    Span() = default;
+
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    // 从任何提供 data()/size() 的连续容器构造（std::vector、std::array、Span 等）
+    // 例如 std::vector<uint8_t> 可以隐式转换为 Span<const uint8_t>
+    template<typename Container,
+             typename = std::enable_if_t<
+                 std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>>
+    Span(Container& container) : data_(container.data()), size_(container.size()) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](size_t index) const { return data_[index]; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    // 截取子视图 [offset, offset + count)
+    Span subspan(size_t offset, size_t count) const {
+        return Span(data_ + offset, count);
+    }
+
+    Span subspan(size_t offset) const {
+        return Span(data_ + offset, size_ - offset);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+using ByteSpan = Span<uint8_t>;            // 可写字节视图
+using ConstByteSpan = Span<const uint8_t>; // 只读字节视图
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "tinydds/rtps/event_count.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// SpscQueue: 有界单生产者/单消费者无锁环形队列
+//
+// 用于只有一个接收线程给某个 DataReader 投递样本的情况（单写端主题）。
+// 生产者只写 tail、消费者只写 head，两者在不同的缓存行上；
+// 双方各自缓存一份对方的位置，只有看起来满/空时才去读对方的缓存行。
+// push() 和 take() 都是 wait-free 的：没有 CAS，没有锁，失败时立即返回。
+//
+// 模板参数 Blocking 为 true 时消费者可以用 wait_take() 睡眠等待（futex），
+// 代价是每次 push 多一次内存屏障；为 false 时只能轮询 take()。
+// 元素原地构造在环里，不需要默认构造函数；容量向上取 2 的幂
+// ============================================================
+template<typename T, bool Blocking = true>
+class SpscQueue{
+public:
+    explicit SpscQueue(size_t capacity) : mask_(round_up_pow2(capacity) - 1), slots_(new Slot[mask_ + 1]) {}
+
+    ~SpscQueue(){
+        size_t head = consumer_.head.load(std::memory_order_relaxed);
+        size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        for(; head != tail; ++head){
+            slot(head)->~T();
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // ========================================
+    // 生产者（只能有一个线程调用）
+    // ========================================
+
+    // 队列满时返回 false，参数不会被移走
+    template<typename... Args>
+    bool emplace(Args&&... args){
+        size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if(tail - producer_.cached_head > mask_){
+            producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+            if(tail - producer_.cached_head > mask_) return false;
+        }
+        new (storage(tail)) T(std::forward<Args>(args)...);
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        if constexpr (Blocking){
+            signal_.notify_all();
+        }
+        return true;
+    }
+
+    bool push(const T& value) { return emplace(value); }
+    bool push(T&& value) { return emplace(std::move(value)); }
+
+    // ========================================
+    // 消费者（只能有一个线程调用）
+    // ========================================
+
+    // 队列空时返回 false
+    bool take(T& out){
+        size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if(head == consumer_.cached_tail){
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+            if(head == consumer_.cached_tail) return false;
+        }
+        T* item = slot(head);
+        out = std::move(*item);
+        item->~T();
+        consumer_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 一次取出最多 max_count 个元素，对每个调用 fn(T&)，返回取出的数量
+    // 元素在 fn 返回后析构；整批只更新一次 head
+    template<typename Fn>
+    size_t take_batch(Fn&& fn, size_t max_count){
+        size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if(consumer_.cached_tail - head < max_count){
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+        }
+        size_t available = consumer_.cached_tail - head;
+        size_t count = available < max_count ? available : max_count;
+        for(size_t i = 0; i < count; ++i){
+            T* item = slot(head + i);
+            fn(*item);
+            item->~T();
+        }
+        if(count != 0){
+            consumer_.head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // 队列空时睡眠等待，最多 timeout_ms 毫秒（-1 表示一直等），超时返回 false
+    bool wait_take(T& out, int timeout_ms = -1){
+        static_assert(Blocking, "wait_take 需要 SpscQueue<T, true>");
+        return signal_.await([&]{ return take(out); }, timeout_ms);
+    }
+
+    // ========================================
+    // 状态（其他线程读到的只是近似值）
+    // ========================================
+
+    size_t size() const {
+        size_t tail = producer_.tail.load(std::memory_order_acquire);
+        size_t head = consumer_.head.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    struct alignas(CACHE_LINE_SIZE) ProducerState{
+        std::atomic<size_t> tail{0}; // 下一个写入位置（单调递增，取模得到槽位）
+        size_t cached_head = 0;      // 生产者看到的 head，只有看起来满时才刷新
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ConsumerState{
+        std::atomic<size_t> head{0};
+        size_t cached_tail = 0;
+    };
+
+    ProducerState producer_;
+    ConsumerState consumer_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    EventCount signal_;
+
+    void* storage(size_t index) const {
+        return &slots_[index & mask_];
+    }
+
+    T* slot(size_t index) const {
+        return std::launder(reinterpret_cast<T*>(&slots_[index & mask_]));
+    }
+
+    static size_t round_up_pow2(size_t value){
+        size_t result = 1;
+        while(result < value) result <<= 1;
+        return result;
+    }
+};
+
+} // namespace rtps
+} // namespace tinydds
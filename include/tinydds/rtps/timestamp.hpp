@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// Timestamp: RTPS 的 Time_t，UNIX 纪元起的秒数 + 小数部分（单位 1/2^32 秒）
+//
+// INFO_TS 子消息携带写端写入样本时的源时间戳，读端用它抽样计算端到端延迟。
+// 用的是系统时钟，跨机器时两端的时钟需要同步（同一台机器上总是成立）
+// ============================================================
+struct Timestamp{
+    int32_t seconds = -1;           // 默认值是 TIME_INVALID
+    uint32_t fraction = 0xFFFFFFFF;
+
+    Timestamp() = default;
+    Timestamp(int32_t seconds, uint32_t fraction) : seconds(seconds), fraction(fraction) {}
+
+    bool valid() const { return !(seconds == -1 && fraction == 0xFFFFFFFF); }
+
+    // 纪元起的纳秒数（不能是负数）
+    static Timestamp from_nanoseconds(int64_t nanoseconds){
+        uint64_t remainder = static_cast<uint64_t>(nanoseconds % 1000000000);
+        return Timestamp(static_cast<int32_t>(nanoseconds / 1000000000),
+                         static_cast<uint32_t>((remainder << 32) / 1000000000));
+    }
+
+    int64_t to_nanoseconds() const {
+        return static_cast<int64_t>(seconds) * 1000000000 +
+               static_cast<int64_t>((static_cast<uint64_t>(fraction) * 1000000000) >> 32);
+    }
+
+    // 当前的系统时间
+    static Timestamp now(){
+        auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+        return from_nanoseconds(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+    }
+
+    bool operator==(const Timestamp& other) const { return seconds == other.seconds && fraction == other.fraction; }
+    bool operator!=(const Timestamp& other) const { return !(*this == other); }
+};
+
+} // namespace rtps
+} // namespace tinydds
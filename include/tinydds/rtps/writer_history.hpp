@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "tinydds/rtps/sequence_number.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+class EntityStatistics;
+
+// ============================================================
+// HistoryQos: 写端历史缓存的保留策略
+// KEEP_LAST: 只保留最近 depth 个样本，写入新样本时自动挤掉最旧的
+// KEEP_ALL:  保留所有未确认的样本，最多 max_samples 个，满了之后写入失败，
+//            需要等读端确认后调用 remove_changes_up_to() 腾出空间
+// ============================================================
+enum class HistoryKind : uint8_t {
+    KEEP_LAST,
+    KEEP_ALL
+};
+
+struct HistoryQos{
+    HistoryKind kind = HistoryKind::KEEP_LAST;
+    size_t depth = 1;          // KEEP_LAST 时有效
+    size_t max_samples = 1024; // KEEP_ALL 时有效
+};
+
+// ============================================================
+// CacheChange: 历史缓存中的一个样本
+// payload 是带封装头的序列化数据，存储在槽位里反复复用
+// ============================================================
+struct CacheChange{
+    SequenceNumber sequence_number;
+    std::vector<uint8_t> payload;
+
+    ConstByteSpan span() const { return ConstByteSpan(payload.data(), payload.size()); }
+};
+
+// ============================================================
+// WriterHistoryCache: 以序列号为下标的环形历史缓存
+//
+// 缓存中的样本序列号总是连续的 [min_seq, max_seq]，
+// 样本 seq 放在槽位 seq & mask 上（容量向上取整为 2 的幂，窗口连续且不超过容量，
+// 相当于从 min_seq 的槽位起偏移 seq - min_seq）：
+//   - 写入、按序列号查找、按范围删除都是 O(1)，不需要 map
+//   - 槽位在构造时一次性分配，删除样本不释放 payload 的内存，
+//     新样本直接写进被复用的槽位，稳定运行时没有堆分配
+//   - 重传时 get_change() 直接返回槽位里的数据视图
+//
+// 不是线程安全的，由所属的写端负责加锁
+// ============================================================
+class WriterHistoryCache{
+public:
+    // sample_capacity: 每个槽位预留的 payload 容量，避免前几轮写入时扩容
+    explicit WriterHistoryCache(const HistoryQos& qos = HistoryQos(), size_t sample_capacity = 0);
+
+    // 写入新样本，分配下一个序列号（从 1 开始）
+    // KEEP_ALL 并且缓存已满时返回 false
+    bool add_change(ConstByteSpan serialized_payload, SequenceNumber& sequence_number);
+
+    bool add_change(ConstByteSpan serialized_payload){
+        SequenceNumber ignored;
+        return add_change(serialized_payload, ignored);
+    }
+
+    // 按序列号查找，不在缓存中（已删除或者还没写入）时返回 nullptr
+    const CacheChange* get_change(const SequenceNumber& sequence_number) const{
+        int64_t seq = sequence_number.to_int64();
+        if(seq < base_ || seq >= next_) return nullptr;
+        return &slots_[slot_index(seq)];
+    }
+
+    // 删除所有序列号 <= sequence_number 的样本（所有读端都确认之后调用），返回删除的数量
+    size_t remove_changes_up_to(const SequenceNumber& sequence_number);
+
+    // 删除最旧的样本
+    bool remove_min_change();
+
+    // 对 [first, last] 与缓存的交集中的每个样本调用 fn(const CacheChange&)，按序列号递增
+    template<typename Fn>
+    void for_each_change(const SequenceNumber& first, const SequenceNumber& last, Fn&& fn) const{
+        int64_t begin = first.to_int64() > base_ ? first.to_int64() : base_;
+        int64_t end = last.to_int64() + 1 < next_ ? last.to_int64() + 1 : next_;
+        for(int64_t seq = begin; seq < end; ++seq){
+            fn(slots_[slot_index(seq)]);
+        }
+    }
+
+    // ========================================
+    // 状态查询
+    // ========================================
+
+    bool empty() const { return base_ == next_; }
+    size_t size() const { return static_cast<size_t>(next_ - base_); }
+
+    // 能同时保存的样本数（KEEP_LAST 为 depth，KEEP_ALL 为 max_samples）
+    size_t max_size() const { return limit_; }
+    bool full() const { return size() >= limit_; }
+
+    // 缓存为空时 min_seq() == next_sequence_number()，max_seq() == min_seq() - 1，
+    // 这正好是 HEARTBEAT 在没有样本时要求的 first/last
+    SequenceNumber min_seq() const { return SequenceNumber(base_); }
+    SequenceNumber max_seq() const { return SequenceNumber(next_ - 1); }
+    SequenceNumber next_sequence_number() const { return SequenceNumber(next_); }
+
+    const HistoryQos& qos() const { return qos_; }
+
+    // 可靠写端（读端确认后调用 remove_changes_up_to）：KEEP_LAST 挤掉的样本还没被确认，记为丢弃。
+    // 尽力而为的写端不等确认，挤掉最旧的样本只是正常的替换，不算丢弃。默认是尽力而为
+    void set_reliable(bool reliable){ reliable_ = reliable; }
+    bool reliable() const { return reliable_; }
+
+    // KEEP_ALL 写满时被拒绝的样本、可靠写端 KEEP_LAST 挤掉的没被确认的样本和队列深度记到这里（nullptr 不统计）。
+    // 发出的样本数由真正发送的一方（DataWriter）记录，进缓存不算发出
+    void set_statistics(EntityStatistics* statistics){ statistics_ = statistics; }
+
+private:
+    HistoryQos qos_;
+    size_t limit_;
+    size_t mask_;
+    std::vector<CacheChange> slots_;
+    int64_t base_ = 1; // 缓存中最旧样本的序列号
+    int64_t next_ = 1; // 下一个要分配的序列号
+    bool reliable_ = false;
+    EntityStatistics* statistics_ = nullptr;
+
+    size_t slot_index(int64_t seq) const { return static_cast<size_t>(seq) & mask_; }
+};
+
+} // namespace rtps
+} // namespace tinydds
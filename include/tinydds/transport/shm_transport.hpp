@@ -0,0 +1,168 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tinydds/rtps/locator.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace transport {
+
+using rtps::ByteSpan;
+using rtps::ConstByteSpan;
+using rtps::Locator;
+
+// ============================================================
+// 共享内存传输配置
+// ============================================================
+struct ShmTransportConfig{
+    uint32_t port = 0;                // 接收端口，决定本参与者的共享内存段名字
+    size_t slot_count = 256;          // 段内的样本槽位数量（会向上取整为 2 的幂）
+    size_t slot_size = 64 * 1024;     // 每个槽位的字节数（单个样本的最大长度）
+    std::string segment_prefix = "tinydds_shm"; // 段名前缀：/<prefix>_<port>
+    uint32_t spin_before_wait = 2000; // 接收时先自旋轮询多少次，再进入 futex 等待
+    int peer_check_interval_ms = 1000; // 多久确认一次缓存的对端段仍然有效（所有者存活、没有被重新创建）
+    int peer_retry_interval_ms = 100;  // 对端段打开失败后，多久之内不再尝试
+};
+
+class ShmSegment;
+
+// ============================================================
+// ShmLoan: 从对端的共享内存段借出的一个槽位
+// 调用方直接把样本写进 buffer()（例如 CdrSerializer(loan.buffer())），
+// 然后 ShmTransport::commit() 把描述符交给对端；不提交就析构时槽位自动归还
+// loan 持有对端段的映射，可以比 ShmTransport（或者它对该对端的缓存）活得更久
+// ============================================================
+class ShmLoan{
+public:
+    ShmLoan() = default;
+    ~ShmLoan();
+
+    ShmLoan(const ShmLoan&) = delete;
+    ShmLoan& operator=(const ShmLoan&) = delete;
+
+    ShmLoan(ShmLoan&& other) noexcept;
+    ShmLoan& operator=(ShmLoan&& other) noexcept;
+
+    bool valid() const { return segment_ != nullptr; }
+    ByteSpan buffer() const { return buffer_; }
+
+private:
+    friend class ShmTransport;
+
+    ShmLoan(std::shared_ptr<ShmSegment> segment, uint32_t slot, ByteSpan buffer)
+        : segment_(std::move(segment)), slot_(slot), buffer_(buffer) {}
+
+    void release();
+
+    std::shared_ptr<ShmSegment> segment_;
+    uint32_t slot_ = 0;
+    ByteSpan buffer_;
+};
+
+// ============================================================
+// ShmTransport: 同一台机器上参与者之间的共享内存传输
+//
+// 每个参与者创建一个以接收端口命名的 POSIX 共享内存段，段里有：
+// - 固定数量的样本槽位：发送方的 CdrSerializer 直接写进去，不经过内核
+// - 空闲槽位环 + 投递环：两个无锁有界 MPMC 队列（Vyukov 算法），只传递
+//   (槽位, 长度) 描述符，多个发送方可以同时写入同一个接收方
+// 接收方先自旋轮询，空闲时用 futex 休眠，发送方只在有等待者时才唤醒，
+// 常见情况下一次投递只有几次原子操作，没有系统调用
+//
+// 段头记录了所有者的进程号和代数：open() 不会抢占所有者还活着的同名段；
+// 缓存的对端段在对端关闭时马上淘汰，所有者退出或者段被重新创建则在定期检查时淘汰；
+// 打不开的对端在 peer_retry_interval_ms 内不再重试。
+// 注意：进程崩溃时借出的槽位不会被回收
+// ============================================================
+class ShmTransport{
+public:
+    explicit ShmTransport(const ShmTransportConfig& config = ShmTransportConfig());
+    ~ShmTransport();
+
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    // 创建本参与者的接收段，失败返回 false（包括同名段的所有者还活着）
+    bool open();
+    void close();
+    bool is_open() const { return own_segment_ != nullptr; }
+
+    // 本参与者的共享内存地址
+    Locator local_locator() const;
+
+    // 对端的接收段是否存在（对端在本机并且开启了共享内存传输）
+    bool is_reachable(const Locator& destination);
+
+    // ========================================
+    // 发送
+    // ========================================
+
+    // 借出对端段中的一个槽位（对端不存在或没有空闲槽位时返回无效的 loan）
+    ShmLoan loan(const Locator& destination);
+
+    // 提交 loan 中已写入的 size 字节，把描述符交给对端
+    bool commit(ShmLoan& loan, size_t size);
+
+    // 复制一份数据发送（数据已经在别处序列化好时使用）
+    bool send(ConstByteSpan data, const Locator& destination);
+
+    // ========================================
+    // 接收
+    // ========================================
+
+    // 等待最多 timeout_ms 毫秒（-1 一直等待，0 不等待），取出所有已投递的样本（最多 max_batch 个）
+    // 上一批样本的槽位在这里归还，所以 received(i) 在下一次 receive 之前有效
+    size_t receive(int timeout_ms, size_t max_batch = 64);
+
+    ConstByteSpan received(size_t index) const { return received_[index]; }
+
+    // 提前归还上一批样本的槽位
+    void release_received();
+
+    uint64_t samples_sent() const { return samples_sent_; }
+    uint64_t samples_received() const { return samples_received_; }
+    uint64_t samples_dropped() const { return samples_dropped_; } // 槽位号或长度越界而丢弃的描述符
+
+    const ShmTransportConfig& config() const { return config_; }
+
+private:
+    ShmTransportConfig config_;
+    std::unique_ptr<ShmSegment> own_segment_;
+
+    // 按端口缓存的对端段；segment 为空表示打开失败，next_check 之前不再重试
+    struct PeerEntry{
+        std::shared_ptr<ShmSegment> segment;
+        std::chrono::steady_clock::time_point next_check;
+    };
+    std::unordered_map<uint32_t, PeerEntry> peers_;
+
+    std::vector<uint32_t> received_slots_;
+    std::vector<ConstByteSpan> received_;
+
+    uint64_t samples_sent_ = 0;
+    uint64_t samples_received_ = 0;
+    uint64_t samples_dropped_ = 0;
+
+    std::shared_ptr<ShmSegment> peer_segment(const Locator& destination);
+    std::string segment_name(uint32_t port) const;
+};
+
+// ============================================================
+// 本机地址判断
+// ============================================================
+
+// 共享内存 Locator：kind = LOCATOR_KIND_SHM，端口就是对端的接收端口
+Locator make_shm_locator(uint32_t port);
+
+// Locator 是否指向本机（共享内存地址、回环地址或者本机网卡的地址）
+bool is_local_locator(const Locator& locator);
+
+} // namespace transport
+} // namespace tinydds
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "tinydds/transport/shm_transport.hpp"
+#include "tinydds/transport/udp_transport.hpp"
+
+namespace tinydds {
+namespace transport {
+
+// ============================================================
+// TransportRouter: 按目的 Locator 自动选择传输
+// 对端在本机（共享内存地址、回环地址、本机网卡地址）并且它的共享内存段存在时
+// 走共享内存，否则走 UDP。同一个参与者的 UDP 单播端口和共享内存端口相同，
+// 所以 127.0.0.1:7411 这样的 UDP 地址也能找到对端的共享内存段
+// ============================================================
+class TransportRouter{
+public:
+    // 两个传输都可以为空（只用其中一种）；传输对象的生命周期由调用方管理
+    TransportRouter(UdpTransport* udp, ShmTransport* shm) : udp_(udp), shm_(shm) {}
+
+    // 发送到 destination 会不会走共享内存
+    bool uses_shared_memory(const Locator& destination){
+        return shm_ != nullptr && shm_->is_reachable(destination);
+    }
+
+    bool send(ConstByteSpan data, const Locator& destination){
+        if(uses_shared_memory(destination)){
+            return shm_->send(data, destination);
+        }
+        if(udp_ != nullptr && destination.kind == rtps::LocatorKind::LOCATOR_KIND_UDPv4){
+            return udp_->send(data, destination);
+        }
+        return false;
+    }
+
+private:
+    UdpTransport* udp_;
+    ShmTransport* shm_;
+};
+
+} // namespace transport
+} // namespace tinydds
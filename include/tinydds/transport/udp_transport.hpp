@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "tinydds/rtps/locator.hpp"
+#include "tinydds/rtps/span.hpp"
+
+namespace tinydds {
+namespace transport {
+
+using rtps::ConstByteSpan;
+using rtps::Locator;
+
+// ============================================================
+// UDP 传输配置
+// ============================================================
+struct UdpTransportConfig{
+    std::string bind_address = "0.0.0.0"; // 绑定的本机地址
+    uint32_t port = 0;                     // 接收端口，0 表示由系统分配
+    size_t max_datagram_size = 65500;      // 单个数据报的最大长度（接收缓冲区大小）
+    size_t receive_batch = 32;             // 一次 recvmmsg 最多收多少个数据报
+    int multicast_ttl = 1;                 // 多播 TTL，1 表示不出本网段
+    bool multicast_loopback = true;        // 本机发出的多播自己也能收到（同机多个参与者需要）
+    int socket_receive_buffer = 0;         // SO_RCVBUF，0 表示使用系统默认值
+    int socket_send_buffer = 0;            // SO_SNDBUF，0 表示使用系统默认值
+};
+
+// 待发送的数据报：数据视图 + 目的地址（数据在 send 返回前必须有效）
+struct UdpDatagram{
+    ConstByteSpan data;
+    Locator destination;
+};
+
+// 分段的数据报：parts 里的各段按顺序拼成一个数据报，由内核直接从各段读取（iovec 聚合发送），
+// 不需要先复制到一个连续的缓冲区。各段数据在 send 返回前必须有效
+constexpr size_t UDP_MAX_GATHER_PARTS = 4;
+
+struct UdpGatherDatagram{
+    const ConstByteSpan* parts;
+    size_t part_count; // 最多 UDP_MAX_GATHER_PARTS
+    Locator destination;
+};
+
+// 收到的数据报：数据指向传输内部预分配的接收缓冲区，下一次 receive 之前有效
+struct ReceivedDatagram{
+    ConstByteSpan data;
+    Locator source;
+};
+
+// ============================================================
+// UdpTransport: 基于 Locator 的 UDPv4 传输（单播 + 多播）
+//
+// 发送和接收都是批量的：send_batch 用一次 sendmmsg 发出多个数据报（每个数据报可以由多段拼成），
+// receive 用一次 recvmmsg 收取最多 receive_batch 个数据报。
+// 接收缓冲区、mmsghdr/iovec 数组都在 open() 时一次性分配好，收发路径上不再分配内存。
+//
+// 不是线程安全的：一个线程负责 receive，发送可以在另一个线程（socket 本身支持并发收发）
+// ============================================================
+class UdpTransport{
+public:
+    explicit UdpTransport(const UdpTransportConfig& config = UdpTransportConfig());
+    ~UdpTransport();
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // 创建 socket 并绑定端口，失败返回 false
+    bool open();
+    void close();
+    bool is_open() const { return fd_ >= 0; }
+
+    // 加入/离开多播组（需要先 open，并且绑定的端口就是多播端口）
+    bool join_multicast(const Locator& group);
+    bool leave_multicast(const Locator& group);
+
+    // 实际绑定的地址（port 为 0 时由系统分配的端口在 open 之后才知道）
+    // 绑定在 0.0.0.0 时返回 127.0.0.1，便于本机的其它参与者直接使用
+    Locator local_locator() const;
+
+    // 发送单个数据报
+    bool send(ConstByteSpan data, const Locator& destination);
+
+    // 批量发送，返回成功发送的数据报数量
+    // 发送失败的数据报（例如超过 UDP 长度上限）被跳过并计入 send_errors()，不影响后面的数据报
+    size_t send_batch(const UdpDatagram* datagrams, size_t count);
+
+    size_t send_batch(const std::vector<UdpDatagram>& datagrams){
+        return send_batch(datagrams.data(), datagrams.size());
+    }
+
+    // 批量发送分段的数据报（例如 DataFragmenter 生成的 DATA_FRAG 消息），返回成功发送的数量
+    // 分段超过 UDP_MAX_GATHER_PARTS 的数据报同样跳过并计入 send_errors()
+    size_t send_batch(const UdpGatherDatagram* datagrams, size_t count);
+
+    size_t send_batch(const std::vector<UdpGatherDatagram>& datagrams){
+        return send_batch(datagrams.data(), datagrams.size());
+    }
+
+    // 等待最多 timeout_ms 毫秒（-1 表示一直等待，0 表示不等待），
+    // 然后一次 recvmmsg 收取所有已到达的数据报（最多 receive_batch 个），返回收到的数量
+    // 超过 max_datagram_size 被截断的数据报直接丢弃，计入 datagrams_truncated()
+    // 结果通过 received(i) 访问，下一次 receive 之前有效
+    size_t receive(int timeout_ms);
+
+    const ReceivedDatagram& received(size_t index) const { return received_[index]; }
+
+    // 统计
+    uint64_t datagrams_sent() const { return datagrams_sent_; }
+    uint64_t datagrams_received() const { return datagrams_received_; }
+    uint64_t send_syscalls() const { return send_syscalls_; }
+    uint64_t receive_syscalls() const { return receive_syscalls_; }
+    uint64_t send_errors() const { return send_errors_; }                   // 发送失败被跳过的数据报
+    uint64_t datagrams_truncated() const { return datagrams_truncated_; }   // 接收时被截断而丢弃的数据报
+
+    const UdpTransportConfig& config() const { return config_; }
+
+private:
+    UdpTransportConfig config_;
+    int fd_ = -1;
+    uint32_t bound_port_ = 0;
+
+    // 接收路径上预分配的资源
+    std::vector<uint8_t> receive_storage_;      // receive_batch 个缓冲区首尾相连
+    std::vector<struct mmsghdr> receive_headers_;
+    std::vector<struct iovec> receive_iovecs_;
+    std::vector<sockaddr_in> receive_addresses_;
+    std::vector<ReceivedDatagram> received_;
+
+    uint64_t datagrams_sent_ = 0;
+    uint64_t datagrams_received_ = 0;
+    uint64_t send_syscalls_ = 0;
+    uint64_t receive_syscalls_ = 0;
+    uint64_t send_errors_ = 0;
+    uint64_t datagrams_truncated_ = 0;
+
+    bool set_multicast_membership(const Locator& group, int option);
+};
+
+// Locator 与 sockaddr_in 互相转换（地址在 Locator.address[12..15]，已经是网络字节序）
+sockaddr_in to_sockaddr(const Locator& locator);
+Locator from_sockaddr(const sockaddr_in& address);
+
+} // namespace transport
+} // namespace tinydds
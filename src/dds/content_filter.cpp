@@ -0,0 +1,893 @@
+#include "tinydds/dds/content_filter.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "tinydds/rtps/byte_swap.hpp"
+
+namespace tinydds {
+namespace dds {
+
+namespace {
+
+using rtps::CdrFieldKind;
+using rtps::CdrTypeDesc;
+
+bool equals_keyword(std::string_view text, const char* keyword){
+    size_t length = std::strlen(keyword);
+    if(text.size() != length) return false;
+    for(size_t i = 0; i < length; ++i){
+        char c = text[i];
+        if(c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if(c != keyword[i]) return false;
+    }
+    return true;
+}
+
+bool is_identifier_start(char c){
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool is_digit(char c){
+    return c >= '0' && c <= '9';
+}
+
+// 解析整个字符串为数字；不是数字返回 false
+bool parse_number(std::string_view text, FilterValue& value){
+    if(text.empty()) return false;
+    std::string buffer(text);
+    const char* begin = buffer.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long long integer = std::strtoll(begin, &end, 10);
+    if(end == begin + buffer.size() && errno == 0){
+        value.type = FilterValue::Type::INTEGER;
+        value.integer = integer;
+        return true;
+    }
+    errno = 0;
+    double real = std::strtod(begin, &end);
+    if(end == begin + buffer.size() && errno == 0){
+        value.type = FilterValue::Type::REAL;
+        value.real = real;
+        return true;
+    }
+    return false;
+}
+
+// LIKE 匹配：% 匹配任意串（可以为空），_ 匹配一个字符
+bool like_match(std::string_view text, std::string_view pattern){
+    size_t t = 0;
+    size_t p = 0;
+    size_t star = std::string_view::npos; // 最近一个 % 的位置
+    size_t resume = 0;                    // 回溯时 text 的位置
+    while(t < text.size()){
+        if(p < pattern.size() && (pattern[p] == '_' || pattern[p] == text[t])){
+            ++t;
+            ++p;
+        }
+        else if(p < pattern.size() && pattern[p] == '%'){
+            star = p++;
+            resume = t;
+        }
+        else if(star != std::string_view::npos){
+            p = star + 1;
+            t = ++resume;
+        }
+        else{
+            return false;
+        }
+    }
+    while(p < pattern.size() && pattern[p] == '%') ++p;
+    return p == pattern.size();
+}
+
+// 比较结果：-1 / 0 / 1，无法比较（NaN）时为 2
+int compare_values(const FilterValue& x, const FilterValue& y){
+    if(x.type == FilterValue::Type::INTEGER && y.type == FilterValue::Type::INTEGER){
+        return x.integer < y.integer ? -1 : x.integer > y.integer ? 1 : 0;
+    }
+    if(x.is_numeric() && y.is_numeric()){
+        double a = x.as_real();
+        double b = y.as_real();
+        if(a < b) return -1;
+        if(a > b) return 1;
+        return a == b ? 0 : 2;
+    }
+    if(x.type == FilterValue::Type::STRING && y.type == FilterValue::Type::STRING){
+        int result = x.string.compare(y.string);
+        return result < 0 ? -1 : result > 0 ? 1 : 0;
+    }
+    if(x.type == FilterValue::Type::BOOLEAN && y.type == FilterValue::Type::BOOLEAN){
+        return x.integer == y.integer ? 0 : 2;
+    }
+    return 2;
+}
+
+// 在不依赖数据内容的情况下计算 desc 的编码大小（含对齐），做不到（字符串、序列）时返回 false
+bool fixed_layout(const CdrTypeDesc& desc, size_t& offset){
+    size_t size = desc.primitive_size();
+    if(size != 0){
+        offset = (offset + size - 1) / size * size + size;
+        return true;
+    }
+    switch(desc.kind){
+    case CdrFieldKind::ARRAY: {
+        size_t element = desc.element->primitive_size();
+        if(element != 0){
+            if(desc.count == 0) return true;
+            offset = (offset + element - 1) / element * element + element * desc.count;
+            return true;
+        }
+        for(size_t i = 0; i < desc.count; ++i){
+            if(!fixed_layout(*desc.element, offset)) return false;
+        }
+        return true;
+    }
+    case CdrFieldKind::STRUCT:
+        for(size_t i = 0; i < desc.member_count; ++i){
+            if(!fixed_layout(*desc.members[i].type, offset)) return false;
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename Policy, typename T>
+T load_raw(const uint8_t* data){
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    if constexpr (Policy::swap){
+        value = rtps::byte_swap_value(value);
+    }
+    return value;
+}
+
+void set_integer(FilterValue& value, int64_t integer){
+    value.type = FilterValue::Type::INTEGER;
+    value.integer = integer;
+}
+
+void set_unsigned(FilterValue& value, uint64_t integer){
+    if(integer > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())){
+        value.type = FilterValue::Type::REAL;
+        value.real = static_cast<double>(integer);
+        return;
+    }
+    set_integer(value, static_cast<int64_t>(integer));
+}
+
+void set_real(FilterValue& value, double real){
+    value.type = FilterValue::Type::REAL;
+    value.real = real;
+}
+
+// 按固定偏移读取基本类型字段
+template<typename Policy>
+void read_fixed(const uint8_t* data, CdrFieldKind kind, FilterValue& value){
+    switch(kind){
+    case CdrFieldKind::BOOL:
+        value.type = FilterValue::Type::BOOLEAN;
+        value.integer = data[0] != 0;
+        break;
+    case CdrFieldKind::INT8: set_integer(value, static_cast<int8_t>(data[0])); break;
+    case CdrFieldKind::UINT8: set_integer(value, data[0]); break;
+    case CdrFieldKind::INT16: set_integer(value, load_raw<Policy, int16_t>(data)); break;
+    case CdrFieldKind::UINT16: set_integer(value, load_raw<Policy, uint16_t>(data)); break;
+    case CdrFieldKind::INT32: set_integer(value, load_raw<Policy, int32_t>(data)); break;
+    case CdrFieldKind::UINT32:
+    case CdrFieldKind::ENUM: set_integer(value, load_raw<Policy, uint32_t>(data)); break;
+    case CdrFieldKind::INT64: set_integer(value, load_raw<Policy, int64_t>(data)); break;
+    case CdrFieldKind::UINT64: set_unsigned(value, load_raw<Policy, uint64_t>(data)); break;
+    case CdrFieldKind::FLOAT32: set_real(value, load_raw<Policy, float>(data)); break;
+    case CdrFieldKind::FLOAT64: set_real(value, load_raw<Policy, double>(data)); break;
+    default: break;
+    }
+}
+
+// 用反序列化器读取字段（基本类型或字符串）
+template<typename Policy>
+bool read_field(rtps::BasicCdrDeserializer<Policy>& des, CdrFieldKind kind, FilterValue& value){
+    switch(kind){
+    case CdrFieldKind::BOOL:
+    case CdrFieldKind::INT8:
+    case CdrFieldKind::UINT8: {
+        const uint8_t* data = des.consume_bytes(1);
+        if(data == nullptr) return false;
+        read_fixed<Policy>(data, kind, value);
+        return true;
+    }
+    case CdrFieldKind::INT16: { int16_t v; if(!des.deserialize_int16(v)) return false; set_integer(value, v); return true; }
+    case CdrFieldKind::UINT16: { uint16_t v; if(!des.deserialize_uint16(v)) return false; set_integer(value, v); return true; }
+    case CdrFieldKind::INT32: { int32_t v; if(!des.deserialize_int32(v)) return false; set_integer(value, v); return true; }
+    case CdrFieldKind::UINT32:
+    case CdrFieldKind::ENUM: { uint32_t v; if(!des.deserialize_uint32(v)) return false; set_integer(value, v); return true; }
+    case CdrFieldKind::INT64: { int64_t v; if(!des.deserialize_int64(v)) return false; set_integer(value, v); return true; }
+    case CdrFieldKind::UINT64: { uint64_t v; if(!des.deserialize_uint64(v)) return false; set_unsigned(value, v); return true; }
+    case CdrFieldKind::FLOAT32: { float v; if(!des.deserialize_float(v)) return false; set_real(value, v); return true; }
+    case CdrFieldKind::FLOAT64: { double v; if(!des.deserialize_double(v)) return false; set_real(value, v); return true; }
+    case CdrFieldKind::STRING:
+        value.type = FilterValue::Type::STRING;
+        return des.deserialize_string_view(value.string);
+    default:
+        return false;
+    }
+}
+
+enum class Category : uint8_t{ NUMERIC, STRING, BOOLEAN };
+
+Category category_of(CdrFieldKind kind){
+    if(kind == CdrFieldKind::BOOL) return Category::BOOLEAN;
+    if(kind == CdrFieldKind::STRING) return Category::STRING;
+    return Category::NUMERIC;
+}
+
+Category category_of(const FilterValue& value){
+    if(value.type == FilterValue::Type::STRING) return Category::STRING;
+    if(value.type == FilterValue::Type::BOOLEAN) return Category::BOOLEAN;
+    return Category::NUMERIC;
+}
+
+} // namespace
+
+// ============================================================
+// FilterCompiler: 表达式的词法、语法分析，生成 ContentFilter 的节点
+// ============================================================
+class FilterCompiler{
+public:
+    FilterCompiler(ContentFilter& filter, const rtps::CdrTypeDesc& type, std::string_view text)
+        : filter_(filter), type_(type), text_(text) {}
+
+    bool run(std::string* error){
+        next();
+        uint16_t root = parse_or();
+        if(failed_ || token_.kind != TokenKind::END){
+            if(!failed_) fail("表达式末尾有多余的内容");
+            if(error != nullptr) *error = error_;
+            return false;
+        }
+        filter_.root_ = root;
+        return true;
+    }
+
+private:
+    using Op = ContentFilter::Op;
+    using Node = ContentFilter::Node;
+    static constexpr uint16_t INVALID = ContentFilter::INVALID;
+
+    enum class TokenKind : uint8_t{ END, IDENTIFIER, NUMBER, STRING, PARAMETER, LPAREN, RPAREN, OPERATOR };
+
+    struct Token{
+        TokenKind kind = TokenKind::END;
+        std::string_view text;
+        size_t position = 0;
+    };
+
+    struct Operand{
+        uint16_t node = INVALID;
+        Category category = Category::NUMERIC;
+    };
+
+    ContentFilter& filter_;
+    const rtps::CdrTypeDesc& type_;
+    std::string_view text_;
+    size_t pos_ = 0;
+    Token token_;
+    bool failed_ = false;
+    std::string error_;
+    size_t depth_ = 0; // 当前括号/NOT 的嵌套层数
+
+    uint16_t fail(const std::string& message){
+        if(!failed_){
+            failed_ = true;
+            error_ = message + "（位置 " + std::to_string(token_.position) + "）";
+        }
+        return INVALID;
+    }
+
+    // ========================================
+    // 词法分析
+    // ========================================
+
+    void next(){
+        while(pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                                      text_[pos_] == '\n' || text_[pos_] == '\r')){
+            ++pos_;
+        }
+        token_.position = pos_;
+        if(pos_ >= text_.size()){
+            token_.kind = TokenKind::END;
+            token_.text = std::string_view();
+            return;
+        }
+        size_t start = pos_;
+        char c = text_[pos_];
+        if(is_identifier_start(c)){
+            // 字段路径 a.b.c 作为一个记号
+            while(pos_ < text_.size() && (is_identifier_start(text_[pos_]) || is_digit(text_[pos_]) ||
+                                          text_[pos_] == '.')){
+                ++pos_;
+            }
+            token_.kind = TokenKind::IDENTIFIER;
+        }
+        else if(is_digit(c) || ((c == '-' || c == '+' || c == '.') && pos_ + 1 < text_.size() &&
+                                (is_digit(text_[pos_ + 1]) || text_[pos_ + 1] == '.'))){
+            // 没有算术运算，正负号只会出现在数字前面
+            ++pos_;
+            while(pos_ < text_.size()){
+                char d = text_[pos_];
+                if(is_digit(d) || d == '.'){
+                    ++pos_;
+                }
+                else if((d == 'e' || d == 'E') && pos_ + 1 < text_.size()){
+                    pos_ += (text_[pos_ + 1] == '-' || text_[pos_ + 1] == '+') ? 2 : 1;
+                }
+                else{
+                    break;
+                }
+            }
+            token_.kind = TokenKind::NUMBER;
+        }
+        else if(c == '\''){
+            ++pos_;
+            for(;;){
+                if(pos_ >= text_.size()){
+                    token_.kind = TokenKind::END;
+                    fail("字符串没有结束");
+                    return;
+                }
+                if(text_[pos_] == '\''){
+                    if(pos_ + 1 < text_.size() && text_[pos_ + 1] == '\''){ // '' 表示一个单引号
+                        pos_ += 2;
+                        continue;
+                    }
+                    ++pos_;
+                    break;
+                }
+                ++pos_;
+            }
+            token_.kind = TokenKind::STRING;
+        }
+        else if(c == '%'){
+            ++pos_;
+            while(pos_ < text_.size() && is_digit(text_[pos_])) ++pos_;
+            token_.kind = TokenKind::PARAMETER;
+        }
+        else if(c == '('){
+            ++pos_;
+            token_.kind = TokenKind::LPAREN;
+        }
+        else if(c == ')'){
+            ++pos_;
+            token_.kind = TokenKind::RPAREN;
+        }
+        else if(c == '=' || c == '<' || c == '>' || c == '!'){
+            ++pos_;
+            if(pos_ < text_.size() && (text_[pos_] == '=' || (c == '<' && text_[pos_] == '>'))) ++pos_;
+            token_.kind = TokenKind::OPERATOR;
+        }
+        else{
+            ++pos_;
+            token_.kind = TokenKind::END;
+            token_.text = text_.substr(start, 1);
+            fail("无法识别的字符 '" + std::string(token_.text) + "'");
+            return;
+        }
+        token_.text = text_.substr(start, pos_ - start);
+    }
+
+    bool keyword(const char* word) const {
+        return token_.kind == TokenKind::IDENTIFIER && equals_keyword(token_.text, word);
+    }
+
+    bool reserved() const {
+        return keyword("AND") || keyword("OR") || keyword("NOT") || keyword("BETWEEN") || keyword("LIKE");
+    }
+
+    // ========================================
+    // 语法分析
+    // ========================================
+
+    uint16_t add_node(Op op, uint16_t a = INVALID, uint16_t b = INVALID, uint16_t c = INVALID, uint16_t value = 0){
+        if(failed_) return INVALID;
+        if(filter_.nodes_.size() >= INVALID) return fail("表达式过长");
+        Node node;
+        node.op = op;
+        node.a = a;
+        node.b = b;
+        node.c = c;
+        node.value = value;
+        filter_.nodes_.push_back(node);
+        return static_cast<uint16_t>(filter_.nodes_.size() - 1);
+    }
+
+    uint16_t parse_or(){
+        uint16_t left = parse_and();
+        while(!failed_ && keyword("OR")){
+            next();
+            uint16_t right = parse_and();
+            left = add_node(Op::OR, left, right);
+        }
+        return left;
+    }
+
+    uint16_t parse_and(){
+        uint16_t left = parse_not();
+        while(!failed_ && keyword("AND")){
+            next();
+            uint16_t right = parse_not();
+            left = add_node(Op::AND, left, right);
+        }
+        return left;
+    }
+
+    uint16_t parse_not(){
+        if(keyword("NOT")){
+            if(depth_ >= ContentFilter::MAX_NESTING_DEPTH) return fail("嵌套层数过多");
+            next();
+            ++depth_;
+            uint16_t child = parse_not();
+            --depth_;
+            return add_node(Op::NOT, child);
+        }
+        if(token_.kind == TokenKind::LPAREN){
+            if(depth_ >= ContentFilter::MAX_NESTING_DEPTH) return fail("嵌套层数过多");
+            next();
+            ++depth_;
+            uint16_t inner = parse_or();
+            --depth_;
+            if(failed_) return INVALID;
+            if(token_.kind != TokenKind::RPAREN) return fail("缺少 ')'");
+            next();
+            return inner;
+        }
+        return parse_predicate();
+    }
+
+    uint16_t parse_predicate(){
+        Operand left = parse_operand();
+        if(failed_) return INVALID;
+
+        bool negated = false;
+        if(keyword("NOT")){
+            next();
+            if(!keyword("BETWEEN")) return fail("NOT 之后应为 BETWEEN");
+            negated = true;
+        }
+        if(keyword("BETWEEN")){
+            next();
+            Operand low = parse_operand();
+            if(failed_) return INVALID;
+            if(!keyword("AND")) return fail("BETWEEN 缺少 AND");
+            next();
+            Operand high = parse_operand();
+            if(failed_) return INVALID;
+            if(left.category != Category::NUMERIC || low.category != Category::NUMERIC ||
+               high.category != Category::NUMERIC){
+                return fail("BETWEEN 只能用于数值");
+            }
+            return add_node(negated ? Op::NOT_BETWEEN : Op::BETWEEN, left.node, low.node, high.node);
+        }
+        if(keyword("LIKE")){
+            next();
+            Operand pattern = parse_operand();
+            if(failed_) return INVALID;
+            if(left.category != Category::STRING || pattern.category != Category::STRING){
+                return fail("LIKE 只能用于字符串");
+            }
+            return add_node(Op::LIKE, left.node, pattern.node);
+        }
+        if(token_.kind != TokenKind::OPERATOR) return fail("应为比较运算符");
+
+        Op op;
+        std::string_view text = token_.text;
+        if(text == "=") op = Op::EQ;
+        else if(text == "<>" || text == "!=") op = Op::NE;
+        else if(text == "<") op = Op::LT;
+        else if(text == "<=") op = Op::LE;
+        else if(text == ">") op = Op::GT;
+        else if(text == ">=") op = Op::GE;
+        else return fail("无法识别的运算符 '" + std::string(text) + "'");
+        next();
+
+        Operand right = parse_operand();
+        if(failed_) return INVALID;
+        if(left.category != right.category) return fail("比较的两边类型不一致");
+        if(left.category == Category::BOOLEAN && op != Op::EQ && op != Op::NE){
+            return fail("布尔值只能比较相等");
+        }
+        return add_node(op, left.node, right.node);
+    }
+
+    Operand parse_operand(){
+        Operand operand;
+        switch(token_.kind){
+        case TokenKind::IDENTIFIER: {
+            if(keyword("TRUE") || keyword("FALSE")){
+                FilterValue value;
+                value.type = FilterValue::Type::BOOLEAN;
+                value.integer = keyword("TRUE") ? 1 : 0;
+                next();
+                return add_constant(value);
+            }
+            if(reserved()){
+                fail("应为字段或常量");
+                return operand;
+            }
+            std::string path(token_.text);
+            next();
+            return add_field(path);
+        }
+        case TokenKind::NUMBER: {
+            FilterValue value;
+            if(!parse_number(token_.text, value)){
+                fail("无效的数字 '" + std::string(token_.text) + "'");
+                return operand;
+            }
+            next();
+            return add_constant(value);
+        }
+        case TokenKind::STRING: {
+            std::string text = unquote(token_.text);
+            next();
+            return add_string(std::move(text));
+        }
+        case TokenKind::PARAMETER: {
+            std::string_view digits = token_.text.substr(1);
+            size_t index = 0;
+            for(char c : digits) index = index * 10 + static_cast<size_t>(c - '0');
+            if(digits.empty() || digits.size() > 4 || index >= filter_.parameters_.size()){
+                fail("参数 " + std::string(token_.text) + " 不存在");
+                return operand;
+            }
+            next();
+            return add_parameter(filter_.parameters_[index]);
+        }
+        default:
+            fail(token_.kind == TokenKind::END ? "表达式不完整" : "应为字段或常量");
+            return operand;
+        }
+    }
+
+    // 去掉两边的单引号，'' 还原为 '
+    static std::string unquote(std::string_view quoted){
+        std::string text;
+        for(size_t i = 1; i + 1 < quoted.size(); ++i){
+            text.push_back(quoted[i]);
+            if(quoted[i] == '\'') ++i;
+        }
+        return text;
+    }
+
+    Operand add_constant(const FilterValue& value){
+        Operand operand;
+        if(filter_.constants_.size() >= INVALID){
+            fail("常量过多");
+            return operand;
+        }
+        filter_.constants_.push_back(value);
+        operand.category = category_of(value);
+        operand.node = add_node(Op::CONSTANT, INVALID, INVALID, INVALID,
+                                static_cast<uint16_t>(filter_.constants_.size() - 1));
+        return operand;
+    }
+
+    // 字符串常量存放在 strings_ 里，constants_ 只记下标（过滤器可以被移动）
+    Operand add_string(std::string text){
+        filter_.strings_.push_back(std::move(text));
+        FilterValue value;
+        value.type = FilterValue::Type::STRING;
+        value.integer = static_cast<int64_t>(filter_.strings_.size() - 1);
+        return add_constant(value);
+    }
+
+    Operand add_parameter(const std::string& parameter){
+        std::string_view text = parameter;
+        while(!text.empty() && text.front() == ' ') text.remove_prefix(1);
+        while(!text.empty() && text.back() == ' ') text.remove_suffix(1);
+        if(text.size() >= 2 && text.front() == '\'' && text.back() == '\''){
+            return add_string(unquote(text));
+        }
+        FilterValue value;
+        if(parse_number(text, value)) return add_constant(value);
+        if(equals_keyword(text, "TRUE") || equals_keyword(text, "FALSE")){
+            value.type = FilterValue::Type::BOOLEAN;
+            value.integer = equals_keyword(text, "TRUE") ? 1 : 0;
+            return add_constant(value);
+        }
+        return add_string(parameter);
+    }
+
+    Operand add_field(const std::string& path){
+        Operand operand;
+        int16_t slot = filter_.find_slot(path);
+        if(slot < 0){
+            // 按路径逐层找字段，只能进入结构体
+            const rtps::CdrTypeDesc* type = &type_;
+            size_t start = 0;
+            for(;;){
+                size_t dot = path.find('.', start);
+                std::string name = path.substr(start, dot == std::string::npos ? std::string::npos : dot - start);
+                const rtps::CdrMemberDesc* member =
+                    type->kind == rtps::CdrFieldKind::STRUCT ? type->find_member(name) : nullptr;
+                if(member == nullptr){
+                    fail("类型 " + std::string(type_.name ? type_.name : "") + " 没有字段 " + path);
+                    return operand;
+                }
+                type = member->type;
+                if(dot == std::string::npos) break;
+                start = dot + 1;
+            }
+            if(!type->is_primitive() && type->kind != rtps::CdrFieldKind::STRING){
+                fail("字段 " + path + " 不是基本类型或字符串，不能比较");
+                return operand;
+            }
+            if(filter_.fields_.size() >= ContentFilter::MAX_FIELDS){
+                fail("引用的字段过多");
+                return operand;
+            }
+            filter_.fields_.push_back(ContentFilter::FieldRef{path, type});
+            slot = static_cast<int16_t>(filter_.fields_.size() - 1);
+        }
+        operand.category = category_of(filter_.fields_[slot].type->kind);
+        operand.node = add_node(Op::FIELD, INVALID, INVALID, INVALID, static_cast<uint16_t>(slot));
+        return operand;
+    }
+};
+
+// ============================================================
+// ContentFilter
+// ============================================================
+
+bool ContentFilter::compile(const rtps::CdrTypeDesc& type, std::string_view expression,
+                            const std::vector<std::string>& parameters, std::string* error){
+    *this = ContentFilter();
+    if(type.kind != rtps::CdrFieldKind::STRUCT){
+        if(error != nullptr) *error = "过滤的类型必须是结构体";
+        return false;
+    }
+    expression_ = std::string(expression);
+    parameters_ = parameters;
+    FilterCompiler compiler(*this, type, expression_);
+    if(!compiler.run(error)){
+        *this = ContentFilter();
+        return false;
+    }
+    build_steps(type);
+    return true;
+}
+
+int16_t ContentFilter::find_slot(const std::string& path) const {
+    for(size_t i = 0; i < fields_.size(); ++i){
+        if(fields_[i].path == path) return static_cast<int16_t>(i);
+    }
+    return -1;
+}
+
+void ContentFilter::plan_struct(const rtps::CdrTypeDesc& type, const std::string& prefix, size_t& remaining){
+    for(size_t i = 0; i < type.member_count && remaining > 0; ++i){
+        const rtps::CdrMemberDesc& member = type.members[i];
+        std::string path = prefix + member.name;
+        if(member.type->kind == rtps::CdrFieldKind::STRUCT){
+            std::string nested = path + ".";
+            bool referenced = false;
+            for(const FieldRef& field : fields_){
+                if(field.path.compare(0, nested.size(), nested) == 0){
+                    referenced = true;
+                    break;
+                }
+            }
+            if(referenced){
+                plan_struct(*member.type, nested, remaining);
+                continue;
+            }
+        }
+        else{
+            int16_t slot = find_slot(path);
+            if(slot >= 0){
+                steps_.push_back(Step{member.type, static_cast<uint16_t>(slot)});
+                --remaining;
+                continue;
+            }
+        }
+        steps_.push_back(Step{member.type});
+    }
+}
+
+void ContentFilter::build_steps(const rtps::CdrTypeDesc& type){
+    size_t remaining = fields_.size();
+    plan_struct(type, std::string(), remaining);
+
+    // 所有步骤都是定长的：提前算好每个字段的偏移
+    size_t offset = 0;
+    fixed_offsets_ = true;
+    for(Step& step : steps_){
+        size_t size = step.type->primitive_size();
+        if(size != 0) step.fixed_offset = (offset + size - 1) / size * size;
+        if(!fixed_layout(*step.type, offset)){
+            fixed_offsets_ = false;
+            break;
+        }
+    }
+    fixed_end_ = offset;
+}
+
+template<typename Policy>
+bool ContentFilter::load_fields(rtps::ConstByteSpan payload, std::array<FilterValue, MAX_FIELDS>& slots) const {
+    rtps::BasicCdrDeserializer<Policy> des(payload);
+    if(!des.deserialize_encapsulation()) return false;
+    if(fixed_offsets_){
+        if(des.remaining() < fixed_end_) return false;
+        const uint8_t* base = payload.data() + des.position();
+        for(const Step& step : steps_){
+            if(step.slot != INVALID) read_fixed<Policy>(base + step.fixed_offset, step.type->kind, slots[step.slot]);
+        }
+        return true;
+    }
+    for(const Step& step : steps_){
+        if(step.slot == INVALID){
+            if(!rtps::cdr_skip(des, *step.type)) return false;
+        }
+        else if(!read_field(des, step.type->kind, slots[step.slot])){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ContentFilter::evaluate(rtps::ConstByteSpan payload) const {
+    if(!valid() || payload.size() < rtps::ENCAPSULATION_HEADER_SIZE) return false;
+    std::array<FilterValue, MAX_FIELDS> slots;
+    // 封装头第 2 个字节的最低位就是字节序标志
+    bool loaded = (payload[1] & 0x01) ? load_fields<rtps::LittleEndianPolicy>(payload, slots)
+                                      : load_fields<rtps::BigEndianPolicy>(payload, slots);
+    return loaded && eval(root_, slots);
+}
+
+FilterValue ContentFilter::operand(uint16_t node, const std::array<FilterValue, MAX_FIELDS>& slots) const {
+    const Node& n = nodes_[node];
+    if(n.op == Op::FIELD) return slots[n.value];
+    FilterValue value = constants_[n.value];
+    if(value.type == FilterValue::Type::STRING){
+        value.string = strings_[static_cast<size_t>(value.integer)];
+    }
+    return value;
+}
+
+bool ContentFilter::eval(uint16_t node, const std::array<FilterValue, MAX_FIELDS>& slots) const {
+    const Node& n = nodes_[node];
+    switch(n.op){
+    case Op::AND: return eval(n.a, slots) && eval(n.b, slots);
+    case Op::OR: return eval(n.a, slots) || eval(n.b, slots);
+    case Op::NOT: return !eval(n.a, slots);
+    case Op::LIKE: return like_match(operand(n.a, slots).string, operand(n.b, slots).string);
+    case Op::BETWEEN:
+    case Op::NOT_BETWEEN: {
+        FilterValue value = operand(n.a, slots);
+        int low = compare_values(value, operand(n.b, slots));
+        int high = compare_values(value, operand(n.c, slots));
+        bool inside = (low == 0 || low == 1) && (high == 0 || high == -1);
+        return n.op == Op::BETWEEN ? inside : !inside;
+    }
+    case Op::FIELD:
+    case Op::CONSTANT: return false; // 语法上不会出现在条件的位置
+    default: break;
+    }
+    int result = compare_values(operand(n.a, slots), operand(n.b, slots));
+    switch(n.op){
+    case Op::EQ: return result == 0;
+    case Op::NE: return result != 0;
+    case Op::LT: return result == -1;
+    case Op::LE: return result == -1 || result == 0;
+    case Op::GT: return result == 1;
+    case Op::GE: return result == 1 || result == 0;
+    default: return false;
+    }
+}
+
+// ============================================================
+// ReaderFilterSet
+// ============================================================
+
+std::string ReaderFilterSet::filter_key(const std::string& expression, const std::vector<std::string>& parameters){
+    std::string key = expression;
+    for(const std::string& parameter : parameters){
+        key.push_back('\0');
+        key += parameter;
+    }
+    return key;
+}
+
+void ReaderFilterSet::add_reader(const rtps::GUID& reader){
+    remove_reader(reader);
+    readers_.insert(reader, NO_FILTER);
+    unfiltered_.push_back(reader);
+}
+
+bool ReaderFilterSet::add_reader(const rtps::GUID& reader, const std::string& expression,
+                                 const std::vector<std::string>& parameters, std::string* error){
+    if(expression.empty()){
+        add_reader(reader);
+        return true;
+    }
+    std::string key = filter_key(expression, parameters);
+    auto found = filter_index_.find(key);
+    if(found != filter_index_.end() && filters_[found->second].readers.size() == 1 &&
+       filters_[found->second].readers[0] == reader){
+        return true; // 重复宣告，过滤条件没有变化
+    }
+
+    ContentFilter compiled;
+    if(found == filter_index_.end() && !compiled.compile(type_, expression, parameters, error)) return false;
+
+    remove_reader(reader);
+    found = filter_index_.find(key); // remove_reader 可能移动了过滤器
+    uint32_t index;
+    if(found != filter_index_.end()){
+        index = found->second;
+    }
+    else{
+        if(!compiled.valid() && !compiled.compile(type_, expression, parameters, error)) return false;
+        index = static_cast<uint32_t>(filters_.size());
+        filters_.push_back(SharedFilter{std::move(compiled), {}, key});
+        filter_index_.emplace(std::move(key), index);
+    }
+    filters_[index].readers.push_back(reader);
+    readers_.insert(reader, index);
+    return true;
+}
+
+bool ReaderFilterSet::remove_reader(const rtps::GUID& reader){
+    const uint32_t* entry = readers_.find(reader);
+    if(entry == nullptr) return false;
+    uint32_t index = *entry;
+    readers_.erase(reader);
+
+    std::vector<rtps::GUID>& list = index == NO_FILTER ? unfiltered_ : filters_[index].readers;
+    for(size_t i = 0; i < list.size(); ++i){
+        if(list[i] == reader){
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
+    if(index == NO_FILTER || !filters_[index].readers.empty()) return true;
+
+    // 没有读端再用这个过滤器：把最后一个过滤器挪到空位上
+    filter_index_.erase(filters_[index].key);
+    uint32_t last = static_cast<uint32_t>(filters_.size() - 1);
+    if(index != last){
+        filters_[index] = std::move(filters_[last]);
+        filter_index_[filters_[index].key] = index;
+        for(const rtps::GUID& moved : filters_[index].readers){
+            readers_.insert_or_assign(moved, index);
+        }
+    }
+    filters_.pop_back();
+    return true;
+}
+
+size_t ReaderFilterSet::select(rtps::ConstByteSpan payload, std::vector<rtps::GUID>& out) const {
+    size_t before = out.size();
+    out.insert(out.end(), unfiltered_.begin(), unfiltered_.end());
+    for(const SharedFilter& shared : filters_){
+        if(shared.filter.evaluate(payload)){
+            out.insert(out.end(), shared.readers.begin(), shared.readers.end());
+        }
+    }
+    return out.size() - before;
+}
+
+bool ReaderFilterSet::wanted(rtps::ConstByteSpan payload) const {
+    if(!unfiltered_.empty()) return true;
+    for(const SharedFilter& shared : filters_){
+        if(shared.filter.evaluate(payload)) return true;
+    }
+    return false;
+}
+
+} // namespace dds
+} // namespace tinydds
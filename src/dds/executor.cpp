@@ -0,0 +1,118 @@
+#include "tinydds/dds/executor.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace tinydds {
+namespace dds {
+
+// ============================================================
+// ThreadPoolExecutor
+// ============================================================
+
+ThreadPoolExecutor::ThreadPoolExecutor(const ThreadPoolConfig& config) : config_(config){
+    size_t threads = config_.threads;
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+        if(threads == 0) threads = 1;
+    }
+    workers_.reserve(threads);
+    for(size_t i = 0; i < threads; ++i){
+        workers_.push_back(std::make_unique<Worker>(config_.queue_capacity));
+    }
+    // 所有队列都建好之后再启动线程：工作线程会去偷别的队列
+    for(size_t i = 0; i < threads; ++i){
+        workers_[i]->thread = std::thread([this, i]{ run(i); });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor(){
+    shutdown();
+}
+
+bool ThreadPoolExecutor::post(Task task){
+    if(stopping_.load(std::memory_order_acquire)) return false;
+    size_t count = workers_.size();
+    size_t start = next_worker_.fetch_add(1, std::memory_order_relaxed);
+    for(size_t i = 0; i < count; ++i){
+        if(workers_[(start + i) % count]->queue.push(std::move(task))){
+            idle_.notify_one();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPoolExecutor::post_to(size_t worker, Task task){
+    if(stopping_.load(std::memory_order_acquire)) return false;
+    if(!workers_[worker % workers_.size()]->queue.push(std::move(task))) return false;
+    // 目标线程可能正忙，唤醒任意一个空闲线程来偷
+    idle_.notify_one();
+    return true;
+}
+
+void ThreadPoolExecutor::shutdown(){
+    if(stopping_.exchange(true, std::memory_order_acq_rel)) return;
+    idle_.notify_all();
+    for(std::unique_ptr<Worker>& worker : workers_){
+        if(worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+bool ThreadPoolExecutor::run_one(size_t index){
+    Task task;
+    if(workers_[index]->queue.take(task)){
+        task();
+        return true;
+    }
+    size_t count = workers_.size();
+    for(size_t i = 1; i < count; ++i){
+        if(workers_[(index + i) % count]->queue.take(task)){
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPoolExecutor::has_work() const {
+    for(const std::unique_ptr<Worker>& worker : workers_){
+        if(!worker->queue.empty()) return true;
+    }
+    return false;
+}
+
+void ThreadPoolExecutor::run(size_t index){
+    if(!config_.cpus.empty() && pin_current_thread(config_.cpus[index % config_.cpus.size()])){
+        pinned_.fetch_add(1, std::memory_order_relaxed);
+    }
+    for(;;){
+        if(run_one(index)) continue;
+        // 关闭时先把已经投递的任务执行完
+        if(stopping_.load(std::memory_order_acquire) && !has_work()) return;
+        idle_.await([this]{ return has_work() || stopping_.load(std::memory_order_acquire); }, -1);
+    }
+}
+
+bool ThreadPoolExecutor::pin_current_thread(int cpu){
+    if(cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// ============================================================
+// make_executor
+// ============================================================
+
+std::unique_ptr<Executor> make_executor(const ExecutorConfig& config){
+    if(config.kind == ExecutorKind::THREAD_POOL){
+        return std::make_unique<ThreadPoolExecutor>(config.pool);
+    }
+    return std::make_unique<InlineExecutor>();
+}
+
+} // namespace dds
+} // namespace tinydds
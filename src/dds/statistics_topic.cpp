@@ -0,0 +1,68 @@
+#include "tinydds/dds/statistics_topic.hpp"
+
+#include <cstring>
+
+#include "tinydds/rtps/parameter_list.hpp"
+
+namespace tinydds {
+namespace dds {
+
+using rtps::EntityIdValues::ENTITYID_TINYDDS_STATISTICS_READER;
+using rtps::EntityIdValues::ENTITYID_TINYDDS_STATISTICS_WRITER;
+
+rtps::GUID StatisticsSample::entity_guid() const {
+    rtps::GUID result;
+    std::memcpy(&result, guid.data(), sizeof(result));
+    return result;
+}
+
+void make_statistics_sample(const rtps::EntityStatisticsSnapshot& snapshot, StatisticsSample& out){
+    static_assert(sizeof(rtps::GUID) == 16, "GUID is the 16-byte key");
+    std::memcpy(out.guid.data(), &snapshot.guid, out.guid.size());
+    out.counters = snapshot.counters;
+    const rtps::LatencyHistogram& latency = snapshot.latency;
+    out.latency.count = latency.count();
+    out.latency.min_ns = latency.min();
+    out.latency.p50_ns = latency.value_at_percentile(50.0);
+    out.latency.p99_ns = latency.value_at_percentile(99.0);
+    out.latency.p999_ns = latency.value_at_percentile(99.9);
+    out.latency.max_ns = latency.max();
+}
+
+bool decode_statistics_sample(rtps::ConstByteSpan payload, StatisticsSample& out){
+    return rtps::decode_cdr_payload(payload, [&](auto& deserializer){
+        return deserializer.deserialize_type(out);
+    });
+}
+
+StatisticsPublisher::StatisticsPublisher(const rtps::StatisticsRegistry& registry)
+    : registry_(registry), serializer_(256), inline_qos_(32) {}
+
+size_t StatisticsPublisher::write_samples(rtps::MessageBuilder& builder){
+    registry_.snapshot_all(snapshots_);
+    size_t written = 0;
+    for(const rtps::EntityStatisticsSnapshot& snapshot : snapshots_){
+        make_statistics_sample(snapshot, sample_);
+
+        serializer_.reset();
+        serializer_.serialize_encapsulation();
+        serializer_.serialize_type(sample_);
+
+        // key 是 GUID，正好 16 字节，直接作为 key hash
+        inline_qos_.reset();
+        rtps::ParameterListWriter<rtps::CdrSerializer> writer(inline_qos_);
+        writer.add_bytes(rtps::ParameterIdValues::PID_KEY_HASH,
+                         rtps::ConstByteSpan(sample_.guid.data(), sample_.guid.size()));
+        writer.finish();
+
+        if(!builder.add_data(ENTITYID_TINYDDS_STATISTICS_READER, ENTITYID_TINYDDS_STATISTICS_WRITER, ++sn_,
+                             serializer_.buffer(), inline_qos_.buffer())){
+            break;
+        }
+        ++written;
+    }
+    return written;
+}
+
+} // namespace dds
+} // namespace tinydds
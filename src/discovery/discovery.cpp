@@ -0,0 +1,152 @@
+#include "tinydds/discovery/discovery.hpp"
+
+#include "tinydds/rtps/message_parser.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+using rtps::EntityIdValues::ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER;
+using rtps::EntityIdValues::ENTITYID_SPDP_BUILTIN_PARTICIPANT_READER;
+using rtps::EntityIdValues::ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER;
+using rtps::EntityIdValues::ENTITYID_SEDP_BUILTIN_PUBLICATIONS_READER;
+using rtps::EntityIdValues::ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER;
+using rtps::EntityIdValues::ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_READER;
+
+namespace {
+
+DiscoveryConfig normalized(DiscoveryConfig config){
+    if(config.lease_tick.count() <= 0){
+        config.lease_tick = std::chrono::milliseconds(1);
+    }
+    return config;
+}
+
+} // namespace
+
+Discovery::Discovery(const ParticipantProxyData& local, const DiscoveryConfig& config, Clock::time_point now)
+    : local_(local), config_(normalized(config)),
+      leases_(config_.lease_wheel_slots, to_tick(now)), serializer_(512) {}
+
+// ============================================================
+// 本地端点
+// ============================================================
+
+bool Discovery::add_local_endpoint(const EndpointProxyData& data){
+    if(data.guid.prefix != local_.guid_prefix) return false;
+    local_endpoints_.insert_or_assign(data.guid, data);
+    matcher_.add_endpoint(data); // 本地端点之间（同一参与者内）也可以匹配
+    return true;
+}
+
+bool Discovery::remove_local_endpoint(const rtps::GUID& guid){
+    if(!local_endpoints_.erase(guid)) return false;
+    matcher_.remove_endpoint(guid);
+    return true;
+}
+
+// ============================================================
+// 宣告
+// ============================================================
+
+bool Discovery::write_announcements(rtps::MessageBuilder& builder){
+    serializer_.reset();
+    if(!serialize_participant_data(local_, serializer_) ||
+       !builder.add_data(ENTITYID_SPDP_BUILTIN_PARTICIPANT_READER, ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER,
+                         ++spdp_sn_, serializer_.buffer())){
+        return false;
+    }
+
+    bool ok = true;
+    local_endpoints_.for_each([&](const rtps::GUID&, const EndpointProxyData& endpoint){
+        serializer_.reset();
+        // 编码失败的端点跳过（不占用序列号），其余端点照常宣告
+        if(!serialize_endpoint_data(endpoint, serializer_)){
+            ok = false;
+            return;
+        }
+        if(endpoint.is_writer){
+            ok &= builder.add_data(ENTITYID_SEDP_BUILTIN_PUBLICATIONS_READER, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER,
+                                   ++publications_sn_, serializer_.buffer());
+        }else{
+            ok &= builder.add_data(ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_READER, ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER,
+                                   ++subscriptions_sn_, serializer_.buffer());
+        }
+    });
+    return ok;
+}
+
+// ============================================================
+// 接收
+// ============================================================
+
+size_t Discovery::handle_message(rtps::ConstByteSpan message, Clock::time_point now){
+    rtps::MessageParser parser(message);
+    if(!parser.valid() || parser.header().guid_prefix == local_.guid_prefix) return 0; // 自己的宣告（多播回环）
+
+    size_t handled = 0;
+    rtps::SubmessageView submessage;
+    rtps::DataSubmessage data;
+    while(parser.next(submessage)){
+        if(submessage.id != rtps::SubmessageId::DATA || !rtps::parse_data(submessage, data)) continue;
+        if(data.writer_id == ENTITYID_SPDP_BUILTIN_PARTICIPANT_WRITER){
+            ParticipantProxyData participant;
+            if(deserialize_participant_data(data.serialized_payload, participant)){
+                on_participant_data(participant, now);
+                ++handled;
+            }
+        }else if(data.writer_id == ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER ||
+                 data.writer_id == ENTITYID_SEDP_BUILTIN_SUBSCRIPTIONS_WRITER){
+            EndpointProxyData endpoint;
+            if(deserialize_endpoint_data(data.serialized_payload, endpoint)){
+                on_endpoint_data(endpoint);
+                ++handled;
+            }
+        }
+    }
+    return handled;
+}
+
+bool Discovery::on_participant_data(const ParticipantProxyData& data, Clock::time_point now){
+    if(data.guid_prefix == local_.guid_prefix) return false;
+    // 每次宣告都续期：只修改时间轮里记录的截止时间
+    int64_t deadline = to_tick(now + data.lease_duration);
+    ParticipantProxyData* known = participants_.find(data.guid_prefix);
+    if(known != nullptr){
+        if(*known != data) *known = data;
+        leases_.schedule(data.guid_prefix, deadline);
+        return false;
+    }
+    participants_.insert(data.guid_prefix, data);
+    leases_.schedule(data.guid_prefix, deadline);
+    if(participant_listener_){
+        participant_listener_(*participants_.find(data.guid_prefix), true);
+    }
+    return true;
+}
+
+bool Discovery::on_endpoint_data(const EndpointProxyData& data){
+    if(data.guid.prefix == local_.guid_prefix) return false;
+    if(!participants_.contains(data.guid.prefix)) return false; // 还没有通过 SPDP 发现它的参与者
+    return matcher_.add_endpoint(data);
+}
+
+size_t Discovery::check_leases(Clock::time_point now){
+    return leases_.advance(to_tick(now), [&](const rtps::GuidPrefix& prefix){
+        remove_participant(prefix);
+    });
+}
+
+void Discovery::remove_participant(const rtps::GuidPrefix& prefix){
+    ParticipantProxyData* data = participants_.find(prefix);
+    if(data == nullptr) return;
+    ParticipantProxyData removed = std::move(*data);
+    participants_.erase(prefix);
+    leases_.cancel(prefix);
+    matcher_.remove_participant_endpoints(prefix);
+    if(participant_listener_){
+        participant_listener_(removed, false);
+    }
+}
+
+} // namespace discovery
+} // namespace tinydds
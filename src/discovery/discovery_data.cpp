@@ -0,0 +1,250 @@
+#include "tinydds/discovery/discovery_data.hpp"
+
+#include <cstring>
+
+#include "tinydds/rtps/parameter_list.hpp"
+
+namespace tinydds {
+namespace discovery {
+
+using namespace rtps::ParameterIdValues;
+
+namespace {
+
+using ParameterWriter = rtps::ParameterListWriter<rtps::CdrSerializer>;
+
+// 每个 locator 在线上占 24 字节：kind(4) + port(4) + address(16)
+constexpr size_t LOCATOR_WIRE_SIZE = 24;
+
+// RELIABILITY 的 max_blocking_time 只为了符合线上格式，取规范的默认值 100ms
+constexpr std::chrono::milliseconds DEFAULT_MAX_BLOCKING_TIME{100};
+
+void write_bytes(const uint8_t* data, size_t size, rtps::CdrSerializer& serializer){
+    uint8_t* ptr = serializer.reserve_bytes(size);
+    if(ptr != nullptr) std::memcpy(ptr, data, size);
+}
+
+template<typename Deserializer>
+bool read_bytes(Deserializer& d, uint8_t* out, size_t size){
+    const uint8_t* ptr = d.consume_bytes(size);
+    if(ptr == nullptr) return false;
+    std::memcpy(out, ptr, size);
+    return true;
+}
+
+// Duration_t：秒(int32) + 秒的小数部分(uint32，单位 1/2^32 秒)
+void write_duration(std::chrono::milliseconds duration, rtps::CdrSerializer& serializer){
+    int64_t ms = duration.count();
+    serializer.serialize_int32(static_cast<int32_t>(ms / 1000));
+    serializer.serialize_uint32(static_cast<uint32_t>((static_cast<uint64_t>(ms % 1000) << 32) / 1000));
+}
+
+template<typename Deserializer>
+bool read_duration(Deserializer& d, std::chrono::milliseconds& duration){
+    int32_t seconds;
+    uint32_t fraction;
+    if(!d.deserialize_int32(seconds) || !d.deserialize_uint32(fraction)) return false;
+    uint64_t ms = (static_cast<uint64_t>(fraction) * 1000 + (uint64_t(1) << 31)) >> 32; // 四舍五入
+    duration = std::chrono::milliseconds(static_cast<int64_t>(seconds) * 1000 + static_cast<int64_t>(ms));
+    return true;
+}
+
+// 每个 locator 单独一个参数
+void write_locators(ParameterWriter& writer, rtps::ParameterId id, const std::vector<rtps::Locator>& locators){
+    for(const rtps::Locator& locator : locators){
+        writer.add(id, [&](rtps::CdrSerializer& serializer){
+            serializer.serialize_int32(static_cast<int32_t>(locator.kind));
+            serializer.serialize_uint32(locator.port);
+            write_bytes(locator.address.data(), locator.address.size(), serializer);
+        });
+    }
+}
+
+template<typename Deserializer>
+bool read_locator(Deserializer& d, std::vector<rtps::Locator>& locators){
+    if(d.remaining() < LOCATOR_WIRE_SIZE) return false;
+    rtps::Locator locator;
+    int32_t kind;
+    if(!d.deserialize_int32(kind) || !d.deserialize_uint32(locator.port) ||
+       !read_bytes(d, locator.address.data(), locator.address.size())) return false;
+    locator.kind = static_cast<rtps::LocatorKind>(kind);
+    locators.push_back(locator);
+    return true;
+}
+
+void write_string(ParameterWriter& writer, rtps::ParameterId id, const std::string& value){
+    writer.add(id, [&](rtps::CdrSerializer& serializer){ serializer.serialize_string(value); });
+}
+
+void write_guid(ParameterWriter& writer, rtps::ParameterId id, const rtps::GUID& guid){
+    writer.add(id, [&](rtps::CdrSerializer& serializer){
+        write_bytes(guid.prefix.value.data(), guid.prefix.value.size(), serializer);
+        write_bytes(guid.entityId.value.data(), guid.entityId.value.size(), serializer);
+    });
+}
+
+template<typename Deserializer>
+bool read_guid(Deserializer& d, rtps::GUID& guid){
+    return read_bytes(d, guid.prefix.value.data(), guid.prefix.value.size()) &&
+           read_bytes(d, guid.entityId.value.data(), guid.entityId.value.size());
+}
+
+// ContentFilterProperty_t：4 个字符串 + sequence<string> 参数
+void write_content_filter(const ContentFilterProperty& filter, rtps::CdrSerializer& serializer){
+    serializer.serialize_string(filter.content_filtered_topic_name);
+    serializer.serialize_string(filter.related_topic_name);
+    serializer.serialize_string(filter.filter_class_name);
+    serializer.serialize_string(filter.filter_expression);
+    serializer.serialize_uint32(static_cast<uint32_t>(filter.expression_parameters.size()));
+    for(const std::string& parameter : filter.expression_parameters){
+        serializer.serialize_string(parameter);
+    }
+}
+
+template<typename Deserializer>
+bool read_content_filter(Deserializer& d, ContentFilterProperty& filter){
+    uint32_t count;
+    if(!d.deserialize_string(filter.content_filtered_topic_name) || !d.deserialize_string(filter.related_topic_name) ||
+       !d.deserialize_string(filter.filter_class_name) || !d.deserialize_string(filter.filter_expression) ||
+       !d.deserialize_uint32(count)) return false;
+    if(count > d.remaining() / 4) return false; // 每个字符串至少有 4 字节的长度
+    filter.expression_parameters.resize(count);
+    for(std::string& parameter : filter.expression_parameters){
+        if(!d.deserialize_string(parameter)) return false;
+    }
+    return true;
+}
+
+// 不认识的参数：厂商自定义的或者没有 must-understand 标志的直接跳过，否则整条数据无效
+bool skippable(const rtps::Parameter& parameter){
+    return parameter.vendor_specific() || !parameter.must_understand();
+}
+
+} // namespace
+
+// ============================================================
+// ParticipantProxyData
+// PID_PARTICIPANT_GUID + PID_VENDORID + PID_PARTICIPANT_LEASE_DURATION + 每个 locator 一个参数
+// ============================================================
+
+bool serialize_participant_data(const ParticipantProxyData& data, rtps::CdrSerializer& serializer){
+    serializer.serialize_encapsulation(true);
+    ParameterWriter writer(serializer);
+    write_guid(writer, PID_PARTICIPANT_GUID, rtps::GUID(data.guid_prefix, rtps::EntityIdValues::ENTITYID_PARTICIPANT));
+    writer.add(PID_VENDORID, [&](rtps::CdrSerializer& s){ write_bytes(data.vendor_id.data(), data.vendor_id.size(), s); });
+    writer.add(PID_PARTICIPANT_LEASE_DURATION, [&](rtps::CdrSerializer& s){ write_duration(data.lease_duration, s); });
+    write_locators(writer, PID_METATRAFFIC_UNICAST_LOCATOR, data.metatraffic_unicast_locators);
+    write_locators(writer, PID_METATRAFFIC_MULTICAST_LOCATOR, data.metatraffic_multicast_locators);
+    write_locators(writer, PID_DEFAULT_UNICAST_LOCATOR, data.default_unicast_locators);
+    return writer.finish();
+}
+
+bool deserialize_participant_data(rtps::ConstByteSpan payload, ParticipantProxyData& data){
+    data = ParticipantProxyData();
+    return rtps::decode_parameter_list(payload, [&](auto& reader){
+        bool has_guid = false;
+        bool complete = reader.for_each([&](const rtps::Parameter& parameter){
+            auto d = reader.value_deserializer(parameter);
+            switch(parameter.id){
+            case PID_PARTICIPANT_GUID: {
+                rtps::GUID guid;
+                if(!read_guid(d, guid)) return false;
+                data.guid_prefix = guid.prefix;
+                has_guid = true;
+                return true;
+            }
+            case PID_VENDORID:
+                return read_bytes(d, data.vendor_id.data(), data.vendor_id.size());
+            case PID_PARTICIPANT_LEASE_DURATION:
+                return read_duration(d, data.lease_duration);
+            case PID_METATRAFFIC_UNICAST_LOCATOR:
+                return read_locator(d, data.metatraffic_unicast_locators);
+            case PID_METATRAFFIC_MULTICAST_LOCATOR:
+                return read_locator(d, data.metatraffic_multicast_locators);
+            case PID_DEFAULT_UNICAST_LOCATOR:
+                return read_locator(d, data.default_unicast_locators);
+            default:
+                return skippable(parameter);
+            }
+        });
+        return complete && has_guid;
+    });
+}
+
+// ============================================================
+// EndpointProxyData
+// PID_ENDPOINT_GUID + PID_TOPIC_NAME + PID_TYPE_NAME + PID_RELIABILITY + PID_DURABILITY + locator
+// + 有过滤条件时的 PID_CONTENT_FILTER_PROPERTY
+// 写端还是读端由 GUID 的 EntityKind 决定
+// ============================================================
+
+bool serialize_endpoint_data(const EndpointProxyData& data, rtps::CdrSerializer& serializer){
+    serializer.serialize_encapsulation(true);
+    ParameterWriter writer(serializer);
+    write_guid(writer, PID_ENDPOINT_GUID, data.guid);
+    write_string(writer, PID_TOPIC_NAME, data.topic_name);
+    write_string(writer, PID_TYPE_NAME, data.type_name);
+    writer.add(PID_RELIABILITY, [&](rtps::CdrSerializer& s){
+        s.serialize_int32(static_cast<int32_t>(data.reliability));
+        write_duration(DEFAULT_MAX_BLOCKING_TIME, s);
+    });
+    writer.add(PID_DURABILITY, [&](rtps::CdrSerializer& s){ s.serialize_uint32(static_cast<uint32_t>(data.durability)); });
+    write_locators(writer, PID_UNICAST_LOCATOR, data.unicast_locators);
+    if(!data.content_filter.empty()){
+        writer.add(PID_CONTENT_FILTER_PROPERTY, [&](rtps::CdrSerializer& s){ write_content_filter(data.content_filter, s); });
+    }
+    return writer.finish();
+}
+
+bool deserialize_endpoint_data(rtps::ConstByteSpan payload, EndpointProxyData& data){
+    data = EndpointProxyData();
+    return rtps::decode_parameter_list(payload, [&](auto& reader){
+        bool has_guid = false;
+        bool has_topic = false;
+        bool has_type = false;
+        bool has_reliability = false;
+        bool complete = reader.for_each([&](const rtps::Parameter& parameter){
+            auto d = reader.value_deserializer(parameter);
+            switch(parameter.id){
+            case PID_ENDPOINT_GUID:
+                has_guid = true;
+                return read_guid(d, data.guid);
+            case PID_TOPIC_NAME:
+                has_topic = true;
+                return d.deserialize_string(data.topic_name);
+            case PID_TYPE_NAME:
+                has_type = true;
+                return d.deserialize_string(data.type_name);
+            case PID_RELIABILITY: {
+                int32_t kind;
+                if(!d.deserialize_int32(kind)) return false;
+                data.reliability = static_cast<ReliabilityKind>(kind);
+                has_reliability = true;
+                return true;
+            }
+            case PID_DURABILITY: {
+                uint32_t kind;
+                if(!d.deserialize_uint32(kind)) return false;
+                data.durability = static_cast<DurabilityKind>(kind);
+                return true;
+            }
+            case PID_UNICAST_LOCATOR:
+                return read_locator(d, data.unicast_locators);
+            case PID_CONTENT_FILTER_PROPERTY:
+                return read_content_filter(d, data.content_filter);
+            default:
+                return skippable(parameter);
+            }
+        });
+        if(!complete || !has_guid || !has_topic || !has_type) return false;
+        uint8_t kind = data.guid.entityId.value[3];
+        if(!rtps::EntityKind::is_writer(kind) && !rtps::EntityKind::is_reader(kind)) return false;
+        data.is_writer = rtps::EntityKind::is_writer(kind);
+        // 没有 RELIABILITY 参数时按规范的默认值：写端 RELIABLE，读端 BEST_EFFORT
+        if(!has_reliability && data.is_writer) data.reliability = ReliabilityKind::RELIABLE;
+        return true;
+    });
+}
+
+} // namespace discovery
+} // namespace tinydds
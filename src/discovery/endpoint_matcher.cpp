@@ -0,0 +1,100 @@
+#include "tinydds/discovery/endpoint_matcher.hpp"
+
+#include <algorithm>
+
+namespace tinydds {
+namespace discovery {
+
+namespace {
+
+void erase_guid(std::vector<rtps::GUID>& list, const rtps::GUID& guid){
+    auto it = std::find(list.begin(), list.end(), guid);
+    if(it != list.end()){
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+} // namespace
+
+std::string EndpointMatcher::topic_key(const EndpointProxyData& data){
+    std::string key;
+    key.reserve(data.topic_name.size() + 1 + data.type_name.size());
+    key.append(data.topic_name);
+    key.push_back('\0');
+    key.append(data.type_name);
+    return key;
+}
+
+void EndpointMatcher::notify_matches(const EndpointProxyData& data, const TopicEntry& topic, bool matched){
+    const std::vector<rtps::GUID>& peers = data.is_writer ? topic.readers : topic.writers;
+    for(const rtps::GUID& peer_guid : peers){
+        const EndpointProxyData* peer = endpoints_.find(peer_guid);
+        if(peer == nullptr) continue;
+        ++compatibility_checks_;
+        const EndpointProxyData& writer = data.is_writer ? data : *peer;
+        const EndpointProxyData& reader = data.is_writer ? *peer : data;
+        if(is_compatible(writer, reader) && listener_){
+            listener_(writer, reader, matched);
+        }
+    }
+}
+
+bool EndpointMatcher::add_endpoint(const EndpointProxyData& data){
+    const EndpointProxyData* existing = endpoints_.find(data.guid);
+    if(existing != nullptr){
+        if(*existing == data) return false; // 周期性的重复宣告
+        // 内容变了（主题、QoS 等）：按先移除再加入处理
+        remove_endpoint(data.guid);
+    }
+
+    endpoints_.insert(data.guid, data);
+    participant_endpoints_[data.guid.prefix].push_back(data.guid);
+
+    TopicEntry& topic = topics_[topic_key(data)];
+    (data.is_writer ? topic.writers : topic.readers).push_back(data.guid);
+    notify_matches(*endpoints_.find(data.guid), topic, true);
+    return true;
+}
+
+bool EndpointMatcher::remove_endpoint(const rtps::GUID& guid){
+    EndpointProxyData* data = endpoints_.find(guid);
+    if(data == nullptr) return false;
+    // 先从表里取出来：解除通知时 data 不能指向即将被移动的存储
+    EndpointProxyData removed = std::move(*data);
+    endpoints_.erase(guid);
+
+    std::string key = topic_key(removed);
+    auto topic_it = topics_.find(key);
+    if(topic_it != topics_.end()){
+        TopicEntry& topic = topic_it->second;
+        erase_guid(removed.is_writer ? topic.writers : topic.readers, guid);
+        notify_matches(removed, topic, false);
+        if(topic.writers.empty() && topic.readers.empty()){
+            topics_.erase(topic_it);
+        }
+    }
+
+    std::vector<rtps::GUID>* owned = participant_endpoints_.find(guid.prefix);
+    if(owned != nullptr){
+        erase_guid(*owned, guid);
+        if(owned->empty()){
+            participant_endpoints_.erase(guid.prefix);
+        }
+    }
+    return true;
+}
+
+size_t EndpointMatcher::remove_participant_endpoints(const rtps::GuidPrefix& prefix){
+    std::vector<rtps::GUID>* owned = participant_endpoints_.find(prefix);
+    if(owned == nullptr) return 0;
+    std::vector<rtps::GUID> guids = std::move(*owned);
+    participant_endpoints_.erase(prefix);
+    for(const rtps::GUID& guid : guids){
+        remove_endpoint(guid);
+    }
+    return guids.size();
+}
+
+} // namespace discovery
+} // namespace tinydds
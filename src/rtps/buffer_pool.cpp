@@ -0,0 +1,61 @@
+#include "tinydds/rtps/buffer_pool.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// PooledBuffer
+// ============================================================
+
+void PooledBuffer::reset(){
+    if(pool_ != nullptr && !storage_.empty()){
+        pool_->recycle(std::move(storage_));
+    }
+    storage_.clear();
+    size_ = 0;
+    pool_ = nullptr;
+}
+
+// ============================================================
+// BufferPool
+// ============================================================
+
+BufferPool::BufferPool(size_t buffer_size, size_t preallocate, size_t max_cached)
+    : buffer_size_(buffer_size), max_cached_(max_cached){
+    free_list_.reserve(max_cached_);
+    for(size_t i = 0; i < preallocate && i < max_cached_; ++i){
+        free_list_.emplace_back(buffer_size_);
+    }
+}
+
+PooledBuffer BufferPool::acquire(){
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(!free_list_.empty()){
+            std::vector<uint8_t> storage = std::move(free_list_.back());
+            free_list_.pop_back();
+            return PooledBuffer(std::move(storage), this);
+        }
+    }
+    // 空闲列表为空：在锁外分配新的缓冲区
+    return PooledBuffer(std::vector<uint8_t>(buffer_size_), this);
+}
+
+size_t BufferPool::cached() const{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_list_.size();
+}
+
+void BufferPool::recycle(std::vector<uint8_t>&& storage){
+    // 被扩容过的缓冲区也可以复用，容量只会更大
+    if(storage.size() < buffer_size_){
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(free_list_.size() < max_cached_){
+        free_list_.push_back(std::move(storage));
+    }
+}
+
+} // namespace rtps
+} // namespace tinydds
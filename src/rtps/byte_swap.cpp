@@ -0,0 +1,132 @@
+#include "tinydds/rtps/byte_swap.hpp"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TINYDDS_X86_SIMD 1
+#endif
+
+namespace tinydds {
+namespace rtps {
+
+namespace {
+
+// ========================================
+// 标量实现：逐个元素 bswap
+// ========================================
+
+// 用 memcpy 读写，避免未对齐访问
+inline uint16_t bswap(uint16_t v) { return __builtin_bswap16(v); }
+inline uint32_t bswap(uint32_t v) { return __builtin_bswap32(v); }
+inline uint64_t bswap(uint64_t v) { return __builtin_bswap64(v); }
+
+template<typename U>
+void swap_scalar(uint8_t* dst, const uint8_t* src, size_t count){
+    for(size_t i = 0; i < count; ++i){
+        U v;
+        std::memcpy(&v, src + i * sizeof(U), sizeof(U));
+        v = bswap(v);
+        std::memcpy(dst + i * sizeof(U), &v, sizeof(U));
+    }
+}
+
+void swap_scalar_dispatch(uint8_t* dst, const uint8_t* src, size_t count, size_t elem_size){
+    switch(elem_size){
+        case 2: swap_scalar<uint16_t>(dst, src, count); break;
+        case 4: swap_scalar<uint32_t>(dst, src, count); break;
+        case 8: swap_scalar<uint64_t>(dst, src, count); break;
+        default: std::memmove(dst, src, count * elem_size); break;
+    }
+}
+
+#ifdef TINYDDS_X86_SIMD
+
+// ========================================
+// SIMD 实现：pshufb 按掩码重排字节
+// 掩码第 i 个字节表示输出的第 i 个字节取自输入的哪个位置
+// ========================================
+
+// 16 字节的洗牌掩码（AVX2 的 vpshufb 在两个 128 位通道内分别使用同一个掩码）
+alignas(16) const uint8_t kShuffle16[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) const uint8_t kShuffle32[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+alignas(16) const uint8_t kShuffle64[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+
+const uint8_t* shuffle_mask(size_t elem_size){
+    switch(elem_size){
+        case 2: return kShuffle16;
+        case 4: return kShuffle32;
+        default: return kShuffle64;
+    }
+}
+
+__attribute__((target("ssse3")))
+void swap_ssse3(uint8_t* dst, const uint8_t* src, size_t count, size_t elem_size){
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_mask(elem_size)));
+    size_t bytes = count * elem_size;
+    size_t i = 0;
+    for(; i + 16 <= bytes; i += 16){
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+    // 剩余不足 16 字节的尾部走标量
+    swap_scalar_dispatch(dst + i, src + i, (bytes - i) / elem_size, elem_size);
+}
+
+__attribute__((target("avx2")))
+void swap_avx2(uint8_t* dst, const uint8_t* src, size_t count, size_t elem_size){
+    const __m128i half = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_mask(elem_size)));
+    const __m256i mask = _mm256_broadcastsi128_si256(half);
+    size_t bytes = count * elem_size;
+    size_t i = 0;
+    // 每轮处理 64 字节，让两条洗牌指令并行
+    for(; i + 64 <= bytes; i += 64){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), _mm256_shuffle_epi8(b, mask));
+    }
+    for(; i + 32 <= bytes; i += 32){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    for(; i + 16 <= bytes; i += 16){
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, half));
+    }
+    swap_scalar_dispatch(dst + i, src + i, (bytes - i) / elem_size, elem_size);
+}
+
+using SwapKernel = void (*)(uint8_t*, const uint8_t*, size_t, size_t);
+
+// 进程内只检测一次 CPU 能力
+SwapKernel select_kernel(){
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return swap_avx2;
+    if(__builtin_cpu_supports("ssse3")) return swap_ssse3;
+    return swap_scalar_dispatch;
+}
+
+#endif // TINYDDS_X86_SIMD
+
+} // namespace
+
+void byte_swap_copy(uint8_t* dst, const uint8_t* src, size_t count, size_t elem_size){
+    if(count == 0) return;
+    if(elem_size != 2 && elem_size != 4 && elem_size != 8){
+        swap_scalar_dispatch(dst, src, count, elem_size);
+        return;
+    }
+#ifdef TINYDDS_X86_SIMD
+    static const SwapKernel kernel = select_kernel();
+    // 少量元素时 SIMD 的准备开销不划算
+    if(count * elem_size >= 16){
+        kernel(dst, src, count, elem_size);
+        return;
+    }
+#endif
+    swap_scalar_dispatch(dst, src, count, elem_size);
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -1,10 +1,26 @@
 #include "tinydds/rtps/cdr.hpp"
 
+#include <algorithm>
+
 namespace tinydds {
 namespace rtps {
 
-// 目前所有实现都在头文件中（模板类）
-// 这个文件预留给将来可能的非模板实现
+// 大部分实现都在头文件中（内联），这里放不常走到的冷路径
+
+// 扩容：按两倍增长，直到能放下 required 个字节
+// 外部缓冲区不能扩容，标记为溢出，并把容量收紧到当前长度，
+// 保证后续的写入全部失败，不会在流中间留下空洞
+bool CdrOutputBuffer::grow(size_t required){
+    if(external_){
+        overflow_ = true;
+        capacity_ = size_;
+        return false;
+    }
+    size_t new_capacity = std::max(required, capacity_ * 2);
+    storage_.grow(new_capacity);
+    attach_storage();
+    return true;
+}
 
 } // namespace rtps
-} // namespace tinydds
\ No newline at end of file
+} // namespace tinydds
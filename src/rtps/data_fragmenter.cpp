@@ -0,0 +1,160 @@
+#include "tinydds/rtps/data_fragmenter.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+
+#include <cstring>
+
+#include "tinydds/rtps/cdr_encapsulation.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+namespace {
+
+// 本机字节序对应的 E 标志（头部按本机字节序写入）
+constexpr uint8_t kEndianFlag = native_endian() == CdrEndian::LITTLE_ENDIAN_ORDER ? SubmessageFlag::ENDIANNESS : 0;
+
+// octetsToInlineQos：这个字段之后到 inlineQos（或分片数据）的字节数
+constexpr uint16_t kOctetsToInlineQos = DATA_FRAG_FIXED_SIZE - 4;
+
+// 最后一个分片不满 4 字节对齐时补的填充
+const uint8_t kPadding[SUBMESSAGE_ALIGNMENT] = {0, 0, 0, 0};
+
+// 子消息的长度字段只有 16 位
+constexpr size_t kMaxSubmessageBody = 0xFFFF;
+
+template<typename T>
+uint8_t* put(uint8_t* out, T value){
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+} // namespace
+
+DataFragmenter::DataFragmenter(const GuidPrefix& prefix, size_t fragment_size, size_t max_message_size)
+    : prefix_(prefix){
+    // 一个分片至少要能单独放进一条消息，fragment_size 字段只有 16 位
+    size_t budget = max_message_size > DATA_FRAG_MESSAGE_HEADER_SIZE + SUBMESSAGE_ALIGNMENT
+                        ? max_message_size - DATA_FRAG_MESSAGE_HEADER_SIZE - SUBMESSAGE_ALIGNMENT
+                        : SUBMESSAGE_ALIGNMENT;
+    size_t body_budget = kMaxSubmessageBody - DATA_FRAG_FIXED_SIZE - SUBMESSAGE_ALIGNMENT;
+    if(budget > body_budget) budget = body_budget;
+    if(fragment_size == 0) fragment_size = 1;
+    if(fragment_size > budget) fragment_size = budget;
+    fragment_size_ = fragment_size;
+    fragments_per_message_ = budget / fragment_size_;
+}
+
+void DataFragmenter::write_header(uint8_t* out, const EntityId& reader_id, const EntityId& writer_id,
+                                  const SequenceNumber& writer_sn, uint32_t first_fragment, uint32_t fragment_count,
+                                  uint32_t sample_size, size_t body_size) const {
+    out[0] = 'R';
+    out[1] = 'T';
+    out[2] = 'P';
+    out[3] = 'S';
+    out[4] = PROTOCOL_VERSION_MAJOR;
+    out[5] = PROTOCOL_VERSION_MINOR;
+    out[6] = VENDOR_ID_TINYDDS[0];
+    out[7] = VENDOR_ID_TINYDDS[1];
+    std::memcpy(out + 8, prefix_.value.data(), prefix_.value.size());
+    uint8_t* p = out + RTPS_HEADER_SIZE;
+    *p++ = static_cast<uint8_t>(SubmessageId::DATA_FRAG);
+    *p++ = kEndianFlag;
+    p = put(p, static_cast<uint16_t>(body_size));
+    p = put(p, static_cast<uint16_t>(0)); // extraFlags
+    p = put(p, kOctetsToInlineQos);
+    std::memcpy(p, reader_id.value.data(), 4);
+    std::memcpy(p + 4, writer_id.value.data(), 4);
+    p += 8;
+    p = put(p, writer_sn.high);
+    p = put(p, writer_sn.low);
+    p = put(p, first_fragment);
+    p = put(p, static_cast<uint16_t>(fragment_count));
+    p = put(p, static_cast<uint16_t>(fragment_size_));
+    put(p, sample_size);
+}
+
+Span<const FragmentMessage> DataFragmenter::fragment(const EntityId& reader_id, const EntityId& writer_id,
+                                                     const SequenceNumber& writer_sn, ConstByteSpan payload,
+                                                     uint32_t first_fragment, uint32_t last_fragment){
+    runs_.clear();
+    if(payload.size() > UINT32_MAX) return build(reader_id, writer_id, writer_sn, payload);
+    uint32_t total = fragment_count(payload.size());
+    if(first_fragment == 0) first_fragment = 1;
+    if(last_fragment > total) last_fragment = total;
+    if(first_fragment <= last_fragment){
+        runs_.push_back(Run{first_fragment, last_fragment});
+    }
+    return build(reader_id, writer_id, writer_sn, payload);
+}
+
+Span<const FragmentMessage> DataFragmenter::fragment_missing(const EntityId& reader_id, const EntityId& writer_id,
+                                                             const SequenceNumber& writer_sn, ConstByteSpan payload,
+                                                             const FragmentNumberSet& missing){
+    runs_.clear();
+    if(statistics_ != nullptr) statistics_->on_nack_received();
+    if(payload.size() <= UINT32_MAX){
+        uint32_t total = fragment_count(payload.size());
+        missing.for_each([&](uint32_t fragment){
+            if(fragment == 0 || fragment > total) return;
+            if(!runs_.empty() && runs_.back().last + 1 == fragment){
+                runs_.back().last = fragment;
+            }
+            else{
+                runs_.push_back(Run{fragment, fragment});
+            }
+        });
+    }
+    if(statistics_ != nullptr){
+        for(const Run& run : runs_) statistics_->on_retransmit(run.last - run.first + 1);
+    }
+    return build(reader_id, writer_id, writer_sn, payload);
+}
+
+Span<const FragmentMessage> DataFragmenter::build(const EntityId& reader_id, const EntityId& writer_id,
+                                                  const SequenceNumber& writer_sn, ConstByteSpan payload){
+    messages_.clear();
+    size_t count = 0;
+    for(const Run& run : runs_){
+        count += (run.last - run.first + fragments_per_message_) / fragments_per_message_;
+    }
+    // 先按消息数一次分配好头部缓冲区，之后生成的视图不会因为扩容而失效
+    if(headers_.size() < count * HEADER_STRIDE){
+        headers_.resize(count * HEADER_STRIDE);
+    }
+    messages_.reserve(count);
+
+    uint32_t sample_size = static_cast<uint32_t>(payload.size());
+    for(const Run& run : runs_){
+        for(uint32_t first = run.first; first <= run.last;){
+            uint32_t remaining = run.last - first + 1;
+            uint32_t fragments = remaining < fragments_per_message_ ? remaining
+                                                                    : static_cast<uint32_t>(fragments_per_message_);
+            size_t begin = static_cast<size_t>(first - 1) * fragment_size_;
+            size_t end = begin + static_cast<size_t>(fragments) * fragment_size_;
+            if(end > payload.size()) end = payload.size();
+            size_t data_size = end - begin;
+            size_t padding = (SUBMESSAGE_ALIGNMENT - data_size % SUBMESSAGE_ALIGNMENT) % SUBMESSAGE_ALIGNMENT;
+
+            uint8_t* header = headers_.data() + messages_.size() * HEADER_STRIDE;
+            write_header(header, reader_id, writer_id, writer_sn, first, fragments, sample_size,
+                         DATA_FRAG_FIXED_SIZE + data_size + padding);
+
+            FragmentMessage message;
+            message.parts[0] = ConstByteSpan(header, DATA_FRAG_MESSAGE_HEADER_SIZE);
+            message.parts[1] = payload.subspan(begin, data_size);
+            message.part_count = 2;
+            if(padding != 0){
+                message.parts[2] = ConstByteSpan(kPadding, padding);
+                message.part_count = 3;
+            }
+            message.first_fragment = first;
+            message.fragment_count = fragments;
+            messages_.push_back(message);
+            first += fragments;
+        }
+    }
+    return Span<const FragmentMessage>(messages_.data(), messages_.size());
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,86 @@
+#include "tinydds/rtps/entity_statistics.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+namespace {
+
+uint32_t period_mask(uint32_t period){
+    uint32_t rounded = 1;
+    while(rounded < period && rounded < (1u << 31)) rounded <<= 1;
+    return rounded - 1;
+}
+
+} // namespace
+
+EntityStatistics::EntityStatistics(const GUID& guid, const StatisticsConfig& config)
+    : sample_mask_(period_mask(config.sample_period)), guid_(guid){
+    if(STATISTICS_ENABLED && config.latency_histograms){
+        latency_.reset(new StatCounter[LatencyHistogram::BUCKET_COUNT]);
+    }
+}
+
+void EntityStatistics::snapshot(EntityStatisticsSnapshot& out) const {
+    out.guid = guid_;
+    StatisticsCounters& c = out.counters;
+    c.samples_sent = samples_sent_.load();
+    c.bytes_sent = bytes_sent_.load();
+    c.samples_received = samples_received_.load();
+    c.bytes_received = bytes_received_.load();
+    c.retransmits = retransmits_.load();
+    c.nacks_sent = nacks_sent_.load();
+    c.nacks_received = nacks_received_.load();
+    c.samples_dropped = samples_dropped_.load();
+    c.serialization_ns = serialization_ns_.load();
+    c.serializations = serializations_.load();
+    c.queue_depth = queue_depth_.load();
+    c.queue_depth_max = queue_depth_max_.load();
+
+    out.latency.reset();
+    if(latency_ != nullptr){
+        for(size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i){
+            uint64_t count = latency_[i].load();
+            if(count != 0) out.latency.record(LatencyHistogram::bucket_lowest(i), count);
+        }
+    }
+}
+
+EntityStatistics* StatisticsRegistry::register_entity(const GUID& guid){
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<EntityStatistics>* existing = entities_.find(guid);
+    if(existing != nullptr) return existing->get();
+    std::unique_ptr<EntityStatistics> statistics(new EntityStatistics(guid, config_));
+    EntityStatistics* result = statistics.get();
+    entities_.insert(guid, std::move(statistics));
+    return result;
+}
+
+bool StatisticsRegistry::unregister_entity(const GUID& guid){
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entities_.erase(guid);
+}
+
+bool StatisticsRegistry::snapshot(const GUID& guid, EntityStatisticsSnapshot& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::unique_ptr<EntityStatistics>* statistics = entities_.find(guid);
+    if(statistics == nullptr) return false;
+    (*statistics)->snapshot(out);
+    return true;
+}
+
+void StatisticsRegistry::snapshot_all(std::vector<EntityStatisticsSnapshot>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.resize(entities_.size());
+    size_t index = 0;
+    entities_.for_each([&](const GUID&, const std::unique_ptr<EntityStatistics>& statistics){
+        statistics->snapshot(out[index++]);
+    });
+}
+
+size_t StatisticsRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entities_.size();
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,36 @@
+#include "tinydds/rtps/event_count.hpp"
+
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace tinydds {
+namespace rtps {
+
+// 只在进程内使用，用 FUTEX_PRIVATE_FLAG 让内核走更快的私有 futex 路径
+void EventCount::wait(uint32_t key, int timeout_ms){
+    timespec timeout;
+    timespec* timeout_ptr = nullptr;
+    if(timeout_ms >= 0){
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        timeout_ptr = &timeout;
+    }
+    // epoch_ 已经不等于 key（登记之后来过通知）时内核立即返回
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, key, timeout_ptr, nullptr, 0);
+    waiters_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void EventCount::wake_all(){
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void EventCount::wake_one(){
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+} // namespace rtps
+} // namespace tinydds
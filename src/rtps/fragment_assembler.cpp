@@ -0,0 +1,174 @@
+#include "tinydds/rtps/fragment_assembler.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+
+#include <cstring>
+
+namespace tinydds {
+namespace rtps {
+
+FragmentAssembler::FragmentAssembler(size_t max_samples, size_t max_sample_size)
+    : samples_(max_samples == 0 ? 1 : max_samples), max_sample_size_(max_sample_size) {}
+
+FragmentAssembler::Sample* FragmentAssembler::find(const SequenceNumber& writer_sn){
+    int64_t sequence = writer_sn.to_int64();
+    for(Sample& sample : samples_){
+        if(sample.active && sample.sequence == sequence) return &sample;
+    }
+    return nullptr;
+}
+
+const FragmentAssembler::Sample* FragmentAssembler::find(const SequenceNumber& writer_sn) const {
+    return const_cast<FragmentAssembler*>(this)->find(writer_sn);
+}
+
+bool FragmentAssembler::recently_delivered(int64_t sequence) const {
+    for(int64_t delivered : recent_){
+        if(delivered == sequence) return true;
+    }
+    return false;
+}
+
+FragmentAssembler::Sample& FragmentAssembler::acquire(){
+    Sample* oldest = nullptr;
+    for(Sample& sample : samples_){
+        if(!sample.active) return sample;
+        if(oldest == nullptr || sample.sequence < oldest->sequence) oldest = &sample;
+    }
+    oldest->active = false;
+    ++evicted_;
+    if(statistics_ != nullptr) statistics_->on_sample_dropped();
+    return *oldest;
+}
+
+void FragmentAssembler::release(Sample& sample){
+    recent_[recent_next_] = sample.sequence;
+    recent_next_ = (recent_next_ + 1) % RECENT_SIZE;
+    sample.active = false;
+}
+
+FragmentAssembler::FragmentResult FragmentAssembler::on_data_frag(const DataFragSubmessage& fragment){
+    uint32_t total = fragment.total_fragments();
+    uint32_t first = fragment.fragment_starting_num;
+    uint32_t count = fragment.fragments_in_submessage;
+    if(total == 0 || first == 0 || count == 0 || first > total || count > total - first + 1 ||
+       fragment.sample_size > max_sample_size_){
+        return FragmentResult::INVALID;
+    }
+    // 分片数据要完整（最后一个分片可以不满，之后可能有对齐填充）
+    size_t begin = static_cast<size_t>(first - 1) * fragment.fragment_size;
+    size_t end = begin + static_cast<size_t>(count) * fragment.fragment_size;
+    if(end > fragment.sample_size) end = fragment.sample_size;
+    if(fragment.fragments.size() < end - begin) return FragmentResult::INVALID;
+
+    int64_t sequence = fragment.writer_sn.to_int64();
+    Sample* sample = find(fragment.writer_sn);
+    if(sample == nullptr){
+        if(recently_delivered(sequence)) return FragmentResult::DUPLICATE;
+        sample = &acquire();
+        sample->active = true;
+        sample->sequence = sequence;
+        sample->sample_size = fragment.sample_size;
+        sample->fragment_size = fragment.fragment_size;
+        sample->total = total;
+        sample->received = 0;
+        sample->highest = 0;
+        sample->announced = 0;
+        // 整个样本一次分配（槽位复用时保留容量），分片到达后直接写到最终位置
+        sample->payload.resize(fragment.sample_size);
+        sample->bitmap.assign((total + 63) / 64, 0);
+    }
+    else if(sample->sample_size != fragment.sample_size || sample->fragment_size != fragment.fragment_size){
+        return FragmentResult::INVALID;
+    }
+    else if(sample->received == sample->total){
+        return FragmentResult::DUPLICATE;
+    }
+
+    uint32_t added = 0;
+    const uint8_t* data = fragment.fragments.data();
+    for(uint32_t i = 0; i < count; ++i){
+        uint32_t index = first - 1 + i;
+        uint64_t bit = uint64_t(1) << (index % 64);
+        uint64_t& word = sample->bitmap[index / 64];
+        if(word & bit) continue;
+        word |= bit;
+        size_t offset = static_cast<size_t>(index) * fragment.fragment_size;
+        size_t length = offset + fragment.fragment_size > fragment.sample_size ? fragment.sample_size - offset
+                                                                              : fragment.fragment_size;
+        std::memcpy(sample->payload.data() + offset, data + static_cast<size_t>(i) * fragment.fragment_size, length);
+        ++added;
+    }
+    if(added == 0) return FragmentResult::DUPLICATE;
+    sample->received += added;
+    if(first + count - 1 > sample->highest) sample->highest = first + count - 1;
+    return sample->received == sample->total ? FragmentResult::COMPLETE : FragmentResult::ACCEPTED;
+}
+
+void FragmentAssembler::on_heartbeat_frag(const SequenceNumber& writer_sn, uint32_t last_fragment_num){
+    Sample* sample = find(writer_sn);
+    if(sample == nullptr) return;
+    uint32_t last = last_fragment_num > sample->total ? sample->total : last_fragment_num;
+    if(last > sample->announced) sample->announced = last;
+}
+
+bool FragmentAssembler::build_nack_frag(const SequenceNumber& writer_sn, FragmentNumberSet& out) const {
+    const Sample* sample = find(writer_sn);
+    if(sample == nullptr || sample->received == sample->total) return false;
+    uint32_t known = sample->highest > sample->announced ? sample->highest : sample->announced;
+
+    // 第一个缺失的分片：跳过全 1 的字，再用 ctz 找到字内的位置
+    uint32_t base = 0;
+    size_t words = sample->bitmap.size();
+    for(size_t w = 0; w < words; ++w){
+        uint64_t missing = ~sample->bitmap[w];
+        if(missing != 0){
+            base = static_cast<uint32_t>(w * 64 + static_cast<size_t>(__builtin_ctzll(missing))) + 1;
+            break;
+        }
+    }
+    if(base == 0 || base > known) return false;
+
+    uint32_t end = known - base + 1 < FRAGMENT_NUMBER_SET_MAX_BITS ? known + 1 : base + FRAGMENT_NUMBER_SET_MAX_BITS;
+    out.reset(base, end - base);
+    // 按 64 位字取反，逐个 32 位输出字填入（线上格式最高位在前）
+    for(uint32_t fragment = base; fragment < end;){
+        uint32_t index = fragment - 1;
+        uint32_t shift = index % 64;
+        uint64_t missing = ~sample->bitmap[index / 64] >> shift;
+        uint32_t span = 64 - shift;
+        if(span > end - fragment) span = end - fragment;
+        while(missing != 0){
+            uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(missing));
+            if(bit >= span) break;
+            uint32_t offset = fragment + bit - base;
+            out.bitmap[offset / 32] |= 0x80000000u >> (offset % 32);
+            missing &= missing - 1;
+        }
+        fragment += span;
+    }
+    if(statistics_ != nullptr) statistics_->on_nack_sent();
+    return true;
+}
+
+void FragmentAssembler::drop(const SequenceNumber& writer_sn){
+    Sample* sample = find(writer_sn);
+    if(sample != nullptr) sample->active = false;
+}
+
+void FragmentAssembler::drop_before(const SequenceNumber& writer_sn){
+    int64_t sequence = writer_sn.to_int64();
+    for(Sample& sample : samples_){
+        if(sample.active && sample.sequence < sequence) sample.active = false;
+    }
+}
+
+size_t FragmentAssembler::in_progress() const {
+    size_t count = 0;
+    for(const Sample& sample : samples_){
+        if(sample.active && sample.received != sample.total) ++count;
+    }
+    return count;
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -1,24 +1,71 @@
 #include "tinydds/rtps/guid.hpp"
-#include <random>
+#include "tinydds/rtps/message.hpp"
+
+#include <chrono>
+#include <sys/random.h>
+#include <unistd.h>
 
 namespace tinydds{
 namespace rtps{
 
-// 生成随机的 GuidPrefix
-// 这个函数在创建 DomainParticipaant 时被调用
-// todo:学习怎样生成随机数
+namespace {
+
+// 进程级的 GuidPrefix 素材，第一次使用时初始化一次（函数内静态变量的初始化是线程安全的）
+struct PrefixSeed{
+    uint32_t host_id;
+    uint32_t process_id;
+    std::atomic<uint32_t> counter;
+
+    PrefixSeed(){
+        uint64_t random = 0;
+        // getrandom 在熵池初始化之后不会阻塞；GRND_NONBLOCK 保证最坏情况也立即返回
+        if(getrandom(&random, sizeof(random), GRND_NONBLOCK) != static_cast<ssize_t>(sizeof(random))){
+            // 拿不到随机数时退化为时间 + 地址
+            random = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                     reinterpret_cast<uintptr_t>(this);
+        }
+        random = hash_mix64(random);
+
+        // hostId：主机名的哈希，同一台机器上的参与者前缀相同，便于判断是否同主机
+        char hostname[256] = {};
+        uint64_t host_hash = 0x9E3779B97F4A7C15ULL;
+        if(gethostname(hostname, sizeof(hostname) - 1) == 0){
+            for(const char* c = hostname; *c != '\0'; ++c){
+                host_hash = hash_mix64(host_hash ^ static_cast<uint8_t>(*c));
+            }
+        }else{
+            host_hash = random;
+        }
+        host_id = static_cast<uint32_t>(host_hash);
+        process_id = static_cast<uint32_t>(getpid());
+        // 计数器从随机值开始：进程重启后即使 pid 被复用，前缀也不会和上一次一样
+        counter.store(static_cast<uint32_t>(random >> 32), std::memory_order_relaxed);
+    }
+};
+
+PrefixSeed& prefix_seed(){
+    static PrefixSeed seed;
+    return seed;
+}
+
+} // namespace
+
 GuidPrefix generate_guid_prefix(){
+    PrefixSeed& seed = prefix_seed();
+    uint32_t counter = seed.counter.fetch_add(1, std::memory_order_relaxed);
+
     GuidPrefix prefix;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<uint8_t> dis(0, 255);
-    
-    for (int i = 0; i < 12; ++i) {
-        prefix.value[i] = dis(gen);
+    prefix.value[0] = VENDOR_ID_TINYDDS[0];
+    prefix.value[1] = VENDOR_ID_TINYDDS[1];
+    // 进程号折叠为 2 字节，留出 4 字节给计数器：一个进程里 2^32 个前缀之内不会重复
+    uint16_t process = static_cast<uint16_t>(seed.process_id ^ (seed.process_id >> 16));
+    prefix.value[6] = static_cast<uint8_t>(process >> 8);
+    prefix.value[7] = static_cast<uint8_t>(process);
+    for(int i = 0; i < 4; ++i){
+        prefix.value[2 + i] = static_cast<uint8_t>(seed.host_id >> (24 - 8 * i));
+        prefix.value[8 + i] = static_cast<uint8_t>(counter >> (24 - 8 * i));
     }
-    
     return prefix;
-
 }
 
 } // namespace rtps
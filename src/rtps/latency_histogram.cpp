@@ -0,0 +1,46 @@
+#include "tinydds/rtps/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tinydds {
+namespace rtps {
+
+void LatencyHistogram::merge(const LatencyHistogram& other){
+    for(size_t i = 0; i < BUCKET_COUNT; ++i){
+        counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    sum_ += other.sum_;
+    if(other.min_ < min_) min_ = other.min_;
+    if(other.max_ > max_) max_ = other.max_;
+}
+
+void LatencyHistogram::reset(){
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    sum_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+uint64_t LatencyHistogram::value_at_percentile(double percentile) const {
+    if(total_ == 0) return 0;
+    if(percentile < 0) percentile = 0;
+    if(percentile > 100) percentile = 100;
+    // 第 rank 个记录（从 1 开始）所在的桶
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_)));
+    if(rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for(size_t i = 0; i < BUCKET_COUNT; ++i){
+        seen += counts_[i];
+        if(seen >= rank){
+            // 桶的上界可能超过实际记录的最大值
+            return std::min(bucket_highest(i), max_);
+        }
+    }
+    return max_;
+}
+
+} // namespace rtps
+} // namespace tinydds
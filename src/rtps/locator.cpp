@@ -3,8 +3,147 @@
 namespace tinydds {
 namespace rtps {
 
-// 目前所有实现都在头文件中
-// 这个文件预留给将来可能的扩展
+namespace {
+
+// 往固定大小的缓冲区里追加字符，空间不够时记录失败
+struct CharWriter{
+    char* buffer;
+    size_t size;
+    size_t length = 0;
+    bool overflow = false;
+
+    void put(char c){
+        if(length + 1 >= size){ // 始终给结尾的 '\0' 留一个位置
+            overflow = true;
+            return;
+        }
+        buffer[length++] = c;
+    }
+
+    void put_decimal(uint32_t value){
+        char digits[10];
+        int n = 0;
+        do{
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }while(value != 0);
+        while(n > 0){
+            put(digits[--n]);
+        }
+    }
+
+    // 不带前导 0 的小写十六进制
+    void put_hex(uint32_t value){
+        static const char kHex[] = "0123456789abcdef";
+        bool started = false;
+        for(int shift = 12; shift >= 0; shift -= 4){
+            uint32_t digit = (value >> shift) & 0xF;
+            if(digit != 0 || started || shift == 0){
+                put(kHex[digit]);
+                started = true;
+            }
+        }
+    }
+
+    size_t finish(){
+        if(overflow || size == 0){
+            if(size > 0) buffer[0] = '\0';
+            return 0;
+        }
+        buffer[length] = '\0';
+        return length;
+    }
+};
+
+void write_ipv4(CharWriter& writer, const uint8_t* address){
+    for(int i = 0; i < 4; ++i){
+        if(i > 0) writer.put('.');
+        writer.put_decimal(address[i]);
+    }
+}
+
+void write_ipv6(CharWriter& writer, const uint8_t* address){
+    uint32_t groups[8];
+    for(int i = 0; i < 8; ++i){
+        groups[i] = (static_cast<uint32_t>(address[2 * i]) << 8) | address[2 * i + 1];
+    }
+
+    // IPv4 映射地址 ::ffff:a.b.c.d
+    if(groups[0] == 0 && groups[1] == 0 && groups[2] == 0 && groups[3] == 0 && groups[4] == 0 && groups[5] == 0xFFFF){
+        const char prefix[] = "::ffff:";
+        for(const char* c = prefix; *c != '\0'; ++c) writer.put(*c);
+        write_ipv4(writer, address + 12);
+        return;
+    }
+
+    // 最长的一段连续 0 组（至少两组，长度相同时取第一段）
+    int best_start = -1;
+    int best_length = 1;
+    for(int i = 0; i < 8;){
+        if(groups[i] != 0){
+            ++i;
+            continue;
+        }
+        int start = i;
+        while(i < 8 && groups[i] == 0) ++i;
+        if(i - start > best_length){
+            best_start = start;
+            best_length = i - start;
+        }
+    }
+
+    for(int i = 0; i < 8; ++i){
+        if(i == best_start){
+            writer.put(':');
+            writer.put(':');
+            i += best_length - 1;
+            continue;
+        }
+        if(i > 0 && i != best_start + best_length) writer.put(':');
+        writer.put_hex(groups[i]);
+    }
+}
+
+} // namespace
+
+size_t format_ipv4_address(const uint8_t* address, char* buffer, size_t size){
+    CharWriter writer{buffer, size};
+    write_ipv4(writer, address);
+    return writer.finish();
+}
+
+size_t format_ipv6_address(const uint8_t* address, char* buffer, size_t size){
+    CharWriter writer{buffer, size};
+    write_ipv6(writer, address);
+    return writer.finish();
+}
+
+size_t Locator::address_to_chars(char* buffer, size_t size) const{
+    if(kind == LocatorKind::LOCATOR_KIND_UDPv6){
+        return format_ipv6_address(address.data(), buffer, size);
+    }
+    if(kind == LocatorKind::LOCATOR_KIND_UDPv4){
+        return format_ipv4_address(&address[12], buffer, size);
+    }
+    return 0;
+}
+
+size_t Locator::to_chars(char* buffer, size_t size) const{
+    CharWriter writer{buffer, size};
+    if(kind == LocatorKind::LOCATOR_KIND_UDPv6){
+        writer.put('[');
+        write_ipv6(writer, address.data());
+        writer.put(']');
+    }else if(kind == LocatorKind::LOCATOR_KIND_UDPv4){
+        write_ipv4(writer, &address[12]);
+    }else{
+        if(size > 0) buffer[0] = '\0';
+        return 0;
+    }
+    writer.put(':');
+    writer.put_decimal(port);
+    return writer.finish();
+}
 
 } // namespace rtps
-} // namespace tinydds
\ No newline at end of file
+} // namespace tinydds
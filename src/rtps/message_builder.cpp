@@ -0,0 +1,252 @@
+#include "tinydds/rtps/message_builder.hpp"
+
+#include <cstring>
+
+namespace tinydds {
+namespace rtps {
+
+namespace {
+
+constexpr size_t align4(size_t n){
+    return (n + SUBMESSAGE_ALIGNMENT - 1) / SUBMESSAGE_ALIGNMENT * SUBMESSAGE_ALIGNMENT;
+}
+
+// 本机字节序对应的 E 标志
+constexpr uint8_t kEndianFlag = native_endian() == CdrEndian::LITTLE_ENDIAN_ORDER ? SubmessageFlag::ENDIANNESS : 0;
+
+// DATA 的固定部分：extraFlags(2) + octetsToInlineQos(2) + readerId(4) + writerId(4) + writerSN(8)
+constexpr size_t kDataFixedSize = 20;
+// octetsToInlineQos：从这个字段之后到 inlineQos（或负载）的字节数
+constexpr uint16_t kOctetsToInlineQos = 16;
+// INFO_TS 的内容：seconds(4) + fraction(4)
+constexpr size_t kInfoTimestampSize = 8;
+
+size_t sequence_number_set_size(uint32_t num_bits){
+    return 8 + 4 + (num_bits + 31) / 32 * 4;
+}
+
+} // namespace
+
+MessageBuilder::MessageBuilder(const GuidPrefix& prefix, Sink sink, size_t mtu, std::chrono::microseconds max_delay)
+    : prefix_(prefix), sink_(std::move(sink)), mtu_(mtu), max_delay_(max_delay), serializer_(mtu){
+    write_message_header();
+}
+
+void MessageBuilder::write_message_header(){
+    serializer_.reset();
+    current_timestamp_ = Timestamp();
+    uint8_t* ptr = serializer_.reserve_bytes(RTPS_HEADER_SIZE);
+    ptr[0] = 'R';
+    ptr[1] = 'T';
+    ptr[2] = 'P';
+    ptr[3] = 'S';
+    ptr[4] = PROTOCOL_VERSION_MAJOR;
+    ptr[5] = PROTOCOL_VERSION_MINOR;
+    ptr[6] = VENDOR_ID_TINYDDS[0];
+    ptr[7] = VENDOR_ID_TINYDDS[1];
+    std::memcpy(ptr + 8, prefix_.value.data(), prefix_.value.size());
+}
+
+bool MessageBuilder::begin_submessage(SubmessageId id, uint8_t flags, size_t body_size){
+    size_t total = SUBMESSAGE_HEADER_SIZE + body_size;
+    // 子消息的长度字段只有 16 位，单独一个子消息也要放得进 MTU
+    if(body_size > 0xFFFF || RTPS_HEADER_SIZE + total > mtu_) return false;
+    if(total > remaining()){
+        flush();
+    }
+    if(pending_submessages_ == 0){
+        first_pending_ = Clock::now();
+    }
+    serializer_.serialize_byte(static_cast<uint8_t>(id));
+    serializer_.serialize_byte(flags | kEndianFlag);
+    serializer_.serialize_uint16(static_cast<uint16_t>(body_size));
+    ++pending_submessages_;
+    return true;
+}
+
+void MessageBuilder::write_entity_id(const EntityId& id){
+    uint8_t* ptr = serializer_.reserve_bytes(4);
+    std::memcpy(ptr, id.value.data(), 4);
+}
+
+void MessageBuilder::write_sequence_number(const SequenceNumber& seq){
+    serializer_.serialize_int32(seq.high);
+    serializer_.serialize_uint32(seq.low);
+}
+
+void MessageBuilder::write_sequence_number_set(const SequenceNumber& base, uint32_t num_bits, const uint32_t* bitmap){
+    write_sequence_number(base);
+    serializer_.serialize_uint32(num_bits);
+    size_t words = (num_bits + 31) / 32;
+    for(size_t i = 0; i < words; ++i){
+        serializer_.serialize_uint32(bitmap[i]);
+    }
+}
+
+bool MessageBuilder::add_info_ts(const Timestamp& timestamp){
+    if(!timestamp.valid()){
+        if(!begin_submessage(SubmessageId::INFO_TS, SubmessageFlag::INVALIDATE, 0)) return false;
+    }
+    else{
+        if(!begin_submessage(SubmessageId::INFO_TS, 0, kInfoTimestampSize)) return false;
+        serializer_.serialize_int32(timestamp.seconds);
+        serializer_.serialize_uint32(timestamp.fraction);
+    }
+    current_timestamp_ = timestamp;
+    return true;
+}
+
+bool MessageBuilder::fits_data(size_t serialized_payload_size, size_t inline_qos_size) const {
+    size_t body_size = kDataFixedSize + inline_qos_size + align4(serialized_payload_size);
+    return body_size <= 0xFFFF && RTPS_HEADER_SIZE + SUBMESSAGE_HEADER_SIZE + body_size <= mtu_;
+}
+
+bool MessageBuilder::clear_timestamp(size_t data_size){
+    if(!current_timestamp_.valid()) return true;
+    if(data_size + SUBMESSAGE_HEADER_SIZE <= remaining()) return add_info_ts(Timestamp());
+    flush(); // DATA 可能刚好放得下，但不能跟在别人的时间戳后面
+    return true;
+}
+
+bool MessageBuilder::add_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                              ConstByteSpan serialized_payload, ConstByteSpan inline_qos){
+    size_t data_size = SUBMESSAGE_HEADER_SIZE + kDataFixedSize + inline_qos.size() + align4(serialized_payload.size());
+    if(!clear_timestamp(data_size)) return false;
+    return append_data(reader_id, writer_id, writer_sn, serialized_payload, inline_qos);
+}
+
+bool MessageBuilder::add_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                              ConstByteSpan serialized_payload, const Timestamp& source_timestamp){
+    size_t data_size = SUBMESSAGE_HEADER_SIZE + kDataFixedSize + align4(serialized_payload.size());
+    size_t info_size = SUBMESSAGE_HEADER_SIZE + kInfoTimestampSize;
+    if(RTPS_HEADER_SIZE + info_size + data_size <= mtu_){
+        // 当前消息里已经是这个时间戳，并且 DATA 放得下时不用再写 INFO_TS
+        bool reuse = source_timestamp == current_timestamp_ && data_size <= remaining();
+        if(!reuse){
+            if(info_size + data_size > remaining()) flush();
+            if(!add_info_ts(source_timestamp)) return false;
+        }
+    }
+    else{
+        // 加上 INFO_TS 就超过 MTU：不带时间戳发送
+        if(!clear_timestamp(data_size)) return false;
+    }
+    return append_data(reader_id, writer_id, writer_sn, serialized_payload, ConstByteSpan());
+}
+
+bool MessageBuilder::append_data(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                                 ConstByteSpan serialized_payload, ConstByteSpan inline_qos){
+    size_t padded_payload = align4(serialized_payload.size());
+    size_t body_size = kDataFixedSize + inline_qos.size() + padded_payload;
+    uint8_t flags = 0;
+    if(!inline_qos.empty()) flags |= SubmessageFlag::INLINE_QOS;
+    if(!serialized_payload.empty()) flags |= SubmessageFlag::DATA_PRESENT;
+    if(!begin_submessage(SubmessageId::DATA, flags, body_size)) return false;
+
+    serializer_.serialize_uint16(0); // extraFlags
+    serializer_.serialize_uint16(kOctetsToInlineQos);
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number(writer_sn);
+    if(!inline_qos.empty()){
+        std::memcpy(serializer_.reserve_bytes(inline_qos.size()), inline_qos.data(), inline_qos.size());
+    }
+    if(!serialized_payload.empty()){
+        size_t padding = padded_payload - serialized_payload.size();
+        uint8_t* ptr = serializer_.reserve_bytes(padded_payload);
+        std::memcpy(ptr, serialized_payload.data(), serialized_payload.size());
+        std::memset(ptr + serialized_payload.size(), 0, padding);
+        if(padding > 0 && serialized_payload.size() >= ENCAPSULATION_HEADER_SIZE){
+            // 填充的字节数记在封装头 options 的最低两位（options 是大端，低字节在 ptr[3]）
+            ptr[3] = static_cast<uint8_t>((ptr[3] & ~ENCAPSULATION_OPTIONS_PADDING_MASK) | padding);
+        }
+    }
+    return true;
+}
+
+bool MessageBuilder::add_heartbeat(const EntityId& reader_id, const EntityId& writer_id,
+                                   const SequenceNumber& first_sn, const SequenceNumber& last_sn,
+                                   uint32_t count, bool final_flag, bool liveliness_flag){
+    uint8_t flags = 0;
+    if(final_flag) flags |= SubmessageFlag::FINAL;
+    if(liveliness_flag) flags |= SubmessageFlag::LIVELINESS;
+    if(!begin_submessage(SubmessageId::HEARTBEAT, flags, 4 + 4 + 8 + 8 + 4)) return false;
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number(first_sn);
+    write_sequence_number(last_sn);
+    serializer_.serialize_uint32(count);
+    return true;
+}
+
+bool MessageBuilder::add_acknack(const EntityId& reader_id, const EntityId& writer_id,
+                                 const SequenceNumber& base, uint32_t num_bits, const uint32_t* bitmap,
+                                 uint32_t count, bool final_flag){
+    if(num_bits > SEQUENCE_NUMBER_SET_MAX_BITS) return false;
+    uint8_t flags = final_flag ? SubmessageFlag::FINAL : 0;
+    if(!begin_submessage(SubmessageId::ACKNACK, flags, 4 + 4 + sequence_number_set_size(num_bits) + 4)) return false;
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number_set(base, num_bits, bitmap);
+    serializer_.serialize_uint32(count);
+    return true;
+}
+
+bool MessageBuilder::add_gap(const EntityId& reader_id, const EntityId& writer_id,
+                             const SequenceNumber& gap_start, const SequenceNumber& list_base,
+                             uint32_t num_bits, const uint32_t* bitmap){
+    if(num_bits > SEQUENCE_NUMBER_SET_MAX_BITS) return false;
+    if(!begin_submessage(SubmessageId::GAP, 0, 4 + 4 + 8 + sequence_number_set_size(num_bits))) return false;
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number(gap_start);
+    write_sequence_number_set(list_base, num_bits, bitmap);
+    return true;
+}
+
+bool MessageBuilder::add_nack_frag(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                                   const FragmentNumberSet& fragment_number_state, uint32_t count){
+    uint32_t num_bits = fragment_number_state.num_bits;
+    if(num_bits > FRAGMENT_NUMBER_SET_MAX_BITS) return false;
+    size_t words = (num_bits + 31) / 32;
+    if(!begin_submessage(SubmessageId::NACK_FRAG, 0, 4 + 4 + 8 + 4 + 4 + words * 4 + 4)) return false;
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number(writer_sn);
+    serializer_.serialize_uint32(fragment_number_state.base);
+    serializer_.serialize_uint32(num_bits);
+    for(size_t i = 0; i < words; ++i){
+        serializer_.serialize_uint32(fragment_number_state.bitmap[i]);
+    }
+    serializer_.serialize_uint32(count);
+    return true;
+}
+
+bool MessageBuilder::add_heartbeat_frag(const EntityId& reader_id, const EntityId& writer_id, const SequenceNumber& writer_sn,
+                                        uint32_t last_fragment_num, uint32_t count){
+    if(!begin_submessage(SubmessageId::HEARTBEAT_FRAG, 0, 4 + 4 + 8 + 4 + 4)) return false;
+    write_entity_id(reader_id);
+    write_entity_id(writer_id);
+    write_sequence_number(writer_sn);
+    serializer_.serialize_uint32(last_fragment_num);
+    serializer_.serialize_uint32(count);
+    return true;
+}
+
+void MessageBuilder::flush(){
+    if(pending_submessages_ == 0) return;
+    sink_(serializer_.buffer());
+    ++messages_sent_;
+    submessages_sent_ += pending_submessages_;
+    pending_submessages_ = 0;
+    write_message_header();
+}
+
+bool MessageBuilder::flush_if_due(Clock::time_point now){
+    if(pending_submessages_ == 0 || now - first_pending_ < max_delay_) return false;
+    flush();
+    return true;
+}
+
+} // namespace rtps
+} // namespace tinydds
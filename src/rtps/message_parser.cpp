@@ -0,0 +1,261 @@
+#include "tinydds/rtps/message_parser.hpp"
+
+#include <cstring>
+
+#include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/parameter_list.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+// ============================================================
+// MessageParser
+// ============================================================
+
+MessageParser::MessageParser(ConstByteSpan message) : message_(message){
+    if(message.size() < RTPS_HEADER_SIZE) return;
+    if(message[0] != 'R' || message[1] != 'T' || message[2] != 'P' || message[3] != 'S') return;
+    header_.version_major = message[4];
+    header_.version_minor = message[5];
+    if(header_.version_major != PROTOCOL_VERSION_MAJOR) return;
+    header_.vendor_id[0] = message[6];
+    header_.vendor_id[1] = message[7];
+    std::memcpy(header_.guid_prefix.value.data(), &message[8], header_.guid_prefix.value.size());
+    pos_ = RTPS_HEADER_SIZE;
+    valid_ = true;
+}
+
+bool MessageParser::next(SubmessageView& submessage){
+    if(!valid_ || malformed_) return false;
+    size_t remaining = message_.size() - pos_;
+    if(remaining < SUBMESSAGE_HEADER_SIZE) return false;
+
+    const uint8_t* ptr = &message_[pos_];
+    uint8_t flags = ptr[1];
+    // 子消息头的长度字段按它自己的 E 标志解释
+    uint16_t octets_to_next = (flags & SubmessageFlag::ENDIANNESS)
+        ? static_cast<uint16_t>(ptr[2] | (ptr[3] << 8))
+        : static_cast<uint16_t>((ptr[2] << 8) | ptr[3]);
+
+    size_t body_size = octets_to_next;
+    remaining -= SUBMESSAGE_HEADER_SIZE;
+    // 长度为 0 表示一直延伸到消息末尾（PAD 和 INFO_TS 除外）
+    SubmessageId id = static_cast<SubmessageId>(ptr[0]);
+    if(octets_to_next == 0 && id != SubmessageId::PAD && id != SubmessageId::INFO_TS){
+        body_size = remaining;
+    }
+    if(body_size > remaining){
+        malformed_ = true;
+        return false;
+    }
+
+    submessage.id = id;
+    submessage.flags = flags;
+    submessage.body = message_.subspan(pos_ + SUBMESSAGE_HEADER_SIZE, body_size);
+    pos_ += SUBMESSAGE_HEADER_SIZE + body_size;
+    return true;
+}
+
+// ============================================================
+// 子消息内容
+// 每个子消息可以有不同的字节序，按 E 标志选择对应的反序列化器实例
+// ============================================================
+
+namespace {
+
+template<typename Deserializer>
+bool read_entity_id(Deserializer& d, EntityId& id){
+    const uint8_t* ptr = d.consume_bytes(4);
+    if(ptr == nullptr) return false;
+    std::memcpy(id.value.data(), ptr, 4);
+    return true;
+}
+
+template<typename Deserializer>
+bool read_sequence_number(Deserializer& d, SequenceNumber& seq){
+    return d.deserialize_int32(seq.high) && d.deserialize_uint32(seq.low);
+}
+
+template<typename Deserializer>
+bool read_sequence_number_set(Deserializer& d, SequenceNumberSet& set){
+    if(!read_sequence_number(d, set.base) || !d.deserialize_uint32(set.num_bits)) return false;
+    if(set.num_bits > SEQUENCE_NUMBER_SET_MAX_BITS) return false;
+    size_t words = set.num_words();
+    for(size_t i = 0; i < words; ++i){
+        if(!d.deserialize_uint32(set.bitmap[i])) return false;
+    }
+    for(size_t i = words; i < set.bitmap.size(); ++i){
+        set.bitmap[i] = 0;
+    }
+    return true;
+}
+
+// Q 标志为 1 时从 inline_qos_start 开始是以 PID_SENTINEL 结束的参数列表：
+// 按每个参数的长度跳过，只记录范围。返回负载开始的位置，格式错误时返回 0
+template<typename Policy>
+size_t read_inline_qos(const SubmessageView& submessage, size_t inline_qos_start, ConstByteSpan& inline_qos){
+    inline_qos = ConstByteSpan();
+    if(inline_qos_start > submessage.body.size()) return 0;
+    if(!(submessage.flags & SubmessageFlag::INLINE_QOS)) return inline_qos_start;
+    ParameterListReader<Policy> reader(submessage.body.subspan(inline_qos_start));
+    if(!reader.skip_to_end()) return 0;
+    inline_qos = submessage.body.subspan(inline_qos_start, reader.position());
+    return inline_qos_start + reader.position();
+}
+
+template<typename Policy>
+bool parse_data_body(const SubmessageView& submessage, DataSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    uint16_t extra_flags;
+    uint16_t octets_to_inline_qos;
+    if(!d.deserialize_uint16(extra_flags) || !d.deserialize_uint16(octets_to_inline_qos)) return false;
+    size_t inline_qos_start = d.position() + octets_to_inline_qos;
+    if(!read_entity_id(d, out.reader_id) || !read_entity_id(d, out.writer_id) ||
+       !read_sequence_number(d, out.writer_sn)) return false;
+
+    out.flags = submessage.flags;
+    size_t payload_start = read_inline_qos<Policy>(submessage, inline_qos_start, out.inline_qos);
+    if(payload_start == 0) return false;
+    out.serialized_payload = ConstByteSpan();
+    if(submessage.flags & (SubmessageFlag::DATA_PRESENT | SubmessageFlag::KEY_PRESENT)){
+        out.serialized_payload = submessage.body.subspan(payload_start);
+        // 去掉封装头 options 里记录的末尾填充（子消息按 4 字节对齐时补上的）
+        if(out.serialized_payload.size() >= ENCAPSULATION_HEADER_SIZE){
+            size_t padding = out.serialized_payload[3] & ENCAPSULATION_OPTIONS_PADDING_MASK;
+            if(padding > out.serialized_payload.size() - ENCAPSULATION_HEADER_SIZE) return false;
+            out.serialized_payload = out.serialized_payload.subspan(0, out.serialized_payload.size() - padding);
+        }
+    }
+    return true;
+}
+
+template<typename Policy>
+bool parse_data_frag_body(const SubmessageView& submessage, DataFragSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    uint16_t extra_flags;
+    uint16_t octets_to_inline_qos;
+    if(!d.deserialize_uint16(extra_flags) || !d.deserialize_uint16(octets_to_inline_qos)) return false;
+    size_t inline_qos_start = d.position() + octets_to_inline_qos;
+    if(!read_entity_id(d, out.reader_id) || !read_entity_id(d, out.writer_id) ||
+       !read_sequence_number(d, out.writer_sn) || !d.deserialize_uint32(out.fragment_starting_num) ||
+       !d.deserialize_uint16(out.fragments_in_submessage) || !d.deserialize_uint16(out.fragment_size) ||
+       !d.deserialize_uint32(out.sample_size)) return false;
+
+    out.flags = submessage.flags;
+    size_t payload_start = read_inline_qos<Policy>(submessage, inline_qos_start, out.inline_qos);
+    if(payload_start == 0) return false;
+    out.fragments = submessage.body.subspan(payload_start);
+    return true;
+}
+
+template<typename Policy>
+bool parse_nack_frag_body(const SubmessageView& submessage, NackFragSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    FragmentNumberSet& set = out.fragment_number_state;
+    if(!read_entity_id(d, out.reader_id) || !read_entity_id(d, out.writer_id) ||
+       !read_sequence_number(d, out.writer_sn) || !d.deserialize_uint32(set.base) ||
+       !d.deserialize_uint32(set.num_bits)) return false;
+    if(set.num_bits > FRAGMENT_NUMBER_SET_MAX_BITS) return false;
+    size_t words = set.num_words();
+    for(size_t i = 0; i < words; ++i){
+        if(!d.deserialize_uint32(set.bitmap[i])) return false;
+    }
+    for(size_t i = words; i < set.bitmap.size(); ++i){
+        set.bitmap[i] = 0;
+    }
+    return d.deserialize_uint32(out.count);
+}
+
+template<typename Policy>
+bool parse_heartbeat_frag_body(const SubmessageView& submessage, HeartbeatFragSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    return read_entity_id(d, out.reader_id) && read_entity_id(d, out.writer_id) &&
+           read_sequence_number(d, out.writer_sn) && d.deserialize_uint32(out.last_fragment_num) &&
+           d.deserialize_uint32(out.count);
+}
+
+template<typename Policy>
+bool parse_info_ts_body(const SubmessageView& submessage, InfoTimestampSubmessage& out){
+    out.timestamp = Timestamp();
+    if(submessage.flags & SubmessageFlag::INVALIDATE) return true;
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    return d.deserialize_int32(out.timestamp.seconds) && d.deserialize_uint32(out.timestamp.fraction);
+}
+
+template<typename Policy>
+bool parse_heartbeat_body(const SubmessageView& submessage, HeartbeatSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    out.final_flag = (submessage.flags & SubmessageFlag::FINAL) != 0;
+    out.liveliness_flag = (submessage.flags & SubmessageFlag::LIVELINESS) != 0;
+    return read_entity_id(d, out.reader_id) && read_entity_id(d, out.writer_id) &&
+           read_sequence_number(d, out.first_sn) && read_sequence_number(d, out.last_sn) &&
+           d.deserialize_uint32(out.count);
+}
+
+template<typename Policy>
+bool parse_acknack_body(const SubmessageView& submessage, AckNackSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    out.final_flag = (submessage.flags & SubmessageFlag::FINAL) != 0;
+    return read_entity_id(d, out.reader_id) && read_entity_id(d, out.writer_id) &&
+           read_sequence_number_set(d, out.reader_sn_state) && d.deserialize_uint32(out.count);
+}
+
+template<typename Policy>
+bool parse_gap_body(const SubmessageView& submessage, GapSubmessage& out){
+    BasicCdrDeserializer<Policy> d(submessage.body);
+    return read_entity_id(d, out.reader_id) && read_entity_id(d, out.writer_id) &&
+           read_sequence_number(d, out.gap_start) && read_sequence_number_set(d, out.gap_list);
+}
+
+} // namespace
+
+bool parse_data(const SubmessageView& submessage, DataSubmessage& out){
+    if(submessage.id != SubmessageId::DATA) return false;
+    return submessage.little_endian() ? parse_data_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_data_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_heartbeat(const SubmessageView& submessage, HeartbeatSubmessage& out){
+    if(submessage.id != SubmessageId::HEARTBEAT) return false;
+    return submessage.little_endian() ? parse_heartbeat_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_heartbeat_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_acknack(const SubmessageView& submessage, AckNackSubmessage& out){
+    if(submessage.id != SubmessageId::ACKNACK) return false;
+    return submessage.little_endian() ? parse_acknack_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_acknack_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_gap(const SubmessageView& submessage, GapSubmessage& out){
+    if(submessage.id != SubmessageId::GAP) return false;
+    return submessage.little_endian() ? parse_gap_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_gap_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_data_frag(const SubmessageView& submessage, DataFragSubmessage& out){
+    if(submessage.id != SubmessageId::DATA_FRAG) return false;
+    return submessage.little_endian() ? parse_data_frag_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_data_frag_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_nack_frag(const SubmessageView& submessage, NackFragSubmessage& out){
+    if(submessage.id != SubmessageId::NACK_FRAG) return false;
+    return submessage.little_endian() ? parse_nack_frag_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_nack_frag_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_heartbeat_frag(const SubmessageView& submessage, HeartbeatFragSubmessage& out){
+    if(submessage.id != SubmessageId::HEARTBEAT_FRAG) return false;
+    return submessage.little_endian() ? parse_heartbeat_frag_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_heartbeat_frag_body<BigEndianPolicy>(submessage, out);
+}
+
+bool parse_info_ts(const SubmessageView& submessage, InfoTimestampSubmessage& out){
+    if(submessage.id != SubmessageId::INFO_TS) return false;
+    return submessage.little_endian() ? parse_info_ts_body<LittleEndianPolicy>(submessage, out)
+                                      : parse_info_ts_body<BigEndianPolicy>(submessage, out);
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,146 @@
+#include "tinydds/rtps/receive_window.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+ReceiveWindow::ReceiveWindow(const SequenceNumber& first_expected)
+    : base_(first_expected.to_int64()),
+      irrelevant_before_(first_expected.to_int64()),
+      highest_received_(first_expected.to_int64() - 1),
+      writer_last_(first_expected.to_int64() - 1) {}
+
+ReceiveWindow::ReceiveResult ReceiveWindow::on_data(const SequenceNumber& sequence_number, ConstByteSpan payload,
+                                                   const Timestamp& source_timestamp){
+    int64_t seq = sequence_number.to_int64();
+    int64_t offset = seq - base_;
+    if(offset < 0) return ReceiveResult::DUPLICATE;
+    if(offset >= static_cast<int64_t>(WINDOW_SIZE)){
+        if(statistics_ != nullptr) statistics_->on_sample_dropped();
+        return ReceiveResult::OUT_OF_WINDOW;
+    }
+    size_t pos = slot_index(seq);
+    if(test_bit(pos)) return ReceiveResult::DUPLICATE;
+
+    Slot& slot = slots_[pos];
+    slot.payload.assign(payload.begin(), payload.end());
+    slot.source_timestamp = source_timestamp;
+    slot.has_data = true;
+    set_bit(pos);
+    if(seq > highest_received_){
+        highest_received_ = seq;
+    }
+    return ReceiveResult::ACCEPTED;
+}
+
+void ReceiveWindow::on_gap(const SequenceNumber& gap_start, const SequenceNumberSet& gap_list){
+    mark_irrelevant(gap_start.to_int64(), gap_list.base.to_int64() - 1);
+    // 位图部分按字处理，连续的 1 合并成一个区间
+    int64_t list_base = gap_list.base.to_int64();
+    for(size_t i = 0; i < gap_list.num_words(); ++i){
+        uint32_t word = gap_list.bitmap[i];
+        while(word != 0){
+            uint32_t begin = static_cast<uint32_t>(__builtin_clz(word));
+            uint32_t rest = ~(word << begin);
+            uint32_t length = rest == 0 ? 32 - begin : static_cast<uint32_t>(__builtin_clz(rest));
+            int64_t first = list_base + static_cast<int64_t>(i * 32 + begin);
+            mark_irrelevant(first, first + length - 1);
+            word &= length + begin >= 32 ? 0u : (0xFFFFFFFFu >> (begin + length));
+        }
+    }
+    if(gap_list.base.to_int64() - 1 > writer_last_){
+        writer_last_ = gap_list.base.to_int64() - 1;
+    }
+}
+
+void ReceiveWindow::on_heartbeat(const SequenceNumber& first, const SequenceNumber& last){
+    if(last.to_int64() > writer_last_){
+        writer_last_ = last.to_int64();
+    }
+    if(first.to_int64() > irrelevant_before_){
+        irrelevant_before_ = first.to_int64();
+    }
+}
+
+bool ReceiveWindow::build_acknack(SequenceNumberSet& out) const{
+    int64_t last = last_known().to_int64();
+    if(last < base_){
+        out.reset(SequenceNumber(base_));
+        return false;
+    }
+    int64_t span = last - base_ + 1;
+    uint32_t num_bits = span > static_cast<int64_t>(WINDOW_SIZE) ? static_cast<uint32_t>(WINDOW_SIZE)
+                                                                 : static_cast<uint32_t>(span);
+    out.reset(SequenceNumber(base_), num_bits);
+
+    // 开头这些序号已经不可用，不再请求重传
+    int64_t skip = irrelevant_before_ - base_;
+    bool missing_any = false;
+    for(size_t i = 0; i < out.num_words(); ++i){
+        uint32_t received = static_cast<uint32_t>(window_bits(slot_index(base_ + static_cast<int64_t>(i * 32))) >> 32);
+        uint32_t missing = ~received;
+        uint32_t bits_in_word = num_bits - static_cast<uint32_t>(i * 32);
+        if(bits_in_word < 32){
+            missing &= ~(0xFFFFFFFFu >> bits_in_word);
+        }
+        int64_t skip_in_word = skip - static_cast<int64_t>(i * 32);
+        if(skip_in_word >= 32){
+            missing = 0;
+        }else if(skip_in_word > 0){
+            missing &= 0xFFFFFFFFu >> skip_in_word;
+        }
+        out.bitmap[i] = missing;
+        missing_any |= missing != 0;
+    }
+    if(missing_any && statistics_ != nullptr) statistics_->on_nack_sent();
+    return missing_any;
+}
+
+size_t ReceiveWindow::pending() const{
+    size_t total = 0;
+    for(uint64_t word : received_){
+        total += static_cast<size_t>(__builtin_popcountll(word));
+    }
+    return total;
+}
+
+int64_t ReceiveWindow::skip_irrelevant() const{
+    int64_t limit = irrelevant_before_ - base_;
+    for(size_t k = 0; k < WORDS; ++k){
+        uint64_t bits = window_bits(slot_index(base_ + static_cast<int64_t>(k * 64)));
+        if(bits != 0){
+            int64_t distance = static_cast<int64_t>(k * 64) + __builtin_clzll(bits);
+            return distance < limit ? distance : limit;
+        }
+    }
+    // 窗口里什么都没有：直接跳到 irrelevant_before_
+    return limit;
+}
+
+void ReceiveWindow::mark_irrelevant(int64_t first, int64_t last){
+    if(last < first) return;
+    if(first <= base_){
+        // 从窗口起点开始的区间只需要移动 irrelevant_before_，即使超出窗口也不用逐个标记
+        if(last + 1 > irrelevant_before_){
+            irrelevant_before_ = last + 1;
+        }
+        return;
+    }
+    int64_t end = base_ + static_cast<int64_t>(WINDOW_SIZE);
+    if(last >= end) last = end - 1;
+    if(last < first) return;
+    // 位为 0 的槽位 has_data 一定是 false，所以直接按字把位置 1 即可
+    size_t pos = slot_index(first);
+    size_t count = static_cast<size_t>(last - first + 1);
+    while(count > 0){
+        size_t shift = pos % 64;
+        size_t n = count < 64 - shift ? count : 64 - shift;
+        uint64_t mask = n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1) << (64 - shift - n);
+        received_[pos / 64] |= mask;
+        pos = (pos + n) & MASK;
+        count -= n;
+    }
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,75 @@
+#include "tinydds/rtps/writer_history.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+
+namespace tinydds {
+namespace rtps {
+
+namespace {
+
+size_t round_up_pow2(size_t n){
+    size_t result = 1;
+    while(result < n){
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+WriterHistoryCache::WriterHistoryCache(const HistoryQos& qos, size_t sample_capacity) : qos_(qos){
+    limit_ = qos_.kind == HistoryKind::KEEP_LAST ? qos_.depth : qos_.max_samples;
+    if(limit_ == 0){
+        limit_ = 1;
+    }
+    // 序列号是连续的，窗口长度不超过 limit_，所以 seq & mask 在窗口内不会冲突
+    size_t capacity = round_up_pow2(limit_);
+    mask_ = capacity - 1;
+    slots_.resize(capacity);
+    if(sample_capacity > 0){
+        for(CacheChange& slot : slots_){
+            slot.payload.reserve(sample_capacity);
+        }
+    }
+}
+
+bool WriterHistoryCache::add_change(ConstByteSpan serialized_payload, SequenceNumber& sequence_number){
+    if(full()){
+        if(qos_.kind == HistoryKind::KEEP_ALL){
+            if(statistics_ != nullptr) statistics_->on_sample_dropped();
+            return false;
+        }
+        // KEEP_LAST：挤掉最旧的样本，它的槽位马上被复用。
+        // 可靠写端确认过的样本已经被 remove_changes_up_to 移走，还在缓存里的就是没被确认的，记为丢弃
+        ++base_;
+        if(reliable_ && statistics_ != nullptr) statistics_->on_sample_dropped();
+    }
+    CacheChange& slot = slots_[slot_index(next_)];
+    slot.sequence_number = SequenceNumber(next_);
+    // assign 在容量足够时不会重新分配，槽位的内存一直复用
+    slot.payload.assign(serialized_payload.begin(), serialized_payload.end());
+    sequence_number = slot.sequence_number;
+    ++next_;
+    if(statistics_ != nullptr) statistics_->set_queue_depth(size());
+    return true;
+}
+
+size_t WriterHistoryCache::remove_changes_up_to(const SequenceNumber& sequence_number){
+    int64_t end = sequence_number.to_int64() + 1;
+    if(end <= base_) return 0;
+    if(end > next_) end = next_;
+    // 只移动窗口起点，槽位里的数据留给之后的样本覆盖
+    size_t removed = static_cast<size_t>(end - base_);
+    base_ = end;
+    if(statistics_ != nullptr) statistics_->set_queue_depth(size());
+    return removed;
+}
+
+bool WriterHistoryCache::remove_min_change(){
+    if(empty()) return false;
+    ++base_;
+    if(statistics_ != nullptr) statistics_->set_queue_depth(size());
+    return true;
+}
+
+} // namespace rtps
+} // namespace tinydds
@@ -0,0 +1,613 @@
+#include "tinydds/transport/shm_transport.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <linux/futex.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace tinydds {
+namespace transport {
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x54445348; // "TDSH"
+constexpr uint32_t kShmVersion = 2;
+constexpr size_t kCacheLine = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "共享内存中的原子变量必须是无锁的");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "共享内存中的原子变量必须是无锁的");
+
+size_t round_up_pow2(size_t value){
+    size_t result = 1;
+    while(result < value) result <<= 1;
+    return result;
+}
+
+size_t align_up(size_t value, size_t alignment){
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// futex 在共享映射上跨进程有效（不能用 FUTEX_PRIVATE_FLAG）
+void futex_wait(std::atomic<uint32_t>* address, uint32_t expected, int timeout_ms){
+    timespec timeout;
+    timespec* timeout_ptr = nullptr;
+    if(timeout_ms >= 0){
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        timeout_ptr = &timeout;
+    }
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAIT, expected, timeout_ptr, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<uint32_t>* address){
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// ============================================================
+// 共享内存中的无锁有界 MPMC 队列（Vyukov）
+// 每个格子带一个序号，生产者/消费者通过 CAS 抢位置，
+// 再用格子序号的 release/acquire 发布数据
+// ============================================================
+struct RingCell{
+    std::atomic<uint64_t> sequence;
+    uint64_t value;
+};
+
+struct alignas(kCacheLine) RingHeader{
+    alignas(kCacheLine) std::atomic<uint64_t> enqueue_pos;
+    alignas(kCacheLine) std::atomic<uint64_t> dequeue_pos;
+};
+
+class SharedRing{
+public:
+    SharedRing() = default;
+
+    SharedRing(void* memory, size_t capacity)
+        : header_(static_cast<RingHeader*>(memory)),
+          cells_(reinterpret_cast<RingCell*>(static_cast<uint8_t*>(memory) + sizeof(RingHeader))),
+          mask_(capacity - 1) {}
+
+    static size_t bytes(size_t capacity){
+        return sizeof(RingHeader) + align_up(capacity * sizeof(RingCell), kCacheLine);
+    }
+
+    // 创建者调用：在共享内存中构造原子变量
+    void initialize(){
+        new (&header_->enqueue_pos) std::atomic<uint64_t>(0);
+        new (&header_->dequeue_pos) std::atomic<uint64_t>(0);
+        for(size_t i = 0; i <= mask_; ++i){
+            new (&cells_[i].sequence) std::atomic<uint64_t>(i);
+            cells_[i].value = 0;
+        }
+    }
+
+    bool push(uint64_t value){
+        uint64_t pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+        RingCell* cell;
+        for(;;){
+            cell = &cells_[pos & mask_];
+            uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if(diff == 0){
+                if(header_->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0){
+                return false; // 队列满
+            }
+            else{
+                pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(uint64_t& value){
+        uint64_t pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+        RingCell* cell;
+        for(;;){
+            cell = &cells_[pos & mask_];
+            uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+            if(diff == 0){
+                if(header_->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if(diff < 0){
+                return false; // 队列空
+            }
+            else{
+                pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    RingHeader* header_ = nullptr;
+    RingCell* cells_ = nullptr;
+    size_t mask_ = 0;
+};
+
+// 段的状态（ftruncate 之后全是 0，即 INITIALIZING）
+constexpr uint32_t kSegmentInitializing = 0;
+constexpr uint32_t kSegmentReady = 1;
+constexpr uint32_t kSegmentClosed = 2; // 所有者已经 close，段名已经删除
+
+// ============================================================
+// 段头：段的布局参数 + 所有者 + 通知用的 futex 字
+// 布局：[SegmentHeader][空闲槽位环][投递环][槽位 0][槽位 1]...
+// ============================================================
+struct alignas(kCacheLine) SegmentHeader{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t slot_count;
+    uint64_t slot_size;
+    uint32_t owner_pid;   // 创建者的进程号，用来判断段是否是异常退出留下的
+    uint64_t generation;  // 每次创建都不同：同一个端口重新创建的段和旧段区分开
+    std::atomic<uint32_t> state;
+    alignas(kCacheLine) std::atomic<uint32_t> notify_seq; // 每次投递加一，接收方在它上面 futex 等待
+    std::atomic<uint32_t> waiters;                        // 正在等待的接收方数量
+};
+
+size_t segment_bytes(size_t slot_count, size_t slot_size){
+    return sizeof(SegmentHeader) + 2 * SharedRing::bytes(slot_count) + slot_count * slot_size;
+}
+
+// 进程是否还在（同一个 pid 命名空间内）；EPERM 说明进程存在但属于其他用户
+bool process_alive(uint32_t pid){
+    if(pid == 0) return false;
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
+uint64_t new_generation(){
+    uint64_t now = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return (static_cast<uint64_t>(::getpid()) << 32) ^ now;
+}
+
+// 只映射段头，读出所有者和代数（不改动段）。段不存在或者太小时返回 false
+bool read_segment_owner(const std::string& name, uint32_t& state, uint32_t& owner_pid, uint64_t& generation){
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if(fd < 0) return false;
+    struct stat info;
+    if(::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader)){
+        ::close(fd);
+        return false;
+    }
+    void* base = ::mmap(nullptr, sizeof(SegmentHeader), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(base == MAP_FAILED) return false;
+    const SegmentHeader* header = static_cast<const SegmentHeader*>(base);
+    state = header->state.load(std::memory_order_acquire);
+    owner_pid = header->owner_pid;
+    generation = header->generation;
+    ::munmap(base, sizeof(SegmentHeader));
+    return true;
+}
+
+// 描述符：低 32 位槽位号，高 32 位数据长度
+uint64_t make_descriptor(uint32_t slot, uint32_t size){
+    return (static_cast<uint64_t>(size) << 32) | slot;
+}
+
+} // namespace
+
+// ============================================================
+// ShmSegment: 一个映射好的共享内存段
+// ============================================================
+class ShmSegment{
+public:
+    ~ShmSegment(){
+        if(owner_){
+            // 先删除段名再标记关闭：看到 CLOSED 的进程可以马上用同一个名字创建新段，不会被这里误删
+            ::shm_unlink(name_.c_str());
+            header()->state.store(kSegmentClosed, std::memory_order_release);
+        }
+        if(base_ != nullptr){
+            ::munmap(base_, bytes_);
+        }
+    }
+
+    // 创建新段（接收方）
+    // 同名段的所有者还活着时失败（例如两个参与者配置了同一个端口），
+    // 只有所有者已经退出或者已经关闭的段（上次异常退出留下的）才删掉重建
+    static std::unique_ptr<ShmSegment> create(const std::string& name, size_t slot_count, size_t slot_size){
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if(fd < 0 && errno == EEXIST){
+            uint32_t state = kSegmentInitializing;
+            uint32_t owner_pid = 0;
+            uint64_t generation = 0;
+            if(read_segment_owner(name, state, owner_pid, generation) &&
+               state != kSegmentClosed && process_alive(owner_pid)){
+                return nullptr;
+            }
+            ::shm_unlink(name.c_str());
+            fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+        if(fd < 0) return nullptr;
+        size_t bytes = segment_bytes(slot_count, slot_size);
+        if(::ftruncate(fd, static_cast<off_t>(bytes)) != 0){
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(base == MAP_FAILED){
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+
+        std::unique_ptr<ShmSegment> segment(new ShmSegment(name, base, bytes, true));
+        SegmentHeader* header = segment->header();
+        header->owner_pid = static_cast<uint32_t>(::getpid()); // 尽早写入，初始化期间也不会被当成遗留的段
+        new (&header->state) std::atomic<uint32_t>(kSegmentInitializing);
+        header->generation = new_generation();
+        header->magic = kShmMagic;
+        header->version = kShmVersion;
+        header->slot_count = slot_count;
+        header->slot_size = slot_size;
+        new (&header->notify_seq) std::atomic<uint32_t>(0);
+        new (&header->waiters) std::atomic<uint32_t>(0);
+        segment->attach_layout();
+        segment->free_ring_.initialize();
+        segment->delivery_ring_.initialize();
+        for(uint32_t slot = 0; slot < slot_count; ++slot){
+            segment->free_ring_.push(slot);
+        }
+        segment->generation_ = header->generation;
+        header->state.store(kSegmentReady, std::memory_order_release); // 初始化完成后才对其它进程可见
+        return segment;
+    }
+
+    // 打开已有的段（发送方）
+    static std::unique_ptr<ShmSegment> open(const std::string& name){
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if(fd < 0) return nullptr;
+        struct stat info;
+        if(::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader)){
+            ::close(fd);
+            return nullptr;
+        }
+        size_t bytes = static_cast<size_t>(info.st_size);
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(base == MAP_FAILED) return nullptr;
+
+        std::unique_ptr<ShmSegment> segment(new ShmSegment(name, base, bytes, false));
+        SegmentHeader* header = segment->header();
+        // 先确认创建者已经初始化完成并且还活着，再读取布局参数
+        if(header->state.load(std::memory_order_acquire) != kSegmentReady ||
+           header->magic != kShmMagic || header->version != kShmVersion ||
+           !process_alive(header->owner_pid) ||
+           segment_bytes(header->slot_count, header->slot_size) > bytes){
+            return nullptr;
+        }
+        segment->generation_ = header->generation;
+        segment->attach_layout();
+        return segment;
+    }
+
+    // 所有者已经 close（每次使用缓存的对端段时检查，只是一次原子读）
+    bool closed() const {
+        return header()->state.load(std::memory_order_acquire) != kSegmentReady;
+    }
+
+    // 段仍然有效：所有者还活着，并且段名指向的还是这个段（没有被重新创建）
+    // 需要几次系统调用，按 peer_check_interval_ms 定期检查
+    bool current() const {
+        if(closed() || !process_alive(header()->owner_pid)) return false;
+        uint32_t state = kSegmentInitializing;
+        uint32_t owner_pid = 0;
+        uint64_t generation = 0;
+        return read_segment_owner(name_, state, owner_pid, generation) &&
+               state == kSegmentReady && generation == generation_;
+    }
+
+    SegmentHeader* header() const { return static_cast<SegmentHeader*>(base_); }
+    size_t slot_count() const { return slot_count_; }
+    size_t slot_size() const { return slot_size_; }
+
+    uint8_t* slot(uint32_t index) const { return slots_ + static_cast<size_t>(index) * slot_size_; }
+
+    bool acquire_slot(uint32_t& index){
+        uint64_t value;
+        if(!free_ring_.pop(value)) return false;
+        if(value >= slot_count_) return false; // 环里的数据来自其它进程，越界的槽位号不能用
+        index = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    void release_slot(uint32_t index){
+        free_ring_.push(index);
+    }
+
+    // 投递描述符，有接收方在等待时才唤醒
+    bool deliver(uint32_t slot, uint32_t size){
+        if(!delivery_ring_.push(make_descriptor(slot, size))) return false;
+        SegmentHeader* h = header();
+        h->notify_seq.fetch_add(1, std::memory_order_seq_cst);
+        if(h->waiters.load(std::memory_order_seq_cst) != 0){
+            futex_wake_all(&h->notify_seq);
+        }
+        return true;
+    }
+
+    bool take(uint32_t& slot, uint32_t& size){
+        uint64_t value;
+        if(!delivery_ring_.pop(value)) return false;
+        slot = static_cast<uint32_t>(value & 0xFFFFFFFF);
+        size = static_cast<uint32_t>(value >> 32);
+        return true;
+    }
+
+    uint32_t notify_sequence() const {
+        return header()->notify_seq.load(std::memory_order_seq_cst);
+    }
+
+    // 休眠直到 notify_seq 不再等于 seen（有新的投递）或超时
+    // seen 必须在检查投递环之前读取：发送方先增加 notify_seq 再检查 waiters，
+    // 接收方先登记 waiters 再由 futex 比较 notify_seq，两边都是 seq_cst，不会丢失唤醒
+    void wait(uint32_t seen, int timeout_ms){
+        SegmentHeader* h = header();
+        h->waiters.fetch_add(1, std::memory_order_seq_cst);
+        futex_wait(&h->notify_seq, seen, timeout_ms);
+        h->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+private:
+    std::string name_;
+    void* base_ = nullptr;
+    size_t bytes_ = 0;
+    bool owner_ = false;
+    uint64_t generation_ = 0;
+    size_t slot_count_ = 0;
+    size_t slot_size_ = 0;
+    SharedRing free_ring_;
+    SharedRing delivery_ring_;
+    uint8_t* slots_ = nullptr;
+
+    ShmSegment(const std::string& name, void* base, size_t bytes, bool owner)
+        : name_(name), base_(base), bytes_(bytes), owner_(owner) {}
+
+    void attach_layout(){
+        slot_count_ = header()->slot_count;
+        slot_size_ = header()->slot_size;
+        uint8_t* cursor = static_cast<uint8_t*>(base_) + sizeof(SegmentHeader);
+        free_ring_ = SharedRing(cursor, slot_count_);
+        cursor += SharedRing::bytes(slot_count_);
+        delivery_ring_ = SharedRing(cursor, slot_count_);
+        cursor += SharedRing::bytes(slot_count_);
+        slots_ = cursor;
+    }
+};
+
+// ============================================================
+// ShmLoan
+// ============================================================
+
+ShmLoan::~ShmLoan(){
+    release();
+}
+
+ShmLoan::ShmLoan(ShmLoan&& other) noexcept
+    : segment_(std::move(other.segment_)), slot_(other.slot_), buffer_(other.buffer_){
+    other.buffer_ = ByteSpan();
+}
+
+ShmLoan& ShmLoan::operator=(ShmLoan&& other) noexcept{
+    if(this != &other){
+        release();
+        segment_ = std::move(other.segment_);
+        slot_ = other.slot_;
+        buffer_ = other.buffer_;
+        other.buffer_ = ByteSpan();
+    }
+    return *this;
+}
+
+void ShmLoan::release(){
+    if(segment_ != nullptr){
+        segment_->release_slot(slot_);
+        segment_.reset();
+        buffer_ = ByteSpan();
+    }
+}
+
+// ============================================================
+// ShmTransport
+// ============================================================
+
+ShmTransport::ShmTransport(const ShmTransportConfig& config) : config_(config){
+    config_.slot_count = round_up_pow2(config_.slot_count < 2 ? 2 : config_.slot_count);
+    config_.slot_size = align_up(config_.slot_size == 0 ? 1 : config_.slot_size, kCacheLine);
+}
+
+ShmTransport::~ShmTransport(){
+    close();
+}
+
+std::string ShmTransport::segment_name(uint32_t port) const{
+    return "/" + config_.segment_prefix + "_" + std::to_string(port);
+}
+
+bool ShmTransport::open(){
+    if(is_open()) return true;
+    own_segment_ = ShmSegment::create(segment_name(config_.port), config_.slot_count, config_.slot_size);
+    if(own_segment_ == nullptr) return false;
+    received_slots_.reserve(config_.slot_count);
+    received_.reserve(config_.slot_count);
+    return true;
+}
+
+void ShmTransport::close(){
+    if(own_segment_ != nullptr){
+        release_received();
+    }
+    peers_.clear();
+    own_segment_.reset();
+}
+
+Locator ShmTransport::local_locator() const{
+    return make_shm_locator(config_.port);
+}
+
+std::shared_ptr<ShmSegment> ShmTransport::peer_segment(const Locator& destination){
+    if(!is_local_locator(destination)) return nullptr;
+    auto now = std::chrono::steady_clock::now();
+    auto it = peers_.find(destination.port);
+    if(it != peers_.end()){
+        PeerEntry& entry = it->second;
+        if(entry.segment == nullptr){
+            if(now < entry.next_check) return nullptr; // 重试间隔内不再尝试打开
+        }
+        else if(!entry.segment->closed()){
+            if(now < entry.next_check) return entry.segment;
+            if(entry.segment->current()){
+                entry.next_check = now + std::chrono::milliseconds(config_.peer_check_interval_ms);
+                return entry.segment;
+            }
+        }
+        // 对端已经关闭、退出或者重新创建了段：淘汰缓存，重新打开
+        // （借出的 loan 仍然持有旧段，归还时不会访问已经解除的映射）
+    }
+    std::shared_ptr<ShmSegment> segment = ShmSegment::open(segment_name(destination.port));
+    PeerEntry& entry = peers_[destination.port];
+    entry.segment = segment;
+    entry.next_check = now + std::chrono::milliseconds(segment != nullptr ? config_.peer_check_interval_ms
+                                                                          : config_.peer_retry_interval_ms);
+    return segment;
+}
+
+bool ShmTransport::is_reachable(const Locator& destination){
+    return peer_segment(destination) != nullptr;
+}
+
+ShmLoan ShmTransport::loan(const Locator& destination){
+    std::shared_ptr<ShmSegment> segment = peer_segment(destination);
+    uint32_t slot;
+    if(segment == nullptr || !segment->acquire_slot(slot)) return ShmLoan();
+    ByteSpan buffer(segment->slot(slot), segment->slot_size());
+    return ShmLoan(std::move(segment), slot, buffer);
+}
+
+bool ShmTransport::commit(ShmLoan& loan, size_t size){
+    if(!loan.valid() || size > loan.buffer_.size()) return false;
+    // 空闲槽位数等于投递环容量，投递环不会满
+    if(!loan.segment_->deliver(loan.slot_, static_cast<uint32_t>(size))) return false;
+    loan.segment_.reset(); // 槽位的所有权已经交给接收方
+    loan.buffer_ = ByteSpan();
+    ++samples_sent_;
+    return true;
+}
+
+bool ShmTransport::send(ConstByteSpan data, const Locator& destination){
+    ShmLoan slot = loan(destination);
+    if(!slot.valid() || data.size() > slot.buffer().size()) return false;
+    std::memcpy(slot.buffer().data(), data.data(), data.size());
+    return commit(slot, data.size());
+}
+
+void ShmTransport::release_received(){
+    for(uint32_t slot : received_slots_){
+        own_segment_->release_slot(slot);
+    }
+    received_slots_.clear();
+    received_.clear();
+}
+
+size_t ShmTransport::receive(int timeout_ms, size_t max_batch){
+    if(!is_open()) return 0;
+    release_received();
+
+    ShmSegment* segment = own_segment_.get();
+    uint32_t spins = 0;
+    for(;;){
+        uint32_t seen = segment->notify_sequence();
+        uint32_t slot;
+        uint32_t size;
+        while(received_.size() < max_batch && segment->take(slot, size)){
+            // 描述符来自其它进程，槽位号和长度越界的直接丢弃（槽位号有效时归还槽位）
+            if(slot >= segment->slot_count() || size > segment->slot_size()){
+                if(slot < segment->slot_count()) segment->release_slot(slot);
+                ++samples_dropped_;
+                continue;
+            }
+            received_slots_.push_back(slot);
+            received_.push_back(ConstByteSpan(segment->slot(slot), size));
+        }
+        if(!received_.empty() || timeout_ms == 0) break;
+        // 先自旋一段时间（延迟最低），仍然没有数据再休眠
+        if(spins < config_.spin_before_wait){
+            ++spins;
+            continue;
+        }
+        segment->wait(seen, timeout_ms);
+        if(timeout_ms > 0) timeout_ms = 0; // 醒来后再取一次就返回（超时时间是近似的）
+    }
+    samples_received_ += received_.size();
+    return received_.size();
+}
+
+// ============================================================
+// 本机地址判断
+// ============================================================
+
+Locator make_shm_locator(uint32_t port){
+    Locator locator;
+    locator.kind = rtps::LocatorKind::LOCATOR_KIND_SHM;
+    locator.port = port;
+    return locator;
+}
+
+namespace {
+
+// 本机所有网卡的 IPv4 地址（网络字节序），进程内只查询一次
+const std::vector<uint32_t>& local_ipv4_addresses(){
+    static const std::vector<uint32_t> addresses = []{
+        std::vector<uint32_t> result;
+        ifaddrs* list = nullptr;
+        if(::getifaddrs(&list) == 0){
+            for(ifaddrs* it = list; it != nullptr; it = it->ifa_next){
+                if(it->ifa_addr != nullptr && it->ifa_addr->sa_family == AF_INET){
+                    result.push_back(reinterpret_cast<sockaddr_in*>(it->ifa_addr)->sin_addr.s_addr);
+                }
+            }
+            ::freeifaddrs(list);
+        }
+        return result;
+    }();
+    return addresses;
+}
+
+} // namespace
+
+bool is_local_locator(const Locator& locator){
+    if(locator.kind == rtps::LocatorKind::LOCATOR_KIND_SHM) return true;
+    if(locator.kind != rtps::LocatorKind::LOCATOR_KIND_UDPv4) return false;
+    if(locator.address[12] == 127) return true; // 127.0.0.0/8 回环
+    uint32_t address;
+    std::memcpy(&address, &locator.address[12], 4);
+    for(uint32_t local : local_ipv4_addresses()){
+        if(local == address) return true;
+    }
+    return false;
+}
+
+} // namespace transport
+} // namespace tinydds
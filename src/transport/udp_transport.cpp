@@ -0,0 +1,261 @@
+#include "tinydds/transport/udp_transport.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace tinydds {
+namespace transport {
+
+namespace {
+
+// 一次 sendmmsg 最多携带的数据报数量（在栈上准备头部数组）
+constexpr size_t kSendBatch = 64;
+
+// 按 kSendBatch 个一批调用 sendmmsg，prepare(index, iovecs, address, part_count) 填好第 index 个数据报的
+// iovec（最多 UDP_MAX_GATHER_PARTS 个）和目的地址，数据报发不出去时返回 false。
+// 单个数据报失败（准备失败，或者 sendmmsg 报错，例如 EMSGSIZE、目的不可达）只跳过它本身并计入 errors，
+// 同一批里后面的数据报照常发送
+template<typename Prepare>
+size_t send_in_batches(int fd, size_t count, uint64_t& syscalls, uint64_t& datagrams, uint64_t& errors,
+                       Prepare&& prepare){
+    mmsghdr headers[kSendBatch];
+    iovec iovecs[kSendBatch * UDP_MAX_GATHER_PARTS];
+    sockaddr_in addresses[kSendBatch];
+
+    size_t sent = 0;
+    size_t next = 0; // 下一个要准备的数据报
+    while(next < count){
+        size_t chunk = 0;
+        while(chunk < kSendBatch && next < count){
+            iovec* parts = &iovecs[chunk * UDP_MAX_GATHER_PARTS];
+            std::memset(&headers[chunk], 0, sizeof(headers[chunk]));
+            size_t part_count = 0;
+            if(!prepare(next++, parts, addresses[chunk], part_count)){
+                ++errors;
+                continue;
+            }
+            headers[chunk].msg_hdr.msg_iovlen = part_count;
+            headers[chunk].msg_hdr.msg_name = &addresses[chunk];
+            headers[chunk].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            headers[chunk].msg_hdr.msg_iov = parts;
+            ++chunk;
+        }
+
+        size_t done = 0;
+        while(done < chunk){
+            int result = ::sendmmsg(fd, headers + done, static_cast<unsigned int>(chunk - done), 0);
+            ++syscalls;
+            if(result < 0 && errno == EINTR) continue;
+            if(result <= 0){
+                // 出错的是这一批里第一个没发出去的数据报：跳过它
+                ++errors;
+                ++done;
+                continue;
+            }
+            // 部分发送时从第一个没发出去的数据报继续（下一次调用会报告它的错误）
+            done += static_cast<size_t>(result);
+            sent += static_cast<size_t>(result);
+            datagrams += static_cast<uint64_t>(result);
+        }
+    }
+    return sent;
+}
+
+} // namespace
+
+// ============================================================
+// 地址转换
+// ============================================================
+
+sockaddr_in to_sockaddr(const Locator& locator){
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(locator.port));
+    std::memcpy(&address.sin_addr.s_addr, &locator.address[12], 4);
+    return address;
+}
+
+Locator from_sockaddr(const sockaddr_in& address){
+    Locator locator;
+    locator.kind = rtps::LocatorKind::LOCATOR_KIND_UDPv4;
+    locator.port = ntohs(address.sin_port);
+    std::memcpy(&locator.address[12], &address.sin_addr.s_addr, 4);
+    return locator;
+}
+
+// ============================================================
+// UdpTransport
+// ============================================================
+
+UdpTransport::UdpTransport(const UdpTransportConfig& config) : config_(config){
+    if(config_.receive_batch == 0){
+        config_.receive_batch = 1;
+    }
+}
+
+UdpTransport::~UdpTransport(){
+    close();
+}
+
+bool UdpTransport::open(){
+    if(is_open()) return true;
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if(fd_ < 0) return false;
+
+    // 同一台机器上多个参与者需要绑定同一个多播端口
+    int enable = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if(config_.socket_receive_buffer > 0){
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &config_.socket_receive_buffer, sizeof(int));
+    }
+    if(config_.socket_send_buffer > 0){
+        ::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &config_.socket_send_buffer, sizeof(int));
+    }
+
+    unsigned char ttl = static_cast<unsigned char>(config_.multicast_ttl);
+    ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    unsigned char loop = config_.multicast_loopback ? 1 : 0;
+    ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(config_.port));
+    if(inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1 ||
+       ::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0){
+        close();
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    bound_port_ = ntohs(address.sin_port);
+
+    // 预分配接收缓冲区和 recvmmsg 需要的头部
+    size_t batch = config_.receive_batch;
+    receive_storage_.assign(batch * config_.max_datagram_size, 0);
+    receive_headers_.assign(batch, mmsghdr());
+    receive_iovecs_.assign(batch, iovec());
+    receive_addresses_.assign(batch, sockaddr_in());
+    received_.assign(batch, ReceivedDatagram());
+    for(size_t i = 0; i < batch; ++i){
+        receive_iovecs_[i].iov_base = receive_storage_.data() + i * config_.max_datagram_size;
+        receive_iovecs_[i].iov_len = config_.max_datagram_size;
+        msghdr& header = receive_headers_[i].msg_hdr;
+        std::memset(&header, 0, sizeof(header));
+        header.msg_iov = &receive_iovecs_[i];
+        header.msg_iovlen = 1;
+        header.msg_name = &receive_addresses_[i];
+    }
+    return true;
+}
+
+void UdpTransport::close(){
+    if(fd_ >= 0){
+        ::close(fd_);
+        fd_ = -1;
+    }
+    bound_port_ = 0;
+}
+
+bool UdpTransport::set_multicast_membership(const Locator& group, int option){
+    if(!is_open() || !group.is_multicast()) return false;
+    ip_mreq request;
+    std::memcpy(&request.imr_multiaddr.s_addr, &group.address[12], 4);
+    request.imr_interface.s_addr = htonl(INADDR_ANY);
+    return ::setsockopt(fd_, IPPROTO_IP, option, &request, sizeof(request)) == 0;
+}
+
+bool UdpTransport::join_multicast(const Locator& group){
+    return set_multicast_membership(group, IP_ADD_MEMBERSHIP);
+}
+
+bool UdpTransport::leave_multicast(const Locator& group){
+    return set_multicast_membership(group, IP_DROP_MEMBERSHIP);
+}
+
+Locator UdpTransport::local_locator() const{
+    std::string address = config_.bind_address == "0.0.0.0" ? "127.0.0.1" : config_.bind_address;
+    return Locator(address, bound_port_);
+}
+
+bool UdpTransport::send(ConstByteSpan data, const Locator& destination){
+    UdpDatagram datagram{data, destination};
+    return send_batch(&datagram, 1) == 1;
+}
+
+size_t UdpTransport::send_batch(const UdpDatagram* datagrams, size_t count){
+    if(!is_open()) return 0;
+    return send_in_batches(fd_, count, send_syscalls_, datagrams_sent_, send_errors_,
+                           [&](size_t index, iovec* parts, sockaddr_in& address, size_t& part_count){
+        const UdpDatagram& datagram = datagrams[index];
+        address = to_sockaddr(datagram.destination);
+        parts[0].iov_base = const_cast<uint8_t*>(datagram.data.data());
+        parts[0].iov_len = datagram.data.size();
+        part_count = 1;
+        return true;
+    });
+}
+
+size_t UdpTransport::send_batch(const UdpGatherDatagram* datagrams, size_t count){
+    if(!is_open()) return 0;
+    return send_in_batches(fd_, count, send_syscalls_, datagrams_sent_, send_errors_,
+                           [&](size_t index, iovec* parts, sockaddr_in& address, size_t& part_count){
+        const UdpGatherDatagram& datagram = datagrams[index];
+        // 分段过多的数据报发不出去，跳过
+        if(datagram.part_count > UDP_MAX_GATHER_PARTS) return false;
+        address = to_sockaddr(datagram.destination);
+        for(size_t i = 0; i < datagram.part_count; ++i){
+            parts[i].iov_base = const_cast<uint8_t*>(datagram.parts[i].data());
+            parts[i].iov_len = datagram.parts[i].size();
+        }
+        part_count = datagram.part_count;
+        return true;
+    });
+}
+
+size_t UdpTransport::receive(int timeout_ms){
+    if(!is_open()) return 0;
+
+    if(timeout_ms != 0){
+        pollfd descriptor{fd_, POLLIN, 0};
+        int ready = ::poll(&descriptor, 1, timeout_ms);
+        if(ready <= 0) return 0;
+    }
+
+    // 每次都要重置地址长度（内核会改写）
+    for(size_t i = 0; i < receive_headers_.size(); ++i){
+        receive_headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int result = ::recvmmsg(fd_, receive_headers_.data(), static_cast<unsigned int>(receive_headers_.size()),
+                            MSG_DONTWAIT, nullptr);
+    ++receive_syscalls_;
+    if(result <= 0) return 0;
+
+    // 超过 max_datagram_size 的数据报被内核截断（msg_flags 带 MSG_TRUNC），内容不完整，丢弃
+    size_t count = 0;
+    for(size_t i = 0; i < static_cast<size_t>(result); ++i){
+        if(receive_headers_[i].msg_hdr.msg_flags & MSG_TRUNC){
+            ++datagrams_truncated_;
+            continue;
+        }
+        received_[count].data = ConstByteSpan(static_cast<const uint8_t*>(receive_iovecs_[i].iov_base),
+                                              receive_headers_[i].msg_len);
+        received_[count].source = from_sockaddr(receive_addresses_[i]);
+        ++count;
+    }
+    datagrams_received_ += count;
+    return count;
+}
+
+} // namespace transport
+} // namespace tinydds
@@ -0,0 +1,86 @@
+#include "tinydds/rtps/buffer_pool.hpp"
+#include "tinydds/rtps/cdr.hpp"
+#include "test_check.hpp"
+#include <iostream>
+
+using namespace tinydds::rtps;
+
+int main() {
+    std::cout << "=== BufferPool / 零拷贝序列化 测试 ===" << std::endl;
+
+    // 测试1: 缓冲区归还后被复用
+    BufferPool pool(256, 2);
+    CHECK(pool.cached() == 2);
+    const uint8_t* first_data = nullptr;
+    {
+        PooledBuffer buf = pool.acquire();
+        CHECK(buf.capacity() == 256);
+        CHECK(pool.cached() == 1);
+        first_data = buf.data();
+    }
+    CHECK(pool.cached() == 2);
+    {
+        PooledBuffer buf = pool.acquire();
+        std::cout << "归还后复用同一块内存: " << (buf.data() == first_data ? "是 ✅" : "否 ❌") << std::endl;
+        CHECK(buf.data() == first_data);
+    }
+
+    // 测试2: 池化模式序列化，并把缓冲区移动给“传输层”
+    PooledBuffer sent;
+    {
+        CdrSerializer serializer(pool);
+        serializer.serialize_uint32(0xAABBCCDD);
+        serializer.serialize_string("Hello DDS!");
+        sent = serializer.release_buffer();
+    }
+    CHECK(sent.pool() == &pool);
+    CHECK(sent.size() == 4 + 4 + 11);
+    CdrDeserializer deserializer(sent.span());
+    uint32_t out_u32 = 0;
+    std::string out_str;
+    CHECK(deserializer.deserialize_uint32(out_u32) && out_u32 == 0xAABBCCDD);
+    CHECK(deserializer.deserialize_string(out_str) && out_str == "Hello DDS!");
+    std::cout << "池化序列化: " << out_str << " ✅" << std::endl;
+
+    size_t cached_before = pool.cached();
+    sent.reset(); // 传输层发送完成
+    CHECK(pool.cached() == cached_before + 1);
+
+    // 测试3: 写入外部缓冲区，不扩容，写满后 good() 为 false
+    uint8_t external[8] = {0};
+    CdrSerializer span_serializer{ByteSpan(external, sizeof(external))};
+    span_serializer.serialize_uint32(0x11223344);
+    CHECK(span_serializer.good());
+    CHECK(span_serializer.data() == external);
+    CHECK(span_serializer.size() == 4);
+    span_serializer.serialize_uint64(1); // 需要 8 字节对齐 + 8 字节，超出
+    CHECK(!span_serializer.good());
+    size_t size_after_overflow = span_serializer.size();
+    span_serializer.serialize_byte(1);   // 溢出之后的写入全部丢弃
+    CHECK(span_serializer.size() == size_after_overflow);
+    // reset() 之后整块外部内存又可以用了
+    span_serializer.reset();
+    CHECK(span_serializer.good() && span_serializer.capacity() == sizeof(external));
+    span_serializer.serialize_uint64(0x0102030405060708ull);
+    CHECK(span_serializer.good() && span_serializer.size() == sizeof(external));
+    CHECK(span_serializer.data() == external);
+    std::cout << "外部缓冲区溢出检测 ✅" << std::endl;
+
+    // 测试4: 自有缓冲区自动扩容
+    CdrSerializer small(4);
+    for(uint32_t i = 0; i < 100; ++i){
+        small.serialize_uint32(i);
+    }
+    CHECK(small.size() == 400);
+    CdrDeserializer growing(small.buffer());
+    for(uint32_t i = 0; i < 100; ++i){
+        uint32_t v = 0;
+        CHECK(growing.deserialize_uint32(v) && v == i);
+    }
+    std::vector<uint8_t> owned = small.release_buffer().release();
+    CHECK(owned.size() == 400);
+    std::cout << "自动扩容 + 移动交出所有权 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
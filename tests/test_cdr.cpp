@@ -1,6 +1,7 @@
 #include "tinydds/rtps/cdr.hpp"
+#include "tinydds/rtps/byte_swap.hpp"
+#include "test_check.hpp"
 #include <iostream>
-#include <cassert>
 
 using namespace tinydds::rtps;
 
@@ -33,9 +34,9 @@ int main() {
     // 3. 反序列化
     CdrDeserializer deserializer(buf);
     
-    uint8_t  out_byte;
-    uint16_t out_u16;
-    uint32_t out_u32;
+    uint8_t  out_byte = 0;
+    uint16_t out_u16 = 0;
+    uint32_t out_u32 = 0;
     std::string out_str;
 
     bool ok = true;
@@ -55,6 +56,164 @@ int main() {
     std::cout << "U16:  " << std::hex << out_u16 << (out_u16 == v_u16 ? " ✅" : " ❌") << std::endl;
     std::cout << "U32:  " << std::hex << out_u32 << (out_u32 == v_u32 ? " ✅" : " ❌") << std::endl;
     std::cout << "Str:  " << out_str << (out_str == v_str ? " ✅" : " ❌") << std::endl;
+    std::cout << std::dec;
+
+    // 5. 批量序列：浮点和 uint16 数组整块复制
+    std::vector<float> v_points(1000);
+    for (size_t i = 0; i < v_points.size(); ++i) v_points[i] = static_cast<float>(i) * 0.5f;
+    std::vector<uint16_t> v_pixels(333);
+    for (size_t i = 0; i < v_pixels.size(); ++i) v_pixels[i] = static_cast<uint16_t>(i * 7);
+
+    CdrSerializer seq_serializer;
+    seq_serializer.serialize_byte(1); // 让后面的序列需要对齐
+    seq_serializer.serialize_sequence(v_points);
+    seq_serializer.serialize_sequence(v_pixels);
+    CHECK(seq_serializer.size() == 4 + 4 + 1000 * 4 + 4 + 333 * 2);
+
+    CdrDeserializer seq_deserializer(seq_serializer.buffer());
+    std::vector<float> out_points;
+    std::vector<uint16_t> out_pixels;
+    uint8_t marker;
+    CHECK(seq_deserializer.deserialize_byte(marker));
+    CHECK(seq_deserializer.deserialize_sequence(out_points) && out_points == v_points);
+    CHECK(seq_deserializer.deserialize_sequence(out_pixels) && out_pixels == v_pixels);
+    // 数据已读完，再读应该越界失败
+    CHECK(!seq_deserializer.deserialize_sequence(out_pixels));
+    std::cout << "批量序列 (float x1000, uint16 x333) ✅" << std::endl;
+
+    // 6. 批量字节序翻转：覆盖 SIMD 主循环和标量尾部
+    for (size_t count : {1u, 3u, 7u, 8u, 17u, 100u, 1001u}) {
+        std::vector<uint32_t> src(count), dst(count);
+        for (size_t i = 0; i < count; ++i) src[i] = static_cast<uint32_t>(0x01020304u + i);
+        byte_swap_copy(reinterpret_cast<uint8_t*>(dst.data()),
+                       reinterpret_cast<const uint8_t*>(src.data()), count, 4);
+        for (size_t i = 0; i < count; ++i) CHECK(dst[i] == __builtin_bswap32(src[i]));
+
+        std::vector<uint64_t> src64(count), dst64(count);
+        for (size_t i = 0; i < count; ++i) src64[i] = 0x0102030405060708ull + i;
+        byte_swap_copy(reinterpret_cast<uint8_t*>(dst64.data()),
+                       reinterpret_cast<const uint8_t*>(src64.data()), count, 8);
+        for (size_t i = 0; i < count; ++i) CHECK(dst64[i] == __builtin_bswap64(src64[i]));
+
+        std::vector<uint16_t> src16(count), dst16(count);
+        for (size_t i = 0; i < count; ++i) src16[i] = static_cast<uint16_t>(0x0102 + i);
+        byte_swap_copy(reinterpret_cast<uint8_t*>(dst16.data()),
+                       reinterpret_cast<const uint8_t*>(src16.data()), count, 2);
+        for (size_t i = 0; i < count; ++i) CHECK(dst16[i] == __builtin_bswap16(src16[i]));
+    }
+    std::cout << "批量字节序翻转 ✅" << std::endl;
+
+    // 7. 封装头 + 字节序：大端写入，按封装头解析
+    CdrSerializerBE be_serializer;
+    be_serializer.serialize_encapsulation();
+    be_serializer.serialize_byte(0x7F);
+    be_serializer.serialize_uint32(0x01020304);
+    be_serializer.serialize_double(3.5);          // 相对封装头之后对齐到 8
+    be_serializer.serialize_sequence(v_pixels);
+    ConstByteSpan be_buf = be_serializer.buffer();
+    CHECK(be_buf[0] == 0x00 && be_buf[1] == 0x00); // CDR_BE
+    CHECK(be_buf[8] == 0x01 && be_buf[11] == 0x04);
+    CHECK(be_buf.size() == 4 + 8 + 8 + 4 + 333 * 2);
+
+    bool decoded = decode_cdr_payload(be_buf, [&](auto& d) {
+        CHECK(d.endian() == CdrEndian::BIG_ENDIAN_ORDER);
+        uint8_t b;
+        uint32_t u;
+        double dv;
+        std::vector<uint16_t> pixels;
+        return d.deserialize_byte(b) && b == 0x7F &&
+               d.deserialize_uint32(u) && u == 0x01020304 &&
+               d.deserialize_double(dv) && dv == 3.5 &&
+               d.deserialize_sequence(pixels) && pixels == v_pixels;
+    });
+    CHECK(decoded);
+
+    CdrSerializerLE le_serializer;
+    le_serializer.serialize_encapsulation(true);
+    le_serializer.serialize_int64(-42);
+    CHECK(le_serializer.buffer()[1] == 0x03); // PL_CDR_LE
+    decoded = decode_cdr_payload(le_serializer.buffer(), [&](auto& d) {
+        int64_t v;
+        return d.encapsulation().is_parameter_list() && d.deserialize_int64(v) && v == -42;
+    });
+    CHECK(decoded);
+
+    // 字节序与封装头不一致、或封装类型未知时拒绝
+    CdrDeserializerLE mismatched(be_buf);
+    CHECK(!mismatched.deserialize_encapsulation());
+    std::vector<uint8_t> bad_header = {0x00, 0x10, 0x00, 0x00};
+    CHECK(!decode_cdr_payload(bad_header, [](auto&) { return true; }));
+    std::cout << "封装头 + 大小端 ✅" << std::endl;
+
+    // 8. 零拷贝读取：视图直接指向输入缓冲区
+    CdrSerializer view_serializer;
+    view_serializer.serialize_string(v_str);
+    view_serializer.serialize_sequence(v_points);
+    ConstByteSpan view_buf = view_serializer.buffer();
+    CdrDeserializer view_deserializer(view_buf.data(), view_buf.size());
+    std::string_view str_view;
+    CdrSequenceView<float, NativeEndianPolicy> points_view;
+    CHECK(view_deserializer.deserialize_string_view(str_view) && str_view == v_str);
+    CHECK(str_view.data() == reinterpret_cast<const char*>(view_buf.data()) + 4);
+    CHECK(view_deserializer.deserialize_sequence_view(points_view));
+    CHECK(points_view.size() == v_points.size() && points_view[999] == v_points[999]);
+    CHECK(points_view.bytes().data() >= view_buf.begin() && points_view.bytes().end() == view_buf.end());
+    CHECK(view_deserializer.remaining() == 0);
+
+    // 大端数据的序列视图：按下标读取和整块复制都会翻转字节序
+    decoded = decode_cdr_payload(be_buf, [&](auto& d) {
+        using View = CdrSequenceView<uint16_t, BigEndianPolicy>;
+        uint8_t b;
+        uint32_t u;
+        double dv;
+        View pixels_view;
+        if (!(d.deserialize_byte(b) && d.deserialize_uint32(u) && d.deserialize_double(dv))) return false;
+        if constexpr (std::is_same<std::decay_t<decltype(d)>, CdrDeserializerBE>::value) {
+            if (!d.deserialize_sequence_view(pixels_view)) return false;
+            std::vector<uint16_t> copied(pixels_view.size());
+            pixels_view.copy_to(copied.data());
+            return pixels_view[100] == v_pixels[100] && copied == v_pixels;
+        }
+        return false;
+    });
+    CHECK(decoded);
+    std::cout << "零拷贝视图 ✅" << std::endl;
+
+    // 9. 大小预计算：计算器与序列化器的结果完全一致，按结果一次分配后无检查写入
+    CdrSizeCalculator calc;
+    calc.serialize_encapsulation();
+    calc.serialize_byte(v_byte);
+    calc.serialize_double(2.0);
+    calc.serialize_string(v_str);
+    calc.serialize_uint16(v_u16);
+    calc.serialize_sequence(v_points);
+    calc.serialize_sequence(std::vector<uint64_t>());
+    calc.serialize_int64(-1);
+
+    CdrPresizedSerializerBE presized(calc.size());
+    presized.serialize_encapsulation();
+    presized.serialize_byte(v_byte);
+    presized.serialize_double(2.0);
+    presized.serialize_string(v_str);
+    presized.serialize_uint16(v_u16);
+    presized.serialize_sequence(v_points);
+    presized.serialize_sequence(std::vector<uint64_t>());
+    presized.serialize_int64(-1);
+    CHECK(presized.size() == calc.size());
+    CHECK(presized.capacity() == calc.size()); // 只分配了一次，没有多余空间
+
+    CdrSerializerBE checked(4);
+    checked.serialize_encapsulation();
+    checked.serialize_byte(v_byte);
+    checked.serialize_double(2.0);
+    checked.serialize_string(v_str);
+    checked.serialize_uint16(v_u16);
+    checked.serialize_sequence(v_points);
+    checked.serialize_sequence(std::vector<uint64_t>());
+    checked.serialize_int64(-1);
+    CHECK(checked.size() == presized.size());
+    CHECK(std::memcmp(checked.data(), presized.data(), checked.size()) == 0);
+    std::cout << "大小预计算: " << calc.size() << " 字节 ✅" << std::endl;
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "tinydds/rtps/cdr_type_support.hpp"
+#include "test_check.hpp"
+#include <iostream>
+
+using namespace tinydds::rtps;
+
+enum class Mode : uint32_t { IDLE = 0, RUNNING = 7 };
+
+struct Vec3{
+    double x;
+    double y;
+    double z;
+};
+
+// 定长类型：所有字段都是基本类型，可以整段复制
+struct Telemetry{
+    uint32_t id;
+    uint32_t flags;
+    int64_t stamp;
+    Vec3 position;
+    std::array<float, 4> quaternion;
+    uint8_t status;
+    uint16_t battery;   // 内存中与 status 之间有 1 字节填充，CDR 中也一样
+    Mode mode;
+};
+
+// 变长类型
+struct Frame{
+    std::string name;
+    bool valid;
+    std::vector<uint16_t> pixels;
+    std::vector<Vec3> points;
+    Telemetry telemetry;
+};
+
+TINYDDS_CDR_TYPE(Vec3, x, y, z);
+TINYDDS_CDR_TYPE(Telemetry, id, flags, stamp, position, quaternion, status, battery, mode);
+TINYDDS_CDR_TYPE(Frame, name, valid, pixels, points, telemetry);
+
+// 与逐个字段手写的编码结果对比
+template<typename Serializer>
+void encode_by_hand(Serializer& s, const Telemetry& t){
+    s.serialize_uint32(t.id);
+    s.serialize_uint32(t.flags);
+    s.serialize_int64(t.stamp);
+    s.serialize_double(t.position.x);
+    s.serialize_double(t.position.y);
+    s.serialize_double(t.position.z);
+    for (float q : t.quaternion) s.serialize_float(q);
+    s.serialize_byte(t.status);
+    s.serialize_uint16(t.battery);
+    s.serialize_uint32(static_cast<uint32_t>(t.mode));
+}
+
+bool same_telemetry(const Telemetry& a, const Telemetry& b){
+    return a.id == b.id && a.flags == b.flags && a.stamp == b.stamp &&
+           a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+           a.quaternion == b.quaternion && a.status == b.status && a.battery == b.battery && a.mode == b.mode;
+}
+
+int main() {
+    std::cout << "=== CDR 类型支持 测试 ===" << std::endl;
+
+    Telemetry t{42, 0x5A5A, -123456789, {1.5, -2.5, 3.25}, {0.f, 0.5f, 1.f, -1.f}, 9, 0xBEEF, Mode::RUNNING};
+
+    // 测试1: 编译期大小
+    static_assert(is_cdr_bounded<Telemetry>(), "Telemetry 应该是定长类型");
+    static_assert(!is_cdr_bounded<Frame>(), "Frame 包含变长字段");
+    static_assert(get_serialized_size<Vec3>() == 24, "");
+    static_assert(get_serialized_size<Telemetry>() == 4 + 4 + 8 + 24 + 16 + 1 + 1 + 2 + 4, "");
+    std::cout << "Telemetry 编译期大小: " << get_serialized_size<Telemetry>() << " ✅" << std::endl;
+
+    // 测试2: 不同起始偏移、不同字节序下与手写结果逐字节相同
+    for (size_t prefix = 0; prefix < 8; ++prefix) {
+        CdrSerializerBE generated;
+        CdrSerializerBE by_hand;
+        generated.serialize_encapsulation();
+        by_hand.serialize_encapsulation();
+        for (size_t i = 0; i < prefix; ++i) {
+            generated.serialize_byte(0xEE);
+            by_hand.serialize_byte(0xEE);
+        }
+        generated.serialize_type(t);
+        encode_by_hand(by_hand, t);
+        CHECK(generated.size() == by_hand.size());
+        CHECK(std::memcmp(generated.data(), by_hand.data(), generated.size()) == 0);
+        CHECK(get_serialized_size(t, prefix) == generated.size() - 4 - prefix);
+
+        bool decoded = decode_cdr_payload(generated.buffer(), [&](auto& d) {
+            uint8_t skip;
+            for (size_t i = 0; i < prefix; ++i) d.deserialize_byte(skip);
+            Telemetry out{};
+            return d.deserialize_type(out) && same_telemetry(out, t) && d.remaining() == 0;
+        });
+        CHECK(decoded);
+
+        CdrSerializer native_generated;
+        CdrSerializer native_by_hand;
+        for (size_t i = 0; i < prefix; ++i) {
+            native_generated.serialize_byte(0xEE);
+            native_by_hand.serialize_byte(0xEE);
+        }
+        native_generated.serialize_type(t);
+        encode_by_hand(native_by_hand, t);
+        CHECK(native_generated.size() == native_by_hand.size());
+        CHECK(std::memcmp(native_generated.data(), native_by_hand.data(), native_generated.size()) == 0);
+    }
+    std::cout << "定长结构体 (大端/本机, 偏移 0~7) ✅" << std::endl;
+
+    // 测试3: 变长结构体往返
+    Frame f;
+    f.name = "camera/front";
+    f.valid = true;
+    f.pixels = {1, 2, 3, 65535};
+    f.points = {{1, 2, 3}, {4, 5, 6}};
+    f.telemetry = t;
+
+    CdrSerializerLE frame_serializer;
+    frame_serializer.serialize_encapsulation();
+    frame_serializer.serialize_type(f);
+    CHECK(get_serialized_size(f) == frame_serializer.size() - ENCAPSULATION_HEADER_SIZE);
+
+    Frame out;
+    bool decoded = decode_cdr_payload(frame_serializer.buffer(), [&](auto& d) {
+        return d.deserialize_type(out);
+    });
+    CHECK(decoded);
+    CHECK(out.name == f.name && out.valid && out.pixels == f.pixels);
+    CHECK(out.points.size() == 2 && out.points[1].z == 6);
+    CHECK(same_telemetry(out.telemetry, t));
+    std::cout << "变长结构体往返 ✅" << std::endl;
+
+    // 测试4: 数据被截断时解码失败
+    ConstByteSpan truncated = frame_serializer.buffer().subspan(0, frame_serializer.size() - 3);
+    decoded = decode_cdr_payload(truncated, [&](auto& d) {
+        Frame partial;
+        return d.deserialize_type(partial);
+    });
+    CHECK(!decoded);
+    std::cout << "截断检测 ✅" << std::endl;
+
+    // 测试5: 先计算大小再一次分配（encode_cdr_payload / CdrSizeCalculator）
+    PooledBuffer payload = encode_cdr_payload<BigEndianPolicy>(f);
+    CHECK(payload.size() == payload.capacity());
+    CHECK(payload.size() == frame_serializer.size());
+    CdrSizeCalculator calc;
+    calc.serialize_encapsulation();
+    calc.serialize_byte(1);
+    calc.serialize_type(f);
+    CdrSerializerBE manual;
+    manual.serialize_encapsulation();
+    manual.serialize_byte(1);
+    manual.serialize_type(f);
+    CHECK(calc.size() == manual.size());
+
+    BufferPool pool(64);
+    PooledBuffer pooled = encode_cdr_payload<LittleEndianPolicy>(pool, f);
+    CHECK(pooled.pool() == &pool && pooled.size() == frame_serializer.size());
+    CHECK(std::memcmp(pooled.data(), frame_serializer.data(), pooled.size()) == 0);
+    decoded = decode_cdr_payload(payload.span(), [&](auto& d) {
+        Frame again;
+        return d.deserialize_type(again) && again.name == f.name && same_telemetry(again.telemetry, t);
+    });
+    CHECK(decoded);
+    std::cout << "预计算大小 + 一次分配 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+// ============================================================
+// 测试用的检查宏
+//
+// 和 assert 不同，CHECK 在 Release（NDEBUG）构建下也会执行：
+// 条件里的函数调用照常发生，失败时打印 ❌ 和位置并以非 0 退出，ctest 记为失败。
+// 可以在 lambda 和其他线程里使用
+// ============================================================
+#define CHECK(condition)                                                                        \
+    do{                                                                                         \
+        if(!(condition)){                                                                       \
+            std::cerr << "❌ " << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") 失败" \
+                      << std::endl;                                                             \
+            std::exit(1);                                                                       \
+        }                                                                                       \
+    }while(0)
@@ -0,0 +1,272 @@
+#include "tinydds/dds/content_filter.hpp"
+#include "tinydds/discovery/discovery_data.hpp"
+#include "tinydds/rtps/cdr_type_info.hpp"
+#include "test_check.hpp"
+#include <iostream>
+
+using namespace tinydds;
+using namespace tinydds::dds;
+using namespace tinydds::rtps;
+
+enum class Level : uint32_t { LOW = 0, HIGH = 2 };
+
+struct Position{
+    double x;
+    double y;
+};
+
+// 定长类型：所有字段都可以按固定偏移读
+struct Reading{
+    uint32_t id;
+    uint8_t flags;
+    int16_t delta;
+    Position position;
+    float temperature;
+    Level level;
+    bool valid;
+};
+
+// 变长类型：被引用的字段之前有字符串和序列，需要逐个跳过
+struct Report{
+    std::string station;
+    std::vector<uint32_t> history;
+    std::vector<Position> track;
+    Reading reading;
+    std::array<uint16_t, 3> codes;
+    std::string note;
+    uint64_t sequence;
+};
+
+TINYDDS_CDR_TYPE(Position, x, y);
+TINYDDS_CDR_TYPE(Reading, id, flags, delta, position, temperature, level, valid);
+TINYDDS_CDR_TYPE(Report, station, history, track, reading, codes, note, sequence);
+
+template<typename Serializer, typename T>
+std::vector<uint8_t> encode(const T& value){
+    Serializer serializer;
+    serializer.serialize_encapsulation();
+    serializer.serialize_type(value);
+    return std::vector<uint8_t>(serializer.data(), serializer.data() + serializer.size());
+}
+
+Reading make_reading(uint32_t id, float temperature){
+    Reading reading{};
+    reading.id = id;
+    reading.flags = 0x81;
+    reading.delta = -5;
+    reading.position = Position{1.5, -2.0};
+    reading.temperature = temperature;
+    reading.level = temperature > 30.0f ? Level::HIGH : Level::LOW;
+    reading.valid = true;
+    return reading;
+}
+
+Report make_report(const std::string& station, uint32_t id, float temperature){
+    Report report;
+    report.station = station;
+    report.history = {1, 2, 3, 4, 5};
+    report.track = {Position{0.0, 0.0}, Position{1.0, 1.0}};
+    report.reading = make_reading(id, temperature);
+    report.codes = {7, 8, 9};
+    report.note = "ok";
+    report.sequence = 42;
+    return report;
+}
+
+bool check(const char* expression, const std::vector<uint8_t>& payload,
+           const std::vector<std::string>& parameters = {}){
+    ContentFilter filter;
+    std::string error;
+    bool compiled = filter.compile<Report>(expression, parameters, &error);
+    if(!compiled) std::cout << "  编译失败: " << expression << " -> " << error << std::endl;
+    CHECK(compiled);
+    return filter.evaluate(ConstByteSpan(payload.data(), payload.size()));
+}
+
+int main() {
+    std::cout << "=== 内容过滤测试 ===" << std::endl;
+
+    // 测试1: 类型描述和在序列化数据上跳过字段
+    {
+        const CdrTypeDesc& desc = cdr_type_desc_v<Report>;
+        CHECK(desc.kind == CdrFieldKind::STRUCT && desc.member_count == 7);
+        CHECK(std::string(desc.members[0].name) == "station");
+        CHECK(desc.members[1].type->kind == CdrFieldKind::SEQUENCE);
+        CHECK(desc.members[1].type->element->kind == CdrFieldKind::UINT32);
+        CHECK(desc.members[4].type->kind == CdrFieldKind::ARRAY && desc.members[4].type->count == 3);
+        const CdrMemberDesc* reading = desc.find_member("reading");
+        CHECK(reading != nullptr && reading->type->kind == CdrFieldKind::STRUCT);
+        CHECK(reading->type->find_member("level")->type->kind == CdrFieldKind::ENUM);
+        CHECK(reading->type->find_member("valid")->type->kind == CdrFieldKind::BOOL);
+        CHECK(desc.find_member("missing") == nullptr);
+
+        std::vector<uint8_t> payload = encode<CdrSerializerBE>(make_report("north", 1, 20.0f));
+        CdrDeserializerBE des(payload);
+        CHECK(des.deserialize_encapsulation());
+        CHECK(cdr_skip(des, desc) && des.remaining() == 0);
+        // 截断的数据
+        CdrDeserializerBE truncated(payload.data(), payload.size() - 1);
+        CHECK(truncated.deserialize_encapsulation());
+        CHECK(!cdr_skip(truncated, desc));
+    }
+    std::cout << "类型描述 ✅" << std::endl;
+
+    // 测试2: 比较、逻辑运算、BETWEEN、LIKE，两种字节序
+    {
+        std::vector<uint8_t> le = encode<CdrSerializerLE>(make_report("north-7", 12, 35.5f));
+        std::vector<uint8_t> be = encode<CdrSerializerBE>(make_report("north-7", 12, 35.5f));
+        for(const std::vector<uint8_t>* payload : {&le, &be}){
+            CHECK(check("reading.id = 12", *payload));
+            CHECK(!check("reading.id <> 12", *payload));
+            CHECK(check("reading.id != 11 AND reading.temperature > 30", *payload));
+            CHECK(check("reading.temperature >= 35.5 and reading.temperature <= 35.5", *payload));
+            CHECK(check("reading.delta < 0 OR reading.id = 0", *payload));
+            CHECK(check("NOT (reading.delta >= 0)", *payload));
+            CHECK(check("reading.flags = 129", *payload));
+            CHECK(check("reading.position.y = -2.0", *payload));
+            CHECK(check("reading.level = 2", *payload));
+            CHECK(check("reading.valid = TRUE", *payload));
+            CHECK(check("reading.id BETWEEN 10 AND 20", *payload));
+            CHECK(check("reading.id NOT BETWEEN 1 AND 5", *payload));
+            CHECK(check("station = 'north-7'", *payload));
+            CHECK(check("station LIKE 'north%'", *payload));
+            CHECK(check("station LIKE 'n_rth-_'", *payload));
+            CHECK(!check("station LIKE 'south%'", *payload));
+            CHECK(check("station > 'a' AND sequence = 42", *payload));
+            CHECK(check("note = 'ok' OR note = 'it''s'", *payload));
+            CHECK(check("12 = reading.id", *payload));
+        }
+    }
+    std::cout << "表达式求值 ✅" << std::endl;
+
+    // 测试3: 参数
+    {
+        std::vector<uint8_t> payload = encode<CdrSerializerLE>(make_report("south", 3, 10.0f));
+        CHECK(check("reading.id = %0 AND station = %1", payload, {"3", "'south'"}));
+        CHECK(check("station = %0", payload, {"south"}));
+        CHECK(check("reading.temperature < %0", payload, {"12.5"}));
+        CHECK(!check("reading.id > %1", payload, {"x", "3"}));
+    }
+    std::cout << "过滤参数 ✅" << std::endl;
+
+    // 测试4: 编译错误
+    {
+        ContentFilter filter;
+        std::string error;
+        const char* bad[] = {
+            "missing = 1",                 // 没有这个字段
+            "history = 1",                 // 序列不能比较
+            "station = 1",                 // 类型不一致
+            "reading.id LIKE 'a%'",        // LIKE 只能用于字符串
+            "reading.id = ",               // 不完整
+            "(reading.id = 1",             // 缺少括号
+            "reading.id = 1 reading.id",   // 多余的内容
+            "station = 'abc",              // 字符串没有结束
+            "reading.id = %3",             // 参数不存在
+            "reading.valid > TRUE",        // 布尔值只能比较相等
+        };
+        for(const char* expression : bad){
+            CHECK(!filter.compile<Report>(expression, {}, &error));
+            CHECK(!error.empty() && !filter.valid());
+        }
+
+        // 嵌套层数有上限：上限以内可以编译，超过上限（包括极深的嵌套）编译失败而不是栈溢出
+        auto nested = [](size_t depth){
+            return std::string(depth, '(') + "reading.id = 1" + std::string(depth, ')');
+        };
+        CHECK(filter.compile<Report>(nested(ContentFilter::MAX_NESTING_DEPTH)));
+        CHECK(!filter.compile<Report>(nested(ContentFilter::MAX_NESTING_DEPTH + 1), {}, &error));
+        CHECK(!error.empty() && !filter.valid());
+        CHECK(!filter.compile<Report>(nested(60000), {}, &error));
+        std::string nots;
+        for(size_t i = 0; i < 60000; ++i) nots += "NOT ";
+        CHECK(!filter.compile<Report>(nots + "reading.id = 1", {}, &error));
+    }
+    std::cout << "编译错误 ✅" << std::endl;
+
+    // 测试5: 定长前缀按固定偏移读，数据不完整时不匹配
+    {
+        ContentFilter fixed;
+        CHECK(fixed.compile<Reading>("temperature > 30 AND position.x = 1.5"));
+        CHECK(fixed.uses_fixed_offsets());
+        std::vector<uint8_t> hot = encode<CdrSerializerBE>(make_reading(1, 31.0f));
+        std::vector<uint8_t> cold = encode<CdrSerializerLE>(make_reading(1, 29.0f));
+        CHECK(fixed.evaluate(ConstByteSpan(hot.data(), hot.size())));
+        CHECK(!fixed.evaluate(ConstByteSpan(cold.data(), cold.size())));
+        CHECK(!fixed.evaluate(ConstByteSpan(hot.data(), 16)));
+
+        ContentFilter variable;
+        CHECK(variable.compile<Report>("reading.temperature > 30"));
+        CHECK(!variable.uses_fixed_offsets());
+        std::vector<uint8_t> report = encode<CdrSerializerBE>(make_report("x", 1, 31.0f));
+        CHECK(!variable.evaluate(ConstByteSpan(report.data(), 12)));
+        // 只读到被引用的字段为止，之后的字段不完整也不影响结果
+        CHECK(variable.evaluate(ConstByteSpan(report.data(), report.size() - 8)));
+    }
+    std::cout << "固定偏移 ✅" << std::endl;
+
+    // 测试6: 写端按读端的过滤条件选择接收者，相同的条件共用一个过滤器
+    {
+        auto reader_guid = [](uint8_t n){
+            GUID guid;
+            guid.prefix.value[0] = n;
+            guid.entityId.value[3] = EntityKind::USER_READER_WITH_KEY;
+            return guid;
+        };
+        ReaderFilterSet set(cdr_type_desc_v<Report>);
+        set.add_reader(reader_guid(1));
+        CHECK(set.add_reader(reader_guid(2), "reading.temperature > %0", {"30"}));
+        CHECK(set.add_reader(reader_guid(3), "reading.temperature > %0", {"30"}));
+        CHECK(set.add_reader(reader_guid(4), "station = 'south'", {}));
+        CHECK(!set.add_reader(reader_guid(5), "nope = 1", {}));
+        CHECK(set.reader_count() == 4 && set.filter_count() == 2);
+
+        std::vector<uint8_t> hot = encode<CdrSerializerLE>(make_report("north", 1, 40.0f));
+        std::vector<GUID> out;
+        CHECK(set.select(ConstByteSpan(hot.data(), hot.size()), out) == 3);
+        CHECK(out[0] == reader_guid(1));
+
+        // 去掉不过滤的读端后，冷的北方站样本没有人需要
+        CHECK(set.remove_reader(reader_guid(1)));
+        std::vector<uint8_t> cold = encode<CdrSerializerLE>(make_report("north", 1, 10.0f));
+        CHECK(!set.wanted(ConstByteSpan(cold.data(), cold.size())));
+        CHECK(set.wanted(ConstByteSpan(hot.data(), hot.size())));
+
+        // 过滤器没有读端用了就删除，剩下的过滤器仍然正确
+        CHECK(set.remove_reader(reader_guid(2)) && set.remove_reader(reader_guid(3)));
+        CHECK(set.filter_count() == 1);
+        std::vector<uint8_t> south = encode<CdrSerializerLE>(make_report("south", 1, 10.0f));
+        out.clear();
+        CHECK(set.select(ConstByteSpan(south.data(), south.size()), out) == 1 && out[0] == reader_guid(4));
+        // 读端修改过滤条件
+        CHECK(set.add_reader(reader_guid(4), "station = 'north'", {}));
+        CHECK(set.reader_count() == 1 && set.filter_count() == 1);
+        CHECK(set.wanted(ConstByteSpan(cold.data(), cold.size())));
+        CHECK(!set.remove_reader(reader_guid(9)));
+    }
+    std::cout << "写端过滤 ✅" << std::endl;
+
+    // 测试7: 过滤条件随 SEDP 宣告
+    {
+        discovery::EndpointProxyData reader;
+        reader.guid.prefix.value[0] = 1;
+        reader.guid.entityId.value[3] = EntityKind::USER_READER_WITH_KEY;
+        reader.topic_name = "reports";
+        reader.type_name = "Report";
+        reader.content_filter.content_filtered_topic_name = "hot_reports";
+        reader.content_filter.related_topic_name = "reports";
+        reader.content_filter.filter_expression = "reading.temperature > %0";
+        reader.content_filter.expression_parameters = {"30"};
+        CdrSerializer serializer;
+        CHECK(discovery::serialize_endpoint_data(reader, serializer));
+        discovery::EndpointProxyData decoded;
+        CHECK(discovery::deserialize_endpoint_data(serializer.buffer(), decoded));
+        CHECK(decoded == reader && decoded.content_filter.filter_class_name == "DDSSQL");
+        rtps::ConstByteSpan truncated(serializer.data(), serializer.size() - 8);
+        CHECK(!discovery::deserialize_endpoint_data(truncated, decoded));
+    }
+    std::cout << "SEDP 宣告 ✅" << std::endl;
+
+    std::cout << "所有内容过滤测试通过 ✅" << std::endl;
+    return 0;
+}
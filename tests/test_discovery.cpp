@@ -0,0 +1,203 @@
+#include "tinydds/discovery/discovery.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tinydds;
+using namespace tinydds::discovery;
+
+static rtps::GuidPrefix make_prefix(uint8_t id){
+    rtps::GuidPrefix prefix;
+    prefix.value[0] = 0x01;
+    prefix.value[1] = 0xFE;
+    prefix.value[11] = id;
+    return prefix;
+}
+
+static EndpointProxyData make_endpoint(const rtps::GuidPrefix& prefix, uint32_t key, bool is_writer,
+                                       const std::string& topic, ReliabilityKind reliability = ReliabilityKind::RELIABLE){
+    EndpointProxyData data;
+    data.guid = rtps::GUID(prefix, rtps::EntityId(static_cast<uint8_t>(key >> 16), static_cast<uint8_t>(key >> 8),
+                                                  static_cast<uint8_t>(key), is_writer ? 0x02 : 0x07));
+    data.is_writer = is_writer;
+    data.topic_name = topic;
+    data.type_name = "ShapeType";
+    data.reliability = reliability;
+    return data;
+}
+
+int main() {
+    std::cout << "=== Discovery 测试 ===" << std::endl;
+
+    // 测试1: 编码/解码
+    ParticipantProxyData participant;
+    participant.guid_prefix = make_prefix(1);
+    participant.vendor_id = {0x01, 0xFE};
+    participant.metatraffic_unicast_locators.push_back(rtps::Locator("192.168.1.10", 7410));
+    participant.metatraffic_multicast_locators.push_back(rtps::Locator("239.255.0.1", 7400));
+    participant.default_unicast_locators.push_back(rtps::Locator("fe80::1", 7411));
+    participant.lease_duration = std::chrono::milliseconds(3000);
+    rtps::CdrSerializer serializer;
+    CHECK(serialize_participant_data(participant, serializer));
+    ParticipantProxyData decoded_participant;
+    CHECK(deserialize_participant_data(serializer.buffer(), decoded_participant));
+    CHECK(decoded_participant == participant);
+
+    EndpointProxyData endpoint = make_endpoint(participant.guid_prefix, 1, true, "Square");
+    endpoint.durability = DurabilityKind::TRANSIENT_LOCAL;
+    endpoint.unicast_locators.push_back(rtps::Locator("10.0.0.1", 7412));
+    serializer.reset();
+    CHECK(serialize_endpoint_data(endpoint, serializer));
+    EndpointProxyData decoded_endpoint;
+    CHECK(deserialize_endpoint_data(serializer.buffer(), decoded_endpoint));
+    CHECK(decoded_endpoint == endpoint);
+    // 截断的数据
+    rtps::ConstByteSpan truncated(serializer.data(), serializer.size() - 4);
+    CHECK(!deserialize_endpoint_data(truncated, decoded_endpoint));
+    // 参数值超过 PARAMETER_MAX_LENGTH 时编码失败
+    EndpointProxyData oversized = make_endpoint(participant.guid_prefix, 2, true, std::string(70000, 't'));
+    serializer.reset();
+    CHECK(!serialize_endpoint_data(oversized, serializer));
+    std::cout << "编码/解码 ✅" << std::endl;
+
+    // 测试2: 时间轮
+    TimerWheel<int> wheel(8, 0);
+    std::vector<int> expired;
+    auto collect = [&](int key){ expired.push_back(key); };
+    wheel.schedule(1, 5);
+    wheel.schedule(2, 20);   // 超过一圈
+    wheel.schedule(3, 6);
+    CHECK(wheel.advance(4, collect) == 0);
+    wheel.schedule(3, 12);   // 续期
+    CHECK(wheel.advance(6, collect) == 1 && expired == std::vector<int>{1});
+    CHECK(wheel.cancel(2) && !wheel.cancel(2));
+    CHECK(wheel.advance(11, collect) == 0);
+    CHECK(wheel.advance(100, collect) == 1 && expired.back() == 3);
+    CHECK(wheel.empty());
+    wheel.schedule(4, 50);   // 已经过去的时间：下一个 tick 到期
+    wheel.schedule(4, 300);
+    wheel.schedule(4, 110);  // 提前
+    CHECK(wheel.advance(109, collect) == 0);
+    CHECK(wheel.advance(110, collect) == 1 && expired.back() == 4);
+    std::cout << "时间轮 ✅" << std::endl;
+
+    // 测试3: 按主题索引的增量匹配
+    int matches = 0;
+    int unmatches = 0;
+    EndpointMatcher matcher([&](const EndpointProxyData& writer, const EndpointProxyData& reader, bool matched){
+        CHECK(writer.is_writer && !reader.is_writer && writer.topic_name == reader.topic_name);
+        (matched ? matches : unmatches)++;
+    });
+    const int kTopics = 100;
+    for(int t = 0; t < kTopics; ++t){
+        for(int i = 0; i < 5; ++i){
+            matcher.add_endpoint(make_endpoint(make_prefix(2), static_cast<uint32_t>(t * 100 + i), true, "topic" + std::to_string(t)));
+            matcher.add_endpoint(make_endpoint(make_prefix(3), static_cast<uint32_t>(t * 100 + i), false, "topic" + std::to_string(t)));
+        }
+    }
+    CHECK(matcher.endpoint_count() == kTopics * 10 && matcher.topic_count() == kTopics);
+    CHECK(matches == kTopics * 25);
+
+    // 新读端只和同一主题的 5 个写端比较
+    uint64_t checks = matcher.compatibility_checks();
+    matcher.add_endpoint(make_endpoint(make_prefix(4), 1, false, "topic42"));
+    CHECK(matcher.compatibility_checks() - checks == 5);
+    CHECK(matches == kTopics * 25 + 5);
+
+    // 重复宣告不做任何匹配
+    checks = matcher.compatibility_checks();
+    CHECK(!matcher.add_endpoint(make_endpoint(make_prefix(4), 1, false, "topic42")));
+    CHECK(matcher.compatibility_checks() == checks);
+
+    // QoS 不兼容：BEST_EFFORT 写端不能匹配 RELIABLE 读端
+    matcher.add_endpoint(make_endpoint(make_prefix(4), 2, true, "topic42", ReliabilityKind::BEST_EFFORT));
+    CHECK(matches == kTopics * 25 + 5);
+    // 类型不同也不匹配
+    EndpointProxyData other_type = make_endpoint(make_prefix(4), 3, true, "topic42");
+    other_type.type_name = "OtherType";
+    matcher.add_endpoint(other_type);
+    CHECK(matches == kTopics * 25 + 5);
+
+    // 参与者离开：它的端点全部解除匹配
+    CHECK(matcher.remove_participant_endpoints(make_prefix(4)) == 3);
+    CHECK(unmatches == 5);
+    CHECK(matcher.remove_endpoint(make_endpoint(make_prefix(2), 4200, true, "topic42").guid));
+    CHECK(unmatches == 5 + 5);
+    std::cout << "增量匹配 ✅" << std::endl;
+
+    // 测试4: 两个参与者通过 RTPS 消息互相发现
+    using Clock = Discovery::Clock;
+    Clock::time_point now = Clock::now();
+    ParticipantProxyData a_data;
+    a_data.guid_prefix = make_prefix(10);
+    a_data.lease_duration = std::chrono::milliseconds(1000);
+    ParticipantProxyData b_data;
+    b_data.guid_prefix = make_prefix(11);
+    b_data.lease_duration = std::chrono::milliseconds(1000);
+    Discovery a(a_data, DiscoveryConfig(), now);
+    Discovery b(b_data, DiscoveryConfig(), now);
+
+    int a_participants = 0;
+    std::vector<std::pair<rtps::GUID, rtps::GUID>> b_matches;
+    a.set_participant_listener([&](const ParticipantProxyData& p, bool discovered){
+        CHECK(p.guid_prefix == b_data.guid_prefix);
+        a_participants += discovered ? 1 : -1;
+    });
+    b.set_match_listener([&](const EndpointProxyData& writer, const EndpointProxyData& reader, bool matched){
+        if(matched) b_matches.emplace_back(writer.guid, reader.guid);
+        else b_matches.clear();
+    });
+
+    CHECK(a.add_local_endpoint(make_endpoint(a_data.guid_prefix, 1, true, "Square")));
+    CHECK(!a.add_local_endpoint(make_endpoint(b_data.guid_prefix, 1, true, "Square")));
+    CHECK(b.add_local_endpoint(make_endpoint(b_data.guid_prefix, 1, false, "Square")));
+    CHECK(b.add_local_endpoint(make_endpoint(b_data.guid_prefix, 2, false, "Circle")));
+
+    rtps::MessageBuilder to_b(a_data.guid_prefix, [&](rtps::ConstByteSpan message){ b.handle_message(message, now); });
+    rtps::MessageBuilder to_a(b_data.guid_prefix, [&](rtps::ConstByteSpan message){ a.handle_message(message, now); });
+    CHECK(a.write_announcements(to_b));
+    to_b.flush();
+    CHECK(b.write_announcements(to_a));
+    to_a.flush();
+
+    CHECK(a.participant_count() == 1 && b.participant_count() == 1 && a_participants == 1);
+    CHECK(b_matches.size() == 1);
+    CHECK(b_matches[0].first.prefix == a_data.guid_prefix && b_matches[0].second.prefix == b_data.guid_prefix);
+    CHECK(a.matcher().endpoint_count() == 3);
+
+    // 再次宣告：只续期，不重复匹配
+    CHECK(a.write_announcements(to_b));
+    to_b.flush();
+    CHECK(b_matches.size() == 1);
+
+    // B 持续宣告，A 不再宣告：A 在 B 那里租期到期
+    now += std::chrono::milliseconds(600);
+    CHECK(b.write_announcements(to_a));
+    to_a.flush();
+    CHECK(b.check_leases(now) == 0 && a.check_leases(now) == 0);
+    now += std::chrono::milliseconds(600);
+    CHECK(b.check_leases(now) == 1);
+    CHECK(b.participant_count() == 0 && b_matches.empty());
+    CHECK(a.check_leases(now) == 0 && a.participant_count() == 1); // B 在 600ms 时续期过
+    now += std::chrono::milliseconds(600);
+    CHECK(a.check_leases(now) == 1 && a_participants == 0);
+
+    // 编码失败的端点被跳过，其余端点照常宣告
+    ParticipantProxyData c_data;
+    c_data.guid_prefix = make_prefix(12);
+    ParticipantProxyData d_data;
+    d_data.guid_prefix = make_prefix(13);
+    Discovery c(c_data, DiscoveryConfig(), now);
+    Discovery d(d_data, DiscoveryConfig(), now);
+    CHECK(c.add_local_endpoint(make_endpoint(c_data.guid_prefix, 1, true, std::string(70000, 't'))));
+    CHECK(c.add_local_endpoint(make_endpoint(c_data.guid_prefix, 2, true, "Square")));
+    rtps::MessageBuilder to_d(c_data.guid_prefix, [&](rtps::ConstByteSpan message){ d.handle_message(message, now); });
+    CHECK(!c.write_announcements(to_d));
+    to_d.flush();
+    CHECK(d.participant_count() == 1 && d.matcher().endpoint_count() == 1);
+    std::cout << "SPDP/SEDP ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
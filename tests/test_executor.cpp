@@ -0,0 +1,142 @@
+#include "tinydds/dds/executor.hpp"
+#include "tinydds/dds/listener_dispatcher.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+using namespace tinydds;
+using namespace tinydds::dds;
+
+// 等待条件成立，最多 5 秒
+template<typename Fn>
+static bool wait_until(Fn&& condition){
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(!condition()){
+        if(std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== 执行器测试 ===" << std::endl;
+
+    // 测试1: InlineExecutor 在调用线程上同步执行
+    {
+        std::unique_ptr<Executor> executor = make_executor(ExecutorConfig());
+        CHECK(executor->runs_inline());
+        std::thread::id ran_on;
+        CHECK(executor->post([&]{ ran_on = std::this_thread::get_id(); }));
+        CHECK(ran_on == std::this_thread::get_id());
+    }
+    std::cout << "内联执行 ✅" << std::endl;
+
+    // 测试2: 线程池执行所有任务，绑核，关闭前执行完已投递的任务
+    {
+        ThreadPoolConfig config;
+        config.threads = 3;
+        config.cpus = {sched_getcpu()}; // 当前线程所在的核一定在允许的范围内
+        config.queue_capacity = 64;
+        ThreadPoolExecutor pool(config);
+        CHECK(pool.thread_count() == 3 && !pool.runs_inline());
+        CHECK(wait_until([&]{ return pool.pinned_threads() == 3; }));
+
+        std::atomic<int> counter{0};
+        int posted = 0;
+        for(int i = 0; i < 10000; ++i){
+            if(pool.post([&]{ counter.fetch_add(1, std::memory_order_relaxed); })) ++posted;
+            else std::this_thread::yield();
+        }
+        pool.shutdown();
+        CHECK(counter.load() == posted && posted > 0);
+        CHECK(!pool.post([]{}));
+    }
+    std::cout << "线程池 ✅" << std::endl;
+
+    // 测试3: 工作窃取 —— 全部投递给 0 号线程，0 号线程被第一个任务卡住时其他线程偷走剩下的
+    {
+        ThreadPoolConfig config;
+        config.threads = 2;
+        ThreadPoolExecutor pool(config);
+        std::atomic<bool> release{false};
+        std::atomic<int> done{0};
+        CHECK(pool.post_to(0, [&]{ while(!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1)); }));
+        for(int i = 0; i < 10; ++i){
+            CHECK(pool.post_to(0, [&]{ done.fetch_add(1); }));
+        }
+        CHECK(wait_until([&]{ return done.load() == 10; }));
+        CHECK(pool.steals() >= 1);
+        release.store(true);
+        pool.shutdown();
+    }
+    std::cout << "工作窃取 ✅" << std::endl;
+
+    // 测试4: 监听器批量回调 —— 多个接收线程投递，回调不并发、不丢、每个线程的顺序不变
+    {
+        ThreadPoolConfig config;
+        config.threads = 2;
+        ThreadPoolExecutor pool(config);
+        const int kThreads = 3;
+        const int kPerThread = 20000;
+        std::atomic<int> in_callback{0};
+        std::vector<int> last(kThreads, -1);
+        size_t max_seen = 0;
+        ListenerDispatcher<uint64_t> dispatcher(pool, [&](rtps::Span<uint64_t> samples){
+            CHECK(in_callback.fetch_add(1) == 0);
+            CHECK(samples.size() <= 32);
+            if(samples.size() > max_seen) max_seen = samples.size();
+            for(uint64_t sample : samples){
+                int t = static_cast<int>(sample >> 32);
+                int i = static_cast<int>(sample & 0xFFFFFFFF);
+                CHECK(i == last[t] + 1);
+                last[t] = i;
+            }
+            in_callback.fetch_sub(1);
+        }, 4096, 32);
+
+        std::vector<std::thread> receivers;
+        for(int t = 0; t < kThreads; ++t){
+            receivers.emplace_back([&, t]{
+                for(int i = 0; i < kPerThread; ++i){
+                    uint64_t sample = (static_cast<uint64_t>(t) << 32) | static_cast<uint64_t>(i);
+                    while(!dispatcher.deliver(sample)) std::this_thread::yield();
+                }
+            });
+        }
+        for(std::thread& t : receivers) t.join();
+        CHECK(wait_until([&]{ return dispatcher.idle(); }));
+        pool.shutdown();
+        uint64_t total = static_cast<uint64_t>(kThreads) * kPerThread;
+        CHECK(dispatcher.delivered() == total);
+        CHECK(dispatcher.batches() <= total);
+        std::cout << "  " << total << " 个样本，" << dispatcher.batches() << " 次回调，最大批量 " << max_seen
+                  << "，队列满重试 " << dispatcher.dropped() << " 次" << std::endl;
+    }
+    std::cout << "批量回调 ✅" << std::endl;
+
+    // 测试5: 内联模式下回调在接收线程上执行
+    {
+        InlineExecutor executor;
+        std::thread::id callback_thread;
+        size_t received = 0;
+        ListenerDispatcher<int> dispatcher(executor, [&](rtps::Span<int> samples){
+            callback_thread = std::this_thread::get_id();
+            received += samples.size();
+        });
+        std::thread receiver([&]{
+            for(int i = 0; i < 100; ++i) dispatcher.deliver(i);
+            CHECK(callback_thread == std::this_thread::get_id());
+        });
+        receiver.join();
+        CHECK(received == 100 && dispatcher.batches() == 100 && dispatcher.idle());
+    }
+    std::cout << "内联回调 ✅" << std::endl;
+
+    std::cout << "所有执行器测试通过 ✅" << std::endl;
+    return 0;
+}
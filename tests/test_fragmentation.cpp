@@ -0,0 +1,252 @@
+#include "tinydds/rtps/data_fragmenter.hpp"
+#include "tinydds/rtps/fragment_assembler.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "tinydds/transport/udp_transport.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+using namespace tinydds::rtps;
+using namespace tinydds::transport;
+
+using FragmentResult = FragmentAssembler::FragmentResult;
+
+// 把分段的消息拼成一个数据报（模拟内核按 iovec 聚合）
+std::vector<uint8_t> flatten(const FragmentMessage& message){
+    std::vector<uint8_t> datagram;
+    for(size_t i = 0; i < message.part_count; ++i){
+        datagram.insert(datagram.end(), message.parts[i].begin(), message.parts[i].end());
+    }
+    return datagram;
+}
+
+// 解析数据报里的 DATA_FRAG 交给 assembler，返回最后一个结果
+FragmentResult receive(FragmentAssembler& assembler, ConstByteSpan datagram){
+    MessageParser parser(datagram);
+    CHECK(parser.valid());
+    SubmessageView sub;
+    FragmentResult result = FragmentResult::INVALID;
+    while(parser.next(sub)){
+        DataFragSubmessage frag;
+        CHECK(parse_data_frag(sub, frag));
+        result = assembler.on_data_frag(frag);
+    }
+    CHECK(!parser.malformed());
+    return result;
+}
+
+std::vector<uint8_t> make_sample(size_t size){
+    std::vector<uint8_t> sample(size);
+    for(size_t i = 0; i < size; ++i) sample[i] = static_cast<uint8_t>(i * 131 + (i >> 8));
+    return sample;
+}
+
+int main() {
+    std::cout << "=== 分片测试 ===" << std::endl;
+
+    GuidPrefix prefix;
+    prefix.value[0] = 0x42;
+    EntityId reader_id;
+    EntityId writer_id;
+    writer_id.value[3] = EntityKind::USER_WRITER_WITH_KEY;
+    SequenceNumber sn(0, 7);
+
+    // 测试1: 切分 + 重组，分片数据是样本缓冲区的视图，不复制
+    {
+        std::vector<uint8_t> sample = make_sample(1000003); // 最后一个分片不满，也不是 4 的倍数
+        DataFragmenter fragmenter(prefix, 1000, 8000);
+        CHECK(fragmenter.fragments_per_message() == 7);
+        CHECK(fragmenter.fragment_count(sample.size()) == 1001);
+
+        Span<const FragmentMessage> messages = fragmenter.fragment(reader_id, writer_id, sn, sample);
+        CHECK(messages.size() == (1001 + 6) / 7);
+        uint32_t next = 1;
+        for(const FragmentMessage& message : messages){
+            CHECK(message.first_fragment == next);
+            next += message.fragment_count;
+            CHECK(message.size() <= 8000 && message.size() % 4 == 0);
+            CHECK(message.parts[1].data() >= sample.data() &&
+                   message.parts[1].data() + message.parts[1].size() <= sample.data() + sample.size());
+        }
+        CHECK(next == 1002);
+        CHECK(messages[messages.size() - 1].part_count == 3); // 最后一条消息有对齐填充
+
+        FragmentAssembler assembler;
+        for(size_t i = 0; i < messages.size(); ++i){
+            std::vector<uint8_t> datagram = flatten(messages[i]);
+            FragmentResult result = receive(assembler, datagram);
+            CHECK(result == (i + 1 == messages.size() ? FragmentResult::COMPLETE : FragmentResult::ACCEPTED));
+        }
+        bool taken = assembler.take(sn, [&](ConstByteSpan payload){
+            CHECK(payload.size() == sample.size());
+            CHECK(std::memcmp(payload.data(), sample.data(), sample.size()) == 0);
+        });
+        CHECK(taken && assembler.in_progress() == 0);
+        // 交付之后到达的重复分片直接丢弃
+        std::vector<uint8_t> late = flatten(messages[0]);
+        CHECK(receive(assembler, late) == FragmentResult::DUPLICATE && assembler.in_progress() == 0);
+    }
+    std::cout << "切分与重组 ✅" << std::endl;
+
+    // 测试2: 丢失的分片用 NACK_FRAG 请求，只重传缺失的部分
+    {
+        std::vector<uint8_t> sample = make_sample(200000);
+        DataFragmenter fragmenter(prefix, 1024, 4 * 1024 + DATA_FRAG_MESSAGE_HEADER_SIZE + 4);
+        CHECK(fragmenter.fragments_per_message() == 4);
+        Span<const FragmentMessage> messages = fragmenter.fragment(reader_id, writer_id, sn, sample);
+        uint32_t total = fragmenter.fragment_count(sample.size());
+        CHECK(total == 196);
+
+        // 丢掉第 2、3 条和最后一条消息
+        FragmentAssembler assembler;
+        std::vector<uint32_t> lost;
+        for(size_t i = 0; i < messages.size(); ++i){
+            if(i == 1 || i == 2 || i + 1 == messages.size()){
+                for(uint32_t f = 0; f < messages[i].fragment_count; ++f) lost.push_back(messages[i].first_fragment + f);
+                continue;
+            }
+            std::vector<uint8_t> datagram = flatten(messages[i]);
+            CHECK(receive(assembler, datagram) == FragmentResult::ACCEPTED);
+        }
+        CHECK(!assembler.take(sn, [](ConstByteSpan){}));
+
+        // 没有 HEARTBEAT_FRAG 时只知道收到的最大分片号，尾部丢失的分片还看不出来
+        FragmentNumberSet missing;
+        CHECK(assembler.build_nack_frag(sn, missing));
+        CHECK(missing.base == 5 && missing.count() == 8);
+        assembler.on_heartbeat_frag(sn, total);
+        CHECK(assembler.build_nack_frag(sn, missing));
+        CHECK(missing.base == 5 && missing.count() == lost.size());
+        size_t index = 0;
+        missing.for_each([&](uint32_t fragment){ CHECK(fragment == lost[index++]); });
+
+        // NACK_FRAG / HEARTBEAT_FRAG 走一遍线上格式
+        std::vector<uint8_t> wire;
+        MessageBuilder builder(prefix, [&](ConstByteSpan message){ wire.assign(message.begin(), message.end()); });
+        CHECK(builder.add_nack_frag(reader_id, writer_id, sn, missing, 3));
+        CHECK(builder.add_heartbeat_frag(reader_id, writer_id, sn, total, 4));
+        builder.flush();
+        MessageParser parser(wire);
+        SubmessageView sub;
+        NackFragSubmessage nack;
+        HeartbeatFragSubmessage heartbeat;
+        CHECK(parser.next(sub) && parse_nack_frag(sub, nack));
+        CHECK(nack.writer_sn == sn && nack.count == 3 && nack.fragment_number_state.base == missing.base);
+        CHECK(nack.fragment_number_state.num_bits == missing.num_bits && nack.fragment_number_state.bitmap == missing.bitmap);
+        CHECK(parser.next(sub) && parse_heartbeat_frag(sub, heartbeat));
+        CHECK(heartbeat.writer_sn == sn && heartbeat.last_fragment_num == total && heartbeat.count == 4);
+
+        // 写端只重传缺失的分片：两段连续缺失（5~12、193~196），每条消息最多 4 个分片 -> 3 条消息
+        Span<const FragmentMessage> resend =
+            fragmenter.fragment_missing(reader_id, writer_id, sn, sample, nack.fragment_number_state);
+        CHECK(resend.size() == 3);
+        FragmentResult result = FragmentResult::INVALID;
+        for(const FragmentMessage& message : resend){
+            std::vector<uint8_t> datagram = flatten(message);
+            result = receive(assembler, datagram);
+        }
+        CHECK(result == FragmentResult::COMPLETE);
+        CHECK(!assembler.build_nack_frag(sn, missing));
+        CHECK(assembler.take(sn, [&](ConstByteSpan payload){
+            CHECK(std::memcmp(payload.data(), sample.data(), sample.size()) == 0);
+        }));
+    }
+    std::cout << "NACK_FRAG 重传 ✅" << std::endl;
+
+    // 测试3: 不一致的分片、容量满时丢掉最旧的样本
+    {
+        std::vector<uint8_t> sample = make_sample(5000);
+        DataFragmenter fragmenter(prefix, 1000, 1500);
+        FragmentAssembler assembler(2, 1 << 20);
+        for(int32_t seq = 1; seq <= 3; ++seq){
+            Span<const FragmentMessage> messages =
+                fragmenter.fragment(reader_id, writer_id, SequenceNumber(0, seq), sample, 1, 1);
+            CHECK(messages.size() == 1);
+            std::vector<uint8_t> datagram = flatten(messages[0]);
+            CHECK(receive(assembler, datagram) == FragmentResult::ACCEPTED);
+        }
+        CHECK(assembler.in_progress() == 2 && assembler.evicted() == 1);
+        FragmentNumberSet missing;
+        CHECK(!assembler.build_nack_frag(SequenceNumber(0, 1), missing));
+
+        // 同一个样本的分片声明了不同的样本大小
+        std::vector<uint8_t> other = make_sample(6000);
+        Span<const FragmentMessage> messages = fragmenter.fragment(reader_id, writer_id, SequenceNumber(0, 3), other, 2, 2);
+        std::vector<uint8_t> datagram = flatten(messages[0]);
+        CHECK(receive(assembler, datagram) == FragmentResult::INVALID);
+
+        // 数据被截断
+        messages = fragmenter.fragment(reader_id, writer_id, SequenceNumber(0, 3), sample, 2, 2);
+        datagram = flatten(messages[0]);
+        datagram.resize(datagram.size() - 100);
+        MessageParser parser(datagram);
+        SubmessageView sub;
+        CHECK(!parser.next(sub) && parser.malformed());
+
+        // 超过 max_sample_size
+        FragmentAssembler small(2, 4096);
+        messages = fragmenter.fragment(reader_id, writer_id, sn, sample, 1, 1);
+        datagram = flatten(messages[0]);
+        CHECK(receive(small, datagram) == FragmentResult::INVALID);
+
+        assembler.drop_before(SequenceNumber(0, 3));
+        CHECK(assembler.in_progress() == 1);
+        assembler.drop(SequenceNumber(0, 3));
+        CHECK(assembler.in_progress() == 0);
+    }
+    std::cout << "异常分片 ✅" << std::endl;
+
+    // 测试4: 通过 UDP 回环聚合发送（sendmmsg + iovec），丢包时按 NACK_FRAG 补发
+    {
+        UdpTransportConfig config;
+        config.bind_address = "127.0.0.1";
+        config.max_datagram_size = 9000;
+        config.receive_batch = 32;
+        config.socket_receive_buffer = 4 * 1024 * 1024;
+        UdpTransport receiver(config);
+        UdpTransport sender;
+        CHECK(receiver.open() && sender.open());
+        Locator destination = receiver.local_locator();
+
+        std::vector<uint8_t> sample = make_sample(300000);
+        DataFragmenter fragmenter(prefix, 1400, 8800);
+        FragmentAssembler assembler;
+        auto send = [&](Span<const FragmentMessage> messages){
+            std::vector<UdpGatherDatagram> datagrams;
+            for(const FragmentMessage& message : messages){
+                datagrams.push_back(UdpGatherDatagram{message.parts.data(), message.part_count, destination});
+            }
+            CHECK(sender.send_batch(datagrams) == datagrams.size());
+        };
+        send(fragmenter.fragment(reader_id, writer_id, sn, sample));
+
+        bool complete = false;
+        for(int round = 0; round < 50 && !complete; ++round){
+            size_t n = receiver.receive(100);
+            for(size_t i = 0; i < n; ++i){
+                if(receive(assembler, receiver.received(i).data) == FragmentResult::COMPLETE) complete = true;
+            }
+            if(n == 0 && !complete){
+                // 一段时间没有数据：请求缺失的分片
+                assembler.on_heartbeat_frag(sn, fragmenter.fragment_count(sample.size()));
+                FragmentNumberSet missing;
+                if(assembler.build_nack_frag(sn, missing)){
+                    send(fragmenter.fragment_missing(reader_id, writer_id, sn, sample, missing));
+                }
+            }
+        }
+        CHECK(complete);
+        CHECK(assembler.take(sn, [&](ConstByteSpan payload){
+            CHECK(payload.size() == sample.size());
+            CHECK(std::memcmp(payload.data(), sample.data(), sample.size()) == 0);
+        }));
+        std::cout << "  " << sample.size() << " 字节，" << fragmenter.fragment_count(sample.size()) << " 个分片，"
+                  << sender.datagrams_sent() << " 个数据报，sendmmsg " << sender.send_syscalls() << " 次" << std::endl;
+    }
+    std::cout << "UDP 聚合发送 ✅" << std::endl;
+
+    std::cout << "所有分片测试通过 ✅" << std::endl;
+    return 0;
+}
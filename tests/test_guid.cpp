@@ -0,0 +1,160 @@
+#include "tinydds/rtps/guid.hpp"
+#include "tinydds/rtps/flat_hash_map.hpp"
+#include "test_check.hpp"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace tinydds::rtps;
+
+static GUID make_guid(uint32_t participant, uint32_t entity){
+    GUID guid;
+    guid.prefix.value = {0x01, 0x0F, 0xAA, 0xBB, 0, 0, 0, 0, 0, 0, 0, 0};
+    std::memcpy(guid.prefix.value.data() + 8, &participant, 4);
+    guid.entityId = EntityId(static_cast<uint8_t>(entity >> 16), static_cast<uint8_t>(entity >> 8),
+                             static_cast<uint8_t>(entity), 0x03);
+    return guid;
+}
+
+int main() {
+    std::cout << "=== GUID 测试 ===" << std::endl;
+
+    // 测试1: 哈希分布 —— 前缀相同、EntityId 连续的 GUID，低 16 位也应当几乎不冲突
+    std::unordered_set<uint64_t> low_bits;
+    const uint32_t kEndpoints = 4096;
+    for(uint32_t i = 0; i < kEndpoints; ++i){
+        low_bits.insert(std::hash<GUID>{}(make_guid(1, i)) & 0xFFFF);
+    }
+    std::cout << kEndpoints << " 个 GUID 的低 16 位有 " << low_bits.size() << " 个不同值" << std::endl;
+    CHECK(low_bits.size() > kEndpoints * 9 / 10);
+
+    // 只差一位的 GUID，哈希值的高位也要变化
+    uint64_t h1 = guid_hash(make_guid(1, 0));
+    uint64_t h2 = guid_hash(make_guid(1, 1));
+    CHECK((h1 ^ h2) >> 32 != 0);
+    CHECK(std::hash<GuidPrefix>{}(make_guid(1, 0).prefix) != std::hash<GuidPrefix>{}(make_guid(2, 0).prefix));
+    std::cout << "哈希分布 ✅" << std::endl;
+
+    // 测试2: FlatHashMap 插入/查找/删除
+    GuidMap<std::string> endpoints;
+    for(uint32_t p = 0; p < 10; ++p){
+        for(uint32_t e = 0; e < 1000; ++e){
+            auto result = endpoints.insert(make_guid(p, e), std::to_string(p * 1000 + e));
+            CHECK(result.second);
+        }
+    }
+    CHECK(endpoints.size() == 10000);
+    CHECK(!endpoints.insert(make_guid(3, 3), "dup").second);
+    CHECK(*endpoints.find(make_guid(3, 3)) == "3003");
+    CHECK(endpoints.find(make_guid(10, 0)) == nullptr);
+
+    // 删掉一半，剩下的仍然都能找到（backward shift 不能破坏探测链）
+    for(uint32_t p = 0; p < 10; ++p){
+        for(uint32_t e = 0; e < 1000; e += 2){
+            CHECK(endpoints.erase(make_guid(p, e)));
+        }
+    }
+    CHECK(!endpoints.erase(make_guid(0, 0)));
+    CHECK(endpoints.size() == 5000);
+    for(uint32_t p = 0; p < 10; ++p){
+        for(uint32_t e = 0; e < 1000; ++e){
+            const std::string* value = endpoints.find(make_guid(p, e));
+            if(e % 2 == 0){
+                CHECK(value == nullptr);
+            }else{
+                CHECK(value != nullptr && *value == std::to_string(p * 1000 + e));
+            }
+        }
+    }
+    size_t visited = 0;
+    endpoints.for_each([&](const GUID&, std::string&){ ++visited; });
+    CHECK(visited == 5000);
+
+    endpoints[make_guid(0, 0)] = "back";
+    CHECK(*endpoints.find(make_guid(0, 0)) == "back");
+    endpoints.insert_or_assign(make_guid(0, 0), "again");
+    CHECK(*endpoints.find(make_guid(0, 0)) == "again");
+    endpoints.clear();
+    CHECK(endpoints.empty() && endpoints.find(make_guid(0, 1)) == nullptr);
+
+    GuidPrefixMap<int> participants(100);
+    size_t capacity = participants.capacity();
+    for(uint32_t p = 0; p < 100; ++p) participants[make_guid(p, 0).prefix] = static_cast<int>(p);
+    CHECK(participants.capacity() == capacity);
+    CHECK(*participants.find(make_guid(42, 7).prefix) == 42);
+    std::cout << "FlatHashMap ✅" << std::endl;
+
+    // 测试3: 按字比较与按字节的字典序一致
+    static_assert(sizeof(GUID) == 16 && alignof(GUID) == 16, "packed GUID");
+    std::mt19937 gen(12345);
+    std::vector<GUID> guids(2000);
+    for(auto& guid : guids){
+        // 只用少量取值，让大量 GUID 只在靠后的字节上不同
+        for(auto& b : guid.prefix.value) b = static_cast<uint8_t>(gen() % 3);
+        for(auto& b : guid.entityId.value) b = static_cast<uint8_t>(gen() % 3);
+    }
+    for(size_t i = 0; i + 1 < guids.size(); ++i){
+        const GUID& a = guids[i];
+        const GUID& b = guids[i + 1];
+        bool bytewise_less = a.prefix.value != b.prefix.value ? a.prefix.value < b.prefix.value
+                                                             : a.entityId.value < b.entityId.value;
+        bool bytewise_equal = a.prefix.value == b.prefix.value && a.entityId.value == b.entityId.value;
+        CHECK((a < b) == bytewise_less);
+        CHECK((a == b) == bytewise_equal);
+        CHECK((a.prefix < b.prefix) == (a.prefix.value < b.prefix.value));
+        CHECK((a.prefix == b.prefix) == (a.prefix.value == b.prefix.value));
+        CHECK((a.entityId < b.entityId) == (a.entityId.value < b.entityId.value));
+    }
+    std::sort(guids.begin(), guids.end());
+    for(size_t i = 0; i + 1 < guids.size(); ++i){
+        CHECK(!(guids[i + 1] < guids[i]));
+    }
+    GUID high = make_guid(0, 0);
+    high.prefix.value[0] = 0xFF;      // 最高字节大于 0x7F 时不能按有符号比较
+    CHECK(make_guid(0, 0) < high && !(high < make_guid(0, 0)));
+    std::cout << "GUID 比较 ✅" << std::endl;
+
+    // 测试4: GuidPrefix 生成，多线程并发也不重复
+    const int kThreads = 4;
+    const int kPerThread = 5000;
+    std::vector<std::vector<GuidPrefix>> generated(kThreads);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < kThreads; ++t){
+        threads.emplace_back([&, t]{
+            for(int i = 0; i < kPerThread; ++i) generated[t].push_back(generate_guid_prefix());
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    std::set<GuidPrefix> unique_prefixes;
+    for(const auto& list : generated){
+        for(const auto& prefix : list){
+            CHECK(prefix.value[0] == 0x01 && prefix.value[1] == 0xFE);
+            // hostId 和 processId 在同一个进程里相同
+            CHECK(std::equal(prefix.value.begin() + 2, prefix.value.begin() + 8,
+                              generated[0][0].value.begin() + 2));
+            unique_prefixes.insert(prefix);
+        }
+    }
+    CHECK(unique_prefixes.size() == static_cast<size_t>(kThreads * kPerThread));
+
+    // 计数器超过 16 位之后也不重复
+    const size_t kMany = 70000;
+    unique_prefixes.clear();
+    for(size_t i = 0; i < kMany; ++i) unique_prefixes.insert(generate_guid_prefix());
+    CHECK(unique_prefixes.size() == kMany);
+
+    EntityIdGenerator entity_ids;
+    EntityId writer_id = entity_ids.next(EntityKind::USER_WRITER_WITH_KEY);
+    EntityId reader_id = entity_ids.next(EntityKind::USER_READER_WITH_KEY);
+    CHECK(writer_id == EntityId(0, 0, 1, 0x02));
+    CHECK(reader_id == EntityId(0, 0, 2, 0x07));
+    std::cout << "GuidPrefix / EntityId 生成 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "tinydds/rtps/latency_histogram.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <random>
+
+using namespace tinydds::rtps;
+
+int main() {
+    std::cout << "=== 延迟直方图测试 ===" << std::endl;
+
+    // 测试1: 桶的下标和范围首尾相接，相对误差不超过 1/128
+    {
+        CHECK(LatencyHistogram::bucket_index(0) == 0);
+        CHECK(LatencyHistogram::bucket_index(255) == 255);
+        CHECK(LatencyHistogram::bucket_index(256) == 256);
+        CHECK(LatencyHistogram::bucket_index(257) == 256);
+        CHECK(LatencyHistogram::bucket_index(258) == 257);
+        for(size_t i = 1; i < LatencyHistogram::BUCKET_COUNT; ++i){
+            uint64_t lowest = LatencyHistogram::bucket_lowest(i);
+            uint64_t highest = LatencyHistogram::bucket_highest(i);
+            CHECK(lowest == LatencyHistogram::bucket_highest(i - 1) + 1);
+            CHECK(LatencyHistogram::bucket_index(lowest) == i);
+            CHECK(LatencyHistogram::bucket_index(highest) == i);
+            CHECK((highest - lowest) * 128 <= lowest);
+        }
+        CHECK(LatencyHistogram::bucket_highest(LatencyHistogram::BUCKET_COUNT - 1) ==
+               LatencyHistogram::MAX_TRACKABLE_VALUE);
+        CHECK(LatencyHistogram::bucket_index(UINT64_MAX) == LatencyHistogram::BUCKET_COUNT - 1);
+    }
+    std::cout << "桶的划分 ✅" << std::endl;
+
+    // 测试2: 分位数
+    {
+        LatencyHistogram histogram;
+        CHECK(histogram.count() == 0 && histogram.value_at_percentile(50) == 0 && histogram.min() == 0);
+        for(uint64_t v = 1; v <= 100; ++v) histogram.record(v);
+        CHECK(histogram.count() == 100 && histogram.min() == 1 && histogram.max() == 100);
+        CHECK(histogram.mean() == 50.5);
+        CHECK(histogram.value_at_percentile(50) == 50);
+        CHECK(histogram.value_at_percentile(99) == 99);
+        CHECK(histogram.value_at_percentile(100) == 100);
+        CHECK(histogram.value_at_percentile(0) == 1);
+
+        // 大的值：结果在相对误差范围内，且不超过实际最大值
+        LatencyHistogram large;
+        std::mt19937_64 rng(3);
+        for(int i = 0; i < 100000; ++i) large.record(1000 + rng() % 1000000);
+        uint64_t p50 = large.value_at_percentile(50);
+        CHECK(p50 > 490000 && p50 < 515000);
+        CHECK(large.value_at_percentile(99.9) <= large.max());
+        CHECK(large.value_at_percentile(100) == large.max());
+
+        // 一个离群值
+        large.record(5000000000ULL);
+        CHECK(large.max() == 5000000000ULL && large.value_at_percentile(100) == 5000000000ULL);
+        uint64_t p9999 = large.value_at_percentile(99.99); // 桶的上界，最多比实际值大 1/128
+        CHECK(p9999 > 990000 && p9999 < 1001000 + 1001000 / 128);
+    }
+    std::cout << "分位数 ✅" << std::endl;
+
+    // 测试3: 合并与清空
+    {
+        LatencyHistogram a;
+        LatencyHistogram b;
+        a.record(10, 3);
+        b.record(1000);
+        b.record(20);
+        a.merge(b);
+        CHECK(a.count() == 5 && a.min() == 10 && a.max() == 1000);
+        size_t buckets = 0;
+        uint64_t total = 0;
+        a.for_each_bucket([&](uint64_t lowest, uint64_t highest, uint64_t count){
+            CHECK(lowest <= highest);
+            ++buckets;
+            total += count;
+        });
+        CHECK(buckets == 3 && total == 5);
+        a.reset();
+        CHECK(a.count() == 0 && a.max() == 0 && a.value_at_percentile(99) == 0);
+    }
+    std::cout << "合并与清空 ✅" << std::endl;
+
+    std::cout << "所有延迟直方图测试通过 ✅" << std::endl;
+    return 0;
+}
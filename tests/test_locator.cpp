@@ -1,5 +1,8 @@
 #include "tinydds/rtps/locator.hpp"
+#include "test_check.hpp"
 #include <iostream>
+#include <string>
+#include <unordered_set>
 
 using namespace tinydds::rtps;
 
@@ -34,6 +37,63 @@ int main(){
     std::cout << "loc1 == loc2? " 
               << (loc1 == loc2 ? "是 ✅" : "否 ❌") << std::endl;
 
+    // 测试5: 编译期构造
+    constexpr Locator compile_time("239.255.0.1", 7400);
+    static_assert(compile_time.kind == LocatorKind::LOCATOR_KIND_UDPv4, "constexpr IPv4");
+    static_assert(compile_time.get_ipv4_address() == 0xEFFF0001u, "constexpr IPv4 bytes");
+    static_assert(compile_time.is_multicast(), "constexpr multicast");
+    static_assert(!Locator("256.1.1.1", 1).is_valid(), "octet out of range");
+    static_assert(!Locator("1.2.3", 1).is_valid(), "too few octets");
+    static_assert(!Locator("01.2.3.4", 1).is_valid(), "leading zero");
+    static_assert(Locator("ff02::1", 1).is_multicast(), "IPv6 multicast");
+    CHECK(compile_time == multicast_loc);
+    std::cout << "编译期构造 ✅" << std::endl;
+
+    // 测试6: IPv6 解析与规范格式
+    struct { const char* input; const char* canonical; } cases[] = {
+        {"::", "::"},
+        {"::1", "::1"},
+        {"fe80::1", "fe80::1"},
+        {"2001:0DB8:0000:0000:0000:0000:0002:0001", "2001:db8::2:1"},
+        {"2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"},
+        {"2001:0:0:1:0:0:0:1", "2001:0:0:1::1"},
+        {"1::", "1::"},
+        {"::ffff:192.168.1.1", "::ffff:192.168.1.1"},
+    };
+    for(const auto& c : cases){
+        Locator loc(c.input, 7400);
+        CHECK(loc.kind == LocatorKind::LOCATOR_KIND_UDPv6);
+        char buffer[IPV6_ADDRESS_MAX_CHARS];
+        size_t length = loc.address_to_chars(buffer, sizeof(buffer));
+        CHECK(std::string(buffer, length) == c.canonical);
+        CHECK(Locator(std::string(buffer), 7400) == loc);
+    }
+    const char* invalid[] = {":::", "1:2:3:4:5:6:7:8:9", "1::2::3", "12345::", "1:", ":1", "g::1", "1:2:3:4:5:6:7::8"};
+    for(const char* text : invalid){
+        CHECK(!Locator(text, 7400).is_valid());
+    }
+    std::cout << "IPv6 ✅" << std::endl;
+
+    // 测试7: 格式化写入调用方缓冲区
+    char text[LOCATOR_MAX_CHARS];
+    CHECK(loc1.to_chars(text, sizeof(text)) == 18 && std::string(text) == "192.168.1.100:7400");
+    CHECK(Locator("::1", 7410).to_chars(text, sizeof(text)) == 10 && std::string(text) == "[::1]:7410");
+    char small[8];
+    CHECK(loc1.to_chars(small, sizeof(small)) == 0 && small[0] == '\0');
+    CHECK(Locator().to_chars(text, sizeof(text)) == 0);
+    CHECK(Locator("255.255.255.255", 0).get_ipv4_string() == "255.255.255.255");
+    std::cout << "格式化 ✅" << std::endl;
+
+    // 测试8: 哈希
+    std::unordered_set<size_t> hashes;
+    for(uint32_t i = 0; i < 1000; ++i){
+        Locator loc("10.0.0.1", 7400 + i);
+        hashes.insert(std::hash<Locator>{}(loc) & 0xFFFF);
+    }
+    CHECK(hashes.size() > 950);
+    CHECK(std::hash<Locator>{}(Locator("10.0.0.1", 7400)) == std::hash<Locator>{}(Locator("10.0.0.1", 7400)));
+    std::cout << "哈希 ✅" << std::endl;
+
     std::cout << "\n所有测试通过！✅" << std::endl;
     return 0;
 }
\ No newline at end of file
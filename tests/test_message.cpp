@@ -0,0 +1,200 @@
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace tinydds::rtps;
+
+int main() {
+    std::cout << "=== RTPS 消息 测试 ===" << std::endl;
+
+    GuidPrefix prefix;
+    for (size_t i = 0; i < prefix.value.size(); ++i) prefix.value[i] = static_cast<uint8_t>(i + 1);
+    EntityId reader(0x00, 0x00, 0x12, 0x04);
+    EntityId writer(0x00, 0x00, 0x12, 0x03);
+
+    std::vector<std::vector<uint8_t>> sent;
+    MessageBuilder builder(prefix, [&](ConstByteSpan message) {
+        sent.emplace_back(message.begin(), message.end());
+    }, 1472);
+
+    // 测试1: 多个小样本合并进同一个数据报，超过 MTU 时自动 flush
+    const int kSamples = 100;
+    for (int i = 0; i < kSamples; ++i) {
+        CdrSerializer payload;
+        payload.serialize_encapsulation();
+        payload.serialize_int32(i);
+        payload.serialize_string("hello"); // 负载长度不是 4 的倍数，需要补齐
+        CHECK(builder.add_data(reader, writer, SequenceNumber(i + 1), payload.buffer()));
+    }
+    uint32_t bitmap[2] = {0xA0000000u, 0x00000001u};
+    CHECK(builder.add_heartbeat(reader, writer, SequenceNumber(1), SequenceNumber(kSamples), 7, true));
+    CHECK(builder.add_acknack(reader, writer, SequenceNumber(5), 40, bitmap, 3));
+    CHECK(builder.add_gap(reader, writer, SequenceNumber(2), SequenceNumber(4), 33, bitmap));
+    builder.flush();
+    CHECK(builder.pending_submessages() == 0);
+    CHECK(builder.submessages_sent() == kSamples + 3);
+    std::cout << kSamples + 3 << " 个子消息合并成 " << sent.size() << " 个数据报" << std::endl;
+    CHECK(sent.size() < 10);
+    for (const auto& message : sent) CHECK(message.size() <= 1472);
+
+    // 测试2: 解析，按顺序取回所有子消息
+    int next_sample = 0;
+    int heartbeats = 0, acknacks = 0, gaps = 0;
+    for (const auto& message : sent) {
+        MessageParser parser(message);
+        CHECK(parser.valid());
+        CHECK(parser.header().guid_prefix == prefix);
+        SubmessageView sub;
+        while (parser.next(sub)) {
+            if (sub.id == SubmessageId::DATA) {
+                DataSubmessage data;
+                CHECK(parse_data(sub, data));
+                CHECK(data.reader_id == reader && data.writer_id == writer);
+                CHECK(data.writer_sn == SequenceNumber(next_sample + 1));
+                // 末尾补了 2 个字节对齐，填充数记在 options 里，解析时去掉
+                CHECK(data.serialized_payload.size() == ENCAPSULATION_HEADER_SIZE + 4 + 4 + 6);
+                CHECK((data.serialized_payload[3] & ENCAPSULATION_OPTIONS_PADDING_MASK) == 2);
+                // 负载是指向原消息的视图
+                CHECK(data.serialized_payload.data() >= message.data() &&
+                       data.serialized_payload.end() <= message.data() + message.size());
+                bool ok = decode_cdr_payload(data.serialized_payload, [&](auto& d) {
+                    int32_t value;
+                    std::string_view text;
+                    return d.deserialize_int32(value) && value == next_sample &&
+                           d.deserialize_string_view(text) && text == "hello";
+                });
+                CHECK(ok);
+                ++next_sample;
+            } else if (sub.id == SubmessageId::HEARTBEAT) {
+                HeartbeatSubmessage hb;
+                CHECK(parse_heartbeat(sub, hb));
+                CHECK(hb.first_sn == SequenceNumber(1) && hb.last_sn == SequenceNumber(kSamples));
+                CHECK(hb.count == 7 && hb.final_flag && !hb.liveliness_flag);
+                ++heartbeats;
+            } else if (sub.id == SubmessageId::ACKNACK) {
+                AckNackSubmessage an;
+                CHECK(parse_acknack(sub, an));
+                CHECK(an.reader_sn_state.base == SequenceNumber(5) && an.reader_sn_state.num_bits == 40);
+                CHECK(an.reader_sn_state.contains(SequenceNumber(5)));
+                CHECK(!an.reader_sn_state.contains(SequenceNumber(6)));
+                CHECK(an.reader_sn_state.contains(SequenceNumber(7)));
+                CHECK(an.reader_sn_state.contains(SequenceNumber(5 + 63)) == false);
+                CHECK(an.count == 3);
+                ++acknacks;
+            } else if (sub.id == SubmessageId::GAP) {
+                GapSubmessage gap;
+                CHECK(parse_gap(sub, gap));
+                CHECK(gap.gap_start == SequenceNumber(2) && gap.gap_list.base == SequenceNumber(4));
+                CHECK(gap.gap_list.num_bits == 33 && gap.gap_list.bitmap[1] == 1u);
+                ++gaps;
+            }
+        }
+        CHECK(!parser.malformed());
+    }
+    CHECK(next_sample == kSamples && heartbeats == 1 && acknacks == 1 && gaps == 1);
+    std::cout << "解析所有子消息 ✅" << std::endl;
+
+    // 测试3: 按时间 flush
+    sent.clear();
+    MessageBuilder timed(prefix, [&](ConstByteSpan message) {
+        sent.emplace_back(message.begin(), message.end());
+    }, 1472, std::chrono::microseconds(100));
+    CHECK(timed.add_heartbeat(reader, writer, SequenceNumber(1), SequenceNumber(1), 1));
+    auto now = MessageBuilder::Clock::now();
+    CHECK(!timed.flush_if_due(now - std::chrono::seconds(1)));
+    CHECK(timed.flush_if_due(now + std::chrono::milliseconds(1)));
+    CHECK(sent.size() == 1);
+    std::cout << "按时间 flush ✅" << std::endl;
+
+    // 测试4: 单个子消息超过 MTU 时拒绝（需要 DATA_FRAG）
+    std::vector<uint8_t> big(2000, 0x55);
+    CHECK(!timed.add_data(reader, writer, SequenceNumber(2), big));
+    std::cout << "超过 MTU 的样本被拒绝 ✅" << std::endl;
+
+    // 测试5: 大端的子消息（其它实现发出的）
+    CdrSerializerBE be;
+    for (char c : std::string("RTPS")) be.serialize_byte(static_cast<uint8_t>(c));
+    be.serialize_byte(2); be.serialize_byte(1); be.serialize_byte(0x01); be.serialize_byte(0x0F);
+    for (uint8_t b : prefix.value) be.serialize_byte(b);
+    be.serialize_byte(static_cast<uint8_t>(SubmessageId::HEARTBEAT));
+    be.serialize_byte(0x00);        // E = 0：大端
+    be.serialize_uint16(28);
+    for (uint8_t b : reader.value) be.serialize_byte(b);
+    for (uint8_t b : writer.value) be.serialize_byte(b);
+    be.serialize_int32(0); be.serialize_uint32(10);
+    be.serialize_int32(1); be.serialize_uint32(20);
+    be.serialize_uint32(99);
+    MessageParser be_parser(be.buffer());
+    SubmessageView sub;
+    CHECK(be_parser.valid() && be_parser.next(sub));
+    HeartbeatSubmessage hb;
+    CHECK(parse_heartbeat(sub, hb));
+    CHECK(hb.first_sn == SequenceNumber(10) && hb.last_sn == SequenceNumber(1, 20) && hb.count == 99);
+    CHECK(!be_parser.next(sub));
+
+    // 长度字段越界
+    std::vector<uint8_t> broken(be.buffer().begin(), be.buffer().end());
+    broken[23] = 200;
+    MessageParser broken_parser(broken);
+    CHECK(!broken_parser.next(sub) && broken_parser.malformed());
+    std::cout << "大端子消息 / 越界检测 ✅" << std::endl;
+
+    // 测试6: INFO_TS：同一个时间戳只写一次，不带时间戳的 DATA 前面先使之无效
+    sent.clear();
+    const Timestamp stamp = Timestamp::from_nanoseconds(1700000000123456789LL);
+    CHECK(stamp.valid() && stamp.to_nanoseconds() / 1000 == 1700000000123456LL);
+    const std::vector<uint8_t> tiny = {0x00, 0x01, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00};
+    CHECK(builder.add_data(reader, writer, SequenceNumber(1), tiny, stamp));
+    CHECK(builder.add_data(reader, writer, SequenceNumber(2), tiny, stamp));
+    CHECK(builder.add_data(reader, writer, SequenceNumber(3), tiny));
+    builder.flush();
+    CHECK(sent.size() == 1);
+    std::vector<Timestamp> stamps; // 每个 DATA 生效的时间戳
+    size_t info_ts_count = 0;
+    MessageParser ts_parser(sent[0]);
+    Timestamp current;
+    while (ts_parser.next(sub)) {
+        if (sub.id == SubmessageId::INFO_TS) {
+            InfoTimestampSubmessage info;
+            CHECK(parse_info_ts(sub, info));
+            current = info.timestamp;
+            ++info_ts_count;
+        } else if (sub.id == SubmessageId::DATA) {
+            stamps.push_back(current);
+        }
+    }
+    CHECK(info_ts_count == 2);
+    CHECK(stamps.size() == 3 && stamps[0] == stamp && stamps[1] == stamp && !stamps[2].valid());
+
+    // INVALIDATE 的 INFO_TS 放不下、DATA 刚好放得下时换一条新消息，DATA 不继承前一个样本的时间戳
+    sent.clear();
+    MessageBuilder small(prefix, [&](ConstByteSpan message) {
+        sent.emplace_back(message.begin(), message.end());
+    }, 96);
+    CHECK(small.add_data(reader, writer, SequenceNumber(1), tiny, stamp)); // 20 + 12 + 32，还剩 32
+    CHECK(small.remaining() == 32);
+    CHECK(small.add_data(reader, writer, SequenceNumber(2), tiny));        // DATA 正好 32
+    small.flush();
+    CHECK(sent.size() == 2);
+    stamps.clear();
+    for (const auto& message : sent) {
+        MessageParser parser(message);
+        Timestamp message_stamp;
+        while (parser.next(sub)) {
+            if (sub.id == SubmessageId::INFO_TS) {
+                InfoTimestampSubmessage info;
+                CHECK(parse_info_ts(sub, info));
+                message_stamp = info.timestamp;
+            } else if (sub.id == SubmessageId::DATA) {
+                stamps.push_back(message_stamp);
+            }
+        }
+    }
+    CHECK(stamps.size() == 2 && stamps[0] == stamp && !stamps[1].valid());
+    std::cout << "INFO_TS 源时间戳 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
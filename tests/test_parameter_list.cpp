@@ -0,0 +1,167 @@
+#include "tinydds/rtps/parameter_list.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tinydds::rtps;
+using namespace tinydds::rtps::ParameterIdValues;
+
+constexpr ParameterId PID_UNKNOWN = 0x0f00;
+constexpr ParameterId PID_UNKNOWN_VENDOR = 0x8001;
+
+// 写一个参数列表：topic 名、一个不认识的大参数、一个 uint64（检查参数值内部的对齐）
+template<typename Serializer>
+static void write_sample_list(Serializer& serializer){
+    serializer.serialize_encapsulation(true);
+    ParameterListWriter<Serializer> writer(serializer);
+    writer.add(PID_TOPIC_NAME, [](Serializer& s){ s.serialize_string("Square"); });
+    std::vector<uint8_t> opaque(1000, 0xAB);
+    writer.add_bytes(PID_UNKNOWN, opaque);
+    writer.begin(PID_STATUS_INFO);
+    serializer.serialize_uint32(7);
+    serializer.serialize_uint64(0x1122334455667788ULL); // 相对参数值开头对齐到 8
+    CHECK(writer.end());
+    CHECK(writer.finish());
+}
+
+template<typename Serializer>
+static void check_roundtrip(){
+    Serializer serializer;
+    write_sample_list(serializer);
+    ConstByteSpan payload = serializer.buffer();
+
+    std::vector<ParameterId> seen;
+    bool ok = decode_parameter_list(payload, [&](auto& reader){
+        return reader.for_each([&](const Parameter& parameter){
+            seen.push_back(parameter.id);
+            CHECK(parameter.value.size() % PARAMETER_ALIGNMENT == 0);
+            auto d = reader.value_deserializer(parameter);
+            if(parameter.id == PID_TOPIC_NAME){
+                std::string_view name;
+                CHECK(d.deserialize_string_view(name) && name == "Square");
+                // 视图直接指向输入缓冲区
+                CHECK(reinterpret_cast<const uint8_t*>(name.data()) >= payload.data() &&
+                       reinterpret_cast<const uint8_t*>(name.data()) < payload.data() + payload.size());
+            }else if(parameter.id == PID_STATUS_INFO){
+                uint32_t a;
+                uint64_t b;
+                CHECK(d.deserialize_uint32(a) && d.deserialize_uint64(b));
+                CHECK(a == 7 && b == 0x1122334455667788ULL);
+                CHECK(parameter.value.size() == 16);
+            }else{
+                CHECK(parameter.id == PID_UNKNOWN && parameter.value.size() == 1000);
+            }
+            return true;
+        });
+    });
+    CHECK(ok);
+    CHECK((seen == std::vector<ParameterId>{PID_TOPIC_NAME, PID_UNKNOWN, PID_STATUS_INFO}));
+}
+
+int main() {
+    std::cout << "=== 参数列表测试 ===" << std::endl;
+
+    // 测试1: 两种字节序的写入/读取，长度回填和补齐
+    check_roundtrip<CdrSerializerLE>();
+    check_roundtrip<CdrSerializerBE>();
+    {
+        CdrSerializerBE serializer;
+        serializer.serialize_encapsulation(true);
+        ParameterListWriter<CdrSerializerBE> writer(serializer);
+        writer.add(PID_TOPIC_NAME, [](CdrSerializerBE& s){ s.serialize_string("ab"); }); // 4 + 3 -> 补齐到 8
+        writer.finish();
+        const uint8_t expected[] = {0x00, 0x02, 0x00, 0x00,
+                                    0x00, 0x05, 0x00, 0x08,
+                                    0x00, 0x00, 0x00, 0x03, 'a', 'b', 0x00, 0x00,
+                                    0x00, 0x01, 0x00, 0x00};
+        CHECK(serializer.size() == sizeof(expected));
+        CHECK(std::memcmp(serializer.data(), expected, sizeof(expected)) == 0);
+    }
+    std::cout << "写入/读取 ✅" << std::endl;
+
+    // 测试2: 跳过 PID_PAD，厂商自定义参数照常返回
+    {
+        CdrSerializerLE serializer;
+        serializer.serialize_encapsulation(true);
+        ParameterListWriter<CdrSerializerLE> writer(serializer);
+        writer.add_bytes(PID_PAD, ConstByteSpan());
+        writer.add(PID_UNKNOWN_VENDOR, [](CdrSerializerLE& s){ s.serialize_uint32(1); });
+        writer.add(PID_DURABILITY, [](CdrSerializerLE& s){ s.serialize_uint32(1); });
+        writer.finish();
+
+        ParameterListReaderLE reader(serializer.buffer().subspan(ENCAPSULATION_HEADER_SIZE));
+        Parameter parameter;
+        CHECK(reader.next(parameter) && parameter.id == PID_UNKNOWN_VENDOR && parameter.vendor_specific());
+        CHECK(reader.next(parameter) && parameter.id == PID_DURABILITY && !parameter.must_understand());
+        CHECK(!reader.next(parameter));
+        CHECK(reader.finished() && !reader.malformed());
+        CHECK(reader.position() == serializer.size() - ENCAPSULATION_HEADER_SIZE);
+    }
+    std::cout << "跳过未知参数 ✅" << std::endl;
+
+    // 测试3: 截断、长度越界、没有 SENTINEL、不是参数列表
+    {
+        CdrSerializerLE serializer;
+        write_sample_list(serializer);
+        auto drain = [](auto& reader){ return reader.skip_to_end(); };
+        CHECK(decode_parameter_list(serializer.buffer(), drain));
+        ConstByteSpan no_sentinel(serializer.data(), serializer.size() - PARAMETER_HEADER_SIZE);
+        CHECK(!decode_parameter_list(no_sentinel, drain));
+        ConstByteSpan truncated(serializer.data(), 40);
+        CHECK(!decode_parameter_list(truncated, drain));
+        ParameterListReaderLE reader(truncated.subspan(ENCAPSULATION_HEADER_SIZE));
+        CHECK(!reader.skip_to_end() && reader.malformed());
+
+        CdrSerializerLE plain;
+        plain.serialize_encapsulation();
+        plain.serialize_uint32(1);
+        bool called = false;
+        CHECK(!decode_parameter_list(plain.buffer(), [&](auto&){ called = true; return true; }));
+        CHECK(!called);
+    }
+    std::cout << "异常数据 ✅" << std::endl;
+
+    // 测试4: 外部缓冲区写满时 good() 为 false
+    {
+        uint8_t storage[16];
+        CdrSerializerLE serializer{ByteSpan(storage, sizeof(storage))};
+        serializer.serialize_encapsulation(true);
+        ParameterListWriter<CdrSerializerLE> writer(serializer);
+        writer.add(PID_TOPIC_NAME, [](CdrSerializerLE& s){ s.serialize_string("a long topic name"); });
+        CHECK(!writer.finish());
+    }
+    std::cout << "缓冲区写满 ✅" << std::endl;
+
+    // 测试5: DATA 子消息的 inline QoS
+    {
+        // MessageBuilder 按本机字节序写子消息，inline QoS 也要用本机字节序
+        CdrSerializer qos;
+        ParameterListWriter<CdrSerializer> writer(qos);
+        writer.add(PID_STATUS_INFO, [](CdrSerializer& s){ s.serialize_uint32(3); });
+        const uint8_t opaque[] = {9, 8, 7, 6, 5};
+        writer.add_bytes(PID_UNKNOWN, ConstByteSpan(opaque, sizeof(opaque)));
+        writer.finish();
+
+        const uint8_t payload_bytes[] = {0x00, 0x01, 0x00, 0x00, 1, 2, 3, 4};
+        std::vector<uint8_t> message;
+        MessageBuilder builder(GuidPrefix(), [&](ConstByteSpan m){ message.assign(m.begin(), m.end()); });
+        CHECK(builder.add_data(EntityId(0, 0, 1, 0x07), EntityId(0, 0, 1, 0x02), SequenceNumber(1),
+                                ConstByteSpan(payload_bytes, sizeof(payload_bytes)), qos.buffer()));
+        builder.flush();
+        MessageParser parser(message);
+        SubmessageView submessage;
+        DataSubmessage data;
+        CHECK(parser.next(submessage) && parse_data(submessage, data));
+        CHECK(data.inline_qos.size() == qos.size());
+        CHECK(data.serialized_payload.size() == sizeof(payload_bytes));
+        CHECK(std::memcmp(data.serialized_payload.data(), payload_bytes, sizeof(payload_bytes)) == 0);
+    }
+    std::cout << "inline QoS ✅" << std::endl;
+
+    std::cout << "所有参数列表测试通过 ✅" << std::endl;
+    return 0;
+}
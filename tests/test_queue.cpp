@@ -0,0 +1,184 @@
+#include "tinydds/rtps/spsc_queue.hpp"
+#include "tinydds/rtps/mpsc_queue.hpp"
+#include "tinydds/rtps/mpmc_queue.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace tinydds::rtps;
+
+// 统计构造/析构次数，检查队列里剩下的元素会被析构
+struct Counted{
+    static int alive;
+    int value = 0;
+    Counted(int v) : value(v) { ++alive; }
+    Counted(const Counted& other) : value(other.value) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() { --alive; }
+};
+int Counted::alive = 0;
+
+template<typename Queue>
+static void check_basic(){
+    Queue queue(6); // 向上取 8
+    CHECK(queue.capacity() == 8 && queue.empty());
+    int out = 0;
+    CHECK(!queue.take(out));
+    // 多绕几圈，检查 FIFO 和满/空判断
+    int next_push = 0;
+    int next_take = 0;
+    for(int round = 0; round < 5; ++round){
+        while(queue.push(next_push)) ++next_push;
+        CHECK(queue.size() == 8);
+        for(int i = 0; i < 5; ++i){
+            CHECK(queue.take(out) && out == next_take++);
+        }
+    }
+    size_t batch = queue.take_batch([&](int& value){ CHECK(value == next_take++); }, 100);
+    CHECK(batch == 3 && queue.empty());
+}
+
+int main() {
+    std::cout << "=== 无锁队列测试 ===" << std::endl;
+
+    // 测试1: 单线程的基本行为
+    check_basic<SpscQueue<int>>();
+    check_basic<MpscQueue<int>>();
+    check_basic<SpscQueue<int, false>>();
+    check_basic<MpscQueue<int, false>>();
+    std::cout << "FIFO/满/空 ✅" << std::endl;
+
+    // 测试2: 只能移动的类型、剩余元素在析构时释放
+    {
+        SpscQueue<std::unique_ptr<int>> spsc(4);
+        CHECK(spsc.push(std::make_unique<int>(1)));
+        std::unique_ptr<int> ptr;
+        CHECK(spsc.take(ptr) && *ptr == 1);
+        MpscQueue<std::unique_ptr<int>> mpsc(4);
+        CHECK(mpsc.emplace(new int(2)));
+        CHECK(mpsc.take(ptr) && *ptr == 2);
+    }
+    {
+        SpscQueue<Counted> spsc(4);
+        MpscQueue<Counted> mpsc(4);
+        for(int i = 0; i < 3; ++i){
+            spsc.emplace(i);
+            mpsc.emplace(i);
+        }
+        Counted out(0);
+        CHECK(spsc.take(out) && mpsc.take(out));
+        CHECK(Counted::alive == 5);
+    }
+    CHECK(Counted::alive == 0);
+    std::cout << "元素生命周期 ✅" << std::endl;
+
+    // 容量 1：格子序号算法至少需要 2 个格子，不能覆盖还没取走的元素
+    {
+        MpscQueue<int> mpsc(1);
+        CHECK(mpsc.capacity() == 2);
+        int out = 0;
+        for(int round = 0; round < 4; ++round){
+            CHECK(mpsc.push(round * 10));
+            CHECK(mpsc.push(round * 10 + 1));
+            CHECK(!mpsc.push(-1));
+            CHECK(mpsc.take(out) && out == round * 10);
+            CHECK(mpsc.take(out) && out == round * 10 + 1);
+            CHECK(!mpsc.take(out));
+        }
+    }
+    {
+        MpmcQueue<int> mpmc(1);
+        CHECK(mpmc.capacity() == 2);
+        int out = 0;
+        for(int round = 0; round < 4; ++round){
+            CHECK(mpmc.push(round * 10));
+            CHECK(mpmc.push(round * 10 + 1));
+            CHECK(!mpmc.push(-1));
+            CHECK(mpmc.take(out) && out == round * 10);
+            CHECK(mpmc.take(out) && out == round * 10 + 1);
+            CHECK(!mpmc.take(out));
+        }
+    }
+    std::cout << "最小容量 ✅" << std::endl;
+
+    // 测试3: SPSC 两个线程，所有元素按顺序到达
+    {
+        const int kCount = 200000;
+        SpscQueue<int, false> queue(1024);
+        std::thread producer([&]{
+            for(int i = 0; i < kCount; ++i){
+                while(!queue.push(i)) std::this_thread::yield();
+            }
+        });
+        int expected = 0;
+        while(expected < kCount){
+            if(queue.take_batch([&](int& value){ CHECK(value == expected); ++expected; }, 64) == 0){
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        CHECK(queue.empty());
+    }
+    std::cout << "SPSC 并发 ✅" << std::endl;
+
+    // 测试4: MPSC 四个生产者，每个生产者自己的元素保持顺序，总数不丢不重
+    {
+        const int kProducers = 4;
+        const int kPerProducer = 50000;
+        MpscQueue<uint64_t> queue(1024);
+        std::vector<std::thread> producers;
+        for(int p = 0; p < kProducers; ++p){
+            producers.emplace_back([&, p]{
+                for(int i = 0; i < kPerProducer; ++i){
+                    uint64_t value = (static_cast<uint64_t>(p) << 32) | static_cast<uint64_t>(i);
+                    while(!queue.push(value)) std::this_thread::yield();
+                }
+            });
+        }
+        std::vector<int64_t> last(kProducers, -1);
+        int received = 0;
+        uint64_t value;
+        while(received < kProducers * kPerProducer){
+            CHECK(queue.wait_take(value, 1000));
+            int p = static_cast<int>(value >> 32);
+            int64_t i = static_cast<int64_t>(value & 0xFFFFFFFF);
+            CHECK(i == last[p] + 1);
+            last[p] = i;
+            ++received;
+        }
+        for(std::thread& t : producers) t.join();
+        CHECK(queue.empty());
+    }
+    std::cout << "MPSC 并发 ✅" << std::endl;
+
+    // 测试5: 阻塞等待：超时返回 false，生产者 push 后立即唤醒
+    {
+        SpscQueue<int> queue(8);
+        int out = 0;
+        auto start = std::chrono::steady_clock::now();
+        CHECK(!queue.wait_take(out, 20));
+        CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+        std::thread producer([&]{
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            queue.push(42);
+        });
+        CHECK(queue.wait_take(out, 5000) && out == 42);
+        producer.join();
+
+        MpscQueue<int> mpsc(8);
+        std::thread mpsc_producer([&]{
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            mpsc.push(7);
+        });
+        CHECK(mpsc.wait_take(out) && out == 7);
+        mpsc_producer.join();
+    }
+    std::cout << "阻塞等待 ✅" << std::endl;
+
+    std::cout << "所有无锁队列测试通过 ✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,372 @@
+#include "tinydds/dds/data_reader.hpp"
+#include "tinydds/dds/data_writer.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "tinydds/rtps/sample_slab.hpp"
+#include "test_check.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinydds::rtps;
+using tinydds::dds::DataReader;
+using tinydds::dds::DataWriter;
+
+// 内存布局就是 CDR 布局
+struct Pose{
+    double x;
+    double y;
+    double z;
+    uint32_t id;
+    uint32_t flags;
+};
+
+// 有界，但 bool 不是平坦类型
+struct Status{
+    uint32_t id;
+    bool valid;
+    std::array<float, 4> levels;
+};
+
+// 变长
+struct Blob{
+    uint32_t id;
+    std::vector<uint8_t> data;
+    std::string name;
+};
+
+TINYDDS_CDR_TYPE(Pose, x, y, z, id, flags);
+TINYDDS_CDR_TYPE(Status, id, valid, levels);
+TINYDDS_CDR_TYPE(Blob, id, data, name);
+
+static_assert(is_cdr_memcpy_layout<Pose>(), "Pose 的内存布局就是 CDR 布局");
+static_assert(!is_cdr_memcpy_layout<Status>() && is_cdr_bounded<Status>(), "Status 有界但需要编码");
+static_assert(!is_cdr_memcpy_layout<Blob>() && !is_cdr_bounded<Blob>(), "Blob 是变长类型");
+static_assert(LoanedSample<Pose>::serializes_in_place() && LoanedSample<Status>::serializes_in_place() &&
+              !LoanedSample<Blob>::serializes_in_place(), "有界类型就地编码");
+
+namespace {
+
+// 全局 operator new 的调用次数，用来检查稳定运行时不分配内存
+std::atomic<size_t> g_allocations{0};
+
+} // namespace
+
+void* operator new(size_t size){
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+bool same_bytes(ConstByteSpan a, const PooledBuffer& b){
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+// 把一个数据报里的 DATA 都交给 reader
+template<typename T>
+size_t deliver_message(ConstByteSpan message, DataReader<T>& reader){
+    size_t delivered = 0;
+    MessageParser parser(message);
+    SubmessageView sub;
+    while(parser.next(sub)){
+        if(sub.id != SubmessageId::DATA) continue;
+        DataSubmessage data;
+        CHECK(parse_data(sub, data));
+        if(reader.on_data(data.serialized_payload)) ++delivered;
+    }
+    return delivered;
+}
+
+// 把 MessageBuilder 发出的数据报里的 DATA 都交给 reader
+template<typename T>
+size_t deliver_all(const std::vector<std::vector<uint8_t>>& sent, DataReader<T>& reader){
+    size_t delivered = 0;
+    for(const auto& message : sent) delivered += deliver_message(message, reader);
+    return delivered;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== 样本借出测试 ===" << std::endl;
+
+    // 测试1: slab 的借出、归还和上限
+    {
+        SampleSlab<Pose> slab(4, 6);
+        std::vector<LoanedSample<Pose>> loans;
+        for(int i = 0; i < 6; ++i){
+            loans.push_back(slab.loan());
+            CHECK(loans.back());
+        }
+        CHECK(slab.capacity() == 6 && slab.available() == 0 && slab.slabs() == 2);
+        CHECK(!slab.loan()); // 达到上限
+
+        Pose* address = loans.back().get();
+        loans.pop_back();
+        CHECK(slab.available() == 1);
+        LoanedSample<Pose> again = slab.loan();
+        CHECK(again.get() == address); // 刚归还的样本马上被复用
+
+        LoanedSample<Pose> moved = std::move(again);
+        CHECK(!again && moved);
+        moved.reset();
+        loans.clear();
+        CHECK(slab.available() == 6);
+
+        // 预热之后反复借还，不再申请内存
+        for(int i = 0; i < 10000; ++i){
+            LoanedSample<Pose> a = slab.loan();
+            LoanedSample<Pose> b = slab.loan();
+            CHECK(a && b);
+        }
+        CHECK(slab.slabs() == 2 && slab.available() == 6);
+
+        SampleSlab<Pose> preallocated(8, 0, 20);
+        CHECK(preallocated.capacity() == 24 && preallocated.slabs() == 3);
+    }
+    std::cout << "借出与归还 ✅" << std::endl;
+
+    // 测试2: 就地编码
+    {
+        SampleSlab<Pose> poses;
+        LoanedSample<Pose> pose = poses.loan();
+        *pose = Pose{1.5, -2.25, 3.0, 42, 0x0F};
+        ConstByteSpan bytes = pose.serialize();
+        // 不编码：序列化数据就是槽位里封装头加上样本本身
+        CHECK(bytes.data() + ENCAPSULATION_HEADER_SIZE == reinterpret_cast<const uint8_t*>(pose.get()));
+        CHECK(bytes.size() == ENCAPSULATION_HEADER_SIZE + get_serialized_size<Pose>());
+        CHECK(same_bytes(bytes, encode_cdr_payload(*pose)));
+        pose->id = 43; // 改样本就是改序列化数据
+        CHECK(same_bytes(pose.serialize(), encode_cdr_payload(*pose)));
+
+        SampleSlab<Status> statuses;
+        LoanedSample<Status> status = statuses.loan();
+        status->id = 7;
+        status->valid = true;
+        status->levels = {0.5f, 1.0f, 1.5f, 2.0f};
+        ConstByteSpan encoded = status.serialize();
+        CHECK(same_bytes(encoded, encode_cdr_payload(*status)));
+
+        SampleSlab<Blob> blobs;
+        LoanedSample<Blob> blob = blobs.loan();
+        CHECK(blob.serialize().empty());
+    }
+    std::cout << "就地编码 ✅" << std::endl;
+
+    // 测试3: 写端借出写入，读端借出取走
+    {
+        GuidPrefix prefix;
+        for(size_t i = 0; i < prefix.value.size(); ++i) prefix.value[i] = static_cast<uint8_t>(i + 1);
+        const EntityId writer_id(0x00, 0x00, 0x20, EntityKind::USER_WRITER_NO_KEY);
+        const EntityId reader_id(0x00, 0x00, 0x21, EntityKind::USER_READER_NO_KEY);
+        std::vector<std::vector<uint8_t>> sent;
+        MessageBuilder builder(prefix, [&](ConstByteSpan message){
+            sent.emplace_back(message.begin(), message.end());
+        }, 1472);
+
+        SampleSlab<Pose> writer_slab(16);
+        SampleSlab<Pose> reader_slab(16);
+        HistoryQos qos;
+        qos.depth = 8;
+        DataWriter<Pose> writer(builder, writer_id, reader_id, writer_slab, qos);
+        DataReader<Pose> reader(reader_slab, 32);
+
+        for(uint32_t i = 0; i < 20; ++i){
+            LoanedSample<Pose> sample = writer.loan_sample();
+            CHECK(sample);
+            *sample = Pose{i * 1.0, i * 2.0, i * 3.0, i, 0};
+            CHECK(writer.write(std::move(sample)));
+            CHECK(!sample);
+        }
+        CHECK(writer.write(Pose{100.0, 0.0, 0.0, 100, 1})); // 按值写入
+        builder.flush();
+        CHECK(writer_slab.available() == writer_slab.capacity()); // 写出后都归还了
+        CHECK(writer.history().size() == 8);
+
+        CHECK(deliver_all(sent, reader) == 21);
+        CHECK(reader.available() == 21);
+        for(uint32_t i = 0; i < 20; ++i){
+            LoanedSample<Pose> sample = reader.take();
+            CHECK(sample && sample->id == i && sample->z == i * 3.0);
+        }
+        {
+            LoanedSample<Pose> last = reader.take();
+            CHECK(last && last->id == 100 && last->flags == 1);
+            CHECK(reader_slab.available() == reader_slab.capacity() - 1);
+        }
+        CHECK(!reader.take());
+        CHECK(reader_slab.available() == reader_slab.capacity());
+    }
+    std::cout << "写端/读端借出 ✅" << std::endl;
+
+    // 测试4: 变长类型复用样本里的容量；读端队列满时丢弃
+    {
+        GuidPrefix prefix;
+        const EntityId writer_id(0x00, 0x00, 0x30, EntityKind::USER_WRITER_NO_KEY);
+        const EntityId reader_id(0x00, 0x00, 0x31, EntityKind::USER_READER_NO_KEY);
+        std::vector<std::vector<uint8_t>> sent;
+        MessageBuilder builder(prefix, [&](ConstByteSpan message){
+            sent.emplace_back(message.begin(), message.end());
+        }, 65000);
+
+        SampleSlab<Blob> writer_slab(2);
+        SampleSlab<Blob> reader_slab(2);
+        DataWriter<Blob> writer(builder, writer_id, reader_id, writer_slab);
+        DataReader<Blob> reader(reader_slab, 2);
+        StatisticsRegistry registry;
+        GUID reader_guid;
+        reader_guid.entityId = reader_id;
+        reader.set_statistics(registry.register_entity(reader_guid));
+
+        {
+            LoanedSample<Blob> blob = writer.loan_sample();
+            blob->data.assign(1000, 0x11);
+        }
+        LoanedSample<Blob> blob = writer.loan_sample();
+        CHECK(blob->data.capacity() >= 1000); // 同一个样本，容量还在
+        blob->id = 1;
+        blob->data.assign(500, 0x22);
+        blob->name = "first";
+        CHECK(writer.write(std::move(blob)));
+        for(uint32_t id = 2; id <= 3; ++id){
+            LoanedSample<Blob> next = writer.loan_sample();
+            next->id = id;
+            next->name = "next";
+            CHECK(writer.write(std::move(next)));
+        }
+        // 超过 MTU 的样本写入失败，不占序列号，也不进历史缓存
+        SequenceNumber next_sequence_number = writer.history().next_sequence_number();
+        LoanedSample<Blob> huge = writer.loan_sample();
+        huge->id = 99;
+        huge->data.assign(70000, 0x33);
+        CHECK(!writer.write(std::move(huge)));
+        CHECK(writer.history().next_sequence_number() == next_sequence_number);
+        CHECK(writer.history().get_change(next_sequence_number) == nullptr);
+        builder.flush();
+
+        CHECK(deliver_all(sent, reader) == 2); // 第三个样本时队列已满
+        LoanedSample<Blob> first = reader.take();
+        CHECK(first->id == 1 && first->data.size() == 500 && first->data[0] == 0x22 && first->name == "first");
+        LoanedSample<Blob> second = reader.take();
+        CHECK(second->id == 2 && second->name == "next");
+
+        EntityStatisticsSnapshot snapshot;
+        CHECK(registry.snapshot(reader_guid, snapshot));
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(snapshot.counters.samples_received == 2 && snapshot.counters.samples_dropped == 1);
+        CHECK(snapshot.counters.queue_depth == 0 && snapshot.counters.queue_depth_max == 2);
+#endif
+        // 解码失败的数据不进队列
+        std::vector<uint8_t> broken = {0x00, 0x01, 0x00, 0x00, 0x01};
+        CHECK(!reader.on_data(broken));
+        CHECK(reader.available() == 0);
+    }
+    std::cout << "变长类型与丢弃 ✅" << std::endl;
+
+    // 测试5: 预热之后，写端借出/写出和读端解码/取走都不再分配内存
+    {
+        GuidPrefix prefix;
+        const EntityId writer_id(0x00, 0x00, 0x40, EntityKind::USER_WRITER_NO_KEY);
+        const EntityId reader_id(0x00, 0x00, 0x41, EntityKind::USER_READER_NO_KEY);
+        SampleSlab<Pose> pose_writer_slab(4);
+        SampleSlab<Pose> pose_reader_slab(4);
+        SampleSlab<Blob> blob_writer_slab(4);
+        SampleSlab<Blob> blob_reader_slab(4);
+        DataReader<Pose> pose_reader(pose_reader_slab, 8);
+        DataReader<Blob> blob_reader(blob_reader_slab, 8);
+        StatisticsRegistry registry;
+        GUID reader_guid;
+        reader_guid.entityId = reader_id;
+        pose_reader.set_statistics(registry.register_entity(reader_guid));
+        // 数据报直接交给读端，不经过会分配内存的容器
+        size_t delivered = 0;
+        MessageBuilder pose_builder(prefix, [&](ConstByteSpan message){
+            delivered += deliver_message(message, pose_reader);
+        }, 1472);
+        MessageBuilder blob_builder(prefix, [&](ConstByteSpan message){
+            delivered += deliver_message(message, blob_reader);
+        }, 1472);
+        DataWriter<Pose> pose_writer(pose_builder, writer_id, reader_id, pose_writer_slab);
+        DataWriter<Blob> blob_writer(blob_builder, writer_id, reader_id, blob_writer_slab);
+
+        auto round = [&](uint32_t i){
+            LoanedSample<Pose> pose = pose_writer.loan_sample();
+            *pose = Pose{i * 1.0, 0.0, 0.0, i, 0};
+            CHECK(pose_writer.write(std::move(pose)));
+            LoanedSample<Blob> blob = blob_writer.loan_sample();
+            blob->id = i;
+            blob->data.assign(64, static_cast<uint8_t>(i));
+            blob->name = "steady";
+            CHECK(blob_writer.write(std::move(blob)));
+            pose_builder.flush();
+            blob_builder.flush();
+            LoanedSample<Pose> pose_in = pose_reader.take();
+            LoanedSample<Blob> blob_in = blob_reader.take();
+            CHECK(pose_in && pose_in->id == i);
+            CHECK(blob_in && blob_in->id == i && blob_in->data.size() == 64 && blob_in->name == "steady");
+        };
+        for(uint32_t i = 0; i < 16; ++i) round(i); // 预热：slab 追加块、样本里的 vector / string 扩容
+        size_t before = g_allocations.load();
+        for(uint32_t i = 16; i < 10016; ++i) round(i);
+        CHECK(g_allocations.load() == before);
+        CHECK(delivered == 2 * 10016);
+        CHECK(pose_writer_slab.slabs() == 1 && pose_reader_slab.slabs() == 1);
+    }
+    std::cout << "稳定运行不分配内存 ✅" << std::endl;
+
+    // 测试6: 多个线程同时借还、多个接收线程同时投递给一个读端
+    {
+        SampleSlab<Pose> slab(8, 32);
+        DataReader<Pose> reader(slab, 16);
+        const uint32_t kPerThread = 20000;
+        const uint32_t kProducers = 3;
+        std::atomic<uint32_t> producers_done{0};
+        std::vector<std::thread> producers;
+        for(uint32_t t = 0; t < kProducers; ++t){
+            producers.emplace_back([&, t]{
+                CdrSerializer serializer;
+                for(uint32_t i = 0; i < kPerThread; ++i){
+                    // 借几个再还：空闲链表上的弹出和压入交错进行
+                    LoanedSample<Pose> a = slab.loan();
+                    LoanedSample<Pose> b = slab.loan();
+                    if(a) a->id = t;
+                    if(b) b->id = t;
+                    serializer.reset();
+                    serializer.serialize_encapsulation();
+                    serializer.serialize_type(Pose{0.0, 0.0, 0.0, t, i});
+                    while(!reader.on_data(serializer.buffer())) std::this_thread::yield(); // 队列满或者 slab 暂时用完
+                }
+                producers_done.fetch_add(1);
+            });
+        }
+        std::vector<uint32_t> next(kProducers, 0); // 每个生产者自己的样本保持顺序
+        uint32_t taken = 0;
+        while(taken < kPerThread * kProducers){
+            LoanedSample<Pose> sample = reader.take();
+            if(!sample){
+                std::this_thread::yield();
+                continue;
+            }
+            CHECK(sample->id < kProducers && sample->flags == next[sample->id]);
+            ++next[sample->id];
+            ++taken;
+        }
+        for(std::thread& producer : producers) producer.join();
+        CHECK(producers_done.load() == kProducers && !reader.take());
+        CHECK(slab.available() == slab.capacity() && slab.capacity() <= 32);
+    }
+    std::cout << "并发借还与投递 ✅" << std::endl;
+
+    std::cout << "所有样本借出测试通过 ✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "tinydds/transport/shm_transport.hpp"
+#include "tinydds/transport/transport_router.hpp"
+#include "tinydds/rtps/cdr.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace tinydds::rtps;
+using namespace tinydds::transport;
+
+int main() {
+    std::cout << "=== 共享内存传输 测试 ===" << std::endl;
+
+    ShmTransportConfig receiver_config;
+    receiver_config.port = 17411;
+    receiver_config.slot_count = 64;
+    receiver_config.slot_size = 4096;
+    ShmTransport receiver(receiver_config);
+    CHECK(receiver.open());
+
+    ShmTransportConfig sender_config;
+    sender_config.port = 17412;
+    ShmTransport sender(sender_config);
+
+    // 测试1: 借出槽位，CdrSerializer 直接写入共享内存
+    Locator destination = receiver.local_locator();
+    CHECK(destination.kind == LocatorKind::LOCATOR_KIND_SHM);
+    {
+        ShmLoan loan = sender.loan(destination);
+        CHECK(loan.valid());
+        CdrSerializer serializer(loan.buffer());
+        serializer.serialize_uint32(0xCAFEBABE);
+        serializer.serialize_string("shared memory");
+        CHECK(serializer.good() && serializer.data() == loan.buffer().data());
+        CHECK(sender.commit(loan, serializer.size()));
+        CHECK(!loan.valid());
+    }
+    CHECK(receiver.receive(100) == 1);
+    CdrDeserializer deserializer(receiver.received(0));
+    uint32_t magic;
+    std::string text;
+    CHECK(deserializer.deserialize_uint32(magic) && magic == 0xCAFEBABE);
+    CHECK(deserializer.deserialize_string(text) && text == "shared memory");
+    std::cout << "借出槽位 + 零拷贝写入 ✅" << std::endl;
+
+    // 测试2: 未提交的 loan 析构时归还槽位，槽位不会泄漏
+    for (int i = 0; i < 200; ++i) {
+        ShmLoan loan = sender.loan(destination);
+        CHECK(loan.valid());
+    }
+    CHECK(receiver.receive(0) == 0);
+    std::cout << "未提交的槽位自动归还 ✅" << std::endl;
+
+    // 测试3: 另一个线程连续发送，接收方按顺序收到全部样本
+    const uint32_t kSamples = 20000;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < kSamples; ++i) {
+            ShmLoan loan;
+            while (!(loan = sender.loan(destination)).valid()) {
+                std::this_thread::yield(); // 接收方还没有归还槽位
+            }
+            CdrSerializer serializer(loan.buffer());
+            serializer.serialize_uint32(i);
+            CHECK(sender.commit(loan, serializer.size()));
+        }
+    });
+    uint32_t expected = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (expected < kSamples) {
+        size_t n = receiver.receive(1000);
+        CHECK(n > 0);
+        for (size_t i = 0; i < n; ++i) {
+            CdrDeserializer d(receiver.received(i));
+            uint32_t value;
+            CHECK(d.deserialize_uint32(value) && value == expected);
+            ++expected;
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    producer.join();
+    std::cout << "跨线程顺序收发 " << kSamples << " 个样本，用时 " << elapsed << " us ✅" << std::endl;
+
+    // 测试4: 路由：本机地址自动选择共享内存，远端地址走 UDP
+    UdpTransport udp;
+    CHECK(udp.open());
+    TransportRouter router(&udp, &sender);
+    CHECK(is_local_locator(Locator("127.0.0.1", 17411)));
+    CHECK(!is_local_locator(Locator("203.0.113.7", 17411)));
+    CHECK(router.uses_shared_memory(Locator("127.0.0.1", 17411)));
+    CHECK(!router.uses_shared_memory(Locator("127.0.0.1", 17499))); // 对端没有共享内存段
+    const uint8_t ping[] = {1, 2, 3};
+    CHECK(router.send(ConstByteSpan(ping, sizeof(ping)), Locator("127.0.0.1", 17411)));
+    CHECK(receiver.receive(100) == 1 && receiver.received(0).size() == 3);
+    std::cout << "本机地址自动选择共享内存 ✅" << std::endl;
+
+    // 测试5: 所有者还活着的段不能被抢占；异常退出留下的段可以重建
+    {
+        ShmTransport duplicate(receiver_config);
+        CHECK(!duplicate.open());
+        CHECK(sender.send(ConstByteSpan(ping, sizeof(ping)), destination)); // 原来的段不受影响
+        CHECK(receiver.receive(100) == 1);
+
+        ShmTransportConfig crashed_config;
+        crashed_config.port = 17413;
+        crashed_config.slot_count = 4;
+        crashed_config.slot_size = 64;
+        pid_t child = ::fork();
+        CHECK(child >= 0);
+        if (child == 0) {
+            ShmTransport crashed(crashed_config);
+            ::_exit(crashed.open() ? 0 : 1); // 不析构，段留在系统里
+        }
+        int status = 0;
+        CHECK(::waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        ShmTransport restarted(crashed_config);
+        CHECK(restarted.open());
+    }
+    std::cout << "不抢占存活的段，清理遗留的段 ✅" << std::endl;
+
+    // 测试6: 对端关闭后缓存被淘汰；打不开的对端按重试间隔缓存
+    {
+        ShmTransportConfig cache_config;
+        cache_config.port = 17415;
+        cache_config.peer_retry_interval_ms = 50;
+        ShmTransport cached_sender(cache_config);
+
+        ShmTransportConfig peer_config;
+        peer_config.port = 17416;
+        peer_config.slot_count = 8;
+        peer_config.slot_size = 256;
+        Locator peer_locator = make_shm_locator(peer_config.port);
+        CHECK(!cached_sender.is_reachable(peer_locator));
+        std::unique_ptr<ShmTransport> peer(new ShmTransport(peer_config));
+        CHECK(peer->open());
+        CHECK(!cached_sender.is_reachable(peer_locator)); // 重试间隔内仍然认为不可达
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        CHECK(cached_sender.is_reachable(peer_locator));
+        CHECK(cached_sender.send(ConstByteSpan(ping, sizeof(ping)), peer_locator));
+        CHECK(peer->receive(100) == 1);
+
+        // 对端关闭，loan 仍然持有旧段
+        ShmLoan outstanding = cached_sender.loan(peer_locator);
+        CHECK(outstanding.valid());
+        peer.reset();
+        CHECK(!cached_sender.send(ConstByteSpan(ping, sizeof(ping)), peer_locator));
+
+        // 对端用同一个端口重新创建段，缓存里的旧段被替换
+        peer.reset(new ShmTransport(peer_config));
+        CHECK(peer->open());
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        CHECK(cached_sender.send(ConstByteSpan(ping, sizeof(ping)), peer_locator));
+        CHECK(peer->receive(100) == 1 && peer->received(0).size() == sizeof(ping));
+
+        // loan 比发送方的缓存活得更久：close 之后归还不会访问已经解除的映射
+        ShmLoan late = cached_sender.loan(peer_locator);
+        CHECK(late.valid());
+        cached_sender.close();
+        late = ShmLoan();
+        outstanding = ShmLoan();
+    }
+    std::cout << "对端缓存的淘汰与重试 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include "tinydds/dds/data_reader.hpp"
+#include "tinydds/dds/data_writer.hpp"
+#include "tinydds/dds/statistics_topic.hpp"
+#include "tinydds/rtps/data_fragmenter.hpp"
+#include "tinydds/rtps/entity_statistics.hpp"
+#include "tinydds/rtps/fragment_assembler.hpp"
+#include "tinydds/rtps/message_builder.hpp"
+#include "tinydds/rtps/message_parser.hpp"
+#include "tinydds/rtps/parameter_list.hpp"
+#include "tinydds/rtps/receive_window.hpp"
+#include "tinydds/rtps/writer_history.hpp"
+#include "test_check.hpp"
+#include <chrono>
+#include <iostream>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace tinydds::rtps;
+using tinydds::dds::DataReader;
+using tinydds::dds::DataWriter;
+using tinydds::dds::StatisticsPublisher;
+using tinydds::dds::StatisticsSample;
+
+namespace {
+
+GUID make_guid(uint8_t id, uint8_t kind){
+    GUID guid;
+    for(size_t i = 0; i < guid.prefix.value.size(); ++i) guid.prefix.value[i] = static_cast<uint8_t>(i + 1);
+    guid.entityId = EntityId(0x00, 0x00, id, kind);
+    return guid;
+}
+
+struct Tick{
+    uint64_t id;
+    double value;
+};
+
+} // namespace
+
+TINYDDS_CDR_TYPE(Tick, id, value);
+
+int main() {
+    std::cout << "=== 实体统计测试 ===" << std::endl;
+    std::cout << "统计" << (STATISTICS_ENABLED ? "已编译" : "已关闭") << std::endl;
+
+    const GUID writer_guid = make_guid(0x10, EntityKind::USER_WRITER_NO_KEY);
+    const GUID reader_guid = make_guid(0x11, EntityKind::USER_READER_NO_KEY);
+    StatisticsRegistry registry;
+    EntityStatistics* writer_stats = registry.register_entity(writer_guid);
+    EntityStatistics* reader_stats = registry.register_entity(reader_guid);
+    CHECK(registry.register_entity(writer_guid) == writer_stats);
+    CHECK(registry.size() == 2);
+
+    // 测试1: 写端历史缓存：KEEP_ALL 写满被拒绝、KEEP_LAST 挤掉没确认的样本、队列深度
+    //       （进缓存不算发出，发出的样本由 DataWriter 记录，见测试6）
+    {
+        HistoryQos qos;
+        qos.kind = HistoryKind::KEEP_ALL;
+        qos.max_samples = 4;
+        WriterHistoryCache history(qos);
+        history.set_statistics(writer_stats);
+        std::vector<uint8_t> payload(100, 0xAB);
+        for(int i = 0; i < 4; ++i) CHECK(history.add_change(payload));
+        CHECK(!history.add_change(payload));
+        history.remove_changes_up_to(SequenceNumber(3));
+
+        EntityStatisticsSnapshot snapshot;
+        CHECK(registry.snapshot(writer_guid, snapshot));
+        CHECK(snapshot.guid == writer_guid);
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(snapshot.counters.samples_sent == 0 && snapshot.counters.bytes_sent == 0);
+        CHECK(snapshot.counters.samples_dropped == 1);
+        CHECK(snapshot.counters.queue_depth == 1 && snapshot.counters.queue_depth_max == 4);
+#endif
+
+        EntityStatistics keep_last_stats(make_guid(0x12, EntityKind::USER_WRITER_NO_KEY));
+        HistoryQos keep_last;
+        keep_last.depth = 2;
+        WriterHistoryCache evicting(keep_last);
+        evicting.set_reliable(true);
+        evicting.set_statistics(&keep_last_stats);
+        CHECK(evicting.add_change(payload) && evicting.add_change(payload));
+        evicting.remove_changes_up_to(SequenceNumber(1)); // 确认了 1，腾出一个位置
+        CHECK(evicting.add_change(payload));              // 不挤掉任何样本
+        CHECK(evicting.add_change(payload));              // 挤掉没确认的 2
+        CHECK(evicting.add_change(payload));              // 挤掉没确认的 3
+        keep_last_stats.snapshot(snapshot);
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(snapshot.counters.samples_dropped == 2);
+        CHECK(snapshot.counters.queue_depth == 2 && snapshot.counters.queue_depth_max == 2);
+#endif
+
+        // 尽力而为的写端：挤掉最旧的样本只是替换，不算丢弃
+        EntityStatistics best_effort_stats(make_guid(0x13, EntityKind::USER_WRITER_NO_KEY));
+        WriterHistoryCache replacing(keep_last);
+        replacing.set_statistics(&best_effort_stats);
+        for(int i = 0; i < 5; ++i) CHECK(replacing.add_change(payload));
+        best_effort_stats.snapshot(snapshot);
+        CHECK(snapshot.counters.samples_dropped == 0);
+    }
+    std::cout << "写端历史缓存 ✅" << std::endl;
+
+    // 测试2: 读端接收窗口：收到、重复、超出窗口、ACKNACK
+    {
+        ReceiveWindow window;
+        window.set_statistics(reader_stats);
+        std::vector<uint8_t> payload(10, 0x01);
+        CHECK(window.on_data(SequenceNumber(1), payload) == ReceiveWindow::ReceiveResult::ACCEPTED);
+        CHECK(window.on_data(SequenceNumber(3), payload) == ReceiveWindow::ReceiveResult::ACCEPTED);
+        CHECK(window.on_data(SequenceNumber(3), payload) == ReceiveWindow::ReceiveResult::DUPLICATE);
+        CHECK(window.on_data(SequenceNumber(10000), payload) == ReceiveWindow::ReceiveResult::OUT_OF_WINDOW);
+        SequenceNumberSet acknack;
+        CHECK(window.build_acknack(acknack)); // 缺 2
+
+        EntityStatisticsSnapshot snapshot;
+        CHECK(registry.snapshot(reader_guid, snapshot));
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(snapshot.counters.samples_received == 0); // 由 DataReader 计数，见测试6
+        CHECK(snapshot.counters.samples_dropped == 1);
+        CHECK(snapshot.counters.nacks_sent == 1);
+#endif
+    }
+    std::cout << "读端接收窗口 ✅" << std::endl;
+
+    // 测试3: 分片：NACK_FRAG 的发出、收到和重传的分片数
+    {
+        DataFragmenter fragmenter(writer_guid.prefix, 1024, 4096);
+        fragmenter.set_statistics(writer_stats);
+        FragmentAssembler assembler;
+        assembler.set_statistics(reader_stats);
+
+        std::vector<uint8_t> sample(10 * 1024, 0x5A);
+        const EntityId reader_id = reader_guid.entityId;
+        const EntityId writer_id = writer_guid.entityId;
+        Span<const FragmentMessage> messages = fragmenter.fragment(reader_id, writer_id, SequenceNumber(1), sample);
+        // 只交给重组器第一条消息，之后的都丢了
+        std::vector<uint8_t> datagram;
+        for(size_t i = 0; i < messages[0].part_count; ++i){
+            datagram.insert(datagram.end(), messages[0].parts[i].begin(), messages[0].parts[i].end());
+        }
+        MessageParser parser(datagram);
+        SubmessageView sub;
+        CHECK(parser.next(sub) && sub.id == SubmessageId::DATA_FRAG);
+        DataFragSubmessage frag;
+        CHECK(parse_data_frag(sub, frag));
+        assembler.on_data_frag(frag);
+        assembler.on_heartbeat_frag(SequenceNumber(1), 10);
+
+        FragmentNumberSet missing;
+        CHECK(assembler.build_nack_frag(SequenceNumber(1), missing));
+        Span<const FragmentMessage> repairs =
+            fragmenter.fragment_missing(reader_id, writer_id, SequenceNumber(1), sample, missing);
+        CHECK(!repairs.empty());
+
+        EntityStatisticsSnapshot writer_snapshot;
+        EntityStatisticsSnapshot reader_snapshot;
+        CHECK(registry.snapshot(writer_guid, writer_snapshot));
+        CHECK(registry.snapshot(reader_guid, reader_snapshot));
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(writer_snapshot.counters.nacks_received == 1);
+        CHECK(writer_snapshot.counters.retransmits == 10 - fragmenter.fragments_per_message());
+        CHECK(reader_snapshot.counters.nacks_sent == 2);
+#endif
+    }
+    std::cout << "分片重传 ✅" << std::endl;
+
+    // 测试4: 抽样的序列化耗时和延迟直方图
+    {
+        StatisticsConfig config;
+        config.sample_period = 10; // 向上取整为 16
+        EntityStatistics statistics(make_guid(0x20, EntityKind::USER_WRITER_NO_KEY), config);
+        size_t timed = 0;
+        for(int i = 0; i < 64; ++i){
+            if(statistics.sample_timing()){
+                ++timed;
+                statistics.record_latency(1000 + static_cast<uint64_t>(i));
+            }
+        }
+        for(int i = 0; i < 64; ++i){
+            SerializationTimer timer(&statistics);
+        }
+        EntityStatisticsSnapshot snapshot;
+        statistics.snapshot(snapshot);
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(timed == 4);
+        CHECK(snapshot.counters.serializations == 4);
+        CHECK(snapshot.latency.count() == 4);
+        CHECK(snapshot.latency.min() >= 1000 && snapshot.latency.max() <= 1100);
+#else
+        CHECK(timed == 0 && snapshot.latency.count() == 0);
+#endif
+
+        // 关闭直方图时只记录计数器
+        config.latency_histograms = false;
+        EntityStatistics no_histogram(make_guid(0x21, EntityKind::USER_WRITER_NO_KEY), config);
+        no_histogram.record_latency(5000);
+        no_histogram.snapshot(snapshot);
+        CHECK(snapshot.latency.count() == 0);
+    }
+    std::cout << "抽样计时 ✅" << std::endl;
+
+    // 测试5: 多个线程同时记录，其他线程读快照（读到的值单调不减，计数不丢失）
+    {
+        EntityStatistics statistics(make_guid(0x30, EntityKind::USER_WRITER_NO_KEY));
+        const uint64_t total = 200000;
+        const size_t kThreads = 4;
+        std::vector<std::thread> writers;
+        for(size_t t = 0; t < kThreads; ++t){
+            writers.emplace_back([&, t]{
+                for(uint64_t i = 0; i < total; ++i){
+                    statistics.on_sample_sent(8);
+                    statistics.set_queue_depth(t * 10 + i % 10);
+                }
+            });
+        }
+        uint64_t last = 0;
+        EntityStatisticsSnapshot snapshot;
+        for(int i = 0; i < 1000; ++i){
+            statistics.snapshot(snapshot);
+            CHECK(snapshot.counters.samples_sent >= last);
+            last = snapshot.counters.samples_sent;
+        }
+        for(std::thread& writer : writers) writer.join();
+        statistics.snapshot(snapshot);
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(snapshot.counters.samples_sent == total * kThreads);
+        CHECK(snapshot.counters.bytes_sent == total * kThreads * 8);
+        CHECK(snapshot.counters.queue_depth_max == (kThreads - 1) * 10 + 9);
+#endif
+    }
+    std::cout << "并发快照 ✅" << std::endl;
+
+    // 测试6: 端到端：写端发出时带 INFO_TS 源时间戳，读端经过接收窗口交付时记录延迟
+    {
+        const GUID e2e_writer_guid = make_guid(0x40, EntityKind::USER_WRITER_NO_KEY);
+        const GUID e2e_reader_guid = make_guid(0x41, EntityKind::USER_READER_NO_KEY);
+        StatisticsConfig config;
+        config.sample_period = 1; // 每个样本都测量
+        StatisticsRegistry e2e_registry(config);
+        std::vector<std::vector<uint8_t>> sent;
+        MessageBuilder builder(e2e_writer_guid.prefix, [&](ConstByteSpan message){
+            sent.emplace_back(message.begin(), message.end());
+        }, 1472);
+        SampleSlab<Tick> writer_slab(8);
+        SampleSlab<Tick> reader_slab(8);
+        DataWriter<Tick> writer(builder, e2e_writer_guid.entityId, e2e_reader_guid.entityId, writer_slab);
+        DataReader<Tick> reader(reader_slab, 32);
+        writer.set_statistics(e2e_registry.register_entity(e2e_writer_guid));
+        reader.set_statistics(e2e_registry.register_entity(e2e_reader_guid));
+
+        const uint64_t kSamples = 20;
+        for(uint64_t i = 0; i < kSamples; ++i) CHECK(writer.write(Tick{i, i * 0.5}));
+        builder.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2)); // "传输"耗时
+
+        // 乱序交给窗口：先收到后一半，再收到前一半
+        ReceiveWindow window;
+        window.set_statistics(e2e_registry.register_entity(e2e_reader_guid)); // 和读端共用，每个样本只计一次
+        std::vector<std::pair<DataSubmessage, Timestamp>> received;
+        for(const auto& message : sent){
+            MessageParser parser(message);
+            SubmessageView sub;
+            Timestamp timestamp;
+            while(parser.next(sub)){
+                if(sub.id == SubmessageId::INFO_TS){
+                    InfoTimestampSubmessage info;
+                    CHECK(parse_info_ts(sub, info));
+                    timestamp = info.timestamp;
+                }
+                else if(sub.id == SubmessageId::DATA){
+                    DataSubmessage data;
+                    CHECK(parse_data(sub, data));
+                    CHECK(timestamp.valid());
+                    received.emplace_back(data, timestamp);
+                }
+            }
+        }
+        CHECK(received.size() == kSamples);
+        for(size_t i = 0; i < received.size(); ++i){
+            const auto& entry = received[(i + kSamples / 2) % kSamples];
+            CHECK(window.on_data(entry.first.writer_sn, entry.first.serialized_payload, entry.second) ==
+                  ReceiveWindow::ReceiveResult::ACCEPTED);
+        }
+        size_t delivered = window.deliver([&](const SequenceNumber&, ConstByteSpan payload, const Timestamp& source){
+            CHECK(reader.on_data(payload, source));
+        });
+        CHECK(delivered == kSamples);
+        for(uint64_t i = 0; i < kSamples; ++i){
+            LoanedSample<Tick> tick = reader.take();
+            CHECK(tick && tick->id == i);
+        }
+
+        EntityStatisticsSnapshot writer_snapshot;
+        EntityStatisticsSnapshot reader_snapshot;
+        CHECK(e2e_registry.snapshot(e2e_writer_guid, writer_snapshot));
+        CHECK(e2e_registry.snapshot(e2e_reader_guid, reader_snapshot));
+        sent.clear();
+        StatisticsPublisher publisher(e2e_registry);
+        CHECK(publisher.write_samples(builder) == 2);
+        builder.flush();
+        StatisticsSample reader_sample;
+        bool reader_sample_found = false;
+        for(const auto& message : sent){
+            MessageParser parser(message);
+            SubmessageView sub;
+            while(parser.next(sub)){
+                if(sub.id != SubmessageId::DATA) continue;
+                DataSubmessage data;
+                StatisticsSample sample;
+                CHECK(parse_data(sub, data) && tinydds::dds::decode_statistics_sample(data.serialized_payload, sample));
+                if(sample.entity_guid() == e2e_reader_guid){
+                    reader_sample = sample;
+                    reader_sample_found = true;
+                }
+            }
+        }
+        CHECK(reader_sample_found);
+#if TINYDDS_ENABLE_STATISTICS
+        CHECK(writer_snapshot.counters.samples_sent == kSamples);
+        CHECK(writer_snapshot.counters.samples_dropped == 0); // 默认 KEEP_LAST depth 1，替换不算丢弃
+        CHECK(reader_snapshot.counters.samples_received == kSamples);
+        CHECK(reader_snapshot.counters.bytes_received == kSamples * (ENCAPSULATION_HEADER_SIZE + 16));
+        CHECK(reader_snapshot.latency.count() == kSamples);
+        CHECK(reader_snapshot.latency.value_at_percentile(50) >= 1000000); // 至少是 sleep 的 2ms（留出桶的误差）
+        CHECK(reader_sample.latency.count == kSamples && reader_sample.latency.p50_ns >= 1000000);
+        CHECK(reader_sample.latency.p99_ns >= reader_sample.latency.p50_ns);
+#else
+        CHECK(reader_snapshot.latency.count() == 0 && reader_sample.latency.p50_ns == 0);
+#endif
+    }
+    std::cout << "端到端延迟 ✅" << std::endl;
+
+    // 测试7: 内置统计主题：每个实体一个 DATA，key hash 是 GUID
+    {
+        GuidPrefix prefix = writer_guid.prefix;
+        std::vector<std::vector<uint8_t>> sent;
+        MessageBuilder builder(prefix, [&](ConstByteSpan message){
+            sent.emplace_back(message.begin(), message.end());
+        }, 1472);
+        StatisticsPublisher publisher(registry);
+        CHECK(publisher.write_samples(builder) == 2);
+        builder.flush();
+
+        size_t samples = 0;
+        for(const auto& message : sent){
+            MessageParser parser(message);
+            SubmessageView sub;
+            while(parser.next(sub)){
+                if(sub.id != SubmessageId::DATA) continue;
+                DataSubmessage data;
+                CHECK(parse_data(sub, data));
+                CHECK(data.writer_id == EntityIdValues::ENTITYID_TINYDDS_STATISTICS_WRITER);
+                CHECK(data.reader_id == EntityIdValues::ENTITYID_TINYDDS_STATISTICS_READER);
+                StatisticsSample sample;
+                CHECK(tinydds::dds::decode_statistics_sample(data.serialized_payload, sample));
+                GUID guid = sample.entity_guid();
+                CHECK(guid == writer_guid || guid == reader_guid);
+
+                bool key_found = false;
+                ParameterListReader<NativeEndianPolicy> inline_qos(data.inline_qos);
+                CHECK(inline_qos.for_each([&](const Parameter& parameter){
+                    if(parameter.id == ParameterIdValues::PID_KEY_HASH){
+                        key_found = parameter.value.size() == 16 &&
+                                    std::memcmp(parameter.value.data(), sample.guid.data(), 16) == 0;
+                    }
+                    return true;
+                }));
+                CHECK(key_found);
+
+                EntityStatisticsSnapshot snapshot;
+                CHECK(registry.snapshot(guid, snapshot));
+                CHECK(sample.counters.samples_sent == snapshot.counters.samples_sent);
+                CHECK(sample.counters.nacks_sent == snapshot.counters.nacks_sent);
+                CHECK(sample.counters.queue_depth_max == snapshot.counters.queue_depth_max);
+                ++samples;
+            }
+        }
+        CHECK(samples == 2);
+    }
+    std::cout << "内置统计主题 ✅" << std::endl;
+
+    // 测试8: 注销
+    {
+        CHECK(registry.unregister_entity(reader_guid));
+        CHECK(!registry.unregister_entity(reader_guid));
+        EntityStatisticsSnapshot snapshot;
+        CHECK(!registry.snapshot(reader_guid, snapshot));
+        std::vector<EntityStatisticsSnapshot> all;
+        registry.snapshot_all(all);
+        CHECK(all.size() == 1 && all[0].guid == writer_guid);
+    }
+    std::cout << "注销 ✅" << std::endl;
+
+    std::cout << "所有实体统计测试通过 ✅" << std::endl;
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "tinydds/transport/udp_transport.hpp"
+#include "tinydds/rtps/cdr.hpp"
+#include "test_check.hpp"
+#include <iostream>
+
+using namespace tinydds::rtps;
+using namespace tinydds::transport;
+
+int main() {
+    std::cout << "=== UDP 传输 测试 ===" << std::endl;
+
+    // 测试1: 回环单播，批量发送 + 批量接收
+    UdpTransportConfig receiver_config;
+    receiver_config.bind_address = "127.0.0.1";
+    receiver_config.max_datagram_size = 1500;
+    receiver_config.receive_batch = 16;
+    UdpTransport receiver(receiver_config);
+    UdpTransport sender;
+    CHECK(receiver.open());
+    CHECK(sender.open());
+    Locator destination = receiver.local_locator();
+    CHECK(destination.port != 0);
+    std::cout << "接收端: " << destination.get_ipv4_string() << ":" << destination.port << std::endl;
+
+    const size_t kMessages = 100;
+    std::vector<CdrSerializer> payloads(kMessages);
+    std::vector<UdpDatagram> datagrams;
+    for (uint32_t i = 0; i < kMessages; ++i) {
+        payloads[i].serialize_uint32(i);
+        payloads[i].serialize_string("sample");
+        datagrams.push_back(UdpDatagram{payloads[i].buffer(), destination});
+    }
+    CHECK(sender.send_batch(datagrams) == kMessages);
+    // 100 个数据报只用了 2 次 sendmmsg（每次最多 64 个）
+    CHECK(sender.send_syscalls() == 2);
+
+    std::vector<bool> seen(kMessages, false);
+    size_t total = 0;
+    while (total < kMessages) {
+        size_t n = receiver.receive(1000);
+        if (n == 0) break;
+        for (size_t i = 0; i < n; ++i) {
+            const ReceivedDatagram& d = receiver.received(i);
+            CdrDeserializer deserializer(d.data);
+            uint32_t index;
+            std::string text;
+            CHECK(deserializer.deserialize_uint32(index) && deserializer.deserialize_string(text));
+            CHECK(index < kMessages && text == "sample");
+            CHECK(d.source.port == sender.local_locator().port);
+            seen[index] = true;
+        }
+        total += n;
+    }
+    CHECK(total == kMessages);
+    for (bool s : seen) CHECK(s);
+    std::cout << "批量收发 " << total << " 个数据报，recvmmsg 调用 "
+              << receiver.receive_syscalls() << " 次 ✅" << std::endl;
+
+    // 测试2: 没有数据时按超时返回
+    CHECK(receiver.receive(10) == 0);
+    std::cout << "接收超时 ✅" << std::endl;
+
+    // 测试3: 发送失败的数据报被跳过，同一批后面的照常发出
+    {
+        std::vector<uint8_t> oversized(70000, 0xAB); // 超过 UDP 长度上限，EMSGSIZE
+        const uint8_t small[] = {1, 2, 3};
+        std::vector<UdpDatagram> batch = {
+            UdpDatagram{ConstByteSpan(small, sizeof(small)), destination},
+            UdpDatagram{ConstByteSpan(oversized.data(), oversized.size()), destination},
+            UdpDatagram{ConstByteSpan(small, sizeof(small)), destination},
+        };
+        CHECK(sender.send_batch(batch) == 2);
+        CHECK(sender.send_errors() == 1);
+
+        ConstByteSpan too_many[UDP_MAX_GATHER_PARTS + 1];
+        for (auto& part : too_many) part = ConstByteSpan(small, 1);
+        std::vector<UdpGatherDatagram> gather = {
+            UdpGatherDatagram{too_many, UDP_MAX_GATHER_PARTS + 1, destination},
+            UdpGatherDatagram{too_many, 2, destination},
+        };
+        CHECK(sender.send_batch(gather) == 1);
+        CHECK(sender.send_errors() == 2);
+
+        size_t got = 0;
+        while (got < 3) {
+            size_t n = receiver.receive(1000);
+            if (n == 0) break;
+            got += n;
+        }
+        CHECK(got == 3);
+    }
+    std::cout << "跳过发送失败的数据报 ✅" << std::endl;
+
+    // 测试4: 超过接收缓冲区的数据报被截断，丢弃并计数
+    {
+        UdpTransportConfig small_config;
+        small_config.bind_address = "127.0.0.1";
+        small_config.max_datagram_size = 64;
+        UdpTransport small_receiver(small_config);
+        CHECK(small_receiver.open());
+        Locator small_destination = small_receiver.local_locator();
+        std::vector<uint8_t> large(200, 0x5A);
+        const uint8_t tiny[] = {'o', 'k'};
+        std::vector<UdpDatagram> batch = {
+            UdpDatagram{ConstByteSpan(large.data(), large.size()), small_destination},
+            UdpDatagram{ConstByteSpan(tiny, sizeof(tiny)), small_destination},
+        };
+        CHECK(sender.send_batch(batch) == 2);
+
+        size_t got = 0;
+        for (int attempt = 0; attempt < 10 && got + small_receiver.datagrams_truncated() < 2; ++attempt) {
+            size_t n = small_receiver.receive(1000);
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(small_receiver.received(i).data.size() == sizeof(tiny));
+            }
+            got += n;
+        }
+        CHECK(got == 1);
+        CHECK(small_receiver.datagrams_truncated() == 1);
+        CHECK(small_receiver.datagrams_received() == 1);
+    }
+    std::cout << "丢弃截断的数据报 ✅" << std::endl;
+
+    // 测试5: 多播（环境不支持多播时跳过）
+    UdpTransportConfig multicast_config;
+    multicast_config.port = 7411;
+    UdpTransport multicast_receiver(multicast_config);
+    Locator group = LocatorValues::default_multicast_locator(7411);
+    if (multicast_receiver.open() && multicast_receiver.join_multicast(group)) {
+        const uint8_t hello[] = {'h', 'i'};
+        CHECK(sender.send(ConstByteSpan(hello, sizeof(hello)), group));
+        size_t n = multicast_receiver.receive(1000);
+        if (n == 1 && multicast_receiver.received(0).data.size() == 2) {
+            std::cout << "多播收发 ✅" << std::endl;
+        } else {
+            std::cout << "多播未收到数据（当前网络环境可能不支持），跳过" << std::endl;
+        }
+        CHECK(multicast_receiver.leave_multicast(group));
+    } else {
+        std::cout << "无法加入多播组，跳过多播测试" << std::endl;
+    }
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}
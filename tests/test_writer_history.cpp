@@ -0,0 +1,86 @@
+#include "tinydds/rtps/writer_history.hpp"
+#include "test_check.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace tinydds::rtps;
+
+static std::vector<uint8_t> make_payload(int value, size_t size){
+    std::vector<uint8_t> data(size);
+    for(size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(value + i);
+    return data;
+}
+
+int main() {
+    std::cout << "=== WriterHistoryCache 测试 ===" << std::endl;
+
+    // 测试1: KEEP_LAST 只保留最近 depth 个样本
+    HistoryQos keep_last;
+    keep_last.kind = HistoryKind::KEEP_LAST;
+    keep_last.depth = 5;
+    WriterHistoryCache history(keep_last, 64);
+    CHECK(history.empty());
+    CHECK(history.min_seq() == SequenceNumber(1) && history.max_seq() == SequenceNumber(0));
+
+    for(int i = 1; i <= 12; ++i){
+        SequenceNumber sn;
+        auto payload = make_payload(i, 16 + i);
+        CHECK(history.add_change(payload, sn));
+        CHECK(sn == SequenceNumber(i));
+    }
+    CHECK(history.size() == 5);
+    CHECK(history.min_seq() == SequenceNumber(8) && history.max_seq() == SequenceNumber(12));
+    CHECK(history.get_change(SequenceNumber(7)) == nullptr);
+    CHECK(history.get_change(SequenceNumber(13)) == nullptr);
+    for(int i = 8; i <= 12; ++i){
+        const CacheChange* change = history.get_change(SequenceNumber(i));
+        CHECK(change != nullptr && change->sequence_number == SequenceNumber(i));
+        CHECK(change->payload == make_payload(i, 16 + i));
+    }
+    std::cout << "KEEP_LAST ✅" << std::endl;
+
+    // 测试2: 槽位内存复用（容量足够时不重新分配）
+    const uint8_t* before = history.get_change(SequenceNumber(8))->payload.data();
+    auto small = make_payload(99, 8);
+    CHECK(history.add_change(small));
+    for(int i = 14; i <= 16; ++i) CHECK(history.add_change(small));
+    // seq 16 与 seq 8 落在同一个槽位（容量 8）
+    CHECK(history.get_change(SequenceNumber(16))->payload.data() == before);
+    std::cout << "槽位复用 ✅" << std::endl;
+
+    // 测试3: KEEP_ALL 满了之后拒绝写入，确认后腾出空间
+    HistoryQos keep_all;
+    keep_all.kind = HistoryKind::KEEP_ALL;
+    keep_all.max_samples = 4;
+    WriterHistoryCache reliable(keep_all);
+    SequenceNumber sn;
+    auto add = [&](int value){
+        auto payload = make_payload(value, 4);
+        return reliable.add_change(payload, sn);
+    };
+    for(int i = 1; i <= 4; ++i) CHECK(add(i));
+    CHECK(reliable.full());
+    CHECK(!add(5));
+    CHECK(reliable.remove_changes_up_to(SequenceNumber(2)) == 2);
+    CHECK(reliable.remove_changes_up_to(SequenceNumber(1)) == 0);
+    CHECK(reliable.get_change(SequenceNumber(2)) == nullptr);
+    CHECK(add(5) && sn == SequenceNumber(5));
+    CHECK(add(6) && sn == SequenceNumber(6));
+    CHECK(!add(7));
+    std::cout << "KEEP_ALL ✅" << std::endl;
+
+    // 测试4: 按范围遍历（重传）
+    std::vector<int64_t> visited;
+    reliable.for_each_change(SequenceNumber(1), SequenceNumber(5), [&](const CacheChange& change){
+        visited.push_back(change.sequence_number.to_int64());
+    });
+    CHECK((visited == std::vector<int64_t>{3, 4, 5}));
+    CHECK(reliable.remove_min_change());
+    CHECK(reliable.remove_changes_up_to(SequenceNumber(100)) == 3);
+    CHECK(reliable.empty() && reliable.next_sequence_number() == SequenceNumber(7));
+    CHECK(reliable.min_seq() == SequenceNumber(7) && reliable.max_seq() == SequenceNumber(6));
+    std::cout << "范围遍历/删除 ✅" << std::endl;
+
+    std::cout << "\n所有测试通过！✅" << std::endl;
+    return 0;
+}